@@ -9,10 +9,35 @@
 #define CPU_ALU_H
 
 #include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * @brief ALU 연산 결과의 유일한 정의입니다 (0=ADD, 1=SUB, 2=MUL, 3=DIV)
+ * @param opcode ALU opcode
+ * @param a 첫 번째 피연산자
+ * @param b 두 번째 피연산자
+ * @returns 8비트 결과 (MUL/DIV는 부호 있는 연산, 0으로 나누면 0, 알 수 없는 opcode는 0)
+ *
+ * @details
+ * add/subtraction/multiply/divide, alu_compute, 테이블 생성기(tools/alu_table_gen.c)가 모두 이 함수를 씁니다.
+ * 생성기는 CPU 코어 없이 빌드되므로 헤더의 인라인 함수로 둡니다.
+ */
+static inline uint8_t alu_result(uint8_t opcode, uint8_t a, uint8_t b) {
+    switch (opcode) {
+        case 0: return (uint8_t)(a + b);
+        case 1: return (uint8_t)(a - b);
+        case 2: return (uint8_t)((int8_t)a * (int8_t)b);
+        case 3: return b == 0 ? 0 : (uint8_t)(int8_t)((int)(int8_t)a / (int8_t)b);   // -128 / -1 = -128
+        default: return 0;
+    }
+}
 
 uint8_t add(uint8_t a, uint8_t b);
 uint8_t subtraction(uint8_t a, uint8_t b);
 uint8_t multiply(uint8_t a, uint8_t b);
 uint8_t divide(uint8_t a, uint8_t b);
 
+// 로그/전역 플래그 없이 결과와 OF만 계산 (OoO 코어 등 별도 엔진용)
+uint8_t alu_compute(uint8_t opcode, uint8_t a, uint8_t b, bool *overflow);
+
 #endif // CPU_ALU_H
\ No newline at end of file
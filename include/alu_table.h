@@ -0,0 +1,48 @@
+/* include/alu_table.h - 테이블 기반 ALU 백엔드
+ * ------------------------------------------------------------
+ * 8비트 연산은 연산마다 입력이 65,536가지뿐이므로, 빌드 시 생성한
+ * 256×256 테이블(결과 + CF/ZF/SF/OF)을 조회해 분기 없이 계산합니다.
+ * 테이블은 tools/alu_table_gen.c가 빌드 디렉터리에 alu_tables.c로 생성합니다.
+ * Test Case: tests/alu_table_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_ALU_TABLE_H
+#define CPU_ALU_TABLE_H
+
+#include <stdint.h>
+
+#define ALU_TABLE_OPS     4U        /* ADD, SUB, MUL, DIV */
+#define ALU_TABLE_ENTRIES 65536U    /* (a << 8) | b */
+
+// 테이블 시작을 캐시 라인(64바이트)에 맞춤
+#if defined(_MSC_VER)
+#define ALU_TABLE_ALIGN __declspec(align(64))
+#else
+#define ALU_TABLE_ALIGN __attribute__((aligned(64)))
+#endif
+
+// 엔트리 하나: 하위 8비트 = 결과, 상위 8비트 = FLAG_* 비트
+#define ALU_TABLE_RESULT(entry) ((uint8_t)((entry) & 0xFF))
+#define ALU_TABLE_FLAGS(entry)  ((uint8_t)((entry) >> 8))
+
+// 생성된 테이블 (alu_tables.c)
+extern ALU_TABLE_ALIGN const uint16_t alu_table[ALU_TABLE_OPS][ALU_TABLE_ENTRIES];
+
+// ALU 백엔드 선택
+typedef enum {
+    ALU_BACKEND_BRANCH = 0,  // 기존 add/subtraction/multiply/divide (로그 포함)
+    ALU_BACKEND_TABLE        // 테이블 조회
+} ALU_Backend;
+
+void alu_set_backend(ALU_Backend backend);
+ALU_Backend alu_get_backend(void);
+const char* alu_backend_name(ALU_Backend backend);
+
+// 테이블 백엔드 연산 (handler_table에 설치됨)
+uint8_t alu_table_add(uint8_t a, uint8_t b);
+uint8_t alu_table_subtraction(uint8_t a, uint8_t b);
+uint8_t alu_table_multiply(uint8_t a, uint8_t b);
+uint8_t alu_table_divide(uint8_t a, uint8_t b);
+
+#endif // CPU_ALU_TABLE_H
@@ -0,0 +1,96 @@
+/* include/asm_session.h - 증분 어셈블 편집 세션
+ * ------------------------------------------------------------
+ * 에디터가 보낸 줄 단위 변경(diff)만 다시 어셈블해 이미지를 고칩니다.
+ * 세션은 줄마다 주소/바이트/읽은 심볼을 기억하고, 심볼마다 그 심볼을 쓰는 줄 목록을 둡니다.
+ *   - 바뀐 줄만 asm_assemble_line()으로 다시 어셈블합니다.
+ *   - 뒤 줄은 주소가 원래와 같아지는 곳까지만 옮기며, 옮긴 줄은 다시 인코딩하지 않습니다.
+ *   - 값이 바뀐 심볼(옮겨진 라벨, 고친 .equ)을 읽는 줄만 다시 인코딩합니다.
+ * 편집 결과로 바뀐 이미지 범위를 돌려주므로 호출자는 그 범위만 CPU 메모리에 반영하면 됩니다.
+ *
+ * asm_assemble()과의 차이:
+ *   - .equ/.org도 뒤에서 정의된 심볼을 쓸 수 있습니다 (서로 참조하면 오류).
+ *   - .org로 영역이 겹치면 마지막으로 인코딩된 줄의 바이트가 남습니다.
+ * Test Case: tests/assembler_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_ASM_SESSION_H
+#define CPU_ASM_SESSION_H
+
+#include "include/assembler.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct AsmSessionLine AsmSessionLine;
+typedef struct AsmSessionSymbol AsmSessionSymbol;
+
+typedef struct {
+    AsmSessionLine **lines;         /* 줄 순서대로 */
+    size_t line_count;
+    size_t line_capacity;
+
+    AsmSessionSymbol **symbols;     /* 오픈 어드레싱 (줄이 포인터로 가리키므로 심볼은 옮기지 않음) */
+    uint32_t symbol_capacity;
+    uint32_t symbol_count;
+
+    AsmSessionLine **pending;       /* 심볼 값이 바뀌어 다시 인코딩할 줄 */
+    size_t pending_count;
+    size_t pending_capacity;
+
+    AsmSessionSymbol **orphans;     /* 지운 줄이 정의했던 심볼 (편집 끝에 다시 정의됐는지 확인) */
+    size_t orphan_count;
+    size_t orphan_capacity;
+
+    uint8_t *image;                 /* 현재 이미지 */
+    AsmSessionLine **owner;         /* 주소별로 바이트를 쓴 줄 */
+    size_t capacity;
+    unsigned error_lines;           /* 오류가 있는 줄 수 */
+
+    /* 편집 하나를 처리하는 동안의 상태 */
+    AsmSessionLine *current;        /* 어셈블 중인 줄 (훅이 참조를 기록) */
+    size_t dirty_start;
+    size_t dirty_end;
+    unsigned assembled;
+    unsigned relocated;
+    int out_of_memory;
+} AsmSession;
+
+typedef struct {
+    size_t dirty_start;             /* 바뀐 이미지 범위 [start, end), 없으면 start == end */
+    size_t dirty_end;
+    unsigned assembled;             /* 다시 어셈블한 줄 수 */
+    unsigned relocated;             /* 다시 어셈블하지 않고 주소만 옮긴 줄 수 */
+    unsigned error_lines;           /* 편집 후 오류가 있는 줄 수 */
+} AsmEdit;
+
+// 빈 세션 (capacity바이트 이미지)
+int asm_session_init(AsmSession *session, size_t capacity);
+void asm_session_free(AsmSession *session);
+
+/*
+ * @brief 소스 전체를 새로 적재합니다 (asm_session_edit로 모든 줄을 바꾸는 것과 같음)
+ * @returns 성공 시 0, 메모리 부족 시 -1
+ */
+int asm_session_load(AsmSession *session, const char *source, size_t length, AsmEdit *edit);
+
+/*
+ * @brief first_line부터 delete_count줄을 지우고 그 자리에 text의 줄들을 넣습니다
+ * @param session 편집 세션
+ * @param first_line 0부터 세는 줄 번호
+ * @param delete_count 지울 줄 수
+ * @param text 넣을 줄들 ('\n'으로 구분, 줄 수 = '\n' 수 + 1), NULL이면 넣지 않음
+ * @param length text 길이
+ * @param edit 바뀐 이미지 범위와 통계
+ * @returns 성공 시 0 (어셈블 오류가 있어도 0), 범위 오류나 메모리 부족 시 -1 (세션은 그대로)
+ */
+int asm_session_edit(AsmSession *session, size_t first_line, size_t delete_count,
+                     const char *text, size_t length, AsmEdit *edit);
+
+// 이미지 (size에 가장 높은 사용 주소 + 1)
+const uint8_t* asm_session_image(const AsmSession *session, size_t *size);
+
+// 오류가 있는 줄의 오류를 줄 순서대로 최대 max개 복사 (line은 1부터), 복사한 개수 반환
+unsigned asm_session_errors(const AsmSession *session, AsmError *errors, unsigned max);
+
+#endif // CPU_ASM_SESSION_H
@@ -0,0 +1,106 @@
+/* include/assembler.h - 2패스 어셈블러 인터페이스
+ * ------------------------------------------------------------
+ * 소스 버퍼를 한 번 훑으며 문장을 토막(오프셋, 길이)으로 기록하고 주소를 배치한 뒤(1패스),
+ * 오픈 어드레싱 심볼 테이블로 라벨/상수를 풀어 ISA 테이블로 인코딩합니다(2패스).
+ * 줄마다 메모리를 할당하지 않으며, 오류는 줄/열과 함께 모읍니다.
+ *
+ * 문법 (한 줄):
+ *   [라벨:]... [니모닉 피연산자, 피연산자 | 지시어 인자...] [; 주석 | # 주석]
+ *   .org 식          위치 카운터를 옮김 (앞에서 정의된 심볼만 사용)
+ *   .byte 식, 식...  바이트를 그대로 씀 (-128~255, 뒤에서 정의된 라벨 사용 가능)
+ *   .equ 이름, 식     상수 정의 (앞에서 정의된 심볼만 사용)
+ *   식: 숫자(10진, 0x, 0b) | 심볼, + / - 로 연결
+ * 니모닉과 레지스터(R1~R7, V0~V3)는 대소문자를 구분하지 않고, 심볼은 구분합니다.
+ * Test Case: tests/assembler_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_ASSEMBLER_H
+#define CPU_ASSEMBLER_H
+
+#include "include/image.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ASM_MAX_ERRORS      16U     /* AsmResult에 보관하는 최대 오류 수 */
+#define ASM_ERROR_LENGTH    96U
+
+typedef struct {
+    unsigned line;          /* 1부터 */
+    unsigned column;        /* 1부터 (바이트 단위) */
+    char message[ASM_ERROR_LENGTH];
+} AsmError;
+
+typedef struct {
+    size_t size;                    /* 이미지 크기 (가장 높은 주소 + 1) */
+    unsigned lines;
+    unsigned instructions;
+    unsigned data_bytes;            /* .byte로 쓴 바이트 수 */
+    unsigned symbols;
+    unsigned error_count;           /* 전체 오류 수 (errors에는 앞쪽 ASM_MAX_ERRORS개) */
+    AsmError errors[ASM_MAX_ERRORS];
+} AsmResult;
+
+/*
+ * @brief 소스를 기계어 이미지로 어셈블합니다
+ * @param source 소스 버퍼 (NUL 종료가 아니어도 됨)
+ * @param length 소스 길이
+ * @param output 출력 이미지 (주소 = 오프셋)
+ * @param capacity output 크기 (이보다 높은 주소에 쓰면 오류)
+ * @param result 결과와 오류 목록
+ * @returns 오류가 없으면 0, 있으면 -1
+ */
+int asm_assemble(const char *source, size_t length, uint8_t *output, size_t capacity, AsmResult *result);
+
+// "줄:열: 메시지" 형식으로 출력
+void asm_print_errors(const AsmResult *result);
+
+/*
+ * @brief 소스를 어셈블하고 image_write()에 넘길 이미지 명세를 만듭니다
+ * @param source 소스 버퍼 (심볼 이름이 가리키므로 spec을 쓰는 동안 유지)
+ * @param length 소스 길이
+ * @param output 출력 이미지 (세그먼트 데이터가 가리키므로 spec을 쓰는 동안 유지)
+ * @param capacity output 크기 (65536 이하만 사용)
+ * @param spec 세그먼트(쓴 주소 범위만), 심볼, 진입 PC(첫 명령어) — asm_image_free로 해제
+ * @param result 결과와 오류 목록
+ * @returns 오류가 없으면 0, 있으면 -1
+ */
+int asm_assemble_image(const char *source, size_t length, uint8_t *output, size_t capacity,
+                       ImageSpec *spec, AsmResult *result);
+void asm_image_free(ImageSpec *spec);
+
+/* ---------------- 한 줄 모드 (편집 세션용) ---------------- */
+
+/* 심볼을 어셈블러 밖(편집 세션)의 테이블에서 찾고 정의하는 훅 */
+typedef struct {
+    // 값을 찾으면 0, 정의되지 않았으면 -1
+    int (*lookup)(void *context, const char *name, size_t length, long *value);
+    // 성공 시 0, 이미 정의되어 있으면 1, 메모리 부족 시 -1 (is_label: 라벨이면 1, .equ면 0)
+    int (*define)(void *context, const char *name, size_t length, long value, int is_label);
+    void *context;
+} AsmSymbolHooks;
+
+typedef struct {
+    size_t size;            /* 이 줄이 차지하는 바이트 수 (.org 줄은 0) */
+    size_t next;            /* 다음 줄의 주소 */
+    int sets_origin;        /* .org로 위치를 옮긴 줄인가? */
+    unsigned error_count;
+    AsmError error;         /* 첫 오류 (line은 항상 1) */
+} AsmLineResult;
+
+/*
+ * @brief 줄 하나를 주어진 주소에 어셈블합니다 (줄바꿈 없는 한 줄)
+ * @param text 줄 내용
+ * @param length 줄 길이
+ * @param address 줄이 시작하는 주소
+ * @param capacity 이미지 크기 (이보다 높은 주소에 쓰면 오류)
+ * @param hooks 심볼 훅 (라벨/.equ 정의와 모든 심볼 참조가 훅으로 갑니다)
+ * @param output 줄의 바이트 (length바이트 이상)
+ * @param result 크기, 다음 주소, 첫 오류
+ * @returns 오류가 없으면 0, 있으면 -1
+ */
+int asm_assemble_line(const char *text, size_t length, size_t address, size_t capacity,
+                      const AsmSymbolHooks *hooks, uint8_t *output, AsmLineResult *result);
+
+#endif // CPU_ASSEMBLER_H
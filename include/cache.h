@@ -16,6 +16,9 @@
 #define CACHE_NUM_LINES     64U      /* 총 64라인 → 256 B */
 #define CACHE_ASSOCIATIVITY 1U       /* direct-mapped */
 
+#define CACHE_HIT_LATENCY   1U       /* 히트 시 접근 사이클 */
+#define CACHE_MISS_PENALTY  10U      /* 미스 시 메모리에서 블록을 가져오는 추가 사이클 */
+
 typedef struct {
     uint16_t tag;                    /* 태그 필드 */
     uint8_t block[CACHE_LINE_SIZE];  /* 캐시 라인 데이터 */
@@ -23,16 +26,27 @@ typedef struct {
     uint8_t dirty;                   /* 메모리에 반영되어있는 값인가? */
 } CacheLine;
 
+typedef struct {
+    uint64_t hits;                   /* 히트 횟수 */
+    uint64_t misses;                 /* 미스 횟수 */
+    uint64_t writebacks;             /* dirty 라인을 메모리에 반영한 횟수 */
+} CacheStats;
+
 typedef struct {
     CacheLine lines[CACHE_NUM_LINES];
+    CacheStats stats;
 } Cache;
 
 /* 초기화 및 유지보수 */
 void cache_init(Cache *cache);
 void cache_flush(Cache *cache, uint8_t *memory, size_t mem_size);
+void cache_invalidate_range(Cache *cache, uint8_t *memory, size_t mem_size, uint16_t address, size_t size);
 
 /* 읽기/쓰기 연산 */
 uint8_t cache_read(Cache *cache, uint8_t *memory, size_t mem_size, uint16_t address);
 void    cache_write(Cache *cache, uint8_t *memory, size_t mem_size, uint16_t address, uint8_t value);
 
+/* 디버깅/UI용: 캐시 상태와 통계를 바꾸지 않고 최신 값을 확인 */
+uint8_t cache_peek(const Cache *cache, const uint8_t *memory, size_t mem_size, uint16_t address);
+
 #endif //CPU_CACHE_H
@@ -5,11 +5,51 @@
 #include "memory.h"
 #include "alu.h"
 #include "cache.h"
+#include "log.h"
+#include "image.h"
 #include <stdint.h>
 
-// 전역 CPU 상태
-extern CPU_Registers regs;
-extern Memory memory;
+// LOAD/STORE 명령어: 4비트 opcode + 1비트 모드 + 3비트 레지스터 + 8비트 주소
+// 모드 비트가 1이면 하위 4비트가 주소를 담은 레지스터 번호 (레지스터 간접 주소 지정)
+#define OPCODE_LOAD     5
+#define OPCODE_STORE    6
+#define MEM_MODE_INDIRECT 0x8
+
+// 관심 구간(region of interest) 표시 명령어: 실행 효과는 없음
+#define OPCODE_SYS      0xF
+#define INSTR_MARK      0xF000
+
+// 명령어 하나의 기본 실행 사이클 (캐시 미스 패널티는 별도)
+#define CPU_BASE_CYCLES 1U
+
+// 시뮬레이션 모드
+typedef enum {
+    CPU_MODE_DETAILED = 0,  // 캐시/타이밍 모델 + 로그
+    CPU_MODE_FUNCTIONAL     // 캐시 모델, 로그, 사이클 계산 없이 결과만 계산
+} CPU_Mode;
+
+// 실행 통계
+typedef struct {
+    uint64_t instructions;  // 실행한 명령어 수
+    uint64_t cycles;        // 상세 모드에서 누적한 사이클 수
+} CPU_Stats;
+
+// CPU 한 대의 전체 상태
+// 코어 함수들은 현재 스레드의 컨텍스트(cpu_set_context)에서 동작합니다
+typedef struct {
+    CPU_Registers regs;
+    Memory memory;
+    CPU_Stats stats;
+    CPU_Mode mode;
+    int saved_log_enabled;  // 기능 모드 진입 전 로그 설정
+    struct Profile *profile; // PC별 프로파일 (include/profiler.h, 처음 켤 때 할당)
+    int profiling;          // 1이면 cpu_step()마다 profile에 기록
+} CPU_Context;
+
+// 컨텍스트 관리
+void cpu_context_init(CPU_Context *ctx);
+CPU_Context* cpu_get_context(void);
+CPU_Context* cpu_set_context(CPU_Context *ctx);
 
 // CPU 초기화 및 실행 함수들
 void cpu_init(void);
@@ -17,11 +57,20 @@ void cpu_reset(void);
 void cpu_step(void);
 void cpu_run(void);
 void cpu_load_program(const uint8_t* program, size_t size);
+// 레지스터/PC는 그대로 두고 메모리 일부만 교체 (해당 캐시 라인만 반영 후 비움)
+void cpu_patch_program(uint16_t address, const uint8_t* bytes, size_t size);
+// 검사를 마친 이미지(image_open)로 리셋 후 세그먼트/초기 레지스터/진입 PC 적재 (범위 초과 시 -1)
+int cpu_load_image(const ProgramImage *image);
+
+// 시뮬레이션 모드 전환 (상세 모드로 돌아갈 때 최근 warmup_accesses개 접근으로 캐시를 데움)
+void cpu_set_mode(CPU_Mode mode, unsigned warmup_accesses);
+CPU_Mode cpu_get_mode(void);
 
 // CPU 상태 정보 함수들
 void print_cpu_state(void);
 CPU_Registers* get_cpu_registers(void);
 Memory* get_cpu_memory(void);
+CPU_Stats* get_cpu_stats(void);
 
 // 명령어 처리 함수들
 uint16_t fetch_instruction(void);
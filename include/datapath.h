@@ -0,0 +1,60 @@
+/* include/datapath.h - 8/16/32비트 데이터패스 인터페이스
+ * ------------------------------------------------------------
+ * 레지스터 파일, ALU, 명령어 인코딩을 폭(8/16/32비트)별로 특수화한 코어입니다.
+ * 구현은 src/datapath_template.h 하나를 폭마다 한 번씩 include해 생성하므로
+ * 각 변형은 실행 중 폭 검사 없이 독립된 빠른 경로로 컴파일됩니다.
+ *
+ * 명령어는 8비트 코어와 같은 isa.c 표로 디코드하고(include/isa.h), 폭에 따라 달라지는 것은:
+ *   MOV  Rn, imm : [0x4 | n] [imm: 폭/8 바이트, 빅엔디안]
+ *   LOAD/STORE, 기존 6비트 포맷의 메모리 기록 : 폭/8 바이트를 빅엔디안으로 읽고 씀
+ * 패킹 SIMD/벡터 메모리는 8비트 레인 그대로이고, 정지는 0x0000입니다.
+ * 8비트 변형(dp8)은 cpu_step()과 같은 결과를 냅니다.
+ * Test Case: tests/datapath_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_DATAPATH_H
+#define CPU_DATAPATH_H
+
+#include "include/memory.h"
+#include "include/register.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * 폭별 타입과 함수 선언을 만드는 매크로
+ * 예: DATAPATH_DECLARE(16, uint16_t) → DP_Machine16, dp16_step(), ...
+ */
+#define DATAPATH_DECLARE(BITS, UINT)                                                     \
+    typedef struct {                                                                     \
+        uint16_t pc;                                                                     \
+        UINT r[8];              /* R1~R7 (r[0]은 사용하지 않음) */                       \
+        uint8_t flags;          /* FLAG_CF/ZF/SF/OF */                                   \
+        uint8_t v[VREG_COUNT][VREG_LANES];  /* 벡터 레지스터 (simd.h) */                 \
+    } DP_Regs##BITS;                                                                     \
+                                                                                         \
+    typedef struct {                                                                     \
+        DP_Regs##BITS regs;                                                              \
+        Memory memory;                                                                   \
+        uint64_t instructions;                                                           \
+        uint64_t cycles;        /* 기본 사이클 + 캐시 미스 패널티 */                     \
+        int halted;                                                                      \
+    } DP_Machine##BITS;                                                                  \
+                                                                                         \
+    void     dp##BITS##_init(DP_Machine##BITS *machine);                                 \
+    void     dp##BITS##_load_program(DP_Machine##BITS *machine,                          \
+                                     const uint8_t *program, size_t size);               \
+    UINT     dp##BITS##_alu(unsigned op, UINT a, UINT b, uint8_t *flags);                \
+    int      dp##BITS##_step(DP_Machine##BITS *machine);                                 \
+    uint64_t dp##BITS##_run(DP_Machine##BITS *machine, uint64_t max_steps);              \
+    size_t   dp##BITS##_encode_mov(uint8_t reg, UINT imm, uint8_t *buffer);              \
+    size_t   dp##BITS##_encode_alu(unsigned op, uint8_t reg1, uint8_t reg2, uint8_t *buffer); \
+    size_t   dp##BITS##_encode_mem(unsigned opcode, uint8_t reg, int indirect,           \
+                                   uint8_t address, uint8_t *buffer);
+
+DATAPATH_DECLARE(8, uint8_t)
+DATAPATH_DECLARE(16, uint16_t)
+DATAPATH_DECLARE(32, uint32_t)
+
+#endif // CPU_DATAPATH_H
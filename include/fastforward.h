@@ -0,0 +1,45 @@
+/* include/fastforward.h - 기능 모드 fast-forward 인터페이스
+ * ------------------------------------------------------------
+ * 관심 구간 전까지는 캐시/로그/타이밍 없이 cpu_step()으로 빠르게 실행하고,
+ * PC/단계 수/MARK 명령어에서 멈춘 뒤 캐시를 데워 상세 모드로 전환합니다.
+ * Test Case: tests/fastforward_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_FASTFORWARD_H
+#define CPU_FASTFORWARD_H
+
+#include <stdint.h>
+
+#define FF_NO_STOP_PC (-1)
+#define FF_CHECK_INTERVAL 1024U     // should_stop 확인 간격 (단계)
+
+// 멈춤 조건
+typedef struct {
+    int32_t stop_pc;            // 이 PC에 도달하면 (실행 전) 멈춤, FF_NO_STOP_PC면 사용 안 함
+    uint64_t max_steps;         // 이만큼 실행하면 멈춤, 0이면 제한 없음
+    int stop_at_marker;         // MARK 명령어를 실행한 직후 멈출지 여부
+    unsigned warmup_accesses;   // 상세 모드로 전환할 때 재생할 최근 메모리 접근 수
+    int (*should_stop)(void *arg);  // FF_CHECK_INTERVAL 단계마다 호출, 0이 아니면 멈춤 (NULL이면 사용 안 함)
+    void *stop_arg;
+} FastForwardConfig;
+
+// 멈춘 이유
+typedef enum {
+    FF_STOP_PC = 0,
+    FF_STOP_STEPS,
+    FF_STOP_MARKER,
+    FF_STOP_HALT,               // 빈 명령어 또는 메모리 끝
+    FF_STOP_CANCELLED           // should_stop (취소, 마감 시각)
+} FastForwardStop;
+
+typedef struct {
+    FastForwardStop reason;
+    uint64_t steps;             // 기능 모드로 실행한 명령어 수
+} FastForwardResult;
+
+void ff_default_config(FastForwardConfig *config);
+FastForwardResult cpu_fast_forward(const FastForwardConfig *config);
+const char* ff_stop_reason_name(FastForwardStop reason);
+
+#endif // CPU_FASTFORWARD_H
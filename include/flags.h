@@ -7,6 +7,54 @@
 // 전방 선언
 struct CPU_Registers;
 
+// 플래그 비트 (CPU_Registers.flags)
+#define FLAG_CF 0x01    // 캐리: 덧셈 자리올림 / 뺄셈 자리빌림 / 곱셈 범위 초과
+#define FLAG_ZF 0x02    // 제로: 결과가 0
+#define FLAG_SF 0x04    // 부호: 결과의 최상위 비트
+#define FLAG_OF 0x08    // 오버플로우: 부호 있는 범위 초과 또는 0으로 나누기
+
+// 플래그를 마지막으로 바꾼 연산 (지연 평가용)
+typedef enum {
+    FLAG_OP_NONE = 0,   // flags 필드에 이미 계산된 값이 있음
+    FLAG_OP_ADD,
+    FLAG_OP_SUB,
+    FLAG_OP_MUL,
+    FLAG_OP_DIV
+} FlagOp;
+
+/*
+ * @brief ALU 연산의 종류와 피연산자만 기록합니다 (플래그는 읽을 때 계산)
+ * @param regs CPU 레지스터 구조체 포인터
+ * @param op FlagOp 연산 종류
+ * @param a 첫 번째 피연산자
+ * @param b 두 번째 피연산자
+ * @param result 연산 결과
+ * @returns 없음 (void)
+ */
+void flags_record(struct CPU_Registers* regs, uint8_t op, uint8_t a, uint8_t b, uint8_t result);
+
+/*
+ * @brief 기록된 연산으로부터 CF/ZF/SF/OF를 계산합니다
+ * @param regs CPU 레지스터 구조체 포인터
+ * @returns FLAG_* 비트 조합
+ */
+uint8_t get_flags(const struct CPU_Registers* regs);
+
+/*
+ * @brief 플래그 하나를 직접 설정합니다 (기록된 연산은 먼저 계산해 확정)
+ * @param regs CPU 레지스터 구조체 포인터
+ * @param flag FLAG_* 비트
+ * @param value 설정할 값
+ * @returns 없음 (void)
+ */
+void set_flag(struct CPU_Registers* regs, uint8_t flag, bool value);
+
+// 개별 플래그 설정/읽기
+void set_carry_flag(struct CPU_Registers* regs, bool value);
+bool get_carry_flag(const struct CPU_Registers* regs);
+bool get_zero_flag(const struct CPU_Registers* regs);
+bool get_sign_flag(const struct CPU_Registers* regs);
+
 /*
  * @brief 덧셈 연산에서 캐리 플래그를 설정합니다
  * @param regs CPU 레지스터 구조체 포인터
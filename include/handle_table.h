@@ -0,0 +1,68 @@
+/* include/handle_table.h - 세대 번호가 붙은 핸들 테이블
+ * ------------------------------------------------------------
+ * 포인터를 32비트 핸들(하위 HANDLE_INDEX_BITS = 슬롯 번호, 상위 = 세대)로 등록합니다.
+ * 빈 슬롯은 free-list로 이어 두므로 등록/해제/조회가 모두 O(1)이고,
+ * 해제할 때 슬롯의 세대를 올리므로 같은 슬롯을 다시 써도 옛 핸들은 NULL로 조회됩니다.
+ * 슬롯이 모자라면 배열을 두 배로 늘리며 (max_slots까지), 항목 자체는 옮기지 않습니다.
+ * 유효한 핸들은 0이 아닙니다 (세대는 1부터). 스레드 안전하지 않으므로 호출자가 직렬화합니다.
+ * Test Case: tests/handle_table_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_HANDLE_TABLE_H
+#define CPU_HANDLE_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define HANDLE_INDEX_BITS   20U
+#define HANDLE_INDEX_MASK   ((1U << HANDLE_INDEX_BITS) - 1U)
+#define HANDLE_MAX_SLOTS    (1U << HANDLE_INDEX_BITS)
+#define HANDLE_GENERATIONS  (1U << (32U - HANDLE_INDEX_BITS))
+#define HANDLE_INVALID      0U
+#define HANDLE_NO_SLOT      UINT32_MAX      /* free-list 끝 */
+
+typedef uint32_t Handle;
+
+typedef struct {
+    void *item;                 /* NULL이면 빈 슬롯 */
+    uint32_t generation;        /* 1 ~ HANDLE_GENERATIONS-1 */
+    uint32_t next_free;         /* 빈 슬롯일 때 다음 빈 슬롯 */
+} HandleSlot;
+
+typedef struct {
+    HandleSlot *slots;
+    uint32_t capacity;
+    uint32_t count;             /* 등록된 항목 수 */
+    uint32_t free_head;
+    uint32_t max_slots;
+} HandleTable;
+
+// max_slots: 슬롯 수 상한 (0이거나 HANDLE_MAX_SLOTS보다 크면 HANDLE_MAX_SLOTS)
+int  handle_table_init(HandleTable *table, uint32_t initial_capacity, uint32_t max_slots);
+void handle_table_free(HandleTable *table);
+
+/*
+ * @brief 항목을 등록합니다
+ * @returns 핸들, 상한에 닿았거나 메모리가 부족하면 HANDLE_INVALID
+ */
+Handle handle_alloc(HandleTable *table, void *item);
+
+/*
+ * @brief 핸들의 항목을 찾습니다
+ * @returns 항목, 해제됐거나 잘못된 핸들이면 NULL
+ */
+void* handle_get(const HandleTable *table, Handle handle);
+
+/*
+ * @brief 항목을 해제합니다 (이 핸들은 이후 조회되지 않음)
+ * @returns 성공 시 0, 이미 해제됐거나 잘못된 핸들이면 -1
+ */
+int handle_release(HandleTable *table, Handle handle);
+
+// 슬롯 순회용 (index < capacity, 빈 슬롯이면 NULL)
+static inline void* handle_table_at(const HandleTable *table, uint32_t index) {
+    return table->slots[index].item;
+}
+
+#endif // CPU_HANDLE_TABLE_H
@@ -0,0 +1,18 @@
+/* include/hash.h - 64비트 비암호 해시
+ * ------------------------------------------------------------
+ * 내용 주소 캐시(프로그램/실행 결과)의 키를 빠르게 해시합니다.
+ * 알고리즘은 xxHash64와 같아 같은 입력에 같은 값을 냅니다 (충돌 확인은 호출자가 키를 비교).
+ * Test Case: tests/lru_cache_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_HASH_H
+#define CPU_HASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// data[0..length)의 64비트 해시
+uint64_t hash64(const void *data, size_t length, uint64_t seed);
+
+#endif // CPU_HASH_H
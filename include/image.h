@@ -0,0 +1,127 @@
+/* include/image.h - 바이너리 프로그램 이미지 형식
+ * ------------------------------------------------------------
+ * 어셈블한 프로그램을 텍스트/JSON 없이 바로 적재할 수 있는 파일 형식입니다.
+ * 파일을 mmap한 뒤 헤더와 표를 구조체로 그대로 가리키므로 적재할 때 파싱이나 복사가 없습니다.
+ *
+ * 파일 구성 (모든 값은 리틀엔디언, 표와 데이터는 8바이트 정렬):
+ *   ImageHeader                     magic "CPUI", 버전, 진입 PC, 초기 레지스터, 표 위치, 체크섬
+ *   ImageSegment[segment_count]     메모리 주소, 크기, 데이터 오프셋
+ *   ImageSymbol[symbol_count]       이름(문자열 표 오프셋), 값 (선택)
+ *   문자열 표                        심볼 이름들 (NUL 없이 이어 붙임)
+ *   세그먼트 데이터
+ * 체크섬은 헤더 뒤 전체의 hash64이며, image_view()가 모든 오프셋/크기를 검사한 뒤에만 성공합니다.
+ * Test Case: tests/image_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_IMAGE_H
+#define CPU_IMAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define IMAGE_MAGIC         "CPUI"
+#define IMAGE_VERSION       1U
+#define IMAGE_ALIGN         8U
+#define IMAGE_REGISTERS     8U      /* registers[1..7] = R1~R7 ([0]은 사용하지 않음) */
+
+/* ImageHeader.flags */
+#define IMAGE_FLAG_REGISTERS 0x0001U    /* registers[]의 초기값을 적용 */
+
+typedef struct {
+    char magic[4];              /* IMAGE_MAGIC */
+    uint16_t version;           /* IMAGE_VERSION (빅엔디언 호스트에서는 맞지 않아 거부됨) */
+    uint16_t flags;             /* IMAGE_FLAG_* */
+    uint16_t load_address;      /* 가장 낮은 세그먼트 주소 */
+    uint16_t entry_pc;          /* 적재 후 PC */
+    uint16_t segment_count;
+    uint16_t symbol_count;
+    uint32_t symbol_offset;     /* ImageSymbol 표의 파일 오프셋 */
+    uint32_t string_offset;     /* 문자열 표의 파일 오프셋 */
+    uint32_t string_size;
+    uint32_t file_size;         /* 파일 전체 크기 */
+    uint64_t checksum;          /* 헤더 뒤 전체의 hash64 */
+    uint8_t registers[IMAGE_REGISTERS];
+} ImageHeader;                  /* 48바이트, 바로 뒤에 세그먼트 표 */
+
+typedef struct {
+    uint16_t address;           /* 메모리 주소 */
+    uint16_t size;              /* 바이트 수 */
+    uint32_t offset;            /* 데이터의 파일 오프셋 */
+} ImageSegment;
+
+typedef struct {
+    uint32_t name_offset;       /* 문자열 표 안의 오프셋 */
+    uint16_t name_length;
+    uint16_t reserved;
+    int32_t value;
+} ImageSymbol;
+
+/* 검사를 마친 이미지 (모든 포인터는 파일 매핑 또는 호출자 버퍼를 가리킴) */
+typedef struct {
+    const ImageHeader *header;
+    const ImageSegment *segments;
+    const ImageSymbol *symbols;
+    const char *strings;
+    void *mapping;              /* image_open이 만든 매핑 (image_view면 NULL) */
+    size_t mapping_size;
+} ProgramImage;
+
+/* 이미지를 쓸 때의 입력 */
+typedef struct {
+    uint16_t address;
+    uint16_t size;
+    const uint8_t *data;
+} ImageSegmentSpec;
+
+typedef struct {
+    const char *name;           /* NUL 종료가 아니어도 됨 */
+    size_t length;
+    long value;
+} ImageSymbolSpec;
+
+typedef struct {
+    uint16_t entry_pc;
+    int has_registers;
+    uint8_t registers[IMAGE_REGISTERS];
+    const ImageSegmentSpec *segments;
+    unsigned segment_count;
+    const ImageSymbolSpec *symbols;
+    unsigned symbol_count;
+} ImageSpec;
+
+// 세그먼트 데이터 (검사를 마친 이미지이므로 범위 안)
+static inline const uint8_t* image_segment_data(const ProgramImage *image, unsigned index) {
+    return (const uint8_t *)image->header + image->segments[index].offset;
+}
+
+/*
+ * @brief 메모리에 있는 이미지를 검사하고 표를 가리킵니다 (복사 없음)
+ * @param data 이미지 (8바이트 정렬)
+ * @param size 크기
+ * @param image 결과
+ * @param error 실패 이유 (NULL 가능)
+ * @param error_size error 크기
+ * @returns 성공 시 0, 형식 오류 시 -1
+ */
+int image_view(const void *data, size_t size, ProgramImage *image, char *error, size_t error_size);
+
+// 파일을 읽기 전용으로 mmap하고 image_view로 검사 (성공하면 image_close로 해제)
+int image_open(const char *path, ProgramImage *image, char *error, size_t error_size);
+void image_close(ProgramImage *image);
+
+// 심볼 값 찾기 (있으면 0)
+int image_find_symbol(const ProgramImage *image, const char *name, long *value);
+
+/*
+ * @brief 이미지 파일을 씁니다
+ * @param file 출력 파일 (바이너리 모드)
+ * @param spec 세그먼트/심볼/진입점
+ * @param error 실패 이유 (NULL 가능)
+ * @param error_size error 크기
+ * @returns 성공 시 0, 실패 시 -1
+ */
+int image_write(FILE *file, const ImageSpec *spec, char *error, size_t error_size);
+
+#endif // CPU_IMAGE_H
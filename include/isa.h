@@ -0,0 +1,138 @@
+/* include/isa.h - 선언적 ISA 테이블
+ * ------------------------------------------------------------
+ * 명령어 하나가 ISA_INSTRUCTIONS의 한 줄이며, 어셈블러(isa_encode), 디스어셈블러
+ * (isa_disassemble), 디코더(isa_decode), 실행기 디스패치 테이블(cpu.c)이 모두 이 표에서
+ * 만들어집니다. 명령어를 추가할 때는 이 표와 실행 함수만 고치면 됩니다.
+ *
+ * 포맷 (16비트 빅엔디언 워드):
+ *   RR     [op][r1][r2][1111]     ALU 레지스터-레지스터, 결과는 R7 (r1, r2 = 1~7)
+ *   I6     [op][a:6][b:6]         기존 6비트 즉시값 포맷 (ALU: R1=a, R2=b, R7=결과 / MOV: 메모리[a]=b)
+ *   RI     [op][reg][imm8]        레지스터 ← 즉시값 (reg = 1~7)
+ *   MEM    [op][M|reg:3][addr8]   M=1이면 [0000][areg]로 레지스터 값이 주소 (reg, areg = 1~7)
+ *   PACKED [op][vd:2][vs:2][op:2][S][L][0000]
+ *   VMEM   [op][W][L][v:2][addr8]
+ *   NONE   워드 전체가 고정 (MARK)
+ * 같은 니모닉의 여러 포맷은 이웃한 줄에 두며, 어셈블러는 피연산자 모양이 맞는 첫 줄을,
+ * 디코더는 (워드 & mask) == base이고 포맷 조건을 만족하는 첫 줄을 고릅니다.
+ * Test Case: tests/isa_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_ISA_H
+#define CPU_ISA_H
+
+#include "include/cpu.h"
+#include "include/simd.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ISA_HASH_SIZE 64    /* 니모닉 완전 해시 슬롯 수 (2의 거듭제곱) */
+
+#define ISA_PACKED_BASE(op, sat, lanes8) \
+    (uint16_t)((OPCODE_PACKED << 12) | ((op) << PACKED_OP_SHIFT) | ((sat) ? PACKED_SATURATE : 0) | \
+               ((lanes8) ? PACKED_LANES8 : 0))
+#define ISA_VMEM_BASE(store, lanes8) \
+    (uint16_t)((OPCODE_VMEM << 12) | (((store) ? VMEM_STORE : 0) | ((lanes8) ? VMEM_LANES8 : 0)) << 8)
+
+/* X(id, 니모닉, 포맷, base, mask, 실행 함수 접미사) */
+#define ISA_INSTRUCTIONS(X) \
+    X(ADD_RR,  "ADD",     RR,     0x000F, 0xF00F, alu_rr)  \
+    X(ADD_I6,  "ADD",     I6,     0x0000, 0xF000, alu_i6)  \
+    X(SUB_RR,  "SUB",     RR,     0x100F, 0xF00F, alu_rr)  \
+    X(SUB_I6,  "SUB",     I6,     0x1000, 0xF000, alu_i6)  \
+    X(MUL_RR,  "MUL",     RR,     0x200F, 0xF00F, alu_rr)  \
+    X(MUL_I6,  "MUL",     I6,     0x2000, 0xF000, alu_i6)  \
+    X(DIV_RR,  "DIV",     RR,     0x300F, 0xF00F, alu_rr)  \
+    X(DIV_I6,  "DIV",     I6,     0x3000, 0xF000, alu_i6)  \
+    X(MOV_RI,  "MOV",     RI,     0x4000, 0xF000, mov_ri)  \
+    X(MOV_I6,  "MOV",     I6,     0x4000, 0xF000, mov_i6)  \
+    X(LOAD,    "LOAD",    MEM,    (OPCODE_LOAD << 12), 0xF000, load)   \
+    X(STORE,   "STORE",   MEM,    (OPCODE_STORE << 12), 0xF000, store) \
+    X(PADD,    "PADD",    PACKED, ISA_PACKED_BASE(PACKED_ADD, 0, 1), 0xF0FF, packed) \
+    X(PADDS,   "PADDS",   PACKED, ISA_PACKED_BASE(PACKED_ADD, 1, 1), 0xF0FF, packed) \
+    X(PADD4,   "PADD4",   PACKED, ISA_PACKED_BASE(PACKED_ADD, 0, 0), 0xF0FF, packed) \
+    X(PADDS4,  "PADDS4",  PACKED, ISA_PACKED_BASE(PACKED_ADD, 1, 0), 0xF0FF, packed) \
+    X(PSUB,    "PSUB",    PACKED, ISA_PACKED_BASE(PACKED_SUB, 0, 1), 0xF0FF, packed) \
+    X(PSUBS,   "PSUBS",   PACKED, ISA_PACKED_BASE(PACKED_SUB, 1, 1), 0xF0FF, packed) \
+    X(PSUB4,   "PSUB4",   PACKED, ISA_PACKED_BASE(PACKED_SUB, 0, 0), 0xF0FF, packed) \
+    X(PSUBS4,  "PSUBS4",  PACKED, ISA_PACKED_BASE(PACKED_SUB, 1, 0), 0xF0FF, packed) \
+    X(PMUL,    "PMUL",    PACKED, ISA_PACKED_BASE(PACKED_MUL, 0, 1), 0xF0FF, packed) \
+    X(PMULS,   "PMULS",   PACKED, ISA_PACKED_BASE(PACKED_MUL, 1, 1), 0xF0FF, packed) \
+    X(PMUL4,   "PMUL4",   PACKED, ISA_PACKED_BASE(PACKED_MUL, 0, 0), 0xF0FF, packed) \
+    X(PMULS4,  "PMULS4",  PACKED, ISA_PACKED_BASE(PACKED_MUL, 1, 0), 0xF0FF, packed) \
+    X(VLOAD,   "VLOAD",   VMEM,   ISA_VMEM_BASE(0, 1), 0xFC00, vmem) \
+    X(VLOAD4,  "VLOAD4",  VMEM,   ISA_VMEM_BASE(0, 0), 0xFC00, vmem) \
+    X(VSTORE,  "VSTORE",  VMEM,   ISA_VMEM_BASE(1, 1), 0xFC00, vmem) \
+    X(VSTORE4, "VSTORE4", VMEM,   ISA_VMEM_BASE(1, 0), 0xFC00, vmem) \
+    X(MARK,    "MARK",    NONE,   INSTR_MARK, 0xFFFF, mark)
+
+typedef enum {
+    ISA_FMT_RR = 0,
+    ISA_FMT_I6,
+    ISA_FMT_RI,
+    ISA_FMT_MEM,
+    ISA_FMT_PACKED,
+    ISA_FMT_VMEM,
+    ISA_FMT_NONE,
+    ISA_FMT_COUNT
+} IsaFormat;
+
+/* 0은 어떤 줄과도 맞지 않는 워드 (초기화 전 디코드 테이블도 INVALID) */
+#define ISA_ENUM_ENTRY(id, mnemonic, format, base, mask, exec) ISA_##id,
+typedef enum {
+    ISA_INVALID = 0,
+    ISA_INSTRUCTIONS(ISA_ENUM_ENTRY)
+    ISA_COUNT
+} IsaId;
+#undef ISA_ENUM_ENTRY
+
+/* 분류된 피연산자 (어셈블러가 심볼을 풀어 만든 값도 같은 형태) */
+typedef enum {
+    ISA_OPND_NONE = 0,  /* 없음 */
+    ISA_OPND_REG,       /* R1~R7 */
+    ISA_OPND_VREG,      /* V0~V3 */
+    ISA_OPND_IMM,       /* 숫자 */
+    ISA_OPND_MEM,       /* [숫자] */
+    ISA_OPND_MEM_REG,   /* [R1~R7] */
+    ISA_OPND_INVALID
+} IsaOperandKind;
+
+typedef struct {
+    IsaOperandKind kind;
+    long value;         /* 레지스터 번호 또는 숫자 */
+} IsaOperand;
+
+typedef struct {
+    const char *mnemonic;
+    IsaFormat format;
+    uint16_t base;
+    uint16_t mask;
+} IsaInfo;
+
+extern const IsaInfo isa_table[ISA_COUNT];
+extern uint8_t isa_decode_table[65536];     /* 워드 → IsaId (isa_init에서 채움) */
+
+// 디코드 테이블과 니모닉 해시를 만듭니다 (cpu_init에서 호출, 여러 번 호출해도 됨)
+int isa_init(void);
+
+// 워드 → 명령어 (O(1), isa_init 이후)
+static inline IsaId isa_decode(uint16_t word) {
+    return (IsaId)isa_decode_table[word];
+}
+
+// 니모닉 → 그 니모닉의 첫 줄, 없으면 ISA_INVALID
+IsaId isa_lookup(const char *mnemonic);
+
+// 어셈블리 한 줄 ↔ 워드
+int isa_encode(const char *mnemonic, const char *operand1, const char *operand2, uint16_t *word);
+int isa_encode_operands(IsaId first, const IsaOperand *operand1, const IsaOperand *operand2, uint16_t *word,
+                        char *error, size_t error_size);
+int isa_disassemble(uint16_t word, char *output, int max_length);
+
+// 피연산자 파서 (R1~R7 → 1~7, V0~V3 → 0~3, 실패 시 -1)
+int isa_parse_register(const char *text);
+int isa_parse_vector_register(const char *text);
+void isa_parse_operand(const char *text, IsaOperand *operand);
+
+#endif // CPU_ISA_H
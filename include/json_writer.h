@@ -0,0 +1,54 @@
+/* include/json_writer.h - 할당 없는 스트리밍 JSON 출력
+ * ------------------------------------------------------------
+ * 호출자가 준 버퍼에 JSON 텍스트를 앞에서부터 바로 씁니다 (객체 트리, 중간 문자열, malloc 없음).
+ * 쉼표는 중첩 깊이마다 "첫 항목인가" 비트 하나로 처리하고, 공간이 모자라면 overflow만 표시한 뒤
+ * 이후 호출을 모두 무시하므로 호출자는 마지막에 jw_finish() 한 번만 확인하면 됩니다.
+ * 서버에서는 풀에서 꺼낸 전송 프레임(include/send_queue.h)의 본문에 바로 써서 복사 없이 대기열에 넣습니다.
+ * Test Case: tests/json_writer_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_JSON_WRITER_H
+#define CPU_JSON_WRITER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define JW_MAX_DEPTH 32U
+
+typedef struct {
+    char *buffer;
+    size_t capacity;
+    size_t length;
+    uint32_t has_items;         /* 비트 d = 깊이 d에 이미 항목이 있음 (다음 항목 앞에 쉼표) */
+    unsigned depth;
+    int after_key;              /* 키 바로 뒤 (값 앞에 쉼표를 쓰지 않음) */
+    int overflow;
+} JsonWriter;
+
+void jw_init(JsonWriter *writer, char *buffer, size_t capacity);
+
+void jw_begin_object(JsonWriter *writer);
+void jw_end_object(JsonWriter *writer);
+void jw_begin_array(JsonWriter *writer);
+void jw_end_array(JsonWriter *writer);
+
+// 객체 안의 키 (키는 이스케이프가 필요 없는 ASCII 식별자로 가정)
+void jw_key(JsonWriter *writer, const char *key);
+
+void jw_int(JsonWriter *writer, long value);
+void jw_uint64(JsonWriter *writer, uint64_t value);
+void jw_bool(JsonWriter *writer, int value);
+void jw_string(JsonWriter *writer, const char *text);     /* ", \, 제어 문자 이스케이프, UTF-8은 그대로 */
+
+// 작은 정수 배열 (메모리/캐시 블록)
+void jw_byte_array(JsonWriter *writer, const uint8_t *bytes, size_t count);
+
+/*
+ * @brief 출력을 끝냅니다
+ * @param writer JSON 출력기
+ * @returns 쓴 길이, 공간이 모자랐거나 중첩이 맞지 않으면 0
+ */
+size_t jw_finish(const JsonWriter *writer);
+
+#endif // CPU_JSON_WRITER_H
@@ -0,0 +1,26 @@
+/* include/log.h - 실행 로그 출력 스위치
+ * ------------------------------------------------------------
+ * 명령어 실행 중 printf 로그를 런타임에 켜고 끄는 매크로를 정의합니다.
+ * 기능(functional) 모드처럼 로그가 필요 없는 구간에서는 분기 하나만 비용으로 남습니다.
+ * Test Case: tests/cpu_cycle_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_LOG_H
+#define CPU_LOG_H
+
+#include <stdio.h>
+
+// 스레드 로컬 저장소 (C99에는 _Thread_local이 없어 컴파일러 확장 사용)
+#if defined(_MSC_VER)
+#define CPU_THREAD_LOCAL __declspec(thread)
+#else
+#define CPU_THREAD_LOCAL __thread
+#endif
+
+// 0이면 CPU_LOG 출력을 생략 (cpu.c에서 정의, 스레드마다 별도)
+extern CPU_THREAD_LOCAL int cpu_log_enabled;
+
+#define CPU_LOG(...) do { if (cpu_log_enabled) printf(__VA_ARGS__); } while (0)
+
+#endif // CPU_LOG_H
@@ -0,0 +1,54 @@
+/* include/lru_cache.h - 메모리 상한이 있는 내용 주소 LRU 캐시
+ * ------------------------------------------------------------
+ * 바이트열 키 → 바이트열 값. 키는 hash64로 버킷을 고르고 전체 바이트를 비교하므로 해시가
+ * 충돌해도 잘못된 값을 돌려주지 않습니다. 항목 하나는 헤더+키+값을 한 번에 할당하며,
+ * 전체 크기(max_bytes)를 넘으면 가장 오래 쓰지 않은 항목부터 버립니다.
+ * 스레드 안전하지 않으므로 호출자가 직렬화합니다.
+ * Test Case: tests/lru_cache_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_LRU_CACHE_H
+#define CPU_LRU_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct LruEntry LruEntry;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t insertions;
+    uint64_t evictions;         /* 용량 때문에 버린 항목 수 */
+} LruStats;
+
+typedef struct {
+    LruEntry **buckets;         /* 체이닝 해시 (2의 거듭제곱) */
+    size_t bucket_count;
+    LruEntry *head;             /* 가장 최근에 쓴 항목 */
+    LruEntry *tail;             /* 가장 오래된 항목 (다음에 버릴 것) */
+    size_t entry_count;
+    size_t bytes;               /* 항목이 차지한 전체 바이트 (헤더 포함) */
+    size_t max_bytes;
+    LruStats stats;
+} LruCache;
+
+// max_bytes: 항목 전체 크기 상한 (0이면 아무것도 저장하지 않음)
+int  lru_init(LruCache *cache, size_t max_bytes);
+void lru_free(LruCache *cache);
+void lru_clear(LruCache *cache);
+
+/*
+ * @brief 키의 값을 찾고 그 항목을 가장 최근으로 옮깁니다
+ * @returns 값 포인터 (8바이트 정렬, 다음 lru_put/lru_clear 전까지 유효), 없으면 NULL
+ */
+const void* lru_get(LruCache *cache, const void *key, size_t key_length, size_t *value_length);
+
+/*
+ * @brief 키에 값을 저장합니다 (같은 키가 있으면 교체)
+ * @returns 저장하면 0, 항목 하나가 상한보다 크거나 메모리 부족이면 -1
+ */
+int lru_put(LruCache *cache, const void *key, size_t key_length, const void *value, size_t value_length);
+
+#endif // CPU_LRU_CACHE_H
@@ -14,14 +14,21 @@
 #include <stdint.h>
 
 #define MEMORY_SIZE 256 // 256B 매모리
+#define MEMORY_ACCESS_LOG_SIZE 1024U // 캐시 없이 실행할 때 기억하는 최근 접근 수 (2의 거듭제곱)
+#define MEMORY_ACCESS_WRITE 0x10000U // access_log 항목의 쓰기 표시 비트
 
 typedef struct {
     uint8_t data[MEMORY_SIZE];
     Cache cache;
+    uint8_t cache_enabled;                        /* 0이면 캐시 모델 없이 data[]에 직접 접근 */
+    uint32_t access_log[MEMORY_ACCESS_LOG_SIZE];  /* 캐시 비활성 중 최근 접근 (주소 | 쓰기 비트) */
+    uint32_t access_log_pos;                      /* 누적 접근 수 (링 버퍼 위치) */
 } Memory;
 
 void init_memory(Memory *memory);
 void memory_write(Memory *memory, uint16_t address, uint8_t value);
 uint8_t memory_read(Memory *memory, uint16_t address);
+uint8_t memory_peek(const Memory *memory, uint16_t address);
+void memory_set_cache_enabled(Memory *memory, int enabled, unsigned warmup_accesses);
 
 #endif //CPU_MEMORY_H
@@ -0,0 +1,151 @@
+/* include/ooo.h - 비순차(Out-of-Order) 슈퍼스칼라 코어 인터페이스
+ * ------------------------------------------------------------
+ * Tomasulo 알고리즘(레지스터 리네이밍 + 예약 스테이션)과 재정렬 버퍼(ROB)로
+ * 명령어를 비순차 실행하고 순차 커밋하는 대체 코어 엔진을 정의합니다.
+ * 결과는 기존 순차 코어(cpu_step)와 비교해 검증할 수 있습니다.
+ * Test Case: tests/ooo_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_OOO_H
+#define CPU_OOO_H
+
+#include "include/register.h"
+#include "include/memory.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define OOO_MAX_ISSUE_WIDTH 8U     /* 설정 가능한 최대 issue 폭 */
+#define OOO_MAX_ROB_SIZE    64U    /* 재정렬 버퍼 최대 크기 */
+#define OOO_MAX_RS_SIZE     16U    /* 기능 유닛별 예약 스테이션 최대 개수 */
+#define OOO_MAX_FU_UNITS    4U     /* 기능 유닛 종류별 최대 유닛 수 */
+#define OOO_MAX_UOPS        4U     /* 명령어 하나가 쪼개지는 최대 micro-op 수 */
+
+/* 기능 유닛 종류 */
+typedef enum {
+    OOO_FU_ADD = 0,   /* ADD/SUB */
+    OOO_FU_MUL,       /* MUL */
+    OOO_FU_DIV,       /* DIV */
+    OOO_FU_LS,        /* LOAD/STORE */
+    OOO_FU_COUNT
+} OOO_FuClass;
+
+/* micro-op 종류 */
+typedef enum {
+    OOO_UOP_NOP = 0,  /* 아무 효과 없음 (정의되지 않은 opcode) */
+    OOO_UOP_MOVI,     /* 레지스터 ← 즉시값 (기능 유닛 불필요) */
+    OOO_UOP_ALU,      /* 레지스터 ← 레지스터/즉시값 ALU 연산 */
+    OOO_UOP_LOAD,     /* 레지스터 ← 메모리[src1/imm1] (캐시 경유) */
+    OOO_UOP_STORE,    /* 메모리[src2/imm2] ← src1/imm1 (커밋 시 캐시 경유 기록) */
+    OOO_UOP_SIMD      /* 패킹 SIMD/벡터 메모리 (word를 커밋 시 순차 실행) */
+} OOO_UopType;
+
+/* 코어 구성 파라미터 */
+typedef struct {
+    unsigned issue_width;                   /* 사이클당 issue 가능한 micro-op 수 */
+    unsigned commit_width;                  /* 사이클당 커밋 가능한 micro-op 수 */
+    unsigned rob_size;                      /* ROB 엔트리 수 */
+    unsigned rs_size[OOO_FU_COUNT];         /* 종류별 예약 스테이션 수 */
+    unsigned fu_units[OOO_FU_COUNT];        /* 종류별 기능 유닛 수 */
+    unsigned latency[OOO_FU_COUNT];         /* 종류별 실행 지연 (사이클) */
+} OOO_Config;
+
+/* 디코드된 micro-op */
+typedef struct {
+    uint8_t type;       /* OOO_UopType */
+    uint8_t alu_op;     /* ALU opcode (0~3) */
+    uint8_t dest;       /* 목적지 레지스터 (0 = 없음) */
+    uint8_t src1;       /* 소스 레지스터 1 (0 = 즉시값 imm1 사용) */
+    uint8_t src2;       /* 소스 레지스터 2 (0 = 즉시값 imm2 사용) */
+    uint8_t imm1;
+    uint8_t imm2;
+    uint16_t pc;        /* 원래 명령어의 PC */
+    uint16_t word;      /* OOO_UOP_SIMD: 원래 명령어 */
+    uint8_t last;       /* 명령어의 마지막 micro-op인가? (IPC 집계용) */
+} OOO_Uop;
+
+/* 재정렬 버퍼 엔트리 */
+typedef struct {
+    uint8_t busy;
+    uint8_t ready;          /* 결과가 준비되어 커밋 가능한가? */
+    uint8_t type;
+    uint8_t dest;
+    uint8_t value;          /* 레지스터 결과 또는 STORE 데이터 */
+    uint8_t writes_flag;    /* 플래그를 갱신하는 micro-op인가? */
+    uint8_t alu_op;         /* 플래그 계산용 연산과 피연산자 (커밋 시 flags_record) */
+    uint8_t flag_a;
+    uint8_t flag_b;
+    uint8_t last;
+    uint16_t address;       /* LOAD/STORE 유효 주소 (실행 시 계산) */
+    uint16_t pc;
+    uint16_t word;          /* OOO_UOP_SIMD: 커밋 시 실행할 명령어 */
+} OOO_RobEntry;
+
+/* 예약 스테이션 엔트리 */
+typedef struct {
+    uint8_t busy;
+    uint8_t executing;      /* 기능 유닛에서 실행 중인가? */
+    uint8_t alu_op;
+    uint8_t vj, vk;         /* 준비된 피연산자 값 */
+    int qj, qk;             /* 피연산자를 생산할 ROB 인덱스 (-1 = 준비됨) */
+    int rob;                /* 결과를 기록할 ROB 인덱스 */
+    unsigned remaining;     /* 남은 실행 사이클 */
+    uint64_t seq;           /* issue 순서 (oldest-first 선택용) */
+} OOO_RSEntry;
+
+/* 실행 통계 */
+typedef struct {
+    uint64_t cycles;
+    uint64_t instructions;                  /* 커밋된 아키텍처 명령어 수 */
+    uint64_t uops;                          /* 커밋된 micro-op 수 */
+    uint64_t rob_full_stalls;               /* ROB가 가득 차 issue가 멈춘 사이클 */
+    uint64_t rs_full_stalls[OOO_FU_COUNT];  /* 예약 스테이션이 가득 차 멈춘 사이클 */
+    uint64_t fu_busy_stalls[OOO_FU_COUNT];  /* 준비된 연산이 유닛을 기다린 횟수 */
+    uint64_t pipeline_flushes;              /* 자기 수정 코드로 인한 파이프라인 비움 */
+    uint64_t memory_order_stalls;           /* 앞선 STORE를 기다린 LOAD 횟수 */
+} OOO_Stats;
+
+/* OoO 코어 전체 상태 */
+typedef struct {
+    OOO_Config config;
+
+    CPU_Registers regs;     /* 아키텍처(커밋된) 레지스터 상태 */
+    Memory memory;          /* 코어 전용 메모리 + 캐시 */
+
+    int rat[8];             /* 레지스터 별칭 테이블: R1~R7 → ROB 인덱스 (-1 = 아키텍처 값) */
+
+    OOO_RobEntry rob[OOO_MAX_ROB_SIZE];
+    unsigned rob_head;
+    unsigned rob_count;
+
+    OOO_RSEntry rs[OOO_FU_COUNT][OOO_MAX_RS_SIZE];
+    unsigned fu_busy[OOO_FU_COUNT];         /* 현재 사용 중인 유닛 수 */
+
+    OOO_Uop pending[OOO_MAX_UOPS];          /* 디코드되었지만 아직 issue되지 않은 micro-op */
+    unsigned pending_count;
+    unsigned pending_pos;
+
+    uint16_t fetch_pc;                      /* 다음 fetch 주소 */
+    int fetch_halted;                       /* 빈 명령어/메모리 끝에 도달 */
+    uint64_t seq;
+
+    OOO_Stats stats;
+} OOO_Core;
+
+/* 구성 및 초기화 */
+void ooo_default_config(OOO_Config *config);
+void ooo_init(OOO_Core *core, const OOO_Config *config);
+void ooo_load_program(OOO_Core *core, const uint8_t *program, size_t size);
+
+/* 실행 */
+int      ooo_cycle(OOO_Core *core);
+uint64_t ooo_run(OOO_Core *core, uint64_t max_cycles);
+int      ooo_is_done(const OOO_Core *core);
+
+/* 통계 및 검증 */
+double ooo_ipc(const OOO_Core *core);
+void   ooo_print_stats(const OOO_Core *core);
+int    ooo_verify_against_sequential(const uint8_t *program, size_t size, const OOO_Config *config);
+
+#endif //CPU_OOO_H
@@ -0,0 +1,71 @@
+/* include/profiler.h - PC별 실행 프로파일러 인터페이스
+ * ------------------------------------------------------------
+ * 게스트 PC마다 실행 횟수와 캐시 미스를 MEMORY_SIZE 크기의 평평한 배열에 세고,
+ * 정렬된 핫스팟 보고서(디스어셈블리 포함)와 flamegraph용 folded stack을 만듭니다.
+ * 켜져 있을 때 cpu_step()의 비용은 실행 횟수 증가 한 번(+ 미스가 났을 때만 덧셈)입니다.
+ * 사이클은 상세 모드 모델(CPU_BASE_CYCLES + 미스 × CACHE_MISS_PENALTY)로 보고 시 계산합니다.
+ * Test Case: tests/profiler_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_PROFILER_H
+#define CPU_PROFILER_H
+
+#include "include/memory.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define PROFILE_OPCODES 16
+
+// profiler_enable() 반환값
+#define PROFILER_OK          0
+#define PROFILER_ERR_NOMEM  (-1)    /* 카운터 할당 실패 */
+
+/* PC별 카운터 (CPU_Context.profile이 가리킴) */
+typedef struct Profile {
+    uint64_t count[MEMORY_SIZE];    /* 이 PC에서 실행한 명령어 수 */
+    uint64_t misses[MEMORY_SIZE];   /* 이 PC의 명령어가 일으킨 캐시 미스 (fetch + 데이터) */
+} Profile;
+
+/* 보고서 한 줄 */
+typedef struct {
+    uint16_t pc;
+    uint16_t word;
+    uint64_t count;
+    uint64_t misses;
+    uint64_t cycles;
+} ProfileHotspot;
+
+/* opcode별 합계 */
+typedef struct {
+    uint64_t count;
+    uint64_t misses;
+    uint64_t cycles;
+} ProfileOpcode;
+
+// 바이트 → 어셈블리 변환 함수 (decode_bytes_to_assembly와 같은 형태, NULL이면 16진수로 표시)
+typedef int (*profiler_disasm_fn)(const uint8_t *bytes, int byte_count, char *output, int max_length);
+
+// 켜기/끄기 (현재 CPU 컨텍스트에 적용, 끈 뒤에도 결과는 남음)
+int      profiler_enable(void);
+void     profiler_disable(void);
+int      profiler_is_enabled(void);
+void     profiler_reset(void);
+Profile* profiler_get(void);
+
+// 실행 시 훅 (cpu_step)
+static inline void profiler_record(Profile *profile, uint16_t pc, uint64_t misses) {
+    profile->count[pc]++;
+    if (misses) profile->misses[pc] += misses;
+}
+
+// 결과 (명령어는 보고 시점의 memory에서 읽으므로 자기 수정 코드는 마지막 내용으로 표시됨)
+int  profiler_hotspots(const Profile *profile, const Memory *memory, ProfileHotspot *out, int max_count);
+void profiler_opcodes(const Profile *profile, const Memory *memory, ProfileOpcode out[PROFILE_OPCODES]);
+const char* profiler_opcode_name(uint8_t opcode);
+void profiler_print_report(const Profile *profile, const Memory *memory, FILE *out, int top_n,
+                           profiler_disasm_fn disasm);
+int  profiler_write_folded(const Profile *profile, const Memory *memory, FILE *out, profiler_disasm_fn disasm);
+
+#endif // CPU_PROFILER_H
@@ -12,9 +12,13 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+// 패킹 SIMD 벡터 레지스터 (V0~V3, 각 8개의 8비트 레인)
+#define VREG_COUNT 4
+#define VREG_LANES 8
+
 // 범용 레지스터
 // 다음 리스트는 그저 권장사항일 뿐이지, 사용하는 방법은 상관없다.
-typedef struct
+typedef struct CPU_Registers
 {
     uint16_t pc;        // 누산기: 산술 연산, 데이터 저장
     uint8_t register1; // 베이스: 메모리 주소 지정 시 베이스 주소로 사용
@@ -24,7 +28,13 @@ typedef struct
     uint8_t register5; // 목적지 인덱스: 문자열/배열 복사 시 목적지 주소
     uint8_t register6; // 베이스 포인터: 스택 프레임의 시작 주소를 가리킴 (지역 변수 접근)
     uint8_t register7; // 스택 포인터: 스택의 가장 윗부분을 가리킴 (PUSH, POP)
-    bool overflow_flag;   // 캐리 플래그: 덧셈 시 자리올림, 뺄셈 시 자리빌림 발생 시 설정
+    // 플래그 (flags.h): 마지막 ALU 연산만 기록하고 읽을 때 CF/ZF/SF/OF를 계산
+    uint8_t flags;        // 확정된 플래그 (flag_op가 FLAG_OP_NONE일 때 유효)
+    uint8_t flag_op;      // 플래그를 마지막으로 바꾼 연산
+    uint8_t flag_a;       // 그 연산의 피연산자와 결과
+    uint8_t flag_b;
+    uint8_t flag_result;
+    uint8_t vreg[VREG_COUNT][VREG_LANES];  // 벡터 레지스터 (simd.h)
 } CPU_Registers;
 
 // 레지스터 번호 상수 (0~7)
@@ -50,7 +60,7 @@ uint8_t get_register(const CPU_Registers* regs, uint8_t reg_num);
 // 모든 레지스터를 0으로 초기화
 void reset_registers(CPU_Registers* regs);
 
-// 캐리 플래그 설정/읽기 함수들
+// 오버플로우 플래그 설정/읽기 함수들 (나머지 플래그는 flags.h)
 void set_overflow_flag(CPU_Registers* regs, bool value);
 bool get_overflow_flag(const CPU_Registers* regs);
 
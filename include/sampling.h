@@ -0,0 +1,67 @@
+/* include/sampling.h - 샘플링 시뮬레이션 인터페이스
+ * ------------------------------------------------------------
+ * 기능 모드로 프로그램 전체를 빠르게 실행하며 N 명령어마다 체크포인트를 남기고,
+ * 선택한 구간만 스레드 풀에서 상세(캐시/타이밍) 모드로 병렬 실행한 뒤
+ * CPI와 캐시 미스율을 신뢰구간과 함께 전체 실행으로 외삽합니다.
+ * Test Case: tests/sampling_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_SAMPLING_H
+#define CPU_SAMPLING_H
+
+#include "include/cpu.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SAMPLE_MAX_CHECKPOINTS 256U   /* 저장할 수 있는 최대 체크포인트(구간) 수 */
+#define SAMPLE_MAX_THREADS     16U    /* 상세 구간을 실행할 최대 워커 스레드 수 */
+#define SAMPLE_Z_95            1.96   /* 95% 신뢰구간 z 값 */
+
+/* 샘플링 구성 */
+typedef struct {
+    uint64_t interval_length;   /* 구간 길이 N (명령어 수) */
+    unsigned max_samples;       /* 상세 실행할 구간 수 K, 0이면 전체 구간 */
+    unsigned threads;           /* 워커 스레드 수 */
+    unsigned warmup_accesses;   /* 구간 시작 전 캐시를 데울 최근 메모리 접근 수 */
+    uint64_t max_instructions;  /* 기능 모드 실행 상한, 0이면 프로그램 끝까지 */
+} SampleConfig;
+
+/* 구간 시작 시점의 아키텍처 상태 */
+typedef struct {
+    uint64_t start_instruction;
+    CPU_Registers regs;
+    Memory memory;              /* 데이터 + 캐시 워밍용 접근 기록 */
+} SampleCheckpoint;
+
+/* 상세 모드로 실행한 구간 하나의 결과 */
+typedef struct {
+    unsigned checkpoint;        /* 체크포인트(구간) 번호 */
+    uint64_t instructions;
+    uint64_t cycles;
+    uint64_t hits;
+    uint64_t misses;
+    double cpi;
+    double miss_rate;
+} SampleInterval;
+
+/* 외삽 결과 */
+typedef struct {
+    uint64_t total_instructions;    /* 기능 모드로 센 전체 명령어 수 */
+    unsigned total_intervals;       /* 전체 구간 수 */
+    unsigned sampled_intervals;     /* 상세 실행한 구간 수 */
+    double cpi_mean;                /* 표본 구간의 사이클 합 / 명령어 합 */
+    double cpi_ci;                  /* 95% 신뢰구간 반폭 */
+    double miss_rate_mean;          /* 미스 합 / 접근 합 */
+    double miss_rate_ci;
+    double estimated_cycles;
+    double estimated_cycles_ci;
+    SampleInterval intervals[SAMPLE_MAX_CHECKPOINTS];
+} SampleResult;
+
+void sample_default_config(SampleConfig *config);
+int  cpu_sample_run(const uint8_t *program, size_t size, const SampleConfig *config, SampleResult *result);
+void sample_print_result(const SampleResult *result);
+
+#endif // CPU_SAMPLING_H
@@ -0,0 +1,111 @@
+/* include/send_queue.h - 클라이언트별 전송 대기열과 참조 카운트 프레임
+ * ------------------------------------------------------------
+ * 브로드캐스트 메시지는 OutFrame 하나로 한 번만 직렬화하고, 받을 클라이언트마다 대기열에
+ * 포인터만 넣습니다 (참조 +1). 실제 전송은 LWS_CALLBACK_SERVER_WRITEABLE에서 하나씩 꺼내
+ * 락 없이 lws_write한 뒤 참조를 놓고, 마지막 참조가 놓일 때 프레임을 해제합니다.
+ * 프레임 앞에는 headroom(LWS_PRE)바이트를 비워 두므로 lws_write에 그대로 넘길 수 있습니다.
+ *
+ * 프레임 풀: out_frame_alloc()은 본문 용량을 크기 등급(512B/4KB/16KB)으로 올려 스레드별 빈 목록에서
+ * 꺼내고, 마지막 참조를 놓은 스레드의 빈 목록으로 돌려보냅니다 (등급마다 OUT_FRAME_POOL_DEPTH개까지,
+ * 넘치거나 등급보다 큰 프레임은 free). 호출자는 out_frame_payload()에 바로 직렬화하고 length를
+ * 채우므로 메시지마다 할당/복사가 없습니다. 스레드가 끝나기 전에 out_frame_pool_trim()으로 비웁니다.
+ * 대기열 자체는 스레드 안전하지 않으므로 호출자(서버 뮤텍스)가 직렬화하고,
+ * 참조 카운트만 원자적으로 바꿉니다 (대기열 밖에서 전송 중인 프레임을 놓을 수 있도록).
+ *
+ * 느린 클라이언트: 대기열이 SEND_QUEUE_HIGH_WATER까지 차면 합치기(coalescing) 상태가 되어
+ * 대기 중이던 상태 프레임(state가 1인 프레임)을 버리고 이후 상태 프레임도 받지 않습니다.
+ * 오류/확인 같은 이벤트 프레임은 계속 쌓입니다. SEND_QUEUE_LOW_WATER까지 비면
+ * send_queue_resume()이 1을 돌려주고, 호출자는 그때의 최신 상태 하나(키프레임)만 넣습니다.
+ * Test Case: tests/send_queue_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_SEND_QUEUE_H
+#define CPU_SEND_QUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SEND_QUEUE_DEPTH      64U                     /* 클라이언트 하나가 쌓아 둘 수 있는 프레임 수 */
+#define SEND_QUEUE_HIGH_WATER (SEND_QUEUE_DEPTH / 2)    /* 이만큼 쌓이면 상태 프레임을 합치기 시작 */
+#define SEND_QUEUE_LOW_WATER  (SEND_QUEUE_DEPTH / 8)    /* 이만큼 비면 최신 상태를 보내고 다시 쌓음 */
+
+#define OUT_FRAME_HEADROOM_MAX 32U    /* 풀 프레임이 본문 앞에 비워 둘 수 있는 최대 여유 (LWS_PRE 이상) */
+#define OUT_FRAME_POOL_DEPTH   32U    /* 스레드·크기 등급마다 보관할 빈 프레임 수 */
+
+typedef struct OutFrame {
+    uint32_t refs;
+    int binary;                 /* 1이면 바이너리 프레임, 0이면 텍스트 */
+    int state;                  /* 1이면 상태 프레임 (더 새 상태가 대체하므로 합칠 수 있음), 0이면 이벤트 */
+    int pool_class;             /* 돌려보낼 크기 등급, 풀 밖에서 할당했으면 -1 */
+    size_t length;              /* 본문 길이 */
+    size_t capacity;            /* 본문 최대 길이 */
+    size_t headroom;            /* 본문 앞 여유 (LWS_PRE) */
+    struct OutFrame *next_free; /* 스레드 풀의 빈 프레임 목록 */
+    uint8_t data[];             /* headroom + 본문 */
+} OutFrame;
+
+typedef struct {
+    OutFrame *frames[SEND_QUEUE_DEPTH];     /* 원형 버퍼 */
+    unsigned head;              /* 다음에 보낼 위치 */
+    unsigned count;
+    unsigned peak;              /* 최대 깊이 */
+    int coalescing;             /* 1이면 상태 프레임을 받지 않음 (최신 상태는 재개할 때 한 번에) */
+    uint64_t sent;              /* 꺼낸 프레임 수 */
+    uint64_t dropped;           /* 대기열이 가득 차서 버린 이벤트 프레임 수 */
+    uint64_t coalesced;         /* 합치기 상태에서 버린 상태 프레임 수 */
+} SendQueue;
+
+typedef enum {
+    SEND_QUEUED,                /* 대기열에 넣음 */
+    SEND_COALESCED,             /* 상태 프레임을 합침 (재개할 때 최신 상태로 대체) */
+    SEND_DROPPED                /* 이벤트 프레임인데 대기열이 가득 참 */
+} SendResult;
+
+/*
+ * @brief 본문 capacity바이트를 쓸 수 있는 참조 1개짜리 빈 이벤트 프레임을 풀에서 꺼냅니다
+ * @returns 프레임 (length는 0, 본문을 쓴 뒤 호출자가 채움), 메모리 부족이면 NULL
+ */
+OutFrame* out_frame_alloc(size_t capacity, size_t headroom, int binary);
+
+/*
+ * @brief 본문을 복사해 참조 1개짜리 이벤트 프레임을 만듭니다 (상태 프레임이면 state를 1로)
+ * @returns 프레임, 메모리 부족이면 NULL
+ */
+OutFrame* out_frame_create(const void *payload, size_t length, size_t headroom, int binary);
+void out_frame_retain(OutFrame *frame);
+
+// 참조를 놓고, 마지막 참조면 이 스레드의 풀로 돌려보냅니다 (풀이 가득 찼으면 free)
+void out_frame_release(OutFrame *frame);
+
+// 이 스레드의 풀에 남은 빈 프레임을 모두 해제합니다 (스레드 종료 전)
+void out_frame_pool_trim(void);
+
+static inline uint8_t* out_frame_payload(OutFrame *frame) {
+    return frame->data + frame->headroom;
+}
+
+void send_queue_init(SendQueue *queue);
+
+/*
+ * @brief 프레임을 대기열 끝에 넣습니다 (넣으면 참조 +1)
+ * @returns SEND_QUEUED, 느린 클라이언트의 상태 프레임이면 SEND_COALESCED, 가득 찼으면 SEND_DROPPED
+ */
+SendResult send_queue_push(SendQueue *queue, OutFrame *frame);
+
+/*
+ * @brief 맨 앞 프레임을 꺼냅니다 (대기열의 참조가 호출자에게 넘어감, 다 쓰면 out_frame_release)
+ * @returns 프레임, 비어 있으면 NULL
+ */
+OutFrame* send_queue_pop(SendQueue *queue);
+
+/*
+ * @brief 합치기 상태에서 대기열이 충분히 비었으면 합치기를 끝냅니다
+ * @returns 끝냈으면 1 (호출자가 최신 상태 프레임을 넣어야 함), 아니면 0
+ */
+int send_queue_resume(SendQueue *queue);
+
+// 남은 프레임의 참조를 모두 놓습니다 (연결 종료)
+void send_queue_clear(SendQueue *queue);
+
+#endif // CPU_SEND_QUEUE_H
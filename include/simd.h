@@ -0,0 +1,55 @@
+/* include/simd.h - 패킹 SIMD 명령어 인터페이스
+ * ------------------------------------------------------------
+ * 벡터 레지스터 V0~V3(각 8×8비트 레인)에 대한 PADD/PSUB/PMUL(랩/포화, 4/8레인)과
+ * VLOAD/VSTORE의 인코딩을 정의하고, 레인 연산을 호스트 벡터 명령어로 실행합니다.
+ *
+ * 패킹 ALU (opcode 8): [1000][vd:2][vs:2] [op:2][S][L][0000]   vd ← vd op vs
+ *   op: 0=PADD, 1=PSUB, 2=PMUL / S: 부호 없는 포화 / L: 8레인 (0이면 하위 4레인)
+ * 벡터 메모리 (opcode 9): [1001][W][L][v:2] [addr8]
+ *   W: 1이면 VSTORE, 0이면 VLOAD / L: 8레인 (0이면 4레인)
+ * Test Case: tests/simd_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_SIMD_H
+#define CPU_SIMD_H
+
+#include <stdint.h>
+
+#define OPCODE_PACKED     8
+#define OPCODE_VMEM       9
+
+// 패킹 ALU 두 번째 바이트 필드
+#define PACKED_OP_SHIFT   6
+#define PACKED_SATURATE   0x20
+#define PACKED_LANES8     0x10
+
+// 벡터 메모리 첫 번째 바이트 필드
+#define VMEM_STORE        0x8
+#define VMEM_LANES8       0x4
+
+typedef enum {
+    PACKED_ADD = 0,
+    PACKED_SUB,
+    PACKED_MUL,
+    PACKED_OP_COUNT
+} PackedOp;
+
+/*
+ * @brief 레인별 연산 dst[i] = dst[i] op src[i]를 수행합니다
+ * @param op PackedOp
+ * @param saturate 0이면 랩어라운드, 1이면 부호 없는 포화 (0~255)
+ * @param lanes 4 또는 8 (4레인이면 상위 레인은 바뀌지 않음)
+ * @param dst 목적지/첫 번째 피연산자 (8바이트)
+ * @param src 두 번째 피연산자 (8바이트)
+ * @returns 없음 (void)
+ */
+void simd_packed_op(uint8_t op, int saturate, unsigned lanes, uint8_t *dst, const uint8_t *src);
+
+// 레인 루프 기준 구현 (검증용)
+void simd_packed_op_scalar(uint8_t op, int saturate, unsigned lanes, uint8_t *dst, const uint8_t *src);
+
+// 컴파일된 호스트 백엔드 이름 ("sse2", "neon", "scalar")
+const char* simd_backend_name(void);
+
+#endif // CPU_SIMD_H
@@ -0,0 +1,94 @@
+/* include/state_delta.h - 클라이언트에 보낼 상태 변화(delta) 계산
+ * ------------------------------------------------------------
+ * 클라이언트가 마지막으로 받은 상태(shadow)를 서버가 기억하고, 단계마다 현재 상태와 비교해
+ * 바뀐 레지스터/플래그/벡터 레지스터/메모리 구간/캐시 라인만 골라냅니다.
+ * 변화마다 순서 번호를 붙이고, keyframe_interval번마다 (또는 재동기화 요청 시) 전체 상태를 보냅니다.
+ * 클라이언트는 순서 번호가 건너뛰면 "resync"를 보내 다음 키프레임부터 다시 맞춥니다.
+ * Test Case: tests/state_delta_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_STATE_DELTA_H
+#define CPU_STATE_DELTA_H
+
+#include "include/cpu.h"
+
+#include <stdint.h>
+
+#define STATE_KEYFRAME_INTERVAL 64U                 /* 키프레임 사이의 delta 수 */
+#define STATE_MAX_RUNS          (MEMORY_SIZE / 2)   /* 바뀐 메모리 구간 최대 수 (한 칸씩 건너 바뀔 때) */
+
+/* 클라이언트에 보이는 상태 전체 */
+typedef struct {
+    uint16_t pc;
+    uint8_t registers[8];                       /* [1..7] = R1~R7 */
+    uint8_t flags;                              /* FLAG_* (지연 평가 결과) */
+    uint8_t vreg[VREG_COUNT][VREG_LANES];
+    CPU_Mode mode;
+    uint64_t instructions;
+    uint64_t cycles;
+    uint8_t memory[MEMORY_SIZE];                /* memory_peek 값 (dirty 캐시 라인 반영) */
+    CacheLine lines[CACHE_NUM_LINES];
+    CacheStats cache_stats;
+} StateSnapshot;
+
+/* 연속으로 바뀐 메모리 구간 */
+typedef struct {
+    uint16_t address;
+    uint16_t length;
+} StateRun;
+
+/* 한 번의 변화 목록 (값은 StateTracker.current에서 읽음) */
+typedef struct {
+    uint32_t sequence;
+    int keyframe;                               /* 1이면 모든 항목이 들어 있음 */
+    uint8_t register_mask;                      /* 비트 r = Rr이 바뀜 */
+    uint8_t vreg_mask;                          /* 비트 v = Vv가 바뀜 */
+    int flags_changed;
+    int mode_changed;
+    int cache_stats_changed;
+    unsigned run_count;
+    StateRun runs[STATE_MAX_RUNS];
+    unsigned line_count;
+    uint8_t lines[CACHE_NUM_LINES];             /* 바뀐 캐시 라인 인덱스 */
+} StateDelta;
+
+typedef struct {
+    StateSnapshot shadow;                       /* 클라이언트가 마지막으로 받은 상태 */
+    StateSnapshot current;                      /* 마지막 state_tracker_next가 캡처한 상태 */
+    uint32_t sequence;
+    unsigned since_keyframe;
+    unsigned keyframe_interval;
+    int need_keyframe;
+} StateTracker;
+
+// keyframe_interval번째 delta마다 키프레임 (0이면 STATE_KEYFRAME_INTERVAL)
+void state_tracker_init(StateTracker *tracker, unsigned keyframe_interval);
+
+// 다음 delta를 키프레임으로 (새 클라이언트, 재동기화 요청)
+void state_tracker_resync(StateTracker *tracker);
+
+// 컨텍스트의 보이는 상태를 캡처 (캐시 통계/LRU를 바꾸지 않음)
+void state_snapshot_capture(StateSnapshot *snapshot, const CPU_Context *ctx);
+
+/*
+ * @brief 현재 상태를 캡처해 shadow와 비교하고 shadow를 갱신합니다
+ * @param tracker 상태 추적기
+ * @param ctx 비교할 CPU 컨텍스트
+ * @param delta 바뀐 항목 (값은 tracker->current)
+ * @returns 바뀐 항목 수 (키프레임이면 전체 항목 수)
+ */
+unsigned state_tracker_next(StateTracker *tracker, const CPU_Context *ctx, StateDelta *delta);
+
+/*
+ * @brief 마지막으로 보낸 상태(tracker->current) 전체를 키프레임으로 만듭니다 (추적기는 바꾸지 않음)
+ * @param tracker 상태 추적기
+ * @param delta 결과 (순서 번호는 마지막으로 보낸 delta와 같음)
+ * @returns 없음 (void)
+ *
+ * @details
+ * 중간 delta를 건너뛴 클라이언트 하나만 다시 맞출 때 씁니다. 다음 delta는 이 키프레임 위에 그대로 적용됩니다.
+ */
+void state_tracker_keyframe(const StateTracker *tracker, StateDelta *delta);
+
+#endif // CPU_STATE_DELTA_H
@@ -0,0 +1,80 @@
+/* include/trace.h - 비동기 바이너리 실행 트레이스 인터페이스
+ * ------------------------------------------------------------
+ * cpu_step()마다 고정 크기 레코드(PC, 명령어, 쓴 레지스터/값, 메모리 주소,
+ * 캐시 히트/미스, 플래그)를 잠금 없는 SPSC 링 버퍼에 넣고, 백그라운드 작성 스레드가
+ * 이전 레코드와의 차이만 varint로 압축해 파일에 기록합니다.
+ * 시뮬레이션 스레드는 I/O를 기다리지 않으며, 링이 가득 차면 레코드를 버리고 셉니다.
+ * 파일은 tools/trace_decode로 사람이 읽을 수 있는 텍스트로 되돌립니다.
+ * Test Case: tests/trace_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_TRACE_H
+#define CPU_TRACE_H
+
+#include "include/log.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define TRACE_MAGIC          "CPUTRC1"   /* 파일 머리 8바이트 (NUL 포함) */
+#define TRACE_DEFAULT_RING   65536U      /* 기본 링 용량 (2의 거듭제곱) */
+#define TRACE_NO_REG         0           /* 레지스터를 쓰지 않음 */
+
+// TraceRecord.events 비트
+#define TRACE_EV_FETCH_MISS  0x01        /* 명령어 fetch가 캐시 미스 */
+#define TRACE_EV_MEM_READ    0x02        /* 데이터 읽기가 있었음 */
+#define TRACE_EV_MEM_WRITE   0x04        /* 데이터 쓰기가 있었음 */
+#define TRACE_EV_MEM_MISS    0x08        /* 데이터 접근 중 캐시 미스가 있었음 */
+
+/* 명령어 하나의 실행 기록 (고정 크기) */
+typedef struct {
+    uint64_t seq;           /* 트레이스 시작 후 명령어 번호 */
+    uint16_t pc;
+    uint16_t word;          /* 원본 16비트 명령어 */
+    uint16_t mem_addr;      /* 첫 데이터 접근 주소 (events에 접근 비트가 있을 때만 유효) */
+    uint8_t  op;            /* 4비트 opcode */
+    uint8_t  dest_reg;      /* 명령어가 결과를 쓴 레지스터 (ALU는 R7, TRACE_NO_REG = 없음) */
+    uint8_t  dest_value;
+    uint8_t  mem_value;     /* 첫 데이터 접근 값 */
+    uint8_t  mem_count;     /* 데이터 접근 횟수 */
+    uint8_t  flags;         /* FLAG_CF/ZF/SF/OF */
+    uint8_t  events;        /* TRACE_EV_* */
+} TraceRecord;
+
+/* 트레이스 통계 */
+typedef struct {
+    uint64_t records;       /* 링에 넣은 레코드 수 */
+    uint64_t dropped;       /* 링이 가득 차 버린 레코드 수 */
+    uint64_t bytes;         /* 파일에 쓴 바이트 수 */
+} TraceStats;
+
+/* 압축 상태 (인코더/디코더 공용: 이전 레코드) */
+typedef struct {
+    TraceRecord previous;
+} TraceCodec;
+
+// 현재 스레드가 트레이스 생산자이면 0이 아님 (hot path에서 검사)
+extern CPU_THREAD_LOCAL int trace_producer;
+#define TRACE_ACTIVE() (trace_producer != 0)
+
+// 시작/종료: 호출한 스레드가 생산자가 됨
+int  trace_start(const char *path, unsigned ring_capacity);
+void trace_stop(TraceStats *stats);
+
+// cpu_step()/memory_read()/memory_write()에서 호출하는 훅
+struct CPU_Registers;
+void trace_step_begin(uint16_t pc, uint16_t word, int fetch_miss);
+void trace_note_access(uint16_t address, uint8_t value, int write, int miss);
+void trace_step_end(const struct CPU_Registers *regs);
+
+// 파일 형식 인코딩/디코딩 (작성 스레드와 tools/trace_decode 공용)
+void   trace_codec_init(TraceCodec *codec);
+size_t trace_encode_record(TraceCodec *codec, const TraceRecord *record, uint8_t *out);
+int    trace_decode_record(TraceCodec *codec, FILE *in, TraceRecord *record);
+void   trace_format_record(const TraceRecord *record, char *buffer, size_t size);
+
+#define TRACE_MAX_ENCODED 40U   /* 레코드 하나의 최대 인코딩 크기 */
+
+#endif // CPU_TRACE_H
@@ -4,11 +4,32 @@
 #include <libwebsockets.h>
 #include <json-c/json.h>
 #include <stdint.h>
+#include <pthread.h>
 #include "cpu.h"
+#include "asm_session.h"
+#include "lru_cache.h"
+#include "state_delta.h"
+#include "json_writer.h"
+#include "send_queue.h"
+#include "handle_table.h"
+#include "worker_pool.h"
 
 #define WS_PORT 8080
 #define MAX_PAYLOAD_SIZE 4096
-#define MAX_CLIENTS 10
+#define WS_MAX_MESSAGE_BYTES (1024 * 1024)        // 조각을 모은 수신 메시지 상한 (넘으면 오류 응답 후 버림)
+#define WS_MAX_CONNECTIONS  65536                 // 동시 연결 상한 (핸들 테이블 슬롯 수)
+#define WS_CLIENTS_INITIAL  64                    // 처음 핸들 테이블 크기 (연결이 늘면 두 배씩)
+#define WS_MAX_SERVICE_THREADS 32                 // lws 서비스 스레드 상한 (count_threads)
+#define RUN_DEFAULT_RATE    5                     // run_all 기본 속도 (초당 단계, 예전 200ms 간격)
+#define RUN_MIN_INTERVAL_US 1000                  // 타이머 간격 하한 (더 빠른 속도는 한 번에 여러 단계)
+#define RUN_SLICE_STEPS     4096                  // 최대 속도(rate 0)에서 타이머 한 번에 실행할 단계 수
+#define WS_JOB_DEADLINE_MS  10000                 // 워커 작업 기본 마감 시간 (deadline_ms로 바꿈, 0이면 없음)
+#define WS_JOB_CHECK_STEPS  1024                  // 워커 실행 중 취소/마감 확인 간격 (단계)
+#define WS_ASM_OFFLOAD_BYTES 1024                 // 이보다 긴 소스의 어셈블은 워커에서 (짧으면 바로)
+#define PROGRAM_CACHE_BYTES (256 * 1024)        // 소스 → 어셈블 결과 캐시 상한
+#define RUN_CACHE_BYTES     (4 * 1024 * 1024)   // (프로그램, 초기 상태, 단계 한도) → 최종 상태 캐시 상한
+#define WS_FILE_NAME_MAX    64                    // 클라이언트가 고르는 파일 이름 길이 상한 (서버 디렉터리 안)
+#define WS_TRACE_DIR        "."                   // 트레이스 파일 기본 디렉터리 (CPU_WS_TRACE_DIR로 바꿈)
 
 // 메시지 타입 정의
 typedef enum {
@@ -23,14 +44,6 @@ typedef enum {
     MSG_TYPE_PONG           // 퐁
 } message_type_t;
 
-// WebSocket 클라이언트 세션 정보
-typedef struct {
-    struct lws *wsi;
-    char ip_addr[32];
-    int session_id;
-    int is_connected;
-} ws_client_session_t;
-
 // CPU 실행 상태 정보
 typedef struct {
     int is_running;
@@ -41,19 +54,96 @@ typedef struct {
     int decoded_length;
 } cpu_execution_state_t;
 
+struct ws_client_session;
+struct RunMemoKey;
+struct ws_job;
+
+// run_all 작업 상태
+typedef enum {
+    RUN_IDLE,
+    RUN_RUNNING,
+    RUN_PAUSED
+} run_state_t;
+
+// run_all 작업: 세션 스레드의 lws_sul 타이머가 조금씩 실행 (서비스 스레드는 잠들지 않음)
+typedef struct {
+    lws_sorted_usec_list_t timer;   // 다음 실행 조각 (세션을 서비스하는 스레드에서 호출)
+    run_state_t state;
+    int tsi;                        // 타이머를 건 서비스 스레드
+    uint32_t rate;                  // 초당 단계 수 (0이면 최대한 빨리)
+    uint64_t budget;                // 단계 한도 (0이면 프로그램이 끝날 때까지)
+    uint64_t steps;                 // 지금까지 실행한 단계
+    uint32_t deadline_ms;           // 최대 속도 실행을 워커에 맡길 때 마감 시간 (0이면 없음)
+    int initial_pc;
+    struct RunMemoKey *memo_key;    // 실행 결과 캐시 키 (캐시하지 않으면 NULL)
+    CacheStats cache_before;        // 시작 시 통계 (캐시에 늘어난 만큼 저장)
+    CPU_Stats stats_before;
+} ws_run_job_t;
+
+// 연결 하나가 소유하는 CPU 세션
+// 요청을 처리하는 동안만 cpu_set_context로 이 세션의 CPU를 현재 컨텍스트로 바꿉니다
+typedef struct ws_cpu_session {
+    CPU_Context cpu;                // 이 연결만의 레지스터/메모리/캐시
+    cpu_execution_state_t exec;
+    AsmSession editor;              // load_program/edit_program이 공유하는 줄 단위 어셈블 상태
+    char *editor_source;            // 캐시 히트로 적재해 아직 editor에 넣지 않은 소스 (첫 편집 때 적재)
+    StateTracker tracker;           // 이 세션을 보는 클라이언트가 마지막으로 받은 상태 (단계별 delta 계산)
+    ws_run_job_t run;               // 진행 중인 run_all
+    struct ws_job *job;             // 워커에서 실행 중인 작업 (세션 스레드만 바꿈, 없으면 NULL)
+    struct ws_cpu_session *view;    // 구독 중인 세션 (자기 자신, 또는 관전 중인 다른 연결의 세션)
+    struct ws_client_session *viewers;  // 이 세션을 구독하는 연결 (소유자 + 관전자, 이중 연결 목록)
+    unsigned viewer_count[2];       // 형식별 구독자 수 ([0] JSON, [1] 바이너리)
+    pthread_mutex_t lock;           // 요청 처리 중 잡음 (소유 스레드만 쓰면 경합 없음, 다른 스레드의 관전자와만 경합)
+    unsigned pins;                  // 다른 연결이 이 세션을 쓰는 중 (연결이 닫힐 때 0이 될 때까지 기다림)
+    int ready;                      // session_open 완료 (핸드셰이크 전에 닫힌 연결 구분)
+} ws_cpu_session_t;
+
+// WebSocket 클라이언트 세션 정보 (lws per-session user data, 콜백의 user 포인터)
+typedef struct ws_client_session {
+    struct lws *wsi;
+    char ip_addr[32];
+    Handle session_id;      // 세대 번호가 붙은 핸들 (끊긴 연결의 ID는 다시 쓰여도 조회되지 않음)
+    int is_connected;
+    int binary;             // "cpu-binary" 서브프로토콜 (include/wire.h)
+    int tsi;                // 이 연결을 서비스하는 스레드 (연결이 끝날 때까지 바뀌지 않음)
+    int wake_pending;       // 다른 스레드가 넣은 프레임이 있어 서비스 스레드를 깨워 둠
+    struct ws_client_session *next_wake;
+    SendQueue queue;        // 보낼 프레임 (LWS_CALLBACK_SERVER_WRITEABLE에서 하나씩 전송)
+    ws_cpu_session_t session;   // 이 연결만의 CPU 세션
+    struct ws_client_session *next_viewer;  // session.view의 구독자 목록
+    struct ws_client_session *prev_viewer;
+    char *rx_buffer;        // 조각난 수신 메시지를 마지막 조각까지 모음 (rx_buffer_size보다 큰 메시지)
+    size_t rx_length;
+    size_t rx_capacity;
+    int rx_overflow;        // WS_MAX_MESSAGE_BYTES를 넘은 메시지 (남은 조각은 버림)
+} ws_client_session_t;
+
 // WebSocket 서버 컨텍스트
 typedef struct {
     struct lws_context *context;
-    ws_client_session_t clients[MAX_CLIENTS];
-    int client_count;
-    cpu_execution_state_t cpu_state;
-    pthread_mutex_t mutex;
+    HandleTable clients;            // session_id → ws_client_session_t (연결/해제 O(1))
+    int thread_count;               // 실제 서비스 스레드 수 (lws가 LWS_MAX_SMP로 줄일 수 있음)
+    ws_client_session_t *wake[WS_MAX_SERVICE_THREADS];  // 스레드별, 쓰기 가능 콜백을 요청해야 하는 연결
+    int trace_tsi;                  // 트레이스를 시작한 스레드 (-1이면 꺼짐, 생산자는 그 스레드만)
+    LruCache program_cache;         // 소스 텍스트 → 이미지 (서버 전체 공유)
+    LruCache run_cache;             // run_all 초기 상태 → 최종 상태
+    pthread_mutex_t cache_mutex;    // program_cache, run_cache
+    WorkerPool workers;             // 긴 실행/큰 어셈블 (서비스 스레드는 I/O와 프레임만)
+    MpscQueue done[WS_MAX_SERVICE_THREADS];     // 스레드별, 끝난 워커 작업 (LWS_CALLBACK_EVENT_WAIT_CANCELLED에서 적용)
+    uint32_t next_job_id;           // __atomic
+    pthread_mutex_t mutex;          // 연결 테이블, 구독자 목록, 전송 대기열, wake, pins
+    pthread_cond_t unpinned;        // 세션의 pins가 0이 됨
 } ws_server_context_t;
 
 // WebSocket 서버 함수들
-int ws_server_init(int port);
+int ws_server_init(int port, int threads, int workers);
 void ws_server_cleanup(void);
 int ws_server_run(void);
+void ws_server_stop(void);
+
+// 트레이스 파일을 쓸 디렉터리와 이미지를 읽을 디렉터리 (ws_server_init 전에, 문자열은 서버가 끝날 때까지 유지)
+void ws_server_set_trace_dir(const char *dir);
+void ws_server_set_image_dir(const char *dir);
 
 // 메시지 전송 함수들
 void ws_send_cpu_state(void);
@@ -62,23 +152,37 @@ void ws_send_register_state(void);
 void ws_send_execution_step(const char* instruction, const uint8_t* bytes, int byte_count);
 void ws_send_error(const char* error_msg);
 void ws_send_ack(const char* message);
+void ws_send_state_delta(const char* step, const uint8_t* bytes, int byte_count, const char* warning);
 
 // CPU 제어 함수들
 int ws_handle_assembly_code(const char* assembly_code);
 int ws_handle_program_load(const char* program_code);
+int ws_handle_program_edit(json_object *edit);
+int ws_handle_image_load(const char* name);
 int ws_handle_step_execution(void);
 int ws_handle_cpu_reset(void);
-int ws_handle_run_all(void);
+int ws_handle_run_all(json_object *options);
+int ws_handle_run_pause(void);
+int ws_handle_run_resume(void);
+int ws_handle_run_stop(void);
+int ws_handle_fast_forward(json_object *options);
+int ws_handle_cancel(json_object *payload);
+int ws_handle_trace(json_object *options);
+int ws_handle_profile(json_object *options);
 void ws_execute_instruction_step(void);
 void ws_reset_cpu(void);
 
 // JSON 메시지 처리 함수들
-json_object* create_state_message(void);
-json_object* create_memory_message(void);
-json_object* create_register_message(void);
-json_object* create_execution_message(const char* instruction, const uint8_t* bytes, int byte_count);
-json_object* create_error_message(const char* error);
-json_object* create_ack_message(const char* message);
+void write_state_message(JsonWriter *writer);
+void write_memory_message(JsonWriter *writer);
+void write_cache_message(JsonWriter *writer);
+void write_execution_message(JsonWriter *writer, const char* instruction, const uint8_t* bytes, int byte_count);
+void write_text_message(JsonWriter *writer, const char* type, const char* text);
+void write_delta_message(JsonWriter *writer, const StateDelta *delta, const StateSnapshot *now, const char *step,
+                         const uint8_t *bytes, int byte_count, const char *warning);
+json_object* create_profile_message(int top_n, int with_folded);
+json_object* create_program_patch_message(const AsmEdit *edit);
+json_object* create_server_cache_message(void);
 
 // 어셈블리 디코딩 함수
 int decode_assembly_to_bytes(const char* assembly, uint8_t* output_bytes, int max_length);
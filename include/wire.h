@@ -0,0 +1,110 @@
+/* include/wire.h - 바이너리 WebSocket 프레임 형식 ("cpu-binary" 서브프로토콜)
+ * ------------------------------------------------------------
+ * JSON("cpu-protocol")과 같은 내용을 고정 레이아웃 리틀엔디언 프레임으로 보냅니다.
+ * 클라이언트가 Sec-WebSocket-Protocol로 "cpu-binary"를 고르면 이 형식만 주고받습니다.
+ *
+ * 프레임 = 헤더 4바이트 (type u8, 0 u8, payload 길이 u16) + payload
+ *   서버 → 클라이언트
+ *     STATE   pc u16, R1~R7 u8×7, flags u8, mode u8, V0~V3 u8×32, instructions u64, cycles u64
+ *     MEMORY  address u16, count u16, 바이트×count
+ *     CACHE   first u8, count u8, hits/misses/writebacks u64×3, 라인×count (tag u16, valid u8, dirty u8, block u8×4)
+ *     STEP    바이트 수 u8, 명령어 바이트×2, 설명 (UTF-8, payload 끝까지)
+ *     ACK / ERROR / WARNING  메시지 (UTF-8)
+ *     DELTA   seq u32, bits u8 (1 키프레임, 2 플래그, 4 모드, 8 캐시 통계), 레지스터 마스크 u8, 벡터 마스크 u8,
+ *             pc u16, instructions u64, cycles u64, [flags u8], [mode u8], [통계 u64×3], 바뀐 레지스터 u8…,
+ *             바뀐 벡터 레지스터 u8×8…, 구간 수 u16 + (address u16, length u16, 바이트…)…,
+ *             라인 수 u8 + (index u8, 라인 8바이트)…
+ *     PONG    (없음)
+ *   클라이언트 → 서버
+ *     CMD_STEP / CMD_RESET / CMD_GET_STATE / CMD_GET_CACHE / CMD_RESYNC / CMD_PING  (없음)
+ *     CMD_RUN_ALL     (없음) 또는 rate u32 (초당 단계, 0이면 최대한 빨리), budget u32 (단계 한도, 0이면 없음)
+ *     CMD_PAUSE / CMD_RESUME / CMD_STOP  run_all 작업 제어 (없음)
+ *     CMD_CANCEL      워커에서 실행 중인 작업 취소 (없음)
+ *     CMD_GET_MEMORY  address u16, count u16
+ *     CMD_LOAD_PROGRAM / CMD_ASSEMBLY / CMD_LOAD_IMAGE  텍스트 (UTF-8, NUL 없이)
+ * 편집/트레이스/프로파일처럼 옵션이 많은 요청과 그 결과는 JSON 프로토콜에만 있습니다.
+ * Test Case: tests/wire_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_WIRE_H
+#define CPU_WIRE_H
+
+#include "include/state_delta.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define WIRE_HEADER_SIZE    4U
+#define WIRE_MAX_PAYLOAD    UINT16_MAX
+#define WIRE_LINE_SIZE      8U      /* 캐시 라인 하나의 크기 */
+
+typedef enum {
+    WIRE_STATE = 0x01,
+    WIRE_MEMORY = 0x02,
+    WIRE_CACHE = 0x03,
+    WIRE_STEP = 0x04,
+    WIRE_ACK = 0x05,
+    WIRE_ERROR = 0x06,
+    WIRE_WARNING = 0x07,
+    WIRE_DELTA = 0x08,
+    WIRE_PONG = 0x09,
+
+    WIRE_CMD_STEP = 0x80,
+    WIRE_CMD_RESET = 0x81,
+    WIRE_CMD_RUN_ALL = 0x82,
+    WIRE_CMD_GET_STATE = 0x83,
+    WIRE_CMD_GET_MEMORY = 0x84,
+    WIRE_CMD_GET_CACHE = 0x85,
+    WIRE_CMD_RESYNC = 0x86,
+    WIRE_CMD_PING = 0x87,
+    WIRE_CMD_LOAD_PROGRAM = 0x88,
+    WIRE_CMD_ASSEMBLY = 0x89,
+    WIRE_CMD_LOAD_IMAGE = 0x8A,
+    WIRE_CMD_PAUSE = 0x8B,
+    WIRE_CMD_RESUME = 0x8C,
+    WIRE_CMD_STOP = 0x8D,
+    WIRE_CMD_CANCEL = 0x8E
+} WireType;
+
+/* DELTA bits */
+#define WIRE_DELTA_KEYFRAME     0x01U
+#define WIRE_DELTA_FLAGS        0x02U
+#define WIRE_DELTA_MODE         0x04U
+#define WIRE_DELTA_CACHE_STATS  0x08U
+
+/* 해석한 클라이언트 명령 */
+typedef struct {
+    WireType type;
+    uint16_t address;           /* CMD_GET_MEMORY */
+    uint16_t count;
+    int has_run_options;        /* CMD_RUN_ALL에 rate/budget이 있음 */
+    uint32_t rate;
+    uint32_t budget;
+    const char *text;           /* 텍스트 명령 (프레임 버퍼를 가리킴, NUL 종료 아님) */
+    size_t length;
+} WireCommand;
+
+/*
+ * 인코더는 out에 헤더를 포함한 프레임을 쓰고 길이를 돌려줍니다 (capacity가 부족하면 0).
+ * lws_write에 넘길 때는 out 앞에 LWS_PRE바이트를 비워 둔 버퍼를 쓰면 복사가 없습니다.
+ */
+size_t wire_encode_state(uint8_t *out, size_t capacity, const StateSnapshot *state);
+size_t wire_encode_memory(uint8_t *out, size_t capacity, const uint8_t *memory, uint16_t address, uint16_t count);
+size_t wire_encode_cache(uint8_t *out, size_t capacity, const CacheLine *lines, const CacheStats *stats,
+                         uint8_t first, uint8_t count);
+size_t wire_encode_step(uint8_t *out, size_t capacity, const char *text, const uint8_t *bytes, int byte_count);
+size_t wire_encode_text(uint8_t *out, size_t capacity, WireType type, const char *text);
+size_t wire_encode_delta(uint8_t *out, size_t capacity, const StateDelta *delta, const StateSnapshot *now);
+size_t wire_encode_empty(uint8_t *out, size_t capacity, WireType type);
+
+/*
+ * @brief 클라이언트 명령 프레임을 해석합니다
+ * @param frame 받은 프레임
+ * @param length 프레임 길이
+ * @param command 결과
+ * @returns 성공 시 0, 형식 오류나 알 수 없는 명령이면 -1
+ */
+int wire_decode_command(const uint8_t *frame, size_t length, WireCommand *command);
+
+#endif // CPU_WIRE_H
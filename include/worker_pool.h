@@ -0,0 +1,94 @@
+/* include/worker_pool.h - 고정 크기 워커 풀과 결과 반환용 MPSC 큐
+ * ------------------------------------------------------------
+ * 오래 걸리는 작업(긴 실행, 큰 어셈블)을 이벤트 루프 밖의 워커 스레드에서 처리합니다.
+ * 제출은 뮤텍스/조건 변수 FIFO로 받고, 끝난 작업은 제출할 때 정한 MpscQueue에 락 없이 넣은 뒤
+ * notify 콜백(서버에서는 lws_cancel_service)으로 소비자 스레드를 깨웁니다.
+ * 취소와 마감 시각은 협력형입니다: 작업이 work_item_check()를 주기적으로 불러 스스로 멈춥니다.
+ * WorkItem은 호출자가 할당해 자기 구조체의 첫 멤버로 두고, 결과를 받을 때까지 해제하지 않습니다.
+ * Test Case: tests/worker_pool_test.c
+ * Author: Cho Sungju
+*/
+
+#ifndef CPU_WORKER_POOL_H
+#define CPU_WORKER_POOL_H
+
+#include <stdint.h>
+#include <pthread.h>
+
+#define WORKER_MAX_THREADS 64U
+
+// 작업 결과 (work_item_check도 같은 값을 돌려줌, WORK_DONE이면 계속해도 됨)
+typedef enum {
+    WORK_DONE = 0,
+    WORK_CANCELLED,             /* work_item_cancel 또는 풀 종료 */
+    WORK_EXPIRED                /* 마감 시각 지남 */
+} WorkStatus;
+
+struct WorkerPool;
+struct MpscQueue;
+
+typedef struct WorkItem {
+    struct WorkItem *next;              /* 제출 대기열, 그다음 결과 큐 연결 */
+    WorkStatus (*run)(struct WorkItem *item);   /* 워커 스레드에서 실행 */
+    uint64_t deadline_us;               /* work_now_us() 기준 마감 시각, 0이면 없음 */
+    struct MpscQueue *reply;            /* 끝난 뒤 넣을 큐 */
+    struct WorkerPool *pool;            /* worker_pool_submit이 채움 */
+    int cancelled;                      /* __atomic (어느 스레드에서든 work_item_cancel) */
+    int finished;                       /* 결과를 큐에 넣기 직전에 켬 (pool->mutex 안에서) */
+    WorkStatus status;                  /* 결과 큐에서 꺼낸 뒤, 또는 work_item_wait 뒤에 읽음 */
+} WorkItem;
+
+// 생산자 여럿, 소비자 하나 (Treiber 스택에 넣고 소비자가 통째로 꺼내 순서를 뒤집음)
+typedef struct MpscQueue {
+    WorkItem *head;                     /* __atomic */
+} MpscQueue;
+
+typedef struct WorkerPool {
+    pthread_t threads[WORKER_MAX_THREADS];
+    unsigned thread_count;
+    pthread_mutex_t mutex;              /* head, tail, stopping 변경 */
+    pthread_cond_t ready;
+    pthread_cond_t finished;            /* 작업 하나가 끝날 때마다 broadcast (work_item_wait) */
+    WorkItem *head;                     /* 제출 대기열 (FIFO) */
+    WorkItem *tail;
+    int stopping;                       /* __atomic (work_item_check가 락 없이 읽음) */
+    void (*notify)(void *arg);          /* 결과를 큐에 넣은 뒤 호출 (워커 스레드) */
+    void *notify_arg;
+} WorkerPool;
+
+// threads: 워커 수 (0이면 온라인 코어 수, WORKER_MAX_THREADS까지), notify는 NULL이어도 됨
+int  worker_pool_init(WorkerPool *pool, unsigned threads, void (*notify)(void *arg), void *arg);
+
+/*
+ * @brief 작업을 제출합니다 (run, reply, deadline_us를 채운 뒤)
+ * @returns 성공 시 0, 풀이 종료 중이면 -1 (작업은 결과 큐에 들어가지 않음)
+ */
+int  worker_pool_submit(WorkerPool *pool, WorkItem *item);
+
+// 대기 중인 작업은 실행하지 않고 WORK_CANCELLED로, 실행 중인 작업은 취소를 알린 뒤 워커를 모두 join
+void worker_pool_shutdown(WorkerPool *pool);
+
+// 실행 중인 작업은 다음 확인에서 멈추고, 아직 대기열에 있는 작업은 빼서 바로 WORK_CANCELLED로 결과 큐에 넣음
+void work_item_cancel(WorkItem *item);
+
+/*
+ * @brief 작업이 계속해도 되는지 확인합니다 (워커에서 주기적으로 호출)
+ * @returns WORK_DONE이면 계속, 아니면 멈춰야 하는 이유
+ */
+WorkStatus work_item_check(const WorkItem *item);
+
+/*
+ * @brief 제출한 작업이 끝날 때까지 기다립니다 (보통 work_item_cancel 뒤에 호출)
+ * @returns 작업 결과 (작업은 여전히 결과 큐로 돌아가므로 해제는 큐를 꺼내는 쪽이 함)
+ */
+WorkStatus work_item_wait(WorkItem *item);
+
+uint64_t work_now_us(void);            /* CLOCK_MONOTONIC (마이크로초) */
+
+void mpsc_init(MpscQueue *queue);
+void mpsc_push(MpscQueue *queue, WorkItem *item);
+
+// 지금까지 들어온 항목을 넣은 순서대로 모두 꺼냄 (소비자 스레드만, 비어 있으면 NULL)
+WorkItem* mpsc_take_all(MpscQueue *queue);
+
+#endif // CPU_WORKER_POOL_H
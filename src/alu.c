@@ -1,10 +1,11 @@
 #include "include/alu.h"
 #include "include/flags.h"
 #include "include/register.h"
+#include "include/log.h"
 #include <stdio.h>
 
-// 전역 레지스터에 대한 외부 참조
-extern CPU_Registers regs;
+// 현재 스레드의 CPU 컨텍스트 레지스터 (cpu.c)
+extern CPU_Registers* get_cpu_registers(void);
 
 /*
  * @brief 두 개의 8비트 값을 더합니다
@@ -14,36 +15,25 @@ extern CPU_Registers regs;
  */
 uint8_t add(uint8_t a, uint8_t b)
 {
-    uint16_t full_result = (uint16_t)a + (uint16_t)b;
-    uint8_t result = (uint8_t)full_result;
-    
-    // OF(Overflow Flag) 설정 - 부호 있는 정수 오버플로우 감지
-    // 두 양수를 더했는데 음수가 나오거나, 두 음수를 더했는데 양수가 나오면 오버플로우
-    bool sign_a = (a & 0x80) != 0;  // a의 부호 비트
-    bool sign_b = (b & 0x80) != 0;  // b의 부호 비트
-    bool sign_result = (result & 0x80) != 0;  // 결과의 부호 비트
-    
-    bool overflow_occurred = false;
-    if (!sign_a && !sign_b && sign_result) {
-        // 양수 + 양수 = 음수 (오버플로우)
-        overflow_occurred = true;
-    } else if (sign_a && sign_b && !sign_result) {
-        // 음수 + 음수 = 양수 (언더플로우)
-        overflow_occurred = true;
-    }
-    
-    set_overflow_flag(&regs, overflow_occurred);
-    
-    if (overflow_occurred) {
-        if (!sign_a && !sign_b) {
-            printf("🚨 덧셈 오버플로우 발생: %d + %d = %d (양수+양수=음수, OF=1)\n", 
-                   (int8_t)a, (int8_t)b, (int8_t)result);
+    uint8_t result = alu_result(0, a, b);
+    CPU_Registers *regs = get_cpu_registers();
+    
+    // 플래그는 연산과 피연산자만 기록하고, 읽을 때 계산 (지연 평가)
+    flags_record(regs, FLAG_OP_ADD, a, b, result);
+    
+    if (cpu_log_enabled) {
+        // 두 양수를 더했는데 음수가 나오거나, 두 음수를 더했는데 양수가 나오면 오버플로우
+        if (get_overflow_flag(regs)) {
+            if (!(a & 0x80)) {
+                CPU_LOG("🚨 덧셈 오버플로우 발생: %d + %d = %d (양수+양수=음수, OF=1)\n", 
+                       (int8_t)a, (int8_t)b, (int8_t)result);
+            } else {
+                CPU_LOG("🚨 덧셈 언더플로우 발생: %d + %d = %d (음수+음수=양수, OF=1)\n", 
+                       (int8_t)a, (int8_t)b, (int8_t)result);
+            }
         } else {
-            printf("🚨 덧셈 언더플로우 발생: %d + %d = %d (음수+음수=양수, OF=1)\n", 
-                   (int8_t)a, (int8_t)b, (int8_t)result);
+            CPU_LOG("✅ 덧셈 정상: %d + %d = %d (OF=0)\n", (int8_t)a, (int8_t)b, (int8_t)result);
         }
-    } else {
-        printf("✅ 덧셈 정상: %d + %d = %d (OF=0)\n", (int8_t)a, (int8_t)b, (int8_t)result);
     }
     
     return result;
@@ -57,35 +47,24 @@ uint8_t add(uint8_t a, uint8_t b)
  */
 uint8_t subtraction(uint8_t a, uint8_t b)
 {
-    uint8_t result = a - b;
-    
-    // OF(Overflow Flag) 설정 - 부호 있는 정수 오버플로우 감지
-    // 양수에서 음수를 빼서 음수가 나오거나, 음수에서 양수를 빼서 양수가 나오면 오버플로우
-    bool sign_a = (a & 0x80) != 0;  // a의 부호 비트
-    bool sign_b = (b & 0x80) != 0;  // b의 부호 비트
-    bool sign_result = (result & 0x80) != 0;  // 결과의 부호 비트
-    
-    bool overflow_occurred = false;
-    if (!sign_a && sign_b && sign_result) {
-        // 양수 - 음수 = 음수 (오버플로우)
-        overflow_occurred = true;
-    } else if (sign_a && !sign_b && !sign_result) {
-        // 음수 - 양수 = 양수 (언더플로우)
-        overflow_occurred = true;
-    }
-    
-    set_overflow_flag(&regs, overflow_occurred);
-    
-    if (overflow_occurred) {
-        if (!sign_a && sign_b) {
-            printf("🚨 뺄셈 오버플로우 발생: %d - %d = %d (양수-음수=음수, OF=1)\n", 
-                   (int8_t)a, (int8_t)b, (int8_t)result);
+    uint8_t result = alu_result(1, a, b);
+    CPU_Registers *regs = get_cpu_registers();
+    
+    flags_record(regs, FLAG_OP_SUB, a, b, result);
+    
+    if (cpu_log_enabled) {
+        // 양수에서 음수를 빼서 음수가 나오거나, 음수에서 양수를 빼서 양수가 나오면 오버플로우
+        if (get_overflow_flag(regs)) {
+            if (!(a & 0x80)) {
+                CPU_LOG("🚨 뺄셈 오버플로우 발생: %d - %d = %d (양수-음수=음수, OF=1)\n", 
+                       (int8_t)a, (int8_t)b, (int8_t)result);
+            } else {
+                CPU_LOG("🚨 뺄셈 언더플로우 발생: %d - %d = %d (음수-양수=양수, OF=1)\n", 
+                       (int8_t)a, (int8_t)b, (int8_t)result);
+            }
         } else {
-            printf("🚨 뺄셈 언더플로우 발생: %d - %d = %d (음수-양수=양수, OF=1)\n", 
-                   (int8_t)a, (int8_t)b, (int8_t)result);
+            CPU_LOG("✅ 뺄셈 정상: %d - %d = %d (OF=0)\n", (int8_t)a, (int8_t)b, (int8_t)result);
         }
-    } else {
-        printf("✅ 뺄셈 정상: %d - %d = %d (OF=0)\n", (int8_t)a, (int8_t)b, (int8_t)result);
     }
     
     return result;
@@ -98,18 +77,19 @@ uint8_t subtraction(uint8_t a, uint8_t b)
  * @returns 곱셈 결과 (8비트)
  */
 uint8_t multiply(uint8_t a, uint8_t b) { 
-    int16_t signed_result = (int8_t)a * (int8_t)b;  // 부호 있는 곱셈
-    uint8_t result = (uint8_t)signed_result;
+    uint8_t result = alu_result(2, a, b);   // 부호 있는 곱셈의 하위 8비트
+    CPU_Registers *regs = get_cpu_registers();
     
-    // OF 설정 - 결과가 -128~127 범위를 벗어나면 오버플로우
-    bool overflow_occurred = (signed_result < -128 || signed_result > 127);
-    set_overflow_flag(&regs, overflow_occurred);
+    // 결과가 -128~127 범위를 벗어나면 CF=OF=1 (읽을 때 계산)
+    flags_record(regs, FLAG_OP_MUL, a, b, result);
     
-    if (overflow_occurred) {
-        printf("🚨 곱셈 오버플로우 발생: %d * %d = %d (실제: %d, 범위 초과, OF=1)\n", 
-               (int8_t)a, (int8_t)b, (int8_t)result, signed_result);
-    } else {
-        printf("✅ 곱셈 정상: %d * %d = %d (OF=0)\n", (int8_t)a, (int8_t)b, (int8_t)result);
+    if (cpu_log_enabled) {
+        if (get_overflow_flag(regs)) {
+            CPU_LOG("🚨 곱셈 오버플로우 발생: %d * %d = %d (실제: %d, 범위 초과, OF=1)\n", 
+                   (int8_t)a, (int8_t)b, (int8_t)result, (int8_t)a * (int8_t)b);
+        } else {
+            CPU_LOG("✅ 곱셈 정상: %d * %d = %d (OF=0)\n", (int8_t)a, (int8_t)b, (int8_t)result);
+        }
     }
     
     return result;
@@ -122,28 +102,56 @@ uint8_t multiply(uint8_t a, uint8_t b) {
  * @returns 나눗셈 결과 (8비트), 0으로 나누는 경우 0 반환
  */
 uint8_t divide(uint8_t a, uint8_t b) { 
+    CPU_Registers *regs = get_cpu_registers();
+    uint8_t result = alu_result(3, a, b);   // 0으로 나누면 0
+    
+    flags_record(regs, FLAG_OP_DIV, a, b, result);
     if (b == 0) {
-        set_overflow_flag(&regs, true);
-        printf("🚨 0으로 나누기 에러: %d ÷ 0 (결과: 0, OF=1)\n", (int8_t)a);
+        CPU_LOG("🚨 0으로 나누기 에러: %d ÷ 0 (결과: 0, OF=1)\n", (int8_t)a);
         return 0;
     }
     
     int8_t signed_a = (int8_t)a;
     int8_t signed_b = (int8_t)b;
-    int8_t signed_result = signed_a / signed_b;
-    uint8_t result = (uint8_t)signed_result;
-    
-    // 특별한 경우: -128 / -1 = 128 (8비트 범위 초과)
-    bool overflow_occurred = (signed_a == -128 && signed_b == -1);
-    set_overflow_flag(&regs, overflow_occurred);
+    // 특별한 경우: -128 / -1 = 128 (8비트 범위 초과, OF=1)
+    int8_t signed_result = (int8_t)result;
     
-    if (overflow_occurred) {
-        printf("🚨 나눗셈 오버플로우 발생: %d ÷ %d = %d (실제: 128, 범위 초과, OF=1)\n", 
-               signed_a, signed_b, (int8_t)result);
-    } else {
-        printf("✅ 나눗셈 정상: %d ÷ %d = %d (나머지: %d, OF=0)\n", 
-               signed_a, signed_b, signed_result, signed_a % signed_b);
+    if (cpu_log_enabled) {
+        if (get_overflow_flag(regs)) {
+            CPU_LOG("🚨 나눗셈 오버플로우 발생: %d ÷ %d = %d (실제: 128, 범위 초과, OF=1)\n", 
+                   signed_a, signed_b, (int8_t)result);
+        } else {
+            CPU_LOG("✅ 나눗셈 정상: %d ÷ %d = %d (나머지: %d, OF=0)\n", 
+                   signed_a, signed_b, signed_result, signed_a % signed_b);
+        }
     }
     
     return result;
 }
+
+/*
+ * @brief 부수 효과 없이 ALU 연산 결과와 오버플로우 여부를 계산합니다
+ * @param opcode ALU opcode (0=ADD, 1=SUB, 2=MUL, 3=DIV)
+ * @param a 첫 번째 피연산자
+ * @param b 두 번째 피연산자
+ * @param overflow 오버플로우 여부를 받을 포인터 (NULL 가능)
+ * @returns 연산 결과 (8비트)
+ *
+ * @details
+ * add/subtraction/multiply/divide와 같은 의미를 가지지만 현재 컨텍스트의 regs와 printf를
+ * 건드리지 않으므로, 자체 레지스터 파일을 가진 엔진(OoO 코어 등)에서 사용합니다.
+ */
+uint8_t alu_compute(uint8_t opcode, uint8_t a, uint8_t b, bool *overflow)
+{
+    uint8_t result = alu_result(opcode, a, b);
+
+    if (overflow) {
+        // OF도 flags.c의 정의 하나로 계산
+        CPU_Registers scratch = { 0 };
+        if (opcode <= 3) {
+            flags_record(&scratch, (uint8_t)(FLAG_OP_ADD + opcode), a, b, result);
+        }
+        *overflow = (get_flags(&scratch) & FLAG_OF) != 0;
+    }
+    return result;
+}
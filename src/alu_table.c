@@ -0,0 +1,72 @@
+/* src/alu_table.c - 테이블 기반 ALU 백엔드 구현
+ * ------------------------------------------------------------
+ * 결과와 플래그를 한 번의 16비트 조회로 얻고, 플래그는 확정된 값으로 기록합니다.
+ * alu_set_backend()로 handler_table에 설치할 백엔드를 실행 중에 바꿀 수 있습니다.
+ * Test Case: tests/alu_table_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/alu_table.h"
+#include "include/instruction.h"
+#include "include/register.h"
+#include "include/flags.h"
+#include "include/log.h"
+
+// 현재 스레드의 CPU 컨텍스트 레지스터 (cpu.c)
+extern CPU_Registers* get_cpu_registers(void);
+
+static ALU_Backend current_backend = ALU_BACKEND_BRANCH;
+
+static const char *op_symbols[ALU_TABLE_OPS] = { "+", "-", "*", "÷" };
+
+/*
+ * @brief 테이블에서 결과와 플래그를 읽어 현재 레지스터에 반영합니다
+ * @param op ALU opcode (0~3)
+ * @param a 첫 번째 피연산자
+ * @param b 두 번째 피연산자
+ * @returns 연산 결과 (8비트)
+ */
+static inline uint8_t alu_table_apply(unsigned op, uint8_t a, uint8_t b) {
+    uint16_t entry = alu_table[op][((unsigned)a << 8) | b];
+    CPU_Registers *regs = get_cpu_registers();
+
+    regs->flags = ALU_TABLE_FLAGS(entry);
+    regs->flag_op = FLAG_OP_NONE;
+
+    CPU_LOG("⚡ 테이블 ALU: %d %s %d = %d (OF=%d)\n", (int8_t)a, op_symbols[op], (int8_t)b,
+            (int8_t)ALU_TABLE_RESULT(entry), (ALU_TABLE_FLAGS(entry) & FLAG_OF) != 0);
+    return ALU_TABLE_RESULT(entry);
+}
+
+uint8_t alu_table_add(uint8_t a, uint8_t b)         { return alu_table_apply(0, a, b); }
+uint8_t alu_table_subtraction(uint8_t a, uint8_t b) { return alu_table_apply(1, a, b); }
+uint8_t alu_table_multiply(uint8_t a, uint8_t b)    { return alu_table_apply(2, a, b); }
+uint8_t alu_table_divide(uint8_t a, uint8_t b)      { return alu_table_apply(3, a, b); }
+
+/*
+ * @brief ALU 백엔드를 선택하고 handler_table을 다시 채웁니다
+ * @param backend ALU_BACKEND_BRANCH 또는 ALU_BACKEND_TABLE
+ * @returns 없음 (void)
+ */
+void alu_set_backend(ALU_Backend backend) {
+    current_backend = backend;
+    init_handler_table();
+}
+
+/*
+ * @brief 현재 ALU 백엔드를 반환합니다
+ * @param 없음
+ * @returns 현재 ALU_Backend
+ */
+ALU_Backend alu_get_backend(void) {
+    return current_backend;
+}
+
+/*
+ * @brief ALU 백엔드 이름을 반환합니다
+ * @param backend ALU 백엔드
+ * @returns "branch" 또는 "table"
+ */
+const char* alu_backend_name(ALU_Backend backend) {
+    return backend == ALU_BACKEND_TABLE ? "table" : "branch";
+}
@@ -0,0 +1,698 @@
+/* src/asm_session.c - 증분 어셈블 편집 세션 구현
+ * ------------------------------------------------------------
+ * 줄은 한 번 할당하면 편집으로 지워질 때까지 주소가 바뀌지 않는 객체이고, 심볼은 그 줄들을
+ * 포인터로 가리키는 사용자 목록을 가집니다. 편집 하나는 다음 순서로 처리합니다.
+ *   1) 지운 줄의 참조를 끊고, 그 줄이 정의한 심볼을 비웁니다 (심볼 사용자는 재인코딩 대기)
+ *   2) 새 줄을 끼우고 편집 지점부터 주소를 다시 배치합니다. 바뀐 줄은 다시 어셈블하고,
+ *      뒤 줄은 바이트만 옮기다가 주소가 원래와 같아지는 곳에서 멈춥니다.
+ *   3) 대기열의 줄(값이 바뀐 심볼을 읽는 줄)을 다시 인코딩합니다.
+ * 따라서 한 번의 편집 비용은 프로그램 길이가 아니라 바뀐 줄과 그 줄에 기대는 줄 수에 비례합니다
+ * (줄 포인터 배열을 당기는 memmove만 예외).
+ * Test Case: tests/assembler_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/asm_session.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ASM_SESSION_SYMBOLS_INITIAL 64U     /* 심볼 슬롯 초기 수 (2의 거듭제곱) */
+#define ASM_SESSION_ARRAY_INITIAL   8U
+#define ASM_SESSION_REWORK_LIMIT    8U      /* 편집 하나에서 줄당 허용하는 재인코딩 횟수 (순환 참조 차단) */
+
+/* 정의한 줄이 사라진 심볼의 상태 */
+enum {
+    ASM_SYMBOL_LIVE = 0,
+    ASM_SYMBOL_REASSEMBLING,        /* 정의한 줄을 다시 어셈블 중 (그 줄 안에서는 미정의) */
+    ASM_SYMBOL_ORPHANED             /* 정의한 줄이 지워짐 (편집이 끝날 때까지 옛 값을 빌려줌) */
+};
+
+typedef struct {
+    AsmSessionSymbol *symbol;
+    uint8_t reads;                  /* 값을 읽었는가? (0이면 정의만 함) */
+} AsmSessionRef;
+
+struct AsmSessionLine {
+    char *text;
+    size_t length;
+    size_t address;
+    size_t size;
+    size_t next;                    /* 다음 줄 주소 (.org 줄은 옮겨도 그대로) */
+    uint8_t *bytes;                 /* size바이트 인코딩 결과 */
+    AsmSessionRef *refs;            /* 읽거나 정의한 심볼 */
+    size_t ref_count;
+    size_t ref_capacity;
+    uint8_t dirty;                  /* 다시 어셈블해야 하는가? */
+    uint8_t sets_origin;
+    uint8_t has_error;
+    AsmError error;
+};
+
+struct AsmSessionSymbol {
+    char *name;
+    uint32_t length;
+    uint32_t hash;
+    long value;
+    AsmSessionLine *definer;        /* NULL이면 (아직) 정의되지 않음 */
+    uint8_t is_label;
+    uint8_t stale;                  /* ASM_SYMBOL_* */
+    AsmSessionLine **users;         /* 이 심볼을 읽거나 정의하려 한 줄 */
+    size_t user_count;
+    size_t user_capacity;
+};
+
+static void relayout(AsmSession *session, size_t index, size_t stable_from);
+
+/*
+ * @brief 배열 용량을 두 배로 늘립니다
+ * @returns 성공 시 0, 메모리 부족 시 -1
+ */
+static int grow_array(void **array, size_t *capacity, size_t element_size) {
+    size_t new_capacity = *capacity ? *capacity * 2 : ASM_SESSION_ARRAY_INITIAL;
+    void *grown = realloc(*array, new_capacity * element_size);
+
+    if (!grown) {
+        return -1;
+    }
+    *array = grown;
+    *capacity = new_capacity;
+    return 0;
+}
+
+/* ---------------- 심볼 ---------------- */
+
+static uint32_t symbol_hash(const char *name, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*
+ * @brief 이름이 같은 심볼의 슬롯, 없으면 넣을 빈 슬롯을 찾습니다
+ */
+static AsmSessionSymbol** symbol_slot(AsmSession *session, const char *name, size_t length, uint32_t hash) {
+    uint32_t mask = session->symbol_capacity - 1;
+
+    for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+        AsmSessionSymbol **slot = &session->symbols[i];
+        if (!*slot || ((*slot)->hash == hash && (*slot)->length == length &&
+                       memcmp((*slot)->name, name, length) == 0)) {
+            return slot;
+        }
+    }
+}
+
+/*
+ * @brief 심볼을 찾고, 없으면 정의되지 않은 심볼로 만듭니다
+ * @returns 심볼, 메모리 부족 시 NULL
+ */
+static AsmSessionSymbol* symbol_get(AsmSession *session, const char *name, size_t length) {
+    uint32_t hash = symbol_hash(name, length);
+    AsmSessionSymbol **slot = symbol_slot(session, name, length, hash);
+
+    if (*slot) {
+        return *slot;
+    }
+
+    // 적재율 70%를 넘으면 두 배로 늘려 다시 넣습니다
+    if ((session->symbol_count + 1) * 10 >= session->symbol_capacity * 7) {
+        AsmSessionSymbol **old = session->symbols;
+        uint32_t old_capacity = session->symbol_capacity;
+        AsmSessionSymbol **grown = calloc((size_t)old_capacity * 2, sizeof(AsmSessionSymbol *));
+        if (!grown) {
+            return NULL;
+        }
+        session->symbols = grown;
+        session->symbol_capacity = old_capacity * 2;
+        for (uint32_t i = 0; i < old_capacity; i++) {
+            if (old[i]) {
+                *symbol_slot(session, old[i]->name, old[i]->length, old[i]->hash) = old[i];
+            }
+        }
+        free(old);
+        slot = symbol_slot(session, name, length, hash);
+    }
+
+    AsmSessionSymbol *symbol = calloc(1, sizeof(AsmSessionSymbol));
+    char *copy = malloc(length);
+    if (!symbol || !copy) {
+        free(symbol);
+        free(copy);
+        return NULL;
+    }
+    memcpy(copy, name, length);
+    symbol->name = copy;
+    symbol->length = (uint32_t)length;
+    symbol->hash = hash;
+    *slot = symbol;
+    session->symbol_count++;
+    return symbol;
+}
+
+static void symbol_remove_user(AsmSessionSymbol *symbol, const AsmSessionLine *line) {
+    for (size_t i = 0; i < symbol->user_count; i++) {
+        if (symbol->users[i] == line) {
+            symbol->users[i] = symbol->users[--symbol->user_count];
+            return;
+        }
+    }
+}
+
+/*
+ * @brief 줄을 재인코딩 대기열에 넣습니다
+ */
+static void mark_line(AsmSession *session, AsmSessionLine *line) {
+    if (line->dirty) {
+        return;
+    }
+    if (session->pending_count == session->pending_capacity &&
+        grow_array((void **)&session->pending, &session->pending_capacity, sizeof(AsmSessionLine *)) != 0) {
+        session->out_of_memory = 1;
+        return;
+    }
+    line->dirty = 1;
+    session->pending[session->pending_count++] = line;
+}
+
+/*
+ * @brief 값이 바뀐 심볼을 쓰는 줄을 모두 대기열에 넣습니다 (어셈블 중인 줄은 이미 새 값을 봄)
+ */
+static void symbol_changed(AsmSession *session, AsmSessionSymbol *symbol) {
+    for (size_t i = 0; i < symbol->user_count; i++) {
+        if (symbol->users[i] != session->current) {
+            mark_line(session, symbol->users[i]);
+        }
+    }
+}
+
+/*
+ * @brief 어셈블 중인 줄이 심볼을 쓴다고 기록합니다 (줄 → 심볼, 심볼 → 줄 양방향)
+ * @returns 성공 시 0, 메모리 부족 시 -1
+ */
+static int line_add_ref(AsmSession *session, AsmSessionLine *line, AsmSessionSymbol *symbol, int reads) {
+    for (size_t i = 0; i < line->ref_count; i++) {
+        if (line->refs[i].symbol == symbol) {
+            line->refs[i].reads |= (uint8_t)reads;
+            return 0;
+        }
+    }
+    if ((line->ref_count == line->ref_capacity &&
+         grow_array((void **)&line->refs, &line->ref_capacity, sizeof(AsmSessionRef)) != 0) ||
+        (symbol->user_count == symbol->user_capacity &&
+         grow_array((void **)&symbol->users, &symbol->user_capacity, sizeof(AsmSessionLine *)) != 0)) {
+        session->out_of_memory = 1;
+        return -1;
+    }
+    line->refs[line->ref_count].symbol = symbol;
+    line->refs[line->ref_count].reads = (uint8_t)reads;
+    line->ref_count++;
+    symbol->users[symbol->user_count++] = line;
+    return 0;
+}
+
+/* ---------------- 어셈블러 훅 ---------------- */
+
+static int session_lookup(void *context, const char *name, size_t length, long *value) {
+    AsmSession *session = context;
+    AsmSessionSymbol *symbol = symbol_get(session, name, length);
+
+    if (!symbol || line_add_ref(session, session->current, symbol, 1) != 0) {
+        session->out_of_memory = 1;
+        return -1;
+    }
+    // 지워진 줄의 심볼은 같은 편집에서 다시 정의될 수 있으므로 옛 값을 씁니다
+    // (값이 달라지거나 끝내 정의되지 않으면 사용자 목록을 통해 이 줄이 다시 인코딩됨)
+    if (!symbol->definer && symbol->stale != ASM_SYMBOL_ORPHANED) {
+        return -1;
+    }
+    *value = symbol->value;
+    return 0;
+}
+
+static int session_define(void *context, const char *name, size_t length, long value, int is_label) {
+    AsmSession *session = context;
+    AsmSessionSymbol *symbol = symbol_get(session, name, length);
+
+    if (!symbol || line_add_ref(session, session->current, symbol, 0) != 0) {
+        session->out_of_memory = 1;
+        return -1;
+    }
+    // 다른 줄이 정의 중이면 중복 (그 줄이 지워지면 사용자 목록을 통해 이 줄이 다시 어셈블됨)
+    if (symbol->definer) {
+        return 1;
+    }
+
+    int changed = !symbol->stale || symbol->value != value || symbol->is_label != (uint8_t)is_label;
+    symbol->definer = session->current;
+    symbol->value = value;
+    symbol->is_label = (uint8_t)is_label;
+    symbol->stale = ASM_SYMBOL_LIVE;
+    if (changed) {
+        symbol_changed(session, symbol);
+    }
+    return 0;
+}
+
+/* ---------------- 이미지 ---------------- */
+
+static void mark_dirty(AsmSession *session, size_t start, size_t end) {
+    if (start >= end) {
+        return;
+    }
+    if (start < session->dirty_start) session->dirty_start = start;
+    if (end > session->dirty_end) session->dirty_end = end;
+}
+
+static size_t line_end(const AsmSession *session, const AsmSessionLine *line) {
+    size_t end = line->address + line->size;
+    return end < session->capacity ? end : session->capacity;
+}
+
+/*
+ * @brief 줄이 쓴 바이트를 이미지에서 지웁니다 (뒤에 다른 줄이 덮어쓴 바이트는 그대로)
+ */
+static void line_clear_bytes(AsmSession *session, AsmSessionLine *line) {
+    size_t end = line_end(session, line);
+
+    for (size_t address = line->address; address < end; address++) {
+        if (session->owner[address] == line) {
+            session->owner[address] = NULL;
+            session->image[address] = 0;
+        }
+    }
+    mark_dirty(session, line->address, end);
+}
+
+static void line_write_bytes(AsmSession *session, AsmSessionLine *line) {
+    size_t end = line_end(session, line);
+
+    for (size_t address = line->address; address < end; address++) {
+        session->owner[address] = line;
+        session->image[address] = line->bytes[address - line->address];
+    }
+    mark_dirty(session, line->address, end);
+}
+
+static void line_set_error(AsmSession *session, AsmSessionLine *line, const AsmError *error) {
+    if (line->has_error) {
+        session->error_lines--;
+    }
+    line->has_error = error != NULL;
+    if (error) {
+        line->error = *error;
+        session->error_lines++;
+    }
+}
+
+/* ---------------- 줄 ---------------- */
+
+static AsmSessionLine* line_create(const char *text, size_t length) {
+    AsmSessionLine *line = calloc(1, sizeof(AsmSessionLine));
+
+    if (!line) {
+        return NULL;
+    }
+    line->text = malloc(length + 1);
+    line->bytes = malloc(length + 2);
+    if (!line->text || !line->bytes) {
+        free(line->text);
+        free(line->bytes);
+        free(line);
+        return NULL;
+    }
+    memcpy(line->text, text, length);
+    line->text[length] = '\0';
+    line->length = length;
+    line->dirty = 1;
+    return line;
+}
+
+static void line_free(AsmSessionLine *line) {
+    free(line->text);
+    free(line->bytes);
+    free(line->refs);
+    free(line);
+}
+
+/*
+ * @brief 줄을 address에 다시 어셈블하고, 바뀐 심볼 정의를 사용자에게 알립니다
+ */
+static void line_assemble(AsmSession *session, AsmSessionLine *line, size_t address) {
+    static const AsmSymbolHooks hooks_template = { session_lookup, session_define, NULL };
+    AsmSymbolHooks hooks = hooks_template;
+    AsmSessionRef *old_refs = line->refs;
+    size_t old_count = line->ref_count;
+    AsmLineResult result;
+
+    line_clear_bytes(session, line);
+
+    // 이 줄이 정의했던 심볼은 잠시 비워 두고(stale), 다시 정의되지 않으면 없어진 것으로 봅니다
+    for (size_t i = 0; i < old_count; i++) {
+        AsmSessionSymbol *symbol = old_refs[i].symbol;
+        symbol_remove_user(symbol, line);
+        if (symbol->definer == line) {
+            symbol->definer = NULL;
+            symbol->stale = ASM_SYMBOL_REASSEMBLING;
+        }
+    }
+    line->refs = NULL;
+    line->ref_count = 0;
+    line->ref_capacity = 0;
+
+    hooks.context = session;
+    session->current = line;
+    asm_assemble_line(line->text, line->length, address, session->capacity, &hooks, line->bytes, &result);
+
+    for (size_t i = 0; i < old_count; i++) {
+        AsmSessionSymbol *symbol = old_refs[i].symbol;
+        if (symbol->stale == ASM_SYMBOL_REASSEMBLING) {
+            symbol->stale = ASM_SYMBOL_LIVE;
+            symbol_changed(session, symbol);
+        }
+    }
+    session->current = NULL;
+    free(old_refs);
+
+    line->address = address;
+    line->size = result.size;
+    line->next = result.next;
+    line->sets_origin = (uint8_t)result.sets_origin;
+    line->dirty = 0;
+    line_set_error(session, line, result.error_count ? &result.error : NULL);
+    line_write_bytes(session, line);
+    session->assembled++;
+}
+
+/*
+ * @brief 다시 어셈블하지 않고 줄을 address로 옮깁니다 (라벨 값만 갱신)
+ */
+static void line_move(AsmSession *session, AsmSessionLine *line, size_t address) {
+    int reads_own_label = 0;
+
+    line_clear_bytes(session, line);
+    line->address = address;
+    if (!line->sets_origin) {
+        line->next = address + line->size;
+    }
+    line_write_bytes(session, line);
+
+    session->current = line;
+    for (size_t i = 0; i < line->ref_count; i++) {
+        AsmSessionSymbol *symbol = line->refs[i].symbol;
+        if (symbol->definer == line && symbol->is_label) {
+            symbol->value = (long)address;
+            symbol_changed(session, symbol);
+            reads_own_label |= line->refs[i].reads;
+        }
+    }
+    session->current = NULL;
+
+    // "x: .byte x"처럼 자기 라벨을 읽는 줄은 다시 인코딩해야 합니다
+    if (reads_own_label) {
+        mark_line(session, line);
+    }
+    session->relocated++;
+}
+
+/*
+ * @brief index번째 줄부터 주소를 다시 배치합니다
+ * @param stable_from 이 줄부터는 주소가 원래와 같고 바뀐 것이 없으면 멈춤
+ */
+static void relayout(AsmSession *session, size_t index, size_t stable_from) {
+    size_t location = index ? session->lines[index - 1]->next : 0;
+
+    for (size_t i = index; i < session->line_count; i++) {
+        AsmSessionLine *line = session->lines[i];
+
+        if (i >= stable_from && !line->dirty && line->address == location) {
+            break;
+        }
+        // 범위 오류 같은 줄은 주소가 바뀌면 결과도 바뀔 수 있으므로 다시 어셈블
+        if (line->dirty || line->has_error) {
+            line_assemble(session, line, location);
+        } else if (line->address != location) {
+            line_move(session, line, location);
+        }
+        location = line->next;
+    }
+}
+
+static size_t line_index(const AsmSession *session, const AsmSessionLine *line) {
+    size_t i = 0;
+    while (session->lines[i] != line) i++;
+    return i;
+}
+
+/*
+ * @brief 대기열이 빌 때까지 줄을 다시 인코딩합니다
+ *
+ * @details
+ * 인코딩은 크기를 바꾸지 않지만, .org 줄은 심볼 값에 따라 다음 주소가 바뀌므로 그 뒤를 다시 배치합니다.
+ * .equ끼리 서로 참조하면 값이 끝없이 바뀌므로 재인코딩 횟수에 상한을 둡니다.
+ */
+static void drain_pending(AsmSession *session) {
+    size_t budget = (session->line_count + 1) * ASM_SESSION_REWORK_LIMIT;
+
+    while (session->pending_count) {
+        AsmSessionLine *line = session->pending[--session->pending_count];
+
+        if (!line->dirty) {
+            continue;
+        }
+        if (budget == 0) {
+            AsmError error = { 0, 1, "" };
+            snprintf(error.message, sizeof(error.message), "심볼이 서로를 참조해 값이 정해지지 않습니다");
+            line->dirty = 0;
+            line_set_error(session, line, &error);
+            continue;
+        }
+        budget--;
+
+        size_t old_next = line->next;
+        line_assemble(session, line, line->address);
+        if (line->next != old_next) {
+            size_t index = line_index(session, line);
+            relayout(session, index + 1, index + 1);
+        }
+    }
+}
+
+/* ---------------- 공개 API ---------------- */
+
+/*
+ * @brief 빈 세션을 만듭니다
+ * @param session 초기화할 세션
+ * @param capacity 이미지 크기 (바이트)
+ * @returns 성공 시 0, 메모리 부족 시 -1
+ */
+int asm_session_init(AsmSession *session, size_t capacity) {
+    memset(session, 0, sizeof(*session));
+    session->image = calloc(capacity ? capacity : 1, 1);
+    session->owner = calloc(capacity ? capacity : 1, sizeof(AsmSessionLine *));
+    session->symbols = calloc(ASM_SESSION_SYMBOLS_INITIAL, sizeof(AsmSessionSymbol *));
+    if (!session->image || !session->owner || !session->symbols) {
+        asm_session_free(session);
+        return -1;
+    }
+    session->capacity = capacity;
+    session->symbol_capacity = ASM_SESSION_SYMBOLS_INITIAL;
+    return 0;
+}
+
+/*
+ * @brief 세션의 줄, 심볼, 이미지를 모두 해제합니다
+ * @param session 해제할 세션
+ * @returns 없음 (void)
+ */
+void asm_session_free(AsmSession *session) {
+    for (size_t i = 0; i < session->line_count; i++) {
+        line_free(session->lines[i]);
+    }
+    for (uint32_t i = 0; i < session->symbol_capacity; i++) {
+        if (session->symbols[i]) {
+            free(session->symbols[i]->name);
+            free(session->symbols[i]->users);
+            free(session->symbols[i]);
+        }
+    }
+    free(session->lines);
+    free(session->symbols);
+    free(session->pending);
+    free(session->orphans);
+    free(session->image);
+    free(session->owner);
+    memset(session, 0, sizeof(*session));
+}
+
+/*
+ * @brief first_line부터 delete_count줄을 text의 줄들로 바꿉니다
+ * @param session 편집 세션
+ * @param first_line 0부터 세는 줄 번호
+ * @param delete_count 지울 줄 수
+ * @param text 넣을 줄들 ('\n'으로 구분), NULL이면 넣지 않음
+ * @param length text 길이
+ * @param edit 바뀐 이미지 범위와 통계
+ * @returns 성공 시 0, 범위 오류나 메모리 부족 시 -1
+ *
+ * @details
+ * 새 줄을 모두 만든 뒤에 세션을 고치므로, 범위 오류나 줄 할당 실패 시 세션은 그대로입니다.
+ */
+int asm_session_edit(AsmSession *session, size_t first_line, size_t delete_count,
+                     const char *text, size_t length, AsmEdit *edit) {
+    size_t insert_count = 0;
+    AsmSessionLine **fresh = NULL;
+
+    memset(edit, 0, sizeof(*edit));
+    if (first_line > session->line_count || delete_count > session->line_count - first_line) {
+        return -1;
+    }
+
+    if (text) {
+        const char *p = text;
+        const char *end = text + length;
+        const char *newline;
+        insert_count = 1;
+        while ((newline = memchr(p, '\n', (size_t)(end - p))) != NULL) {
+            insert_count++;
+            p = newline + 1;
+        }
+    }
+
+    size_t new_count = session->line_count - delete_count + insert_count;
+    while (new_count > session->line_capacity) {
+        if (grow_array((void **)&session->lines, &session->line_capacity, sizeof(AsmSessionLine *)) != 0) {
+            return -1;
+        }
+    }
+
+    if (insert_count) {
+        const char *p = text;
+        fresh = calloc(insert_count, sizeof(AsmSessionLine *));
+        for (size_t i = 0; fresh && i < insert_count; i++) {
+            const char *newline = memchr(p, '\n', (size_t)(text + length - p));
+            size_t line_length = newline ? (size_t)(newline - p) : (size_t)(text + length - p);
+            fresh[i] = line_create(p, line_length);
+            if (!fresh[i]) {
+                while (i--) line_free(fresh[i]);
+                free(fresh);
+                fresh = NULL;
+            }
+            p += line_length + 1;
+        }
+        if (!fresh) {
+            return -1;
+        }
+    }
+
+    session->dirty_start = SIZE_MAX;
+    session->dirty_end = 0;
+    session->assembled = 0;
+    session->relocated = 0;
+    session->out_of_memory = 0;
+
+    // 지운 줄끼리 서로 참조할 수 있으므로 참조를 모두 끊은 뒤에 정의를 비웁니다.
+    // 줄 교체는 지우고 넣기이므로, 비운 심볼은 새 줄이 같은 값으로 다시 정의하면 알리지 않습니다
+    for (size_t i = first_line; i < first_line + delete_count; i++) {
+        AsmSessionLine *line = session->lines[i];
+        for (size_t j = 0; j < line->ref_count; j++) {
+            symbol_remove_user(line->refs[j].symbol, line);
+        }
+    }
+    for (size_t i = first_line; i < first_line + delete_count; i++) {
+        AsmSessionLine *line = session->lines[i];
+        for (size_t j = 0; j < line->ref_count; j++) {
+            AsmSessionSymbol *symbol = line->refs[j].symbol;
+            if (symbol->definer == line) {
+                symbol->definer = NULL;
+                symbol->stale = ASM_SYMBOL_ORPHANED;
+                if (session->orphan_count == session->orphan_capacity &&
+                    grow_array((void **)&session->orphans, &session->orphan_capacity,
+                               sizeof(AsmSessionSymbol *)) != 0) {
+                    session->out_of_memory = 1;
+                    symbol->stale = ASM_SYMBOL_LIVE;
+                    symbol_changed(session, symbol);
+                    continue;
+                }
+                session->orphans[session->orphan_count++] = symbol;
+            }
+        }
+        line_clear_bytes(session, line);
+        line_set_error(session, line, NULL);
+        line_free(line);
+    }
+
+    memmove(&session->lines[first_line + insert_count], &session->lines[first_line + delete_count],
+            (session->line_count - first_line - delete_count) * sizeof(AsmSessionLine *));
+    if (insert_count) {
+        memcpy(&session->lines[first_line], fresh, insert_count * sizeof(AsmSessionLine *));
+    }
+    free(fresh);
+    session->line_count = new_count;
+
+    relayout(session, first_line, first_line + insert_count);
+    while (session->orphan_count) {
+        AsmSessionSymbol *symbol = session->orphans[--session->orphan_count];
+        if (symbol->stale == ASM_SYMBOL_ORPHANED) {
+            symbol->stale = ASM_SYMBOL_LIVE;
+            symbol_changed(session, symbol);
+        }
+    }
+    drain_pending(session);
+
+    if (session->dirty_start < session->dirty_end) {
+        edit->dirty_start = session->dirty_start;
+        edit->dirty_end = session->dirty_end;
+    }
+    edit->assembled = session->assembled;
+    edit->relocated = session->relocated;
+    edit->error_lines = session->error_lines;
+    return session->out_of_memory ? -1 : 0;
+}
+
+/*
+ * @brief 소스 전체를 새로 적재합니다
+ * @returns 성공 시 0, 메모리 부족 시 -1
+ */
+int asm_session_load(AsmSession *session, const char *source, size_t length, AsmEdit *edit) {
+    return asm_session_edit(session, 0, session->line_count, source, length, edit);
+}
+
+/*
+ * @brief 현재 이미지를 돌려줍니다
+ * @param session 편집 세션
+ * @param size 가장 높은 사용 주소 + 1 (NULL 가능)
+ * @returns 이미지 (capacity바이트)
+ */
+const uint8_t* asm_session_image(const AsmSession *session, size_t *size) {
+    if (size) {
+        size_t end = session->capacity;
+        while (end > 0 && !session->owner[end - 1]) end--;
+        *size = end;
+    }
+    return session->image;
+}
+
+/*
+ * @brief 오류가 있는 줄의 오류를 줄 순서대로 복사합니다
+ * @param session 편집 세션
+ * @param errors 출력 배열
+ * @param max 최대 개수
+ * @returns 복사한 개수
+ */
+unsigned asm_session_errors(const AsmSession *session, AsmError *errors, unsigned max) {
+    unsigned count = 0;
+
+    for (size_t i = 0; i < session->line_count && count < max && session->error_lines; i++) {
+        if (session->lines[i]->has_error) {
+            errors[count] = session->lines[i]->error;
+            errors[count].line = (unsigned)(i + 1);
+            count++;
+        }
+    }
+    return count;
+}
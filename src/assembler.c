@@ -0,0 +1,1001 @@
+/* src/assembler.c - 2패스 어셈블러 구현
+ * ------------------------------------------------------------
+ * 1패스: 버퍼를 줄 단위로 한 번 훑으며 라벨/.equ/.org를 처리하고, 명령어와 .byte 문장을
+ *        (오프셋, 길이) 토막으로 배열에 기록합니다. 배열은 두 배씩 늘어나므로 줄마다 할당하지 않습니다.
+ * 2패스: 기록한 문장만 돌며 피연산자 식을 심볼 테이블로 풀고 isa_encode_operands()로 인코딩합니다.
+ * 심볼 테이블은 FNV-1a 해시 + 선형 탐사이며, 이름은 소스 버퍼를 가리키기만 합니다.
+ * 한 줄 모드(asm_assemble_line)는 같은 두 패스를 줄 하나에 돌리되 심볼은 훅으로 넘깁니다.
+ * Test Case: tests/assembler_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/assembler.h"
+#include "include/isa.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ASM_SYMBOLS_INITIAL     256U    /* 심볼 테이블 초기 슬롯 수 (2의 거듭제곱) */
+#define ASM_STATEMENTS_INITIAL  1024U
+#define ASM_MNEMONIC_MAX        15U
+#define ASM_LINE_OPERANDS       32U     /* 한 줄 모드에서 스택에 두는 피연산자 수 */
+
+/* 소스 안의 토막 */
+typedef struct {
+    uint32_t offset;
+    uint32_t length;
+} AsmSlice;
+
+typedef enum {
+    ASM_STMT_INSN = 0,
+    ASM_STMT_BYTE
+} AsmStatementKind;
+
+/* 2패스에서 인코딩할 문장 */
+typedef struct {
+    uint8_t kind;
+    uint8_t first;              /* 명령어: 니모닉의 첫 IsaId */
+    uint32_t line;
+    uint32_t line_start;        /* 줄 첫 바이트 오프셋 (열 계산용) */
+    uint32_t keyword;           /* 니모닉/지시어 오프셋 (오류 위치) */
+    uint32_t operand_index;     /* operands 배열 시작 */
+    uint32_t operand_count;
+    size_t address;
+} AsmStatement;
+
+typedef struct {
+    uint32_t name;              /* 소스 오프셋 */
+    uint32_t length;            /* 0이면 빈 슬롯 */
+    uint32_t hash;
+    long value;
+} AsmSymbol;
+
+typedef struct {
+    const char *source;
+    size_t length;
+    uint8_t *output;
+    size_t capacity;
+    AsmResult *result;
+
+    AsmSymbol *symbols;
+    uint32_t symbol_capacity;
+    uint32_t symbol_count;
+
+    AsmStatement *statements;
+    size_t statement_count;
+    size_t statement_capacity;
+
+    AsmSlice *operands;
+    size_t operand_count;
+    size_t operand_capacity;
+
+    size_t location;            /* 위치 카운터 */
+    size_t origin;              /* output[0]의 주소 (한 줄 모드에서는 줄 주소) */
+    const AsmSymbolHooks *hooks;    /* NULL이면 내부 심볼 테이블 */
+    int sets_origin;            /* .org가 위치를 옮겼는가? */
+} Assembler;
+
+static int is_space(char c) {
+    return c == ' ' || c == '\t';
+}
+
+static int is_ident_start(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
+}
+
+static int is_ident_char(char c) {
+    return is_ident_start(c) || (c >= '0' && c <= '9') || c == '.';
+}
+
+static char to_upper(char c) {
+    return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+}
+
+/*
+ * @brief 오류를 기록합니다 (앞쪽 ASM_MAX_ERRORS개만 보관, 개수는 모두 셈)
+ */
+static void asm_error(Assembler *as, unsigned line, uint32_t line_start, uint32_t offset, const char *format, ...) {
+    AsmResult *result = as->result;
+
+    if (result->error_count < ASM_MAX_ERRORS) {
+        AsmError *error = &result->errors[result->error_count];
+        va_list args;
+        error->line = line;
+        error->column = offset - line_start + 1;
+        va_start(args, format);
+        vsnprintf(error->message, sizeof(error->message), format, args);
+        va_end(args);
+    }
+    result->error_count++;
+}
+
+/*
+ * @brief 배열 용량을 두 배로 늘립니다
+ * @returns 성공 시 0, 메모리 부족 시 -1
+ */
+static int grow_array(void **array, size_t *capacity, size_t element_size) {
+    size_t new_capacity = *capacity ? *capacity * 2 : ASM_STATEMENTS_INITIAL;
+    void *grown = realloc(*array, new_capacity * element_size);
+
+    if (!grown) {
+        return -1;
+    }
+    *array = grown;
+    *capacity = new_capacity;
+    return 0;
+}
+
+/* ---------------- 심볼 테이블 ---------------- */
+
+static uint32_t symbol_hash(const char *name, uint32_t length) {
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*
+ * @brief 이름이 같은 슬롯, 없으면 넣을 빈 슬롯을 찾습니다
+ */
+static AsmSymbol* symbol_slot(Assembler *as, uint32_t name, uint32_t length, uint32_t hash) {
+    uint32_t mask = as->symbol_capacity - 1;
+
+    for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+        AsmSymbol *slot = &as->symbols[i];
+        if (slot->length == 0) {
+            return slot;
+        }
+        if (slot->hash == hash && slot->length == length &&
+            memcmp(as->source + slot->name, as->source + name, length) == 0) {
+            return slot;
+        }
+    }
+}
+
+/*
+ * @brief 적재율 70%를 넘으면 테이블을 두 배로 늘려 다시 넣습니다
+ */
+static int symbol_reserve(Assembler *as) {
+    if ((as->symbol_count + 1) * 10 < as->symbol_capacity * 7) {
+        return 0;
+    }
+
+    AsmSymbol *old = as->symbols;
+    uint32_t old_capacity = as->symbol_capacity;
+    AsmSymbol *grown = calloc(old_capacity * 2, sizeof(AsmSymbol));
+    if (!grown) {
+        return -1;
+    }
+    as->symbols = grown;
+    as->symbol_capacity = old_capacity * 2;
+    for (uint32_t i = 0; i < old_capacity; i++) {
+        if (old[i].length) {
+            *symbol_slot(as, old[i].name, old[i].length, old[i].hash) = old[i];
+        }
+    }
+    free(old);
+    return 0;
+}
+
+/*
+ * @brief 심볼을 정의합니다
+ * @returns 성공 시 0, 이미 정의되어 있으면 1, 메모리 부족 시 -1
+ */
+static int symbol_define(Assembler *as, uint32_t name, uint32_t length, long value, int is_label) {
+    if (as->hooks) {
+        return as->hooks->define(as->hooks->context, as->source + name, length, value, is_label);
+    }
+    if (symbol_reserve(as) != 0) {
+        return -1;
+    }
+
+    uint32_t hash = symbol_hash(as->source + name, length);
+    AsmSymbol *slot = symbol_slot(as, name, length, hash);
+    if (slot->length) {
+        return 1;
+    }
+    slot->name = name;
+    slot->length = length;
+    slot->hash = hash;
+    slot->value = value;
+    as->symbol_count++;
+    return 0;
+}
+
+static int symbol_lookup(Assembler *as, uint32_t name, uint32_t length, long *value) {
+    if (as->hooks) {
+        return as->hooks->lookup(as->hooks->context, as->source + name, length, value);
+    }
+
+    AsmSymbol *slot = symbol_slot(as, name, length, symbol_hash(as->source + name, length));
+
+    if (!slot->length) {
+        return -1;
+    }
+    *value = slot->value;
+    return 0;
+}
+
+/* ---------------- 식과 피연산자 ---------------- */
+
+/*
+ * @brief 숫자(10진, 0x, 0b)를 읽습니다
+ * @returns 읽은 끝 위치, 형식 오류면 0
+ */
+static uint32_t parse_number(const char *source, uint32_t p, uint32_t end, long *value) {
+    long base = 10;
+    long result = 0;
+    uint32_t digits = 0;
+
+    if (p + 1 < end && source[p] == '0' && (source[p + 1] == 'x' || source[p + 1] == 'X')) {
+        base = 16;
+        p += 2;
+    } else if (p + 1 < end && source[p] == '0' && (source[p + 1] == 'b' || source[p + 1] == 'B')) {
+        base = 2;
+        p += 2;
+    }
+
+    for (; p < end; p++, digits++) {
+        char c = source[p];
+        long digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else if (is_ident_char(c)) return 0;
+        else break;
+        if (digit >= base) return 0;
+        result = result * base + digit;
+    }
+
+    if (digits == 0) {
+        return 0;
+    }
+    *value = result;
+    return p;
+}
+
+/*
+ * @brief "항 (+|- 항)*" 식을 계산합니다
+ * @returns 성공 시 0, 오류(기록함) 시 -1
+ */
+static int eval_expression(Assembler *as, const AsmStatement *at, AsmSlice slice, long *value) {
+    const char *source = as->source;
+    uint32_t p = slice.offset;
+    uint32_t end = slice.offset + slice.length;
+    long total = 0;
+    long sign = 1;
+    int expect_term = 1;
+
+    while (p < end) {
+        char c = source[p];
+        if (is_space(c)) {
+            p++;
+        } else if (expect_term && (c == '-' || c == '+')) {
+            if (c == '-') sign = -sign;
+            p++;
+        } else if (expect_term && c >= '0' && c <= '9') {
+            long number;
+            uint32_t next = parse_number(source, p, end, &number);
+            if (!next) {
+                asm_error(as, at->line, at->line_start, p, "잘못된 숫자");
+                return -1;
+            }
+            total += sign * number;
+            sign = 1;
+            expect_term = 0;
+            p = next;
+        } else if (expect_term && is_ident_start(c)) {
+            uint32_t start = p;
+            long symbol_value;
+            while (p < end && is_ident_char(source[p])) p++;
+            if (symbol_lookup(as, start, p - start, &symbol_value) != 0) {
+                asm_error(as, at->line, at->line_start, start, "정의되지 않은 심볼: %.*s",
+                          (int)(p - start), source + start);
+                return -1;
+            }
+            total += sign * symbol_value;
+            sign = 1;
+            expect_term = 0;
+        } else if (!expect_term && (c == '+' || c == '-')) {
+            sign = (c == '-') ? -1 : 1;
+            expect_term = 1;
+            p++;
+        } else {
+            asm_error(as, at->line, at->line_start, p, expect_term ? "식에 올 수 없는 문자: '%c'"
+                                                                   : "연산자(+/-)가 필요합니다: '%c'", c);
+            return -1;
+        }
+    }
+
+    if (expect_term) {
+        asm_error(as, at->line, at->line_start, end, "식이 끝나지 않았습니다");
+        return -1;
+    }
+    *value = total;
+    return 0;
+}
+
+/*
+ * @brief 토막 앞뒤 공백을 잘라냅니다
+ */
+static AsmSlice trim(const char *source, uint32_t start, uint32_t end) {
+    AsmSlice slice;
+    while (start < end && is_space(source[start])) start++;
+    while (end > start && is_space(source[end - 1])) end--;
+    slice.offset = start;
+    slice.length = end - start;
+    return slice;
+}
+
+/*
+ * @brief 레지스터 이름(R1~R7, V0~V3, 대소문자 무관)을 확인합니다
+ * @returns 레지스터면 ISA_OPND_REG/ISA_OPND_VREG, 아니면 ISA_OPND_NONE
+ */
+static IsaOperandKind register_kind(const char *source, AsmSlice slice, long *number) {
+    if (slice.length != 2) {
+        return ISA_OPND_NONE;
+    }
+    char prefix = to_upper(source[slice.offset]);
+    char digit = source[slice.offset + 1];
+    if (prefix == 'R' && digit >= '1' && digit <= '7') {
+        *number = digit - '0';
+        return ISA_OPND_REG;
+    }
+    if (prefix == 'V' && digit >= '0' && digit < '0' + VREG_COUNT) {
+        *number = digit - '0';
+        return ISA_OPND_VREG;
+    }
+    return ISA_OPND_NONE;
+}
+
+/*
+ * @brief 피연산자 토막을 ISA 피연산자로 풉니다 (레지스터, [식], [레지스터], 식)
+ * @returns 성공 시 0, 오류(기록함) 시 -1
+ */
+static int resolve_operand(Assembler *as, const AsmStatement *at, AsmSlice slice, IsaOperand *operand) {
+    const char *source = as->source;
+    IsaOperandKind kind = register_kind(source, slice, &operand->value);
+
+    if (kind == ISA_OPND_REG || kind == ISA_OPND_VREG) {
+        operand->kind = kind;
+        return 0;
+    }
+
+    if (source[slice.offset] == '[') {
+        if (source[slice.offset + slice.length - 1] != ']') {
+            asm_error(as, at->line, at->line_start, slice.offset, "']'가 없습니다");
+            return -1;
+        }
+        AsmSlice inner = trim(source, slice.offset + 1, slice.offset + slice.length - 1);
+        if (register_kind(source, inner, &operand->value) == ISA_OPND_REG) {
+            operand->kind = ISA_OPND_MEM_REG;
+            return 0;
+        }
+        operand->kind = ISA_OPND_MEM;
+        return eval_expression(as, at, inner, &operand->value);
+    }
+
+    operand->kind = ISA_OPND_IMM;
+    return eval_expression(as, at, slice, &operand->value);
+}
+
+/* ---------------- 1패스: 줄 분석 ---------------- */
+
+/*
+ * @brief 줄의 나머지를 ','로 나눠 피연산자 토막을 기록합니다
+ * @returns 피연산자 수, 오류(기록함) 시 -1
+ */
+static int split_operands(Assembler *as, unsigned line, uint32_t line_start, uint32_t p, uint32_t end) {
+    int count = 0;
+
+    p = trim(as->source, p, end).offset;
+    if (p >= end) {
+        return 0;
+    }
+
+    for (;;) {
+        uint32_t comma = p;
+        while (comma < end && as->source[comma] != ',') comma++;
+
+        AsmSlice slice = trim(as->source, p, comma);
+        if (slice.length == 0) {
+            asm_error(as, line, line_start, p, "빈 피연산자");
+            return -1;
+        }
+        if (as->operand_count == as->operand_capacity &&
+            grow_array((void **)&as->operands, &as->operand_capacity, sizeof(AsmSlice)) != 0) {
+            asm_error(as, line, line_start, p, "메모리 부족");
+            return -1;
+        }
+        as->operands[as->operand_count++] = slice;
+        count++;
+
+        if (comma >= end) {
+            return count;
+        }
+        p = comma + 1;
+    }
+}
+
+/*
+ * @brief 2패스에서 인코딩할 문장을 추가합니다
+ */
+static AsmStatement* push_statement(Assembler *as, AsmStatementKind kind, unsigned line, uint32_t line_start,
+                                    uint32_t keyword, size_t size) {
+    if (as->statement_count == as->statement_capacity &&
+        grow_array((void **)&as->statements, &as->statement_capacity, sizeof(AsmStatement)) != 0) {
+        asm_error(as, line, line_start, keyword, "메모리 부족");
+        return NULL;
+    }
+    if (as->location + size > as->capacity) {
+        asm_error(as, line, line_start, keyword, "출력 범위(%zu바이트)를 넘었습니다: 주소 %zu",
+                  as->capacity, as->location);
+        as->location += size;
+        return NULL;
+    }
+
+    AsmStatement *statement = &as->statements[as->statement_count++];
+    statement->kind = (uint8_t)kind;
+    statement->first = ISA_INVALID;
+    statement->line = line;
+    statement->line_start = line_start;
+    statement->keyword = keyword;
+    statement->operand_index = 0;
+    statement->operand_count = 0;
+    statement->address = as->location;
+    as->location += size;
+    if (as->location > as->result->size) {
+        as->result->size = as->location;
+    }
+    return statement;
+}
+
+/*
+ * @brief .org/.byte/.equ 지시어를 처리합니다
+ */
+static void process_directive(Assembler *as, unsigned line, uint32_t line_start, uint32_t start, uint32_t end) {
+    const char *source = as->source;
+    uint32_t p = start + 1;
+    uint32_t name_end = p;
+    AsmStatement at = { .line = line, .line_start = line_start };
+    size_t first_operand = as->operand_count;
+    char name[8];
+
+    while (name_end < end && is_ident_char(source[name_end])) name_end++;
+    uint32_t name_length = name_end - p;
+    if (name_length == 0 || name_length >= sizeof(name)) {
+        asm_error(as, line, line_start, start, "알 수 없는 지시어: %.*s", (int)(name_end - start), source + start);
+        return;
+    }
+    for (uint32_t i = 0; i < name_length; i++) {
+        name[i] = to_upper(source[p + i]);
+    }
+    name[name_length] = '\0';
+
+    int count = split_operands(as, line, line_start, name_end, end);
+    if (count < 0) {
+        return;
+    }
+    AsmSlice *args = &as->operands[first_operand];
+
+    if (strcmp(name, "ORG") == 0) {
+        long address;
+        if (count != 1) {
+            asm_error(as, line, line_start, start, ".org에는 주소 하나가 필요합니다");
+        } else if (eval_expression(as, &at, args[0], &address) == 0) {
+            if (address < 0 || (size_t)address > as->capacity) {
+                asm_error(as, line, line_start, args[0].offset, ".org 주소 범위 오류 (0-%zu): %ld",
+                          as->capacity, address);
+            } else {
+                as->location = (size_t)address;
+                as->sets_origin = 1;
+            }
+        }
+        as->operand_count = first_operand;
+    } else if (strcmp(name, "EQU") == 0) {
+        long value;
+        uint32_t name_length_end = args[0].offset;
+        while (name_length_end < args[0].offset + args[0].length && is_ident_char(source[name_length_end])) {
+            name_length_end++;
+        }
+        if (count != 2 || !is_ident_start(source[args[0].offset]) ||
+            name_length_end != args[0].offset + args[0].length) {
+            asm_error(as, line, line_start, start, "형식: .equ 이름, 식");
+        } else if (eval_expression(as, &at, args[1], &value) == 0) {
+            int defined = symbol_define(as, args[0].offset, args[0].length, value, 0);
+            if (defined > 0) {
+                asm_error(as, line, line_start, args[0].offset, "중복 정의된 심볼: %.*s",
+                          (int)args[0].length, source + args[0].offset);
+            } else if (defined < 0) {
+                asm_error(as, line, line_start, args[0].offset, "메모리 부족");
+            }
+        }
+        as->operand_count = first_operand;
+    } else if (strcmp(name, "BYTE") == 0) {
+        if (count == 0) {
+            asm_error(as, line, line_start, start, ".byte에는 값이 하나 이상 필요합니다");
+            return;
+        }
+        AsmStatement *statement = push_statement(as, ASM_STMT_BYTE, line, line_start, start, (size_t)count);
+        if (!statement) {
+            as->operand_count = first_operand;
+            return;
+        }
+        statement->operand_index = (uint32_t)first_operand;
+        statement->operand_count = (uint32_t)count;
+        as->result->data_bytes += (unsigned)count;
+    } else {
+        asm_error(as, line, line_start, start, "알 수 없는 지시어: .%s", name);
+        as->operand_count = first_operand;
+    }
+}
+
+/*
+ * @brief 주석을 뗀 줄 하나를 분석합니다
+ */
+static void process_line(Assembler *as, unsigned line, uint32_t line_start, uint32_t end) {
+    const char *source = as->source;
+    uint32_t p = line_start;
+
+    // 라벨 (여러 개 가능)
+    for (;;) {
+        while (p < end && is_space(source[p])) p++;
+        if (p >= end || !is_ident_start(source[p])) {
+            break;
+        }
+        uint32_t name_end = p;
+        while (name_end < end && is_ident_char(source[name_end])) name_end++;
+        uint32_t colon = name_end;
+        while (colon < end && is_space(source[colon])) colon++;
+        if (colon >= end || source[colon] != ':') {
+            break;
+        }
+
+        int defined = symbol_define(as, p, name_end - p, (long)as->location, 1);
+        if (defined > 0) {
+            asm_error(as, line, line_start, p, "중복 정의된 심볼: %.*s", (int)(name_end - p), source + p);
+        } else if (defined < 0) {
+            asm_error(as, line, line_start, p, "메모리 부족");
+            return;
+        }
+        p = colon + 1;
+    }
+
+    if (p >= end) {
+        return;
+    }
+    if (source[p] == '.') {
+        process_directive(as, line, line_start, p, end);
+        return;
+    }
+    if (!is_ident_start(source[p])) {
+        asm_error(as, line, line_start, p, "명령어가 필요합니다: '%c'", source[p]);
+        return;
+    }
+
+    // 니모닉 → ISA 테이블 (대문자로 바꿔 완전 해시 조회)
+    char mnemonic[ASM_MNEMONIC_MAX + 1];
+    uint32_t mnemonic_end = p;
+    while (mnemonic_end < end && is_ident_char(source[mnemonic_end])) mnemonic_end++;
+    uint32_t mnemonic_length = mnemonic_end - p;
+    IsaId first = ISA_INVALID;
+    if (mnemonic_length <= ASM_MNEMONIC_MAX) {
+        for (uint32_t i = 0; i < mnemonic_length; i++) {
+            mnemonic[i] = to_upper(source[p + i]);
+        }
+        mnemonic[mnemonic_length] = '\0';
+        first = isa_lookup(mnemonic);
+    }
+    if (first == ISA_INVALID) {
+        asm_error(as, line, line_start, p, "알 수 없는 명령어: %.*s", (int)mnemonic_length, source + p);
+        return;
+    }
+
+    size_t first_operand = as->operand_count;
+    int count = split_operands(as, line, line_start, mnemonic_end, end);
+    if (count < 0) {
+        return;
+    }
+    if (count > 2) {
+        asm_error(as, line, line_start, as->operands[first_operand + 2].offset, "피연산자가 너무 많습니다");
+        as->operand_count = first_operand;
+        return;
+    }
+
+    AsmStatement *statement = push_statement(as, ASM_STMT_INSN, line, line_start, p, 2);
+    if (!statement) {
+        as->operand_count = first_operand;
+        return;
+    }
+    statement->first = (uint8_t)first;
+    statement->operand_index = (uint32_t)first_operand;
+    statement->operand_count = (uint32_t)count;
+    as->result->instructions++;
+}
+
+/*
+ * @brief 1패스: 버퍼 전체를 줄 단위로 훑습니다
+ */
+static void first_pass(Assembler *as) {
+    const char *source = as->source;
+    size_t length = as->length;
+    size_t pos = 0;
+    unsigned line = 1;
+
+    while (pos < length) {
+        const char *newline = memchr(source + pos, '\n', length - pos);
+        size_t line_end = newline ? (size_t)(newline - source) : length;
+        size_t content_end = pos;
+
+        // 주석 앞까지가 내용
+        while (content_end < line_end && source[content_end] != ';' && source[content_end] != '#') {
+            content_end++;
+        }
+        if (content_end == line_end && content_end > pos && source[content_end - 1] == '\r') {
+            content_end--;
+        }
+
+        process_line(as, line, (uint32_t)pos, (uint32_t)content_end);
+        pos = line_end + 1;
+        line++;
+    }
+    as->result->lines = line - 1;
+}
+
+/* ---------------- 2패스: 인코딩 ---------------- */
+
+static void second_pass(Assembler *as) {
+    for (size_t i = 0; i < as->statement_count; i++) {
+        const AsmStatement *statement = &as->statements[i];
+        const AsmSlice *args = &as->operands[statement->operand_index];
+        uint8_t *out = as->output + (statement->address - as->origin);
+
+        if (statement->kind == ASM_STMT_BYTE) {
+            for (uint32_t j = 0; j < statement->operand_count; j++) {
+                long value;
+                if (eval_expression(as, statement, args[j], &value) != 0) {
+                    continue;
+                }
+                if (value < -128 || value > 255) {
+                    asm_error(as, statement->line, statement->line_start, args[j].offset,
+                              ".byte 값 범위 오류 (-128-255): %ld", value);
+                    continue;
+                }
+                out[j] = (uint8_t)value;
+            }
+            continue;
+        }
+
+        IsaOperand operands[2] = { { ISA_OPND_NONE, 0 }, { ISA_OPND_NONE, 0 } };
+        int resolved = 1;
+        for (uint32_t j = 0; j < statement->operand_count; j++) {
+            if (resolve_operand(as, statement, args[j], &operands[j]) != 0) {
+                resolved = 0;
+            }
+        }
+        if (!resolved) {
+            continue;
+        }
+
+        char error[ASM_ERROR_LENGTH];
+        uint16_t word;
+        if (isa_encode_operands((IsaId)statement->first, &operands[0], &operands[1], &word,
+                                error, sizeof(error)) != 0) {
+            asm_error(as, statement->line, statement->line_start, statement->keyword, "%s", error);
+            continue;
+        }
+        out[0] = (uint8_t)(word >> 8);
+        out[1] = (uint8_t)(word & 0xFF);
+    }
+}
+
+/*
+ * @brief 두 패스를 돌립니다 (심볼/문장 배열은 호출자가 assembler_free로 해제)
+ */
+static void assemble_source(Assembler *as, const char *source, size_t length, uint8_t *output, size_t capacity,
+                            AsmResult *result) {
+    memset(result, 0, sizeof(*result));
+    memset(as, 0, sizeof(*as));
+    as->source = source;
+    as->length = length;
+    as->output = output;
+    as->capacity = capacity;
+    as->result = result;
+
+    if (length > UINT32_MAX) {
+        asm_error(as, 1, 0, 0, "소스가 너무 큽니다 (%zu바이트)", length);
+        return;
+    }
+
+    isa_init();
+    as->symbols = calloc(ASM_SYMBOLS_INITIAL, sizeof(AsmSymbol));
+    if (!as->symbols) {
+        asm_error(as, 1, 0, 0, "메모리 부족");
+        return;
+    }
+    as->symbol_capacity = ASM_SYMBOLS_INITIAL;
+
+    first_pass(as);
+    memset(output, 0, result->size);
+    second_pass(as);
+    result->symbols = as->symbol_count;
+}
+
+static void assembler_free(Assembler *as) {
+    free(as->symbols);
+    free(as->statements);
+    free(as->operands);
+}
+
+/*
+ * @brief 소스를 기계어 이미지로 어셈블합니다
+ * @param source 소스 버퍼 (NUL 종료가 아니어도 됨)
+ * @param length 소스 길이
+ * @param output 출력 이미지 (주소 = 오프셋)
+ * @param capacity output 크기
+ * @param result 결과와 오류 목록
+ * @returns 오류가 없으면 0, 있으면 -1
+ *
+ * @details
+ * 1패스 오류가 있어도 2패스까지 진행해 가능한 많은 오류를 한 번에 보고합니다.
+ */
+int asm_assemble(const char *source, size_t length, uint8_t *output, size_t capacity, AsmResult *result) {
+    Assembler as;
+
+    assemble_source(&as, source, length, output, capacity, result);
+    assembler_free(&as);
+    return result->error_count ? -1 : 0;
+}
+
+/* ---------------- 이미지 출력 ---------------- */
+
+/* 문장이 차지하는 주소 범위 (세그먼트 병합용) */
+typedef struct {
+    size_t start;
+    size_t end;
+} AsmRange;
+
+static int compare_ranges(const void *a, const void *b) {
+    const AsmRange *left = a;
+    const AsmRange *right = b;
+    return (left->start > right->start) - (left->start < right->start);
+}
+
+static int compare_symbols(const void *a, const void *b) {
+    const ImageSymbolSpec *left = a;
+    const ImageSymbolSpec *right = b;
+    return (left->name > right->name) - (left->name < right->name);
+}
+
+/*
+ * @brief 문장 주소 범위를 정렬/병합해 세그먼트를 만듭니다 (.org로 생긴 빈 곳은 세그먼트에서 빠짐)
+ * @returns 성공 시 0, 메모리 부족 시 -1
+ */
+static int build_segments(const Assembler *as, ImageSpec *spec) {
+    AsmRange *ranges = malloc((as->statement_count + 1) * sizeof(AsmRange));
+    ImageSegmentSpec *segments = NULL;
+    size_t range_count = 0;
+    unsigned segment_count = 0;
+
+    if (!ranges) {
+        return -1;
+    }
+    for (size_t i = 0; i < as->statement_count; i++) {
+        const AsmStatement *statement = &as->statements[i];
+        size_t size = statement->kind == ASM_STMT_BYTE ? statement->operand_count : 2;
+        if (size) {
+            ranges[range_count].start = statement->address;
+            ranges[range_count].end = statement->address + size;
+            range_count++;
+        }
+    }
+    qsort(ranges, range_count, sizeof(AsmRange), compare_ranges);
+
+    // 이어지거나 겹치는 범위를 합침 (세그먼트 크기는 16비트이므로 넘치면 나눔)
+    size_t merged = 0;
+    for (size_t i = 0; i < range_count; i++) {
+        AsmRange *last = merged ? &ranges[merged - 1] : NULL;
+        size_t end = last && ranges[i].end < last->end ? last->end : ranges[i].end;
+        if (last && ranges[i].start <= last->end && end - last->start <= UINT16_MAX) {
+            last->end = end;
+        } else {
+            ranges[merged++] = ranges[i];
+        }
+    }
+
+    if (merged) {
+        segments = malloc(merged * sizeof(ImageSegmentSpec));
+        if (!segments) {
+            free(ranges);
+            return -1;
+        }
+    }
+    for (size_t i = 0; i < merged; i++) {
+        segments[segment_count].address = (uint16_t)ranges[i].start;
+        segments[segment_count].size = (uint16_t)(ranges[i].end - ranges[i].start);
+        segments[segment_count].data = as->output + ranges[i].start;
+        segment_count++;
+    }
+    free(ranges);
+
+    spec->segments = segments;
+    spec->segment_count = segment_count;
+    return 0;
+}
+
+/*
+ * @brief 심볼 테이블을 소스 순서로 복사합니다 (이름은 소스 버퍼를 가리킴)
+ * @returns 성공 시 0, 메모리 부족 시 -1
+ */
+static int build_symbols(const Assembler *as, ImageSpec *spec) {
+    ImageSymbolSpec *symbols = NULL;
+    unsigned count = 0;
+
+    if (as->symbol_count) {
+        symbols = malloc(as->symbol_count * sizeof(ImageSymbolSpec));
+        if (!symbols) {
+            return -1;
+        }
+    }
+    for (uint32_t i = 0; i < as->symbol_capacity; i++) {
+        const AsmSymbol *symbol = &as->symbols[i];
+        if (symbol->length) {
+            symbols[count].name = as->source + symbol->name;
+            symbols[count].length = symbol->length;
+            symbols[count].value = symbol->value;
+            count++;
+        }
+    }
+    if (count) {
+        qsort(symbols, count, sizeof(ImageSymbolSpec), compare_symbols);
+    }
+
+    spec->symbols = symbols;
+    spec->symbol_count = count;
+    return 0;
+}
+
+/*
+ * @brief 소스를 어셈블하고 image_write()에 넘길 이미지 명세를 만듭니다
+ * @param source 소스 버퍼 (심볼 이름이 가리키므로 spec을 쓰는 동안 유지)
+ * @param length 소스 길이
+ * @param output 출력 이미지 (세그먼트 데이터가 가리키므로 spec을 쓰는 동안 유지)
+ * @param capacity output 크기 (65536 이하)
+ * @param spec 세그먼트/심볼/진입점 (asm_image_free로 해제)
+ * @param result 결과와 오류 목록
+ * @returns 오류가 없으면 0, 있으면 -1 (spec은 비어 있음)
+ *
+ * @details
+ * 세그먼트는 실제로 쓴 주소 범위만 담고, 진입 PC는 첫 명령어의 주소입니다.
+ * 어셈블러 문법에는 초기 레지스터 값이 없으므로 has_registers는 0입니다.
+ */
+int asm_assemble_image(const char *source, size_t length, uint8_t *output, size_t capacity,
+                       ImageSpec *spec, AsmResult *result) {
+    Assembler as;
+
+    memset(spec, 0, sizeof(*spec));
+    if (capacity > 0x10000) {
+        capacity = 0x10000;   // 이미지 주소는 16비트
+    }
+    assemble_source(&as, source, length, output, capacity, result);
+
+    if (!result->error_count) {
+        for (size_t i = 0; i < as.statement_count; i++) {
+            if (as.statements[i].kind == ASM_STMT_INSN) {
+                spec->entry_pc = (uint16_t)as.statements[i].address;
+                break;
+            }
+        }
+        if (build_segments(&as, spec) != 0 || build_symbols(&as, spec) != 0) {
+            asm_error(&as, 1, 0, 0, "메모리 부족");
+            asm_image_free(spec);
+        }
+    }
+
+    assembler_free(&as);
+    return result->error_count ? -1 : 0;
+}
+
+/*
+ * @brief asm_assemble_image가 만든 배열을 해제합니다
+ * @param spec 이미지 명세
+ * @returns 없음 (void)
+ */
+void asm_image_free(ImageSpec *spec) {
+    free((void *)spec->segments);
+    free((void *)spec->symbols);
+    memset(spec, 0, sizeof(*spec));
+}
+
+/*
+ * @brief 줄 하나를 주어진 주소에 어셈블합니다 (줄바꿈 없는 한 줄)
+ * @param text 줄 내용
+ * @param length 줄 길이
+ * @param address 줄이 시작하는 주소
+ * @param capacity 이미지 크기
+ * @param hooks 심볼 훅
+ * @param output 줄의 바이트 (length바이트 이상)
+ * @param result 크기, 다음 주소, 첫 오류
+ * @returns 오류가 없으면 0, 있으면 -1
+ *
+ * @details
+ * 문장은 줄마다 하나뿐이므로 출력은 length바이트를 넘지 않습니다 (".byte 1"도 7글자).
+ * 심볼 테이블을 만들지 않고 문장/피연산자 배열도 스택에 두므로, 긴 .byte 줄이 아니면 힙을 쓰지 않습니다.
+ */
+int asm_assemble_line(const char *text, size_t length, size_t address, size_t capacity,
+                      const AsmSymbolHooks *hooks, uint8_t *output, AsmLineResult *result) {
+    AsmResult line_result;
+    AsmStatement statement;
+    AsmSlice operand_buffer[ASM_LINE_OPERANDS];
+    AsmSlice *operands = operand_buffer;
+    size_t operand_capacity = (length + 1) / 2 + 1;   /* 피연산자는 최소 1글자 + ',' */
+    Assembler as;
+
+    memset(result, 0, sizeof(*result));
+    memset(&line_result, 0, sizeof(line_result));
+    memset(&as, 0, sizeof(as));
+    as.source = text;
+    as.length = length;
+    as.output = output;
+    as.capacity = capacity;
+    as.result = &line_result;
+    as.origin = address;
+    as.location = address;
+    as.hooks = hooks;
+
+    // 문장은 하나, 피연산자는 줄 길이로 상한이 정해지므로 배열이 자라지 않게 미리 잡아 둡니다
+    if (operand_capacity > ASM_LINE_OPERANDS) {
+        operands = malloc(operand_capacity * sizeof(AsmSlice));
+    } else {
+        operand_capacity = ASM_LINE_OPERANDS;
+    }
+    as.statements = &statement;
+    as.statement_capacity = 1;
+    as.operands = operands;
+    as.operand_capacity = operand_capacity;
+
+    if (!operands) {
+        asm_error(&as, 1, 0, 0, "메모리 부족");
+    } else if (length > UINT32_MAX) {
+        asm_error(&as, 1, 0, 0, "줄이 너무 깁니다 (%zu바이트)", length);
+    } else {
+        isa_init();
+        first_pass(&as);
+        if (!as.sets_origin) {
+            memset(output, 0, as.location - address);
+        }
+        second_pass(&as);
+    }
+
+    result->sets_origin = as.sets_origin;
+    result->size = as.sets_origin ? 0 : as.location - address;
+    result->next = as.location;
+    result->error_count = line_result.error_count;
+    if (line_result.error_count) {
+        result->error = line_result.errors[0];
+    }
+
+    if (operands != operand_buffer) {
+        free(operands);
+    }
+    return line_result.error_count ? -1 : 0;
+}
+
+/*
+ * @brief 오류를 "줄:열: 메시지" 형식으로 출력합니다
+ * @param result 어셈블 결과
+ * @returns 없음 (void)
+ */
+void asm_print_errors(const AsmResult *result) {
+    unsigned shown = result->error_count < ASM_MAX_ERRORS ? result->error_count : ASM_MAX_ERRORS;
+
+    for (unsigned i = 0; i < shown; i++) {
+        printf("❌ %u:%u: %s\n", result->errors[i].line, result->errors[i].column, result->errors[i].message);
+    }
+    if (result->error_count > shown) {
+        printf("❌ ... 오류 %u개 더\n", result->error_count - shown);
+    }
+}
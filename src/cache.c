@@ -24,9 +24,11 @@ typedef struct {
  */
 static inline AddressInfo decode_address(uint16_t address) {
     AddressInfo info;
-    info.index = address % CACHE_NUM_LINES; // 캐시 라인 인덱스
+    // 블록 번호(address / 라인 크기)로 라인을 고르고 나머지를 태그로 사용해야
+    // 같은 블록이 여러 라인에 중복 적재되지 않고 write-back 주소(base)와도 일치함
     info.offset = address % CACHE_LINE_SIZE; // 블록 내부 오프셋
-    info.tag = address / CACHE_NUM_LINES; // 태그 필드 (캐시 라인 외부 정보)
+    info.index = (address / CACHE_LINE_SIZE) % CACHE_NUM_LINES; // 캐시 라인 인덱스
+    info.tag = address / (CACHE_LINE_SIZE * CACHE_NUM_LINES); // 태그 필드 (캐시 라인 외부 정보)
     return info;
 }
 
@@ -54,11 +56,48 @@ void cache_flush(Cache *cache, uint8_t *memory, size_t mem_size) {
             if (base + CACHE_LINE_SIZE <= mem_size) {
                 memcpy(&memory[base], l->block, CACHE_LINE_SIZE);
             }
+            cache->stats.writebacks++;
         }
         memset(l, 0, sizeof(*l)); // 비우기
     }
 }
 
+/*
+ * @brief 주소 범위를 담은 캐시 라인만 메모리에 반영하고 비웁니다
+ * @param cache 사용할 캐시 구조체 포인터
+ * @param memory 전체 메모리 배열 포인터
+ * @param mem_size 메모리의 크기 (바이트 단위)
+ * @param address 범위 시작 주소
+ * @param size 범위 크기 (바이트)
+ * @returns 없음 (void)
+ *
+ * @details
+ * 메모리를 캐시 밖에서 직접 고치기 전에 호출하면 범위 밖 라인은 그대로 두고도
+ * 고친 바이트의 옛 값이 캐시에 남지 않습니다.
+ */
+void cache_invalidate_range(Cache *cache, uint8_t *memory, size_t mem_size, uint16_t address, size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    size_t last = ((size_t)address + size - 1) / CACHE_LINE_SIZE;
+    for (size_t block = address / CACHE_LINE_SIZE; block <= last; block++) {
+        AddressInfo a = decode_address((uint16_t)(block * CACHE_LINE_SIZE));
+        CacheLine *l = &cache->lines[a.index];
+        if (!l->valid || l->tag != a.tag) {
+            continue;
+        }
+        if (l->dirty) {
+            size_t base = block * CACHE_LINE_SIZE;
+            if (base + CACHE_LINE_SIZE <= mem_size) {
+                memcpy(&memory[base], l->block, CACHE_LINE_SIZE);
+            }
+            cache->stats.writebacks++;
+        }
+        memset(l, 0, sizeof(*l));
+    }
+}
+
 /*
  * @brief 캐시에서 데이터를 읽습니다 (Write-Back + Write-Allocate 방식)
  * @param cache 사용할 캐시 구조체 포인터
@@ -73,8 +112,10 @@ uint8_t cache_read(Cache *cache, uint8_t *memory, size_t mem_size, uint16_t addr
 
     // 유효한 캐시이다 
     if(line->valid && line->tag == a.tag) {
+        cache->stats.hits++;
         return line->block[a.offset];
     }
+    cache->stats.misses++;
 
     // 미스 → 메모리에 있는 값보다 캐시가 더 최신 상태 -> 메모리에 반영
     if(line->valid && line->dirty) {
@@ -82,6 +123,7 @@ uint8_t cache_read(Cache *cache, uint8_t *memory, size_t mem_size, uint16_t addr
         if(base + CACHE_LINE_SIZE <= mem_size) {
             memcpy(&memory[base], line->block, CACHE_LINE_SIZE);
         }
+        cache->stats.writebacks++;
     }
 
     /* 
@@ -119,6 +161,8 @@ void cache_write(Cache *cache, uint8_t *memory, size_t mem_size, uint16_t addres
 
     // 캐시에 해당 블록이 없거나(tag 불일치) 유효하지 않은 경우
     if(!(line->valid && line->tag == a.tag)) {
+        cache->stats.misses++;
+
         // 기존 캐시 블록이 유효하고, 수정된 상태(dirty)면 → 메모리에 반영 (Write-Back)
         if(line->valid && line->dirty) {
             uint16_t base = (line->tag * CACHE_NUM_LINES + a.index) * CACHE_LINE_SIZE;
@@ -127,6 +171,7 @@ void cache_write(Cache *cache, uint8_t *memory, size_t mem_size, uint16_t addres
             if(base + CACHE_LINE_SIZE <= mem_size) {
                 memcpy(&memory[base], line->block, CACHE_LINE_SIZE);
             }
+            cache->stats.writebacks++;
         }
 
         // 새로운 메모리 블록을 캐시에 로드 (Write-Allocate)
@@ -140,9 +185,30 @@ void cache_write(Cache *cache, uint8_t *memory, size_t mem_size, uint16_t addres
         line->tag = a.tag;
         line->valid = 1;
         line->dirty = 0; // 아직 메모리에 반영 안 했으므로 false로 초기화
+    } else {
+        cache->stats.hits++;
     }
 
     // 값을 캐시에 기록
     line->block[a.offset] = value;
     line->dirty = 1; // 이후에 Write-Back 필요하므로 dirty 플래그 설정
-};
\ No newline at end of file
+}
+
+/*
+ * @brief 캐시 상태를 바꾸지 않고 주소의 최신 값을 확인합니다 (UI/디버깅용)
+ * @param cache 사용할 캐시 구조체 포인터
+ * @param memory 전체 메모리 배열 포인터
+ * @param mem_size 메모리의 크기 (바이트 단위)
+ * @param address 확인할 주소
+ * @returns 캐시에 적재된 값이 있으면 그 값, 없으면 메모리 값
+ */
+uint8_t cache_peek(const Cache *cache, const uint8_t *memory, size_t mem_size, uint16_t address) {
+    AddressInfo a = decode_address(address);
+    const CacheLine *line = &cache->lines[a.index];
+
+    // write-back 캐시이므로 dirty 라인의 값이 메모리보다 최신
+    if(line->valid && line->tag == a.tag) {
+        return line->block[a.offset];
+    }
+    return (address < mem_size) ? memory[address] : 0;
+}
@@ -1,18 +1,25 @@
 //레지스터에 저장--> alu연산-->pc값증가-->메모리에 저장
 
 #include "include/cpu.h"
+#include "include/simd.h"
+#include "include/trace.h"
+#include "include/profiler.h"
 #include "include/register.h"
 #include "include/memory.h"
 #include "include/alu.h"
 #include "include/cache.h"
 #include "include/instruction.h"
+#include "include/isa.h"
+#include "include/log.h"
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
 
-// 전역 변수들 선언
-CPU_Registers regs;
-Memory memory;
+// 기본 CPU 컨텍스트 (서버/단일 스레드 실행용)
+static CPU_Context default_ctx = { .mode = CPU_MODE_DETAILED, .saved_log_enabled = 1 };
+
+// 스레드마다 자신이 실행 중인 컨텍스트를 가리킴 (샘플링 워커 등 병렬 실행용)
+static CPU_THREAD_LOCAL CPU_Context *current_ctx = &default_ctx;
 
 // ALU 핸들러 테이블 전역 변수 (instruction.c에서 정의됨)
 extern alu_handler handler_table[4];
@@ -20,23 +27,67 @@ extern alu_handler handler_table[4];
 // CPU 상태 변수
 static int cpu_initialized = 0;
 
+// 실행 로그 출력 여부 (include/log.h)
+CPU_THREAD_LOCAL int cpu_log_enabled = 1;
+
+/*
+ * @brief CPU 컨텍스트를 리셋 직후 상태로 초기화합니다
+ * @param ctx 초기화할 컨텍스트
+ * @returns 없음 (void)
+ */
+void cpu_context_init(CPU_Context *ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    reset_registers(&ctx->regs);
+    init_memory(&ctx->memory);
+    cache_init(&ctx->memory.cache);
+    ctx->mode = CPU_MODE_DETAILED;
+    ctx->saved_log_enabled = 1;
+}
+
+/*
+ * @brief 현재 스레드가 실행 중인 CPU 컨텍스트를 반환합니다
+ * @param 없음
+ * @returns 현재 컨텍스트 포인터
+ */
+CPU_Context* cpu_get_context(void) {
+    return current_ctx;
+}
+
+/*
+ * @brief 현재 스레드가 사용할 CPU 컨텍스트를 바꿉니다
+ * @param ctx 사용할 컨텍스트 (NULL이면 기본 컨텍스트)
+ * @returns 이전에 사용하던 컨텍스트 포인터
+ *
+ * @details
+ * cpu_step() 등 모든 코어 함수는 현재 스레드의 컨텍스트에서 동작하므로,
+ * 스레드마다 다른 컨텍스트를 지정하면 잠금 없이 병렬로 실행할 수 있습니다.
+ */
+CPU_Context* cpu_set_context(CPU_Context *ctx) {
+    CPU_Context *previous = current_ctx;
+    current_ctx = ctx ? ctx : &default_ctx;
+    return previous;
+}
+
 /*
  * @brief CPU를 초기화합니다
  * @param 없음
  * @returns 없음 (void)
  */
 void cpu_init(void) {
+    CPU_Context *ctx = current_ctx;
+
     if (!cpu_initialized) {
         // 메모리 초기화
-        init_memory(&memory);
-        cache_init(&memory.cache);
+        init_memory(&ctx->memory);
+        cache_init(&ctx->memory.cache);
         
         // 레지스터 초기화
-        reset_registers(&regs);
-        regs.pc = 0;
+        reset_registers(&ctx->regs);
+        ctx->regs.pc = 0;
         
-        // ALU 핸들러 테이블 초기화
+        // ALU 핸들러 테이블과 ISA 디코드 테이블 초기화
         init_handler_table();
+        isa_init();
         
         cpu_initialized = 1;
     }
@@ -48,10 +99,17 @@ void cpu_init(void) {
  * @returns 없음 (void)
  */
 void cpu_reset(void) {
-    reset_registers(&regs);
-    regs.pc = 0;
-    init_memory(&memory);
-    cache_init(&memory.cache);
+    CPU_Context *ctx = current_ctx;
+
+    if (ctx->mode != CPU_MODE_DETAILED) {
+        cpu_log_enabled = ctx->saved_log_enabled;
+        ctx->mode = CPU_MODE_DETAILED;
+    }
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    reset_registers(&ctx->regs);
+    ctx->regs.pc = 0;
+    init_memory(&ctx->memory);
+    cache_init(&ctx->memory.cache);
 }
 
 /*
@@ -61,203 +119,276 @@ void cpu_reset(void) {
  * @returns 없음 (void)
  */
 void cpu_load_program(const uint8_t* program, size_t size) {
+    CPU_Context *ctx = current_ctx;
+
     if (size <= MEMORY_SIZE) {
-        memcpy(memory.data, program, size);
+        // 캐시에 남은 이전 값이 새 프로그램을 가리지 않도록 먼저 반영 후 비움
+        cache_flush(&ctx->memory.cache, ctx->memory.data, MEMORY_SIZE);
+        memcpy(ctx->memory.data, program, size);
     }
 }
 
+/*
+ * @brief 실행 상태를 유지한 채 메모리 일부를 교체합니다 (에디터 증분 적재)
+ * @param address 시작 주소
+ * @param bytes 새 바이트
+ * @param size 바이트 수
+ * @returns 없음 (void)
+ */
+void cpu_patch_program(uint16_t address, const uint8_t* bytes, size_t size) {
+    CPU_Context *ctx = current_ctx;
+
+    if ((size_t)address + size <= MEMORY_SIZE) {
+        // 고칠 범위의 캐시 라인만 반영 후 비워 옛 명령어 바이트가 페치되지 않게 함
+        cache_invalidate_range(&ctx->memory.cache, ctx->memory.data, MEMORY_SIZE, address, size);
+        memcpy(&ctx->memory.data[address], bytes, size);
+    }
+}
+
+/*
+ * @brief 바이너리 이미지를 적재합니다
+ * @param image image_open/image_view로 검사를 마친 이미지
+ * @returns 성공 시 0, 세그먼트가 메모리를 벗어나면 -1 (CPU는 그대로)
+ *
+ * @details
+ * 세그먼트 데이터는 파일 매핑에서 게스트 메모리로 바로 복사하며, 중간 버퍼나 파싱이 없습니다.
+ */
+int cpu_load_image(const ProgramImage *image) {
+    CPU_Context *ctx = current_ctx;
+    const ImageHeader *header = image->header;
+
+    for (unsigned i = 0; i < header->segment_count; i++) {
+        if ((size_t)image->segments[i].address + image->segments[i].size > MEMORY_SIZE) {
+            return -1;
+        }
+    }
+    if (header->entry_pc >= MEMORY_SIZE) {
+        return -1;
+    }
+
+    cpu_reset();
+    for (unsigned i = 0; i < header->segment_count; i++) {
+        memcpy(&ctx->memory.data[image->segments[i].address], image_segment_data(image, i),
+               image->segments[i].size);
+    }
+    if (header->flags & IMAGE_FLAG_REGISTERS) {
+        for (uint8_t r = 1; r < IMAGE_REGISTERS; r++) {
+            set_register(&ctx->regs, r, header->registers[r]);
+        }
+    }
+    ctx->regs.pc = header->entry_pc;
+    return 0;
+}
+
 /*
  * @brief 현재 PC 위치에서 명령어를 패치합니다
  * @param 없음
  * @returns 패치된 16비트 명령어
  */
 uint16_t fetch_instruction(void) {
-    if (regs.pc >= MEMORY_SIZE - 1) {
+    CPU_Context *ctx = current_ctx;
+
+    if (ctx->regs.pc >= MEMORY_SIZE - 1) {
         return 0; // 메모리 범위 초과
     }
     
-    uint16_t inst = (memory_read(&memory, regs.pc) << 8) | memory_read(&memory, regs.pc + 1);
+    uint16_t inst = (memory_read(&ctx->memory, ctx->regs.pc) << 8) | memory_read(&ctx->memory, ctx->regs.pc + 1);
     return inst;
 }
 
 /*
- * @brief 명령어를 디코드하고 실행합니다
- * @param instruction 실행할 16비트 명령어
- * @returns 없음 (void)
+ * @brief 디버그 로그용 전체 레지스터 상태를 출력합니다
  */
-void decode_and_execute(uint16_t instruction) {
-    // 4비트 opcode 추출
-    uint8_t opcode = (instruction >> 12) & 0xF;
+static void log_registers(CPU_Context *ctx) {
+    if (cpu_log_enabled) {
+        printf("전체 레지스터 상태:\n");
+        for (int i = 1; i <= 7; i++) {
+            printf("  R%d = %d\n", i, get_register(&ctx->regs, i));
+        }
+    }
+}
 
-    printf("\n=== 명령어 디코딩 ===\n");
-    printf("바이트: 0x%04X -> opcode=%d\n", instruction, opcode);
+static const char alu_symbols[4] = { '+', '-', '*', '/' };
 
-    // 🎯 MOV 명령어 특별 처리
-    if (opcode == 4) {
-        // MOV 레지스터, 즉시값: 4비트 opcode + 4비트 레지스터 + 8비트 즉시값
-        uint8_t reg_num = (instruction >> 8) & 0xF;
-        uint8_t immediate_val = instruction & 0xFF;
-        
-        // 레지스터 번호가 1-7 범위인지 확인 (새로운 MOV 포맷)
-        if (reg_num >= 1 && reg_num <= 7) {
-            printf("🎯 새로운 MOV 포맷: R%d에 값 %d 저장\n", reg_num, immediate_val);
-            
-            // 레지스터에 값 저장
-            set_register(&regs, reg_num, immediate_val);
-            
-            // 저장 확인
-            uint8_t stored_value = get_register(&regs, reg_num);
-            printf("✅ MOV 완료: R%d = %d (저장됨!)\n", reg_num, stored_value);
-            
-            // 모든 레지스터 상태 출력 (디버깅용)
-            printf("전체 레지스터 상태:\n");
-            for (int i = 1; i <= 7; i++) {
-                printf("  R%d = %d\n", i, get_register(&regs, i));
-            }
-            
-            regs.pc += 2;
-            printf("PC: %d\n", regs.pc);
-            printf("====================\n\n");
-            return;
-        }
-        // 기존 MOV 포맷으로 처리 (메모리 주소)
-        else {
-            printf("📊 기존 MOV 포맷으로 처리\n");
-        }
+// 🚀 ADD/SUB/MUL/DIV 레지스터 포맷: R7 = R[r1] op R[r2]
+static void exec_alu_rr(CPU_Context *ctx, uint16_t instruction) {
+    uint8_t opcode = instruction >> 12;
+    uint8_t reg1_num = (instruction >> 8) & 0xF;
+    uint8_t reg2_num = (instruction >> 4) & 0xF;
+    uint8_t operand1 = get_register(&ctx->regs, reg1_num);
+    uint8_t operand2 = get_register(&ctx->regs, reg2_num);
+
+    CPU_LOG("🚀 ALU 레지스터 포맷: R%d(%d) %c R%d(%d)\n", reg1_num, operand1, alu_symbols[opcode],
+            reg2_num, operand2);
+
+    uint8_t result = handler_table[opcode](operand1, operand2);
+    set_register(&ctx->regs, 7, result);
+
+    CPU_LOG("✅ ALU 완료: R7 = %d (결과 저장됨!)\n", result);
+    log_registers(ctx);
+}
+
+// 기존 6비트 즉시값 ALU 포맷: R1 = a, R2 = b, R7 = 결과, 메모리[70 + opcode] = 결과
+static void exec_alu_i6(CPU_Context *ctx, uint16_t instruction) {
+    uint8_t opcode = instruction >> 12;
+    uint8_t operand1 = (instruction >> 6) & 0x3F;
+    uint8_t operand2 = instruction & 0x3F;
+
+    uint8_t result = handler_table[opcode](operand1, operand2);
+
+    set_register(&ctx->regs, 1, operand1);  // R1 = 첫 번째 피연산자
+    set_register(&ctx->regs, 2, operand2);  // R2 = 두 번째 피연산자
+    set_register(&ctx->regs, 7, result);    // resultR = 결과
+
+    if (70 + opcode < MEMORY_SIZE) {
+        memory_write(&ctx->memory, 70 + opcode, result);
     }
-    
-    // 🚀 ADD/SUB/MUL/DIV 명령어 새로운 레지스터 포맷 처리
-    if (opcode >= 0 && opcode <= 3) {
-        uint8_t flag = instruction & 0xF;
-        
-        // 새로운 레지스터 포맷인지 확인 (플래그가 0xF)
-        if (flag == 0xF) {
-            uint8_t reg1_num = (instruction >> 8) & 0xF;
-            uint8_t reg2_num = (instruction >> 4) & 0xF;
-            
-            if (reg1_num >= 1 && reg1_num <= 7 && reg2_num >= 1 && reg2_num <= 7) {
-                printf("🚀 새로운 ALU 포맷: R%d %s R%d\n", reg1_num, 
-                       (opcode == 0) ? "+" : (opcode == 1) ? "-" : (opcode == 2) ? "*" : "/", reg2_num);
-                
-                // 레지스터에서 값 읽기
-                uint8_t operand1 = get_register(&regs, reg1_num);
-                uint8_t operand2 = get_register(&regs, reg2_num);
-                
-                printf("값: R%d(%d) %s R%d(%d)\n", reg1_num, operand1, 
-                       (opcode == 0) ? "+" : (opcode == 1) ? "-" : (opcode == 2) ? "*" : "/", reg2_num, operand2);
-                
-                // ALU 연산 수행
-                uint8_t result = handler_table[opcode](operand1, operand2);
-                
-                printf("결과: %d %s %d = %d\n", operand1, 
-                       (opcode == 0) ? "+" : (opcode == 1) ? "-" : (opcode == 2) ? "*" : "/", operand2, result);
-                
-                // 결과를 R7에 저장 (결과 레지스터)
-                set_register(&regs, 7, result);
-                
-                printf("✅ ALU 완료: R7 = %d (결과 저장됨!)\n", result);
-                
-                // 모든 레지스터 상태 출력 (디버깅용)
-                printf("전체 레지스터 상태:\n");
-                for (int i = 1; i <= 7; i++) {
-                    printf("  R%d = %d\n", i, get_register(&regs, i));
-                }
-                
-                regs.pc += 2;
-                printf("PC: %d\n", regs.pc);
-                printf("====================\n\n");
-                return;
-            }
+
+    CPU_LOG("✅ %s 연산: %d %c %d = %d\n", isa_table[isa_decode(instruction)].mnemonic,
+            operand1, alu_symbols[opcode], operand2, result);
+}
+
+// 🎯 MOV 레지스터, 즉시값
+static void exec_mov_ri(CPU_Context *ctx, uint16_t instruction) {
+    uint8_t reg_num = (instruction >> 8) & 0xF;
+    uint8_t immediate_val = instruction & 0xFF;
+
+    set_register(&ctx->regs, reg_num, immediate_val);
+    CPU_LOG("✅ MOV 완료: R%d = %d (저장됨!)\n", reg_num, immediate_val);
+    log_registers(ctx);
+}
+
+// 🗃️ 기존 MOV 포맷: 메모리[a] = b
+static void exec_mov_i6(CPU_Context *ctx, uint16_t instruction) {
+    uint8_t address = (instruction >> 6) & 0x3F;
+    uint8_t value = instruction & 0x3F;
+
+    memory_write(&ctx->memory, address, value);
+    CPU_LOG("✅ MOV 완료: 메모리[%d] = %d (저장됨!)\n", address, value);
+}
+
+/*
+ * @brief LOAD/STORE의 유효 주소를 계산합니다
+ * @returns 주소, 잘못된 레지스터면 -1
+ */
+static int memory_operand(CPU_Context *ctx, uint16_t instruction) {
+    uint8_t reg_num = (instruction >> 8) & 0x7;
+
+    if (reg_num < 1) {
+        CPU_LOG("❌ 잘못된 레지스터: R%d\n", reg_num);
+        return -1;
+    }
+    if ((instruction >> 8) & MEM_MODE_INDIRECT) {
+        // 레지스터 간접: 하위 4비트의 레지스터 값이 주소
+        uint8_t addr_reg = instruction & 0xF;
+        if (addr_reg < 1 || addr_reg > 7) {
+            CPU_LOG("❌ 잘못된 주소 레지스터: R%d\n", addr_reg);
+            return -1;
         }
+        CPU_LOG("주소: [R%d] = %d\n", addr_reg, get_register(&ctx->regs, addr_reg));
+        return get_register(&ctx->regs, addr_reg);
     }
+    return instruction & 0xFF;
+}
 
-    // 기존 방식: 4비트 opcode + 6비트 reg1 + 6비트 reg2
-    uint8_t reg1_val = (instruction >> 6) & 0x3F;
-    uint8_t reg2_val = instruction & 0x3F;
-
-    printf("기존 포맷: reg1=%d, reg2=%d\n", reg1_val, reg2_val);
+// 📦 LOAD: 모든 데이터 접근은 memory_read()/memory_write()로 캐시를 거침
+static void exec_load(CPU_Context *ctx, uint16_t instruction) {
+    uint8_t reg_num = (instruction >> 8) & 0x7;
+    int address = memory_operand(ctx, instruction);
 
-    uint8_t operand1, operand2;
-    
-    // 첫 번째 피연산자 해석
-    if (reg1_val >= 101 && reg1_val <= 107) {
-        // 레지스터 (R1=101, R2=102, ..., R7=107)
-        uint8_t reg_num = reg1_val - 100;
-        operand1 = get_register(&regs, reg_num);
-        printf("첫 번째: R%d (현재값=%d)\n", reg_num, operand1);
-    } else {
-        // 즉시값 또는 메모리 주소
-        operand1 = reg1_val;
-        printf("첫 번째: 즉시값/주소 %d\n", operand1);
+    if (address >= 0) {
+        uint8_t value = memory_read(&ctx->memory, (uint16_t)address);
+        set_register(&ctx->regs, reg_num, value);
+        CPU_LOG("✅ LOAD 완료: R%d = 메모리[%d] = %d\n", reg_num, address, value);
     }
-    
-    // 두 번째 피연산자 해석
-    if (reg2_val >= 101 && reg2_val <= 107) {
-        // 레지스터
-        uint8_t reg_num = reg2_val - 100;
-        operand2 = get_register(&regs, reg_num);
-        printf("두 번째: R%d (현재값=%d)\n", reg_num, operand2);
-    } else {
-        // 즉시값
-        operand2 = reg2_val;
-        printf("두 번째: 즉시값 %d\n", operand2);
+}
+
+// 📦 STORE
+static void exec_store(CPU_Context *ctx, uint16_t instruction) {
+    uint8_t reg_num = (instruction >> 8) & 0x7;
+    int address = memory_operand(ctx, instruction);
+
+    if (address >= 0) {
+        uint8_t value = get_register(&ctx->regs, reg_num);
+        memory_write(&ctx->memory, (uint16_t)address, value);
+        CPU_LOG("✅ STORE 완료: 메모리[%d] = R%d = %d\n", address, reg_num, value);
     }
+}
 
-    // 명령어 실행
-    if (opcode < 4) {
-        // ALU 연산
-        uint8_t result = handler_table[opcode](operand1, operand2);
-        
-        set_register(&regs, 1, operand1);  // R1 = 첫 번째 피연산자
-        set_register(&regs, 2, operand2);  // R2 = 두 번째 피연산자  
-        set_register(&regs, 7, result);    // resultR = 결과
-        
-        if (70 + opcode < MEMORY_SIZE) {
-            memory.data[70 + opcode] = result;
-        }
-        
-        printf("✅ %s 연산: %d %c %d = %d\n", 
-               (opcode == 0) ? "ADD" : (opcode == 1) ? "SUB" : (opcode == 2) ? "MUL" : "DIV",
-               operand1, (opcode == 0) ? '+' : (opcode == 1) ? '-' : (opcode == 2) ? '*' : '/',
-               operand2, result);
-               
-    } else if (opcode == 4) {
-        // 기존 MOV 명령어 (메모리 주소)
-        if (reg1_val >= 101 && reg1_val <= 107) {
-            // 🎯 MOV R4, 50 형태 → 레지스터에 값 저장
-            uint8_t target_reg = reg1_val - 100;
-            
-            printf("📝 기존 MOV 실행 중: R%d에 값 %d 저장...\n", target_reg, operand2);
-            
-            // 레지스터에 값 저장
-            set_register(&regs, target_reg, operand2);
-            
-            // 저장 확인
-            uint8_t stored_value = get_register(&regs, target_reg);
-            printf("✅ MOV 완료: R%d = %d (저장됨!)\n", target_reg, stored_value);
-            
-            // 모든 레지스터 상태 출력 (디버깅용)
-            printf("전체 레지스터 상태:\n");
-            for (int i = 1; i <= 7; i++) {
-                printf("  R%d = %d\n", i, get_register(&regs, i));
-            }
-            
+// 🧮 패킹 SIMD: 벡터 레지스터 레인 연산은 호스트 벡터 명령어로 한 번에 실행
+static void exec_packed(CPU_Context *ctx, uint16_t instruction) {
+    uint8_t vd = (instruction >> 10) & 0x3;
+    uint8_t vs = (instruction >> 8) & 0x3;
+    uint8_t op = (instruction >> PACKED_OP_SHIFT) & 0x3;
+    int saturate = (instruction & PACKED_SATURATE) != 0;
+    unsigned lanes = (instruction & PACKED_LANES8) ? 8 : 4;
+
+    simd_packed_op(op, saturate, lanes, ctx->regs.vreg[vd], ctx->regs.vreg[vs]);
+
+    const uint8_t *v = ctx->regs.vreg[vd];
+    CPU_LOG("🧮 %s V%d, V%d -> %d %d %d %d %d %d %d %d\n", isa_table[isa_decode(instruction)].mnemonic,
+            vd, vs, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+}
+
+// 🧮 VLOAD/VSTORE: 레인마다 memory_read()/memory_write()로 캐시를 거침
+static void exec_vmem(CPU_Context *ctx, uint16_t instruction) {
+    uint8_t control = (instruction >> 8) & 0xF;
+    uint8_t *vreg = ctx->regs.vreg[control & 0x3];
+    unsigned lanes = (control & VMEM_LANES8) ? 8 : 4;
+    uint16_t address = instruction & 0xFF;
+
+    for (unsigned i = 0; i < lanes; i++) {
+        uint16_t lane_address = (address + i) % MEMORY_SIZE;
+        if (control & VMEM_STORE) {
+            memory_write(&ctx->memory, lane_address, vreg[i]);
         } else {
-            // 🗃️ MOV 255, 32 형태 → 메모리에 값 저장
-            printf("📝 MOV 실행 중: 메모리[%d]에 값 %d 저장...\n", operand1, operand2);
-            
-            if (operand1 < MEMORY_SIZE) {
-                memory.data[operand1] = operand2;
-                printf("✅ MOV 완료: 메모리[%d] = %d (저장됨!)\n", operand1, operand2);
-            } else {
-                printf("❌ MOV 실패: 메모리 주소 %d 범위 초과\n", operand1);
-            }
+            vreg[i] = memory_read(&ctx->memory, lane_address);
         }
     }
+    CPU_LOG("🧮 %s V%d, [%d]\n", isa_table[isa_decode(instruction)].mnemonic, control & 0x3, address);
+}
 
-    regs.pc += 2;
-    printf("PC: %d\n", regs.pc);
-    printf("====================\n\n");
+// 🚩 관심 구간 표시: 효과 없음 (fast-forward가 멈추는 지점)
+static void exec_mark(CPU_Context *ctx, uint16_t instruction) {
+    (void)instruction;
+    CPU_LOG("🚩 MARK (PC: %d)\n", ctx->regs.pc);
+}
+
+// ISA 표에 없는 워드: 아무 효과 없이 건너뜀
+static void exec_invalid(CPU_Context *ctx, uint16_t instruction) {
+    (void)ctx;
+    CPU_LOG("❌ 알 수 없는 명령어: 0x%04X\n", instruction);
+}
+
+// 실행기 디스패치 테이블 (include/isa.h의 ISA_INSTRUCTIONS에서 생성)
+typedef void (*isa_exec_fn)(CPU_Context *ctx, uint16_t instruction);
+#define ISA_EXEC_ENTRY(id, mnemonic, format, base, mask, exec) [ISA_##id] = exec_##exec,
+static const isa_exec_fn exec_table[ISA_COUNT] = {
+    [ISA_INVALID] = exec_invalid,
+    ISA_INSTRUCTIONS(ISA_EXEC_ENTRY)
+};
+#undef ISA_EXEC_ENTRY
+
+/*
+ * @brief 명령어를 디코드하고 실행합니다
+ * @param instruction 실행할 16비트 명령어
+ * @returns 없음 (void)
+ *
+ * @details
+ * 디코드는 isa_decode_table 한 번 조회이고, 실행은 exec_table로 바로 분기합니다.
+ */
+void decode_and_execute(uint16_t instruction) {
+    CPU_Context *ctx = current_ctx;
+    IsaId id = isa_decode(instruction);
+
+    CPU_LOG("\n=== 명령어 디코딩 ===\n");
+    CPU_LOG("바이트: 0x%04X -> %s\n", instruction, isa_table[id].mnemonic);
+
+    exec_table[id](ctx, instruction);
+
+    ctx->regs.pc += 2;
+    CPU_LOG("PC: %d\n", ctx->regs.pc);
+    CPU_LOG("====================\n\n");
 }
 
 /*
@@ -266,24 +397,82 @@ void decode_and_execute(uint16_t instruction) {
  * @returns 없음 (void)
  */
 void cpu_step(void) {
-    if (regs.pc >= MEMORY_SIZE - 1) {
+    CPU_Context *ctx = current_ctx;
+
+    if (ctx->regs.pc >= MEMORY_SIZE - 1) {
         return; // 프로그램 종료
     }
     
+    uint64_t misses = ctx->memory.cache.stats.misses;
+    uint16_t pc = ctx->regs.pc;
     uint16_t instruction = fetch_instruction();
     if (instruction != 0) {
+        if (TRACE_ACTIVE()) {
+            trace_step_begin(pc, instruction, ctx->memory.cache.stats.misses != misses);
+        }
         decode_and_execute(instruction);
+        ctx->stats.instructions++;
+        if (TRACE_ACTIVE()) {
+            trace_step_end(&ctx->regs);
+        }
+        if (ctx->profiling) {
+            profiler_record(ctx->profile, pc, ctx->memory.cache.stats.misses - misses);
+        }
+        
+        // 상세 모드: fetch와 데이터 접근에서 발생한 미스만큼 패널티 추가
+        if (ctx->mode == CPU_MODE_DETAILED) {
+            ctx->stats.cycles += CPU_BASE_CYCLES + (ctx->memory.cache.stats.misses - misses) * CACHE_MISS_PENALTY;
+        }
     }
 }
 
+/*
+ * @brief 시뮬레이션 모드를 전환합니다
+ * @param mode CPU_MODE_DETAILED 또는 CPU_MODE_FUNCTIONAL
+ * @param warmup_accesses 상세 모드로 돌아갈 때 캐시를 데울 최근 접근 수
+ * @returns 없음 (void)
+ *
+ * @details
+ * 기능 모드에서는 캐시를 메모리에 반영한 뒤 끄고 로그도 끕니다.
+ * 상세 모드로 돌아오면 로그 설정을 복원하고 캐시를 데운 뒤 통계를 새로 시작합니다.
+ */
+void cpu_set_mode(CPU_Mode mode, unsigned warmup_accesses) {
+    CPU_Context *ctx = current_ctx;
+
+    if (mode == ctx->mode) {
+        return;
+    }
+    
+    if (mode == CPU_MODE_FUNCTIONAL) {
+        ctx->saved_log_enabled = cpu_log_enabled;
+        cpu_log_enabled = 0;
+        memory_set_cache_enabled(&ctx->memory, 0, 0);
+    } else {
+        memory_set_cache_enabled(&ctx->memory, 1, warmup_accesses);
+        cpu_log_enabled = ctx->saved_log_enabled;
+    }
+    ctx->mode = mode;
+}
+
+/*
+ * @brief 현재 시뮬레이션 모드를 반환합니다
+ * @param 없음
+ * @returns 현재 CPU_Mode
+ */
+CPU_Mode cpu_get_mode(void) {
+    return current_ctx->mode;
+}
+
 /*
  * @brief CPU를 연속으로 실행합니다
  * @param 없음
  * @returns 없음 (void)
  */
 void cpu_run(void) {
+    CPU_Context *ctx = current_ctx;
+
     // 프로그램 실행 루프
-    for (int i = 0; i < 4 && regs.pc < MEMORY_SIZE - 1; i++) {
+    for (int i = 0; i < 4 && ctx->regs.pc < MEMORY_SIZE - 1; i++) {
         cpu_step();
     }
 }
@@ -313,10 +502,12 @@ void cpu(void) {
  * @returns 없음 (void)
  */
 void print_cpu_state() {
-    printf("PC: %d\n", regs.pc);
-    printf("Register1: %d\n", regs.register1);
-    printf("Register2: %d\n", regs.register2);
-    printf("Register3: %d\n", regs.register3);
+    CPU_Context *ctx = current_ctx;
+
+    printf("PC: %d\n", ctx->regs.pc);
+    printf("Register1: %d\n", ctx->regs.register1);
+    printf("Register2: %d\n", ctx->regs.register2);
+    printf("Register3: %d\n", ctx->regs.register3);
 }
 
 /*
@@ -325,7 +516,7 @@ void print_cpu_state() {
  * @returns CPU 레지스터 구조체 포인터
  */
 CPU_Registers* get_cpu_registers(void) {
-    return &regs;
+    return &current_ctx->regs;
 }
 
 /*
@@ -334,6 +525,14 @@ CPU_Registers* get_cpu_registers(void) {
  * @returns 메모리 구조체 포인터
  */
 Memory* get_cpu_memory(void) {
-    return &memory;
+    return &current_ctx->memory;
 }
 
+/*
+ * @brief CPU 실행 통계 포인터를 반환합니다
+ * @param 없음
+ * @returns 실행 통계 구조체 포인터
+ */
+CPU_Stats* get_cpu_stats(void) {
+    return &current_ctx->stats;
+}
@@ -0,0 +1,41 @@
+/* src/datapath.c - 8/16/32비트 데이터패스 구현
+ * ------------------------------------------------------------
+ * src/datapath_template.h를 폭마다 한 번씩 include해 dp8_*, dp16_*, dp32_*를 만듭니다.
+ * 변형마다 레지스터 타입과 부호 비트가 상수로 고정되므로 실행 중 폭 분기가 없습니다.
+ * 디코드는 세 변형 모두 isa.c의 표(isa_decode)를 씁니다.
+ * Test Case: tests/datapath_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/datapath.h"
+#include "include/cpu.h"
+#include "include/cache.h"
+#include "include/flags.h"
+#include "include/isa.h"
+#include "include/simd.h"
+
+#include <string.h>
+
+#define DP_BITS 8
+#define DP_UINT uint8_t
+#define DP_SINT int8_t
+#include "datapath_template.h"
+#undef DP_BITS
+#undef DP_UINT
+#undef DP_SINT
+
+#define DP_BITS 16
+#define DP_UINT uint16_t
+#define DP_SINT int16_t
+#include "datapath_template.h"
+#undef DP_BITS
+#undef DP_UINT
+#undef DP_SINT
+
+#define DP_BITS 32
+#define DP_UINT uint32_t
+#define DP_SINT int32_t
+#include "datapath_template.h"
+#undef DP_BITS
+#undef DP_UINT
+#undef DP_SINT
@@ -0,0 +1,315 @@
+/* src/datapath_template.h - 폭별 데이터패스 구현 템플릿
+ * ------------------------------------------------------------
+ * include 가드가 없습니다. src/datapath.c에서 아래 매크로를 정의한 뒤
+ * 폭마다 한 번씩 include하면 dp<폭>_* 함수들이 만들어집니다.
+ *   DP_BITS  : 8, 16, 32
+ *   DP_UINT  : 부호 없는 레지스터 타입
+ *   DP_SINT  : 같은 폭의 부호 있는 타입
+ * Author: Cho Sungju
+*/
+
+#if !defined(DP_BITS) || !defined(DP_UINT) || !defined(DP_SINT)
+#error "DP_BITS, DP_UINT, DP_SINT를 정의한 뒤 include하세요"
+#endif
+
+#define DP_PASTE_(a, b, c) a##b##c
+#define DP_PASTE(a, b, c)  DP_PASTE_(a, b, c)
+#define DP_FN(name)        DP_PASTE(dp, DP_BITS, _##name)
+#define DP_MACHINE         DP_PASTE(DP_Machine, DP_BITS, )
+
+#define DP_BYTES     (DP_BITS / 8)
+#define DP_SIGN_BIT  ((DP_UINT)1 << (DP_BITS - 1))
+#define DP_SINT_MIN  ((DP_SINT)DP_SIGN_BIT)
+
+/*
+ * @brief 데이터패스를 리셋 직후 상태로 초기화합니다
+ * @param machine 초기화할 머신
+ * @returns 없음 (void)
+ */
+void DP_FN(init)(DP_MACHINE *machine) {
+    memset(machine, 0, sizeof(*machine));
+    isa_init();
+    init_memory(&machine->memory);
+    cache_init(&machine->memory.cache);
+}
+
+/*
+ * @brief 프로그램을 0번지부터 메모리에 적재하고 PC를 0으로 둡니다
+ * @param machine 대상 머신
+ * @param program 프로그램 바이트 배열
+ * @param size 프로그램 크기 (바이트, 메모리 크기를 넘는 부분은 버림)
+ * @returns 없음 (void)
+ */
+void DP_FN(load_program)(DP_MACHINE *machine, const uint8_t *program, size_t size) {
+    if (size > MEMORY_SIZE) size = MEMORY_SIZE;
+    cache_init(&machine->memory.cache);
+    memset(machine->memory.data, 0, MEMORY_SIZE);
+    memcpy(machine->memory.data, program, size);
+    memset(&machine->regs, 0, sizeof(machine->regs));
+    machine->instructions = 0;
+    machine->cycles = 0;
+    machine->halted = 0;
+}
+
+/*
+ * @brief 폭에 맞는 ALU 연산과 CF/ZF/SF/OF를 계산합니다
+ * @param op ALU opcode (0=ADD, 1=SUB, 2=MUL, 3=DIV)
+ * @param a 첫 번째 피연산자
+ * @param b 두 번째 피연산자
+ * @param flags 플래그를 받을 포인터 (NULL 가능)
+ * @returns 연산 결과
+ *
+ * @details
+ * 8비트 ALU(flags.c)와 같은 규칙: ADD/SUB는 부호 없는 자리올림/빌림이 CF,
+ * MUL은 부호 있는 곱이 범위를 벗어나면 CF=OF, DIV는 0으로 나누기와 MIN / -1이 OF입니다.
+ */
+DP_UINT DP_FN(alu)(unsigned op, DP_UINT a, DP_UINT b, uint8_t *flags) {
+    DP_UINT result = 0;
+    uint8_t f = 0;
+
+    switch (op) {
+        case 0:
+            result = (DP_UINT)(a + b);
+            if (result < a) f |= FLAG_CF;
+            if ((DP_UINT)(~(a ^ b) & (a ^ result)) & DP_SIGN_BIT) f |= FLAG_OF;
+            break;
+        case 1:
+            result = (DP_UINT)(a - b);
+            if (a < b) f |= FLAG_CF;
+            if ((DP_UINT)((a ^ b) & (a ^ result)) & DP_SIGN_BIT) f |= FLAG_OF;
+            break;
+        case 2: {
+            int64_t product = (int64_t)(DP_SINT)a * (int64_t)(DP_SINT)b;
+            result = (DP_UINT)product;
+            if (product != (int64_t)(DP_SINT)result) f |= FLAG_CF | FLAG_OF;
+            break;
+        }
+        case 3:
+            if (b == 0) {
+                f |= FLAG_OF;
+            } else if ((DP_SINT)a == DP_SINT_MIN && (DP_SINT)b == -1) {
+                result = a;     // MIN / -1은 표현할 수 없음 (C에서는 정의되지 않은 동작)
+                f |= FLAG_OF;
+            } else {
+                result = (DP_UINT)((DP_SINT)a / (DP_SINT)b);
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (result == 0) f |= FLAG_ZF;
+    if (result & DP_SIGN_BIT) f |= FLAG_SF;
+    if (flags) *flags = f;
+    return result;
+}
+
+/*
+ * @brief 메모리에서 폭/8 바이트를 빅엔디안으로 읽습니다 (캐시 경유)
+ * @param machine 대상 머신
+ * @param address 시작 주소
+ * @returns 읽은 값
+ */
+static DP_UINT DP_FN(read_word)(DP_MACHINE *machine, uint16_t address) {
+    DP_UINT value = 0;
+    for (unsigned i = 0; i < DP_BYTES; i++) {
+        value = (DP_UINT)(value << 8) | memory_read(&machine->memory, (uint16_t)((address + i) % MEMORY_SIZE));
+    }
+    return value;
+}
+
+/*
+ * @brief 메모리에 폭/8 바이트를 빅엔디안으로 씁니다 (캐시 경유)
+ * @param machine 대상 머신
+ * @param address 시작 주소
+ * @param value 쓸 값
+ * @returns 없음 (void)
+ */
+static void DP_FN(write_word)(DP_MACHINE *machine, uint16_t address, DP_UINT value) {
+    for (unsigned i = DP_BYTES; i-- > 0;) {
+        memory_write(&machine->memory, (uint16_t)((address + i) % MEMORY_SIZE), (uint8_t)value);
+        value = (DP_UINT)(value >> 8);
+    }
+}
+
+/*
+ * @brief 명령어 하나를 실행합니다
+ * @param machine 대상 머신
+ * @returns 실행했으면 1, 정지 상태면 0
+ *
+ * @details
+ * 디코드는 8비트 코어와 같은 isa_decode() 표를 쓰므로 같은 워드는 같은 명령어가 됩니다.
+ * 폭에 따라 달라지는 것은 MOV 즉시값 길이와 LOAD/STORE/기존 포맷 메모리 기록의 바이트 수뿐입니다.
+ * MARK와 표에 없는 워드는 효과 없이 건너뜁니다.
+ */
+int DP_FN(step)(DP_MACHINE *machine) {
+    uint16_t pc = machine->regs.pc;
+
+    if (machine->halted || pc >= MEMORY_SIZE - 1) {
+        machine->halted = 1;
+        return 0;
+    }
+
+    uint64_t misses = machine->memory.cache.stats.misses;
+    uint8_t byte0 = memory_read(&machine->memory, pc);
+    uint8_t byte1 = memory_read(&machine->memory, pc + 1);
+    uint16_t word = (uint16_t)((byte0 << 8) | byte1);
+    if (word == 0) {
+        machine->halted = 1;
+        return 0;
+    }
+
+    IsaId id = isa_decode(word);
+    uint8_t opcode = byte0 >> 4;
+    uint16_t next_pc = pc + 2;
+    DP_UINT *r = machine->regs.r;
+
+    switch (isa_table[id].format) {
+    // MOV Rn, imm: 즉시값은 두 번째 바이트부터 폭/8 바이트
+    case ISA_FMT_RI: {
+        DP_UINT imm = byte1;
+        for (unsigned i = 1; i < DP_BYTES; i++) {
+            imm = (DP_UINT)(imm << 8) | memory_read(&machine->memory, (uint16_t)((pc + 1 + i) % MEMORY_SIZE));
+        }
+        r[byte0 & 0xF] = imm;
+        next_pc = pc + 1 + DP_BYTES;
+        break;
+    }
+
+    // ALU Ra, Rb → R7
+    case ISA_FMT_RR:
+        r[7] = DP_FN(alu)(opcode, r[byte0 & 0xF], r[byte1 >> 4], &machine->regs.flags);
+        break;
+
+    // 기존 포맷: ALU는 R1 = a, R2 = b, R7 = 결과, 메모리[70 + opcode] = 결과 / MOV는 메모리[a] = b
+    case ISA_FMT_I6: {
+        DP_UINT a = (DP_UINT)((word >> 6) & 0x3F);
+        DP_UINT b = (DP_UINT)(word & 0x3F);
+        if (id == ISA_MOV_I6) {
+            DP_FN(write_word)(machine, (uint16_t)a, b);
+            break;
+        }
+        r[1] = a;
+        r[2] = b;
+        r[7] = DP_FN(alu)(opcode, a, b, &machine->regs.flags);
+        DP_FN(write_word)(machine, (uint16_t)(70 + opcode), r[7]);
+        break;
+    }
+
+    case ISA_FMT_MEM: {
+        uint8_t reg_num = byte0 & 0x7;
+        uint16_t address = byte1;
+        int valid = reg_num >= 1;
+
+        if (byte0 & MEM_MODE_INDIRECT) {
+            uint8_t addr_reg = byte1 & 0xF;
+            valid = valid && addr_reg >= 1 && addr_reg <= 7;
+            address = valid ? (uint16_t)(r[addr_reg] % MEMORY_SIZE) : 0;
+        }
+        if (valid) {
+            if (id == ISA_LOAD) {
+                r[reg_num] = DP_FN(read_word)(machine, address);
+            } else {
+                DP_FN(write_word)(machine, address, r[reg_num]);
+            }
+        }
+        break;
+    }
+
+    // 패킹 SIMD와 벡터 메모리는 8비트 레인이므로 폭과 관계없음
+    case ISA_FMT_PACKED:
+        simd_packed_op((byte1 >> PACKED_OP_SHIFT) & 0x3, (byte1 & PACKED_SATURATE) != 0,
+                       (byte1 & PACKED_LANES8) ? 8 : 4, machine->regs.v[(byte0 >> 2) & 0x3],
+                       machine->regs.v[byte0 & 0x3]);
+        break;
+
+    case ISA_FMT_VMEM: {
+        uint8_t *vreg = machine->regs.v[byte0 & 0x3];
+        unsigned lanes = (byte0 & VMEM_LANES8) ? 8 : 4;
+        for (unsigned i = 0; i < lanes; i++) {
+            uint16_t lane_address = (uint16_t)((byte1 + i) % MEMORY_SIZE);
+            if (byte0 & VMEM_STORE) {
+                memory_write(&machine->memory, lane_address, vreg[i]);
+            } else {
+                vreg[i] = memory_read(&machine->memory, lane_address);
+            }
+        }
+        break;
+    }
+
+    // MARK, 표에 없는 워드: 효과 없음
+    default:
+        break;
+    }
+
+    machine->regs.pc = next_pc;
+    machine->instructions++;
+    machine->cycles += CPU_BASE_CYCLES + (machine->memory.cache.stats.misses - misses) * CACHE_MISS_PENALTY;
+    return 1;
+}
+
+/*
+ * @brief 정지하거나 max_steps만큼 실행할 때까지 명령어를 실행합니다
+ * @param machine 대상 머신
+ * @param max_steps 최대 실행 명령어 수 (0이면 제한 없음)
+ * @returns 실행한 명령어 수
+ */
+uint64_t DP_FN(run)(DP_MACHINE *machine, uint64_t max_steps) {
+    uint64_t steps = 0;
+    while ((max_steps == 0 || steps < max_steps) && DP_FN(step)(machine)) {
+        steps++;
+    }
+    return steps;
+}
+
+/*
+ * @brief MOV Rn, imm 명령어를 인코딩합니다
+ * @param reg 목적지 레지스터 (1~7)
+ * @param imm 즉시값
+ * @param buffer 출력 버퍼 (1 + 폭/8 바이트)
+ * @returns 기록한 바이트 수
+ */
+size_t DP_FN(encode_mov)(uint8_t reg, DP_UINT imm, uint8_t *buffer) {
+    buffer[0] = (uint8_t)(0x40 | (reg & 0x7));
+    for (unsigned i = 0; i < DP_BYTES; i++) {
+        buffer[1 + i] = (uint8_t)(imm >> (8 * (DP_BYTES - 1 - i)));
+    }
+    return 1 + DP_BYTES;
+}
+
+/*
+ * @brief ALU Ra, Rb 명령어를 인코딩합니다 (결과는 R7)
+ * @param op ALU opcode (0~3)
+ * @param reg1 첫 번째 레지스터 (1~7)
+ * @param reg2 두 번째 레지스터 (1~7)
+ * @param buffer 출력 버퍼 (2바이트)
+ * @returns 기록한 바이트 수
+ */
+size_t DP_FN(encode_alu)(unsigned op, uint8_t reg1, uint8_t reg2, uint8_t *buffer) {
+    buffer[0] = (uint8_t)((op << 4) | (reg1 & 0xF));
+    buffer[1] = (uint8_t)((reg2 << 4) | 0xF);
+    return 2;
+}
+
+/*
+ * @brief LOAD/STORE 명령어를 인코딩합니다
+ * @param opcode OPCODE_LOAD 또는 OPCODE_STORE
+ * @param reg 데이터 레지스터 (1~7)
+ * @param indirect 0이면 address가 주소, 1이면 address가 주소 레지스터 번호
+ * @param address 주소 또는 주소 레지스터 번호
+ * @param buffer 출력 버퍼 (2바이트)
+ * @returns 기록한 바이트 수
+ */
+size_t DP_FN(encode_mem)(unsigned opcode, uint8_t reg, int indirect, uint8_t address, uint8_t *buffer) {
+    buffer[0] = (uint8_t)((opcode << 4) | (indirect ? MEM_MODE_INDIRECT : 0) | (reg & 0x7));
+    buffer[1] = address;
+    return 2;
+}
+
+#undef DP_PASTE_
+#undef DP_PASTE
+#undef DP_FN
+#undef DP_MACHINE
+#undef DP_BYTES
+#undef DP_SIGN_BIT
+#undef DP_SINT_MIN
@@ -0,0 +1,97 @@
+/* src/fastforward.c - 기능 모드 fast-forward 구현
+ * ------------------------------------------------------------
+ * 기능 모드로 바꾼 뒤 멈춤 조건을 만날 때까지 cpu_step()을 반복하고,
+ * 최근 메모리 접근으로 캐시를 데워 상세(캐시/타이밍) 모드로 되돌립니다.
+ * Test Case: tests/fastforward_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/fastforward.h"
+#include "include/cpu.h"
+#include "include/memory.h"
+
+#include <string.h>
+
+/*
+ * @brief 기본 fast-forward 조건을 채웁니다 (MARK에서 멈춤, 워밍 256회)
+ * @param config 채울 구성 구조체 포인터
+ * @returns 없음 (void)
+ */
+void ff_default_config(FastForwardConfig *config) {
+    memset(config, 0, sizeof(*config));
+    config->stop_pc = FF_NO_STOP_PC;
+    config->max_steps = 0;
+    config->stop_at_marker = 1;
+    config->warmup_accesses = 256;
+}
+
+/*
+ * @brief 멈춤 조건까지 기능 모드로 실행한 뒤 상세 모드로 전환합니다
+ * @param config 멈춤 조건과 캐시 워밍 설정
+ * @returns 멈춘 이유와 실행한 명령어 수
+ *
+ * @details
+ * 멈춤 판정용 명령어 확인은 memory_peek()로 하여 워밍용 접근 기록에 섞이지 않게 합니다.
+ * should_stop으로 멈춰도 상세 모드 전환은 그대로 하므로 CPU는 단계 경계의 일관된 상태로 남습니다.
+ */
+FastForwardResult cpu_fast_forward(const FastForwardConfig *config) {
+    FastForwardResult result;
+    CPU_Registers *regs = get_cpu_registers();
+    Memory *memory = get_cpu_memory();
+
+    result.reason = FF_STOP_HALT;
+    result.steps = 0;
+
+    cpu_set_mode(CPU_MODE_FUNCTIONAL, 0);
+
+    for (;;) {
+        if (regs->pc >= MEMORY_SIZE - 1) {
+            result.reason = FF_STOP_HALT;
+            break;
+        }
+        if (config->stop_pc != FF_NO_STOP_PC && regs->pc == (uint16_t)config->stop_pc) {
+            result.reason = FF_STOP_PC;
+            break;
+        }
+        if (config->max_steps && result.steps >= config->max_steps) {
+            result.reason = FF_STOP_STEPS;
+            break;
+        }
+        if (config->should_stop && result.steps % FF_CHECK_INTERVAL == 0 && config->should_stop(config->stop_arg)) {
+            result.reason = FF_STOP_CANCELLED;
+            break;
+        }
+
+        uint16_t instruction = (memory_peek(memory, regs->pc) << 8) | memory_peek(memory, regs->pc + 1);
+        if (instruction == 0) {
+            result.reason = FF_STOP_HALT;
+            break;
+        }
+
+        cpu_step();
+        result.steps++;
+
+        if (config->stop_at_marker && instruction == INSTR_MARK) {
+            result.reason = FF_STOP_MARKER;
+            break;
+        }
+    }
+
+    cpu_set_mode(CPU_MODE_DETAILED, config->warmup_accesses);
+    return result;
+}
+
+/*
+ * @brief 멈춘 이유를 문자열로 변환합니다
+ * @param reason 멈춘 이유
+ * @returns 이유 문자열
+ */
+const char* ff_stop_reason_name(FastForwardStop reason) {
+    switch (reason) {
+        case FF_STOP_PC:     return "pc";
+        case FF_STOP_STEPS:  return "steps";
+        case FF_STOP_MARKER: return "marker";
+        case FF_STOP_CANCELLED: return "cancelled";
+        default:             return "halt";
+    }
+}
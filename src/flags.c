@@ -3,6 +3,131 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+/*
+ * @brief ALU 연산의 종류와 피연산자만 기록합니다 (플래그는 읽을 때 계산)
+ * @param regs CPU 레지스터 구조체 포인터
+ * @param op FlagOp 연산 종류
+ * @param a 첫 번째 피연산자
+ * @param b 두 번째 피연산자
+ * @param result 연산 결과
+ * @returns 없음 (void)
+ *
+ * @details
+ * 연산마다 분기로 플래그를 계산하지 않고 네 바이트만 저장하므로,
+ * 플래그를 읽지 않는 대부분의 명령어는 비용이 거의 들지 않습니다.
+ */
+void flags_record(CPU_Registers* regs, uint8_t op, uint8_t a, uint8_t b, uint8_t result)
+{
+    if (!regs) return;
+    regs->flag_op = op;
+    regs->flag_a = a;
+    regs->flag_b = b;
+    regs->flag_result = result;
+}
+
+/*
+ * @brief 기록된 연산으로부터 CF/ZF/SF/OF를 계산합니다
+ * @param regs CPU 레지스터 구조체 포인터
+ * @returns FLAG_* 비트 조합
+ */
+uint8_t get_flags(const CPU_Registers* regs)
+{
+    if (!regs) return 0;
+    if (regs->flag_op == FLAG_OP_NONE) {
+        return regs->flags;
+    }
+
+    uint8_t a = regs->flag_a;
+    uint8_t b = regs->flag_b;
+    uint8_t result = regs->flag_result;
+    uint8_t flags = 0;
+
+    switch (regs->flag_op) {
+        case FLAG_OP_ADD:
+            // 같은 부호끼리 더했는데 결과 부호가 다르면 오버플로우
+            if (result < a) flags |= FLAG_CF;
+            if ((~(a ^ b) & (a ^ result)) & 0x80) flags |= FLAG_OF;
+            break;
+        case FLAG_OP_SUB:
+            // 다른 부호끼리 뺐는데 결과 부호가 피감수와 다르면 오버플로우
+            if (a < b) flags |= FLAG_CF;
+            if (((a ^ b) & (a ^ result)) & 0x80) flags |= FLAG_OF;
+            break;
+        case FLAG_OP_MUL: {
+            // 부호 있는 곱이 -128~127을 벗어나면 CF=OF=1
+            int16_t product = (int8_t)a * (int8_t)b;
+            if (product < -128 || product > 127) flags |= FLAG_CF | FLAG_OF;
+            break;
+        }
+        case FLAG_OP_DIV:
+            // 0으로 나누기와 -128 / -1은 OF=1
+            if (b == 0 || ((int8_t)a == -128 && (int8_t)b == -1)) flags |= FLAG_OF;
+            break;
+        default:
+            break;
+    }
+
+    if (result == 0) flags |= FLAG_ZF;
+    if (result & 0x80) flags |= FLAG_SF;
+    return flags;
+}
+
+/*
+ * @brief 플래그 하나를 직접 설정합니다 (기록된 연산은 먼저 계산해 확정)
+ * @param regs CPU 레지스터 구조체 포인터
+ * @param flag FLAG_* 비트
+ * @param value 설정할 값
+ * @returns 없음 (void)
+ */
+void set_flag(CPU_Registers* regs, uint8_t flag, bool value)
+{
+    if (!regs) return;
+    uint8_t flags = get_flags(regs);
+    regs->flags = value ? (uint8_t)(flags | flag) : (uint8_t)(flags & ~flag);
+    regs->flag_op = FLAG_OP_NONE;
+}
+
+/*
+ * @brief 캐리 플래그를 설정합니다
+ * @param regs CPU 레지스터 구조체 포인터
+ * @param value 설정할 값
+ * @returns 없음 (void)
+ */
+void set_carry_flag(CPU_Registers* regs, bool value)
+{
+    set_flag(regs, FLAG_CF, value);
+}
+
+/*
+ * @brief 캐리 플래그를 읽습니다
+ * @param regs CPU 레지스터 구조체 포인터
+ * @returns 캐리 플래그 값
+ */
+bool get_carry_flag(const CPU_Registers* regs)
+{
+    return (get_flags(regs) & FLAG_CF) != 0;
+}
+
+/*
+ * @brief 제로 플래그를 읽습니다
+ * @param regs CPU 레지스터 구조체 포인터
+ * @returns 제로 플래그 값
+ */
+bool get_zero_flag(const CPU_Registers* regs)
+{
+    return (get_flags(regs) & FLAG_ZF) != 0;
+}
+
+/*
+ * @brief 부호 플래그를 읽습니다
+ * @param regs CPU 레지스터 구조체 포인터
+ * @returns 부호 플래그 값
+ */
+bool get_sign_flag(const CPU_Registers* regs)
+{
+    return (get_flags(regs) & FLAG_SF) != 0;
+}
+
 /*
  * @brief 덧셈 연산에서 캐리 플래그를 설정합니다
  * @param regs CPU 레지스터 구조체 포인터
@@ -32,7 +157,3 @@ void subtraction_flag(CPU_Registers* regs, uint8_t a, uint8_t b)
     bool carry = (a < b);
     set_carry_flag(regs, carry);
 }
-
-// 이제 결과 보여줄때 캐리값 같이 보여주면 되는거임!!
-// 더한후 결과는 255더한값으로 보여주면 되는거고
-// 뺀후에는 걍 에러 띄워야지 뭐. 음수표현 안됨 우리
\ No newline at end of file
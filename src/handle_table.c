@@ -0,0 +1,132 @@
+/* src/handle_table.c - 세대 번호가 붙은 핸들 테이블 구현
+ * ------------------------------------------------------------
+ * free-list는 가장 최근에 해제한 슬롯부터 다시 씁니다 (캐시에 남아 있을 가능성이 큼).
+ * 배열을 늘릴 때 새 슬롯은 번호 순서대로 free-list 앞에 이어 붙입니다.
+ * Test Case: tests/handle_table_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/handle_table.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * @brief 슬롯 [first, capacity)를 초기화해 free-list 앞에 붙입니다
+ */
+static void link_free_slots(HandleTable *table, uint32_t first) {
+    for (uint32_t i = first; i < table->capacity; i++) {
+        table->slots[i].item = NULL;
+        table->slots[i].generation = 1;
+        table->slots[i].next_free = i + 1 < table->capacity ? i + 1 : table->free_head;
+    }
+    if (first < table->capacity) {
+        table->free_head = first;
+    }
+}
+
+static int grow(HandleTable *table) {
+    if (table->capacity >= table->max_slots) {
+        return -1;
+    }
+
+    uint32_t capacity = table->capacity * 2;
+    if (capacity > table->max_slots) {
+        capacity = table->max_slots;
+    }
+    HandleSlot *slots = realloc(table->slots, (size_t)capacity * sizeof(HandleSlot));
+    if (!slots) {
+        return -1;
+    }
+
+    uint32_t first = table->capacity;
+    table->slots = slots;
+    table->capacity = capacity;
+    link_free_slots(table, first);
+    return 0;
+}
+
+/*
+ * @brief 핸들 테이블을 초기화합니다
+ * @param table 핸들 테이블
+ * @param initial_capacity 처음 슬롯 수 (0이면 1)
+ * @param max_slots 슬롯 수 상한
+ * @returns 성공 시 0, 메모리 부족 시 -1
+ */
+int handle_table_init(HandleTable *table, uint32_t initial_capacity, uint32_t max_slots) {
+    memset(table, 0, sizeof(*table));
+    table->max_slots = max_slots && max_slots < HANDLE_MAX_SLOTS ? max_slots : HANDLE_MAX_SLOTS;
+    table->capacity = initial_capacity ? initial_capacity : 1;
+    if (table->capacity > table->max_slots) {
+        table->capacity = table->max_slots;
+    }
+    table->slots = malloc((size_t)table->capacity * sizeof(HandleSlot));
+    if (!table->slots) {
+        table->capacity = 0;
+        return -1;
+    }
+    table->free_head = HANDLE_NO_SLOT;
+    link_free_slots(table, 0);
+    return 0;
+}
+
+void handle_table_free(HandleTable *table) {
+    free(table->slots);
+    memset(table, 0, sizeof(*table));
+}
+
+/*
+ * @brief 항목을 등록합니다
+ * @param table 핸들 테이블
+ * @param item 등록할 항목 (NULL이 아니어야 함)
+ * @returns 핸들, 상한에 닿았거나 메모리가 부족하면 HANDLE_INVALID
+ */
+Handle handle_alloc(HandleTable *table, void *item) {
+    if (!item || (table->free_head == HANDLE_NO_SLOT && grow(table) != 0)) {
+        return HANDLE_INVALID;
+    }
+
+    uint32_t index = table->free_head;
+    HandleSlot *slot = &table->slots[index];
+    table->free_head = slot->next_free;
+    slot->item = item;
+    table->count++;
+    return (slot->generation << HANDLE_INDEX_BITS) | index;
+}
+
+/*
+ * @brief 핸들의 항목을 찾습니다
+ * @param table 핸들 테이블
+ * @param handle 핸들
+ * @returns 항목, 해제됐거나 잘못된 핸들이면 NULL
+ */
+void* handle_get(const HandleTable *table, Handle handle) {
+    uint32_t index = handle & HANDLE_INDEX_MASK;
+
+    if (index >= table->capacity || table->slots[index].generation != handle >> HANDLE_INDEX_BITS) {
+        return NULL;
+    }
+    return table->slots[index].item;
+}
+
+/*
+ * @brief 항목을 해제합니다
+ * @param table 핸들 테이블
+ * @param handle 핸들
+ * @returns 성공 시 0, 이미 해제됐거나 잘못된 핸들이면 -1
+ */
+int handle_release(HandleTable *table, Handle handle) {
+    uint32_t index = handle & HANDLE_INDEX_MASK;
+
+    if (!handle_get(table, handle)) {
+        return -1;
+    }
+
+    HandleSlot *slot = &table->slots[index];
+    slot->item = NULL;
+    slot->generation = slot->generation + 1 < HANDLE_GENERATIONS ? slot->generation + 1 : 1;
+    slot->next_free = table->free_head;
+    table->free_head = index;
+    table->count--;
+    return 0;
+}
@@ -0,0 +1,277 @@
+/* src/image.c - 바이너리 프로그램 이미지 읽기/쓰기
+ * ------------------------------------------------------------
+ * 쓰기: 표와 데이터의 오프셋을 먼저 정한 뒤 버퍼 하나에 모아 체크섬을 넣고 한 번에 씁니다.
+ * 읽기: 파일을 mmap하고 헤더/표/데이터의 범위를 모두 검사한 뒤 구조체 포인터만 돌려줍니다.
+ * CPU에 적재하는 cpu_load_image()는 cpu.c에 있습니다 (이 파일은 CPU에 의존하지 않음).
+ * Test Case: tests/image_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/image.h"
+#include "include/hash.h"
+
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define IMAGE_CHECKSUM_SEED 0x43505549ULL   /* "CPUI" */
+
+static void set_error(char *error, size_t error_size, const char *format, ...) {
+    if (error && error_size) {
+        va_list args;
+        va_start(args, format);
+        vsnprintf(error, error_size, format, args);
+        va_end(args);
+    }
+}
+
+static size_t align_up(size_t value) {
+    return (value + IMAGE_ALIGN - 1) & ~(size_t)(IMAGE_ALIGN - 1);
+}
+
+/*
+ * @brief [offset, offset + size)가 파일 안에 있는지 확인합니다 (덧셈 넘침 포함)
+ */
+static int in_file(size_t file_size, size_t offset, size_t size) {
+    return offset <= file_size && size <= file_size - offset;
+}
+
+/*
+ * @brief 메모리에 있는 이미지를 검사하고 표를 가리킵니다
+ * @param data 이미지 (8바이트 정렬)
+ * @param size 크기
+ * @param image 결과
+ * @param error 실패 이유 (NULL 가능)
+ * @param error_size error 크기
+ * @returns 성공 시 0, 형식 오류 시 -1
+ */
+int image_view(const void *data, size_t size, ProgramImage *image, char *error, size_t error_size) {
+    const uint8_t *bytes = data;
+    const ImageHeader *header = data;
+
+    memset(image, 0, sizeof(*image));
+    if ((uintptr_t)data % IMAGE_ALIGN != 0) {
+        set_error(error, error_size, "이미지 버퍼가 %u바이트 정렬이 아닙니다", IMAGE_ALIGN);
+        return -1;
+    }
+    if (size < sizeof(ImageHeader) || memcmp(header->magic, IMAGE_MAGIC, sizeof(header->magic)) != 0) {
+        set_error(error, error_size, "프로그램 이미지가 아닙니다");
+        return -1;
+    }
+    if (header->version != IMAGE_VERSION) {
+        set_error(error, error_size, "지원하지 않는 이미지 버전: %u (지원: %u)", header->version, IMAGE_VERSION);
+        return -1;
+    }
+    if (header->file_size != size) {
+        set_error(error, error_size, "이미지 크기가 다릅니다: 헤더 %u, 실제 %zu", header->file_size, size);
+        return -1;
+    }
+
+    size_t segment_bytes = (size_t)header->segment_count * sizeof(ImageSegment);
+    size_t symbol_bytes = (size_t)header->symbol_count * sizeof(ImageSymbol);
+    if (!in_file(size, sizeof(ImageHeader), segment_bytes) ||
+        header->symbol_offset % IMAGE_ALIGN != 0 || !in_file(size, header->symbol_offset, symbol_bytes) ||
+        !in_file(size, header->string_offset, header->string_size)) {
+        set_error(error, error_size, "이미지 표가 파일 범위를 벗어납니다");
+        return -1;
+    }
+
+    const ImageSegment *segments = (const ImageSegment *)(bytes + sizeof(ImageHeader));
+    for (unsigned i = 0; i < header->segment_count; i++) {
+        if (!in_file(size, segments[i].offset, segments[i].size) ||
+            (size_t)segments[i].address + segments[i].size > 0x10000) {
+            set_error(error, error_size, "세그먼트 %u 범위 오류 (주소 %u, 크기 %u)", i, segments[i].address,
+                      segments[i].size);
+            return -1;
+        }
+    }
+
+    const ImageSymbol *symbols = (const ImageSymbol *)(bytes + header->symbol_offset);
+    for (unsigned i = 0; i < header->symbol_count; i++) {
+        if (!in_file(header->string_size, symbols[i].name_offset, symbols[i].name_length)) {
+            set_error(error, error_size, "심볼 %u의 이름이 문자열 표를 벗어납니다", i);
+            return -1;
+        }
+    }
+
+    uint64_t checksum = hash64(bytes + sizeof(ImageHeader), size - sizeof(ImageHeader), IMAGE_CHECKSUM_SEED);
+    if (checksum != header->checksum) {
+        set_error(error, error_size, "체크섬이 맞지 않습니다 (손상된 이미지)");
+        return -1;
+    }
+
+    image->header = header;
+    image->segments = segments;
+    image->symbols = symbols;
+    image->strings = (const char *)bytes + header->string_offset;
+    return 0;
+}
+
+/*
+ * @brief 파일을 읽기 전용으로 mmap하고 검사합니다
+ * @param path 이미지 파일 경로
+ * @param image 결과 (성공하면 image_close로 해제)
+ * @param error 실패 이유 (NULL 가능)
+ * @param error_size error 크기
+ * @returns 성공 시 0, 실패 시 -1
+ */
+int image_open(const char *path, ProgramImage *image, char *error, size_t error_size) {
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    memset(image, 0, sizeof(*image));
+    if (fd < 0) {
+        set_error(error, error_size, "파일을 열 수 없습니다: %s", path);
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(ImageHeader)) {
+        close(fd);
+        set_error(error, error_size, "프로그램 이미지가 아닙니다: %s", path);
+        return -1;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // 매핑은 파일 디스크립터와 무관하게 유지됨
+    if (mapping == MAP_FAILED) {
+        set_error(error, error_size, "mmap 실패: %s", path);
+        return -1;
+    }
+
+    if (image_view(mapping, size, image, error, error_size) != 0) {
+        munmap(mapping, size);
+        return -1;
+    }
+    image->mapping = mapping;
+    image->mapping_size = size;
+    return 0;
+}
+
+/*
+ * @brief image_open의 매핑을 해제합니다 (image_view 결과면 아무것도 하지 않음)
+ * @param image 대상 이미지
+ * @returns 없음 (void)
+ */
+void image_close(ProgramImage *image) {
+    if (image->mapping) {
+        munmap(image->mapping, image->mapping_size);
+    }
+    memset(image, 0, sizeof(*image));
+}
+
+/*
+ * @brief 심볼 값을 찾습니다
+ * @param image 검사를 마친 이미지
+ * @param name 심볼 이름
+ * @param value 값
+ * @returns 있으면 0, 없으면 -1
+ */
+int image_find_symbol(const ProgramImage *image, const char *name, long *value) {
+    size_t length = strlen(name);
+
+    for (unsigned i = 0; i < image->header->symbol_count; i++) {
+        const ImageSymbol *symbol = &image->symbols[i];
+        if (symbol->name_length == length && memcmp(image->strings + symbol->name_offset, name, length) == 0) {
+            *value = symbol->value;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/*
+ * @brief 이미지 파일을 씁니다
+ * @param file 출력 파일 (바이너리 모드)
+ * @param spec 세그먼트/심볼/진입점
+ * @param error 실패 이유 (NULL 가능)
+ * @param error_size error 크기
+ * @returns 성공 시 0, 실패 시 -1
+ */
+int image_write(FILE *file, const ImageSpec *spec, char *error, size_t error_size) {
+    if (spec->segment_count > UINT16_MAX || spec->symbol_count > UINT16_MAX) {
+        set_error(error, error_size, "세그먼트/심볼이 너무 많습니다");
+        return -1;
+    }
+
+    // 1) 배치: 헤더 → 세그먼트 표 → 심볼 표 → 문자열 표 → 데이터
+    size_t symbol_offset = align_up(sizeof(ImageHeader) + spec->segment_count * sizeof(ImageSegment));
+    size_t string_offset = symbol_offset + spec->symbol_count * sizeof(ImageSymbol);
+    size_t string_size = 0;
+    for (unsigned i = 0; i < spec->symbol_count; i++) {
+        if (spec->symbols[i].length > UINT16_MAX) {
+            set_error(error, error_size, "심볼 이름이 너무 깁니다");
+            return -1;
+        }
+        string_size += spec->symbols[i].length;
+    }
+    size_t data_offset = align_up(string_offset + string_size);
+    size_t file_size = data_offset;
+    for (unsigned i = 0; i < spec->segment_count; i++) {
+        file_size = align_up(file_size + spec->segments[i].size);
+    }
+    if (file_size > UINT32_MAX) {
+        set_error(error, error_size, "이미지가 너무 큽니다");
+        return -1;
+    }
+
+    uint8_t *buffer = calloc(1, file_size);
+    if (!buffer) {
+        set_error(error, error_size, "메모리 부족");
+        return -1;
+    }
+
+    // 2) 채우기
+    ImageHeader *header = (ImageHeader *)buffer;
+    ImageSegment *segments = (ImageSegment *)(buffer + sizeof(ImageHeader));
+    ImageSymbol *symbols = (ImageSymbol *)(buffer + symbol_offset);
+    memcpy(header->magic, IMAGE_MAGIC, sizeof(header->magic));
+    header->version = IMAGE_VERSION;
+    header->flags = spec->has_registers ? IMAGE_FLAG_REGISTERS : 0;
+    header->entry_pc = spec->entry_pc;
+    header->segment_count = (uint16_t)spec->segment_count;
+    header->symbol_count = (uint16_t)spec->symbol_count;
+    header->symbol_offset = (uint32_t)symbol_offset;
+    header->string_offset = (uint32_t)string_offset;
+    header->string_size = (uint32_t)string_size;
+    header->file_size = (uint32_t)file_size;
+    if (spec->has_registers) {
+        memcpy(header->registers, spec->registers, sizeof(header->registers));
+    }
+
+    size_t offset = data_offset;
+    header->load_address = spec->segment_count ? UINT16_MAX : 0;
+    for (unsigned i = 0; i < spec->segment_count; i++) {
+        const ImageSegmentSpec *segment = &spec->segments[i];
+        segments[i].address = segment->address;
+        segments[i].size = segment->size;
+        segments[i].offset = (uint32_t)offset;
+        memcpy(buffer + offset, segment->data, segment->size);
+        offset = align_up(offset + segment->size);
+        if (segment->address < header->load_address) {
+            header->load_address = segment->address;
+        }
+    }
+
+    size_t name_offset = 0;
+    for (unsigned i = 0; i < spec->symbol_count; i++) {
+        symbols[i].name_offset = (uint32_t)name_offset;
+        symbols[i].name_length = (uint16_t)spec->symbols[i].length;
+        symbols[i].value = (int32_t)spec->symbols[i].value;
+        memcpy(buffer + string_offset + name_offset, spec->symbols[i].name, spec->symbols[i].length);
+        name_offset += spec->symbols[i].length;
+    }
+
+    header->checksum = hash64(buffer + sizeof(ImageHeader), file_size - sizeof(ImageHeader), IMAGE_CHECKSUM_SEED);
+
+    // 3) 한 번에 쓰기
+    int status = fwrite(buffer, 1, file_size, file) == file_size ? 0 : -1;
+    if (status != 0) {
+        set_error(error, error_size, "이미지 파일 쓰기 실패");
+    }
+    free(buffer);
+    return status;
+}
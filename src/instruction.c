@@ -1,6 +1,7 @@
 #include <instruction.h>
 #include <stdint.h>
 #include "alu.h"
+#include "alu_table.h"
 
 // ALU 핸들러 테이블 전역 변수
 op_handler handler_table[4];
@@ -16,6 +17,7 @@ op_handler handler_table[4];
  * - 0x01: 뺄셈 연산 (subtraction)
  * - 0x02: 곱셈 연산 (multiply)
  * - 0x03: 나눗셈 연산 (divide)
+ * 테이블 백엔드가 선택되어 있으면(alu_set_backend) alu_table_* 함수를 할당합니다.
  *
  * @example
  * init_handler_table();  // 테이블 초기화
@@ -24,6 +26,14 @@ op_handler handler_table[4];
  */
 void init_handler_table()
 {
+    if (alu_get_backend() == ALU_BACKEND_TABLE) {
+        handler_table[0x00] = alu_table_add;
+        handler_table[0x01] = alu_table_subtraction;
+        handler_table[0x02] = alu_table_multiply;
+        handler_table[0x03] = alu_table_divide;
+        return;
+    }
+    
     handler_table[0x00] = add;
     handler_table[0x01] = subtraction;
     handler_table[0x02] = multiply;
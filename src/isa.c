@@ -0,0 +1,391 @@
+/* src/isa.c - ISA 테이블 기반 인코더/디코더/디스어셈블러
+ * ------------------------------------------------------------
+ * include/isa.h의 ISA_INSTRUCTIONS에서 명령어 표를 만들고, 시작할 때 한 번
+ * 65536개 워드 전체의 디코드 테이블과 니모닉 완전 해시 슬롯을 채웁니다.
+ * 포맷별 인코딩/디스어셈블리 규칙만 여기에 있고 명령어별 규칙은 없습니다.
+ * Test Case: tests/isa_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/isa.h"
+#include "include/register.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ISA_TABLE_ENTRY(id, mnemonic, format, base, mask, exec) \
+    [ISA_##id] = { mnemonic, ISA_FMT_##format, (uint16_t)(base), (uint16_t)(mask) },
+const IsaInfo isa_table[ISA_COUNT] = {
+    [ISA_INVALID] = { "???", ISA_FMT_NONE, 0, 0 },
+    ISA_INSTRUCTIONS(ISA_TABLE_ENTRY)
+};
+#undef ISA_TABLE_ENTRY
+
+uint8_t isa_decode_table[65536];
+
+// 니모닉 해시 슬롯: 그 니모닉의 첫 줄 IsaId (0이면 빈 슬롯)
+static uint8_t mnemonic_slots[ISA_HASH_SIZE];
+static int isa_initialized = 0;
+
+/*
+ * @brief 니모닉 완전 해시 (현재 니모닉 집합에서 충돌 없음, isa_init이 확인)
+ * @param text 니모닉
+ * @param length 길이 (2 이상)
+ * @returns 슬롯 번호
+ *
+ * @details
+ * 2번째 글자, 마지막 두 글자, 길이만 보면 PADD/PADDS/PADD4처럼 접두사가 같은 니모닉도 구분됩니다.
+ */
+static unsigned mnemonic_hash(const char *text, size_t length) {
+    return (unsigned)(length + 7u * (uint8_t)text[1] + 6u * (uint8_t)text[length - 1] +
+                      4u * (uint8_t)text[length - 2]) & (ISA_HASH_SIZE - 1);
+}
+
+/*
+ * @brief 포맷별 추가 조건 (mask로 표현할 수 없는 레지스터 범위)
+ */
+static int format_accepts(IsaFormat format, uint16_t word) {
+    switch (format) {
+        case ISA_FMT_RR: {
+            uint8_t r1 = (word >> 8) & 0xF;
+            uint8_t r2 = (word >> 4) & 0xF;
+            return r1 >= 1 && r1 <= 7 && r2 >= 1 && r2 <= 7;
+        }
+        case ISA_FMT_RI: {
+            uint8_t reg = (word >> 8) & 0xF;
+            return reg >= 1 && reg <= 7;
+        }
+        case ISA_FMT_MEM: {
+            // 간접 모드는 하위 4비트만 주소 레지스터이고 나머지는 0 (어셈블러가 만드는 모양만 허용)
+            uint8_t reg = (word >> 8) & 0x7;
+            uint8_t addr_reg = word & 0xF;
+            if (reg == 0) {
+                return 0;
+            }
+            return !((word >> 8) & MEM_MODE_INDIRECT) || ((word & 0xF0) == 0 && addr_reg >= 1 && addr_reg <= 7);
+        }
+        default:
+            return 1;
+    }
+}
+
+/*
+ * @brief 디코드 테이블과 니모닉 해시를 만듭니다
+ * @param 없음
+ * @returns 성공 시 0, 니모닉 해시 충돌 시 -1
+ */
+int isa_init(void) {
+    if (isa_initialized) {
+        return 0;
+    }
+
+    for (uint32_t word = 0; word < 65536; word++) {
+        isa_decode_table[word] = ISA_INVALID;
+        for (int id = ISA_INVALID + 1; id < ISA_COUNT; id++) {
+            const IsaInfo *info = &isa_table[id];
+            if ((word & info->mask) == info->base && format_accepts(info->format, (uint16_t)word)) {
+                isa_decode_table[word] = (uint8_t)id;
+                break;
+            }
+        }
+    }
+
+    memset(mnemonic_slots, 0, sizeof(mnemonic_slots));
+    for (int id = ISA_INVALID + 1; id < ISA_COUNT; id++) {
+        const char *mnemonic = isa_table[id].mnemonic;
+        if (strcmp(mnemonic, isa_table[id - 1].mnemonic) == 0) {
+            continue; // 같은 니모닉의 다른 포맷
+        }
+        unsigned slot = mnemonic_hash(mnemonic, strlen(mnemonic));
+        if (mnemonic_slots[slot] != ISA_INVALID) {
+            printf("❌ 니모닉 해시 충돌: %s / %s\n", mnemonic, isa_table[mnemonic_slots[slot]].mnemonic);
+            return -1;
+        }
+        mnemonic_slots[slot] = (uint8_t)id;
+    }
+
+    isa_initialized = 1;
+    return 0;
+}
+
+/*
+ * @brief 니모닉으로 명령어 표의 줄을 찾습니다
+ * @param mnemonic 니모닉 (대소문자 구분)
+ * @returns 그 니모닉의 첫 줄, 없으면 ISA_INVALID
+ */
+IsaId isa_lookup(const char *mnemonic) {
+    size_t length = strlen(mnemonic);
+    if (length < 2) {
+        return ISA_INVALID;
+    }
+
+    IsaId id = (IsaId)mnemonic_slots[mnemonic_hash(mnemonic, length)];
+    if (id == ISA_INVALID || strcmp(isa_table[id].mnemonic, mnemonic) != 0) {
+        return ISA_INVALID;
+    }
+    return id;
+}
+
+/*
+ * @brief 레지스터 이름을 번호로 변환합니다
+ * @param text 레지스터 문자열 (예: "R1")
+ * @returns 레지스터 번호 (1-7), 실패 시 -1
+ */
+int isa_parse_register(const char *text) {
+    if (text[0] == 'R' && strlen(text) == 2 && text[1] >= '1' && text[1] <= '7') {
+        return text[1] - '0';
+    }
+    return -1;
+}
+
+/*
+ * @brief 벡터 레지스터 이름을 번호로 변환합니다
+ * @param text 레지스터 문자열 (예: "V2")
+ * @returns 레지스터 번호 (0-3), 실패 시 -1
+ */
+int isa_parse_vector_register(const char *text) {
+    if (text[0] == 'V' && strlen(text) == 2 && text[1] >= '0' && text[1] < '0' + VREG_COUNT) {
+        return text[1] - '0';
+    }
+    return -1;
+}
+
+/*
+ * @brief 10진수/16진수(0x) 숫자를 읽습니다
+ * @returns 숫자 전체를 읽었으면 1
+ */
+static int parse_number(const char *text, long *value) {
+    char *end;
+    if (!text[0]) {
+        return 0;
+    }
+    *value = strtol(text, &end, 0);
+    return *end == '\0';
+}
+
+/*
+ * @brief 피연산자 문자열 하나를 분류합니다
+ * @param text 피연산자 ("" 이면 ISA_OPND_NONE)
+ * @param operand 결과
+ * @returns 없음 (void)
+ */
+void isa_parse_operand(const char *text, IsaOperand *operand) {
+    char inner[32];
+    size_t length = strlen(text);
+    int reg;
+
+    operand->kind = ISA_OPND_INVALID;
+    operand->value = 0;
+
+    if (length == 0) {
+        operand->kind = ISA_OPND_NONE;
+    } else if ((reg = isa_parse_register(text)) > 0) {
+        operand->kind = ISA_OPND_REG;
+        operand->value = reg;
+    } else if ((reg = isa_parse_vector_register(text)) >= 0) {
+        operand->kind = ISA_OPND_VREG;
+        operand->value = reg;
+    } else if (text[0] == '[' && text[length - 1] == ']' && length >= 3 && length - 2 < sizeof(inner)) {
+        memcpy(inner, text + 1, length - 2);
+        inner[length - 2] = '\0';
+        if ((reg = isa_parse_register(inner)) > 0) {
+            operand->kind = ISA_OPND_MEM_REG;
+            operand->value = reg;
+        } else if (parse_number(inner, &operand->value)) {
+            operand->kind = ISA_OPND_MEM;
+        }
+    } else if (parse_number(text, &operand->value)) {
+        operand->kind = ISA_OPND_IMM;
+    }
+}
+
+/*
+ * @brief 한 줄(포맷)로 피연산자를 인코딩합니다
+ * @returns 1이면 성공, 0이면 피연산자 모양이 이 포맷이 아님, -1이면 모양은 맞지만 값 오류
+ */
+static int encode_format(const IsaInfo *info, const IsaOperand *op1, const IsaOperand *op2, uint16_t *word,
+                         char *error, size_t error_size) {
+    long a = op1->value;
+    long b = op2->value;
+
+    switch (info->format) {
+        case ISA_FMT_RR:
+            if (op1->kind != ISA_OPND_REG || op2->kind != ISA_OPND_REG) return 0;
+            *word = (uint16_t)(info->base | (a << 8) | (b << 4));
+            return 1;
+        case ISA_FMT_I6:
+            if (op1->kind != ISA_OPND_IMM || (op2->kind != ISA_OPND_IMM && op2->kind != ISA_OPND_NONE)) return 0;
+            if (a < 0 || a > 63 || b < 0 || b > 63) {
+                snprintf(error, error_size, "6비트 즉시값 범위 오류 (0-63): %ld, %ld", a, b);
+                return -1;
+            }
+            *word = (uint16_t)(info->base | (a << 6) | b);
+            return 1;
+        case ISA_FMT_RI:
+            if (op1->kind != ISA_OPND_REG || op2->kind != ISA_OPND_IMM) return 0;
+            if (b < 0 || b > 255) {
+                snprintf(error, error_size, "즉시값 범위 오류 (0-255): %ld", b);
+                return -1;
+            }
+            *word = (uint16_t)(info->base | (a << 8) | b);
+            return 1;
+        case ISA_FMT_MEM:
+            if (op1->kind != ISA_OPND_REG) return 0;
+            if (op2->kind == ISA_OPND_MEM_REG) {
+                *word = (uint16_t)(info->base | ((MEM_MODE_INDIRECT | a) << 8) | b);
+                return 1;
+            }
+            if (op2->kind != ISA_OPND_MEM) {
+                snprintf(error, error_size, "주소는 [주소] 또는 [레지스터] 형식이어야 합니다");
+                return -1;
+            }
+            if (b < 0 || b >= MEMORY_SIZE) {
+                snprintf(error, error_size, "주소 범위 오류 (0-%d): %ld", MEMORY_SIZE - 1, b);
+                return -1;
+            }
+            *word = (uint16_t)(info->base | (a << 8) | b);
+            return 1;
+        case ISA_FMT_PACKED:
+            if (op1->kind != ISA_OPND_VREG || op2->kind != ISA_OPND_VREG) {
+                snprintf(error, error_size, "패킹 연산은 벡터 레지스터(V0-V%d) 두 개가 필요합니다", VREG_COUNT - 1);
+                return -1;
+            }
+            *word = (uint16_t)(info->base | (a << 10) | (b << 8));
+            return 1;
+        case ISA_FMT_VMEM:
+            if (op1->kind != ISA_OPND_VREG || op2->kind != ISA_OPND_MEM) {
+                snprintf(error, error_size, "형식: %s V레지스터, [주소]", info->mnemonic);
+                return -1;
+            }
+            if (b < 0 || b >= MEMORY_SIZE) {
+                snprintf(error, error_size, "주소 범위 오류 (0-%d): %ld", MEMORY_SIZE - 1, b);
+                return -1;
+            }
+            *word = (uint16_t)(info->base | (a << 8) | b);
+            return 1;
+        case ISA_FMT_NONE:
+            if (op1->kind != ISA_OPND_NONE) return 0;
+            *word = info->base;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * @brief 분류된 피연산자로 명령어 워드를 인코딩합니다
+ * @param first 니모닉의 첫 줄 (isa_lookup 결과)
+ * @param operand1 첫 번째 피연산자
+ * @param operand2 두 번째 피연산자
+ * @param word 인코딩 결과
+ * @param error 실패 시 오류 메시지 (NULL 가능)
+ * @param error_size error 버퍼 크기
+ * @returns 성공 시 0, 실패 시 -1
+ *
+ * @details
+ * 같은 니모닉의 줄들을 순서대로 시도하고, 인코딩한 워드가 디코더에서 같은 줄로
+ * 돌아오지 않으면(다른 포맷과 겹치는 비트 패턴) 거부합니다.
+ */
+int isa_encode_operands(IsaId first, const IsaOperand *operand1, const IsaOperand *operand2, uint16_t *word,
+                        char *error, size_t error_size) {
+    char discard[8];
+
+    if (!error) {
+        error = discard;
+        error_size = sizeof(discard);
+    }
+    isa_init();
+
+    for (int id = first; id < ISA_COUNT && strcmp(isa_table[id].mnemonic, isa_table[first].mnemonic) == 0; id++) {
+        int encoded = encode_format(&isa_table[id], operand1, operand2, word, error, error_size);
+        if (encoded < 0) {
+            return -1;
+        }
+        if (encoded == 0) {
+            continue;
+        }
+        if ((int)isa_decode(*word) != id) {
+            snprintf(error, error_size, "0x%04X는 %s 포맷으로 해석되므로 인코딩할 수 없습니다",
+                     *word, isa_table[isa_decode(*word)].mnemonic);
+            return -1;
+        }
+        return 0;
+    }
+
+    snprintf(error, error_size, "%s의 피연산자 형식 오류", isa_table[first].mnemonic);
+    return -1;
+}
+
+/*
+ * @brief 니모닉과 피연산자 문자열을 명령어 워드로 인코딩합니다
+ * @param mnemonic 니모닉
+ * @param operand1 첫 번째 피연산자 ("" 가능)
+ * @param operand2 두 번째 피연산자 ("" 가능)
+ * @param word 인코딩 결과
+ * @returns 성공 시 0, 실패 시 -1 (오류는 출력)
+ */
+int isa_encode(const char *mnemonic, const char *operand1, const char *operand2, uint16_t *word) {
+    IsaOperand op1, op2;
+    char error[128];
+
+    isa_init();
+
+    IsaId first = isa_lookup(mnemonic);
+    if (first == ISA_INVALID) {
+        printf("❌ 알 수 없는 명령어: %s\n", mnemonic);
+        return -1;
+    }
+
+    isa_parse_operand(operand1, &op1);
+    isa_parse_operand(operand2, &op2);
+    if (isa_encode_operands(first, &op1, &op2, word, error, sizeof(error)) != 0) {
+        printf("❌ %s %s, %s: %s\n", mnemonic, operand1, operand2, error);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * @brief 명령어 워드를 어셈블리로 변환합니다
+ * @param word 명령어 워드
+ * @param output 출력 문자열
+ * @param max_length 출력 버퍼 크기
+ * @returns 변환 성공 시 1, 알 수 없는 워드면 0
+ */
+int isa_disassemble(uint16_t word, char *output, int max_length) {
+    isa_init();
+
+    IsaId id = isa_decode(word);
+    const IsaInfo *info = &isa_table[id];
+
+    switch (id == ISA_INVALID ? ISA_FMT_COUNT : info->format) {
+        case ISA_FMT_RR:
+            snprintf(output, max_length, "%s R%d, R%d", info->mnemonic, (word >> 8) & 0xF, (word >> 4) & 0xF);
+            return 1;
+        case ISA_FMT_I6:
+            snprintf(output, max_length, "%s %d, %d", info->mnemonic, (word >> 6) & 0x3F, word & 0x3F);
+            return 1;
+        case ISA_FMT_RI:
+            snprintf(output, max_length, "%s R%d, %d", info->mnemonic, (word >> 8) & 0xF, word & 0xFF);
+            return 1;
+        case ISA_FMT_MEM:
+            if ((word >> 8) & MEM_MODE_INDIRECT) {
+                snprintf(output, max_length, "%s R%d, [R%d]", info->mnemonic, (word >> 8) & 0x7, word & 0xF);
+            } else {
+                snprintf(output, max_length, "%s R%d, [%d]", info->mnemonic, (word >> 8) & 0x7, word & 0xFF);
+            }
+            return 1;
+        case ISA_FMT_PACKED:
+            snprintf(output, max_length, "%s V%d, V%d", info->mnemonic, (word >> 10) & 0x3, (word >> 8) & 0x3);
+            return 1;
+        case ISA_FMT_VMEM:
+            snprintf(output, max_length, "%s V%d, [%d]", info->mnemonic, (word >> 8) & 0x3, word & 0xFF);
+            return 1;
+        case ISA_FMT_NONE:
+            snprintf(output, max_length, "%s", info->mnemonic);
+            return 1;
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,213 @@
+/* src/json_writer.c - 할당 없는 스트리밍 JSON 출력 구현
+ * ------------------------------------------------------------
+ * 정수는 printf 없이 뒤에서부터 자릿수를 채우고, 문자열은 이스케이프가 필요 없는 구간을 통째로 복사합니다.
+ * 0~255 바이트 배열(메모리, 캐시 블록)은 항목마다 쉼표와 자릿수를 한 번에 붙여 씁니다.
+ * Test Case: tests/json_writer_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/json_writer.h"
+
+#include <string.h>
+
+/*
+ * @brief JSON 출력기를 초기화합니다
+ * @param writer JSON 출력기
+ * @param buffer 출력 버퍼
+ * @param capacity 버퍼 크기
+ * @returns 없음 (void)
+ */
+void jw_init(JsonWriter *writer, char *buffer, size_t capacity) {
+    memset(writer, 0, sizeof(*writer));
+    writer->buffer = buffer;
+    writer->capacity = capacity;
+}
+
+static void put(JsonWriter *writer, const char *text, size_t length) {
+    if (writer->overflow || writer->capacity - writer->length < length) {
+        writer->overflow = 1;
+        return;
+    }
+    memcpy(writer->buffer + writer->length, text, length);
+    writer->length += length;
+}
+
+static void put_char(JsonWriter *writer, char c) {
+    if (writer->overflow || writer->length >= writer->capacity) {
+        writer->overflow = 1;
+        return;
+    }
+    writer->buffer[writer->length++] = c;
+}
+
+/*
+ * @brief 값/키 앞의 쉼표를 처리합니다
+ */
+static void begin_item(JsonWriter *writer) {
+    uint32_t bit = 1U << writer->depth;
+
+    if (writer->after_key) {
+        writer->after_key = 0;
+        return;
+    }
+    if (writer->has_items & bit) {
+        put_char(writer, ',');
+    }
+    writer->has_items |= bit;
+}
+
+static void open_scope(JsonWriter *writer, char c) {
+    begin_item(writer);
+    put_char(writer, c);
+    if (writer->depth + 1 >= JW_MAX_DEPTH) {
+        writer->overflow = 1;
+        return;
+    }
+    writer->depth++;
+    writer->has_items &= ~(1U << writer->depth);
+}
+
+static void close_scope(JsonWriter *writer, char c) {
+    if (writer->depth == 0) {
+        writer->overflow = 1;
+        return;
+    }
+    writer->depth--;
+    put_char(writer, c);
+}
+
+void jw_begin_object(JsonWriter *writer) {
+    open_scope(writer, '{');
+}
+
+void jw_end_object(JsonWriter *writer) {
+    close_scope(writer, '}');
+}
+
+void jw_begin_array(JsonWriter *writer) {
+    open_scope(writer, '[');
+}
+
+void jw_end_array(JsonWriter *writer) {
+    close_scope(writer, ']');
+}
+
+/*
+ * @brief 객체 키를 씁니다 (다음 호출이 값)
+ * @param writer JSON 출력기
+ * @param key 키 (이스케이프 없이 그대로 씀)
+ * @returns 없음 (void)
+ */
+void jw_key(JsonWriter *writer, const char *key) {
+    begin_item(writer);
+    put_char(writer, '"');
+    put(writer, key, strlen(key));
+    put(writer, "\":", 2);
+    writer->after_key = 1;
+}
+
+void jw_uint64(JsonWriter *writer, uint64_t value) {
+    char digits[20];
+    size_t count = 0;
+
+    begin_item(writer);
+    do {
+        digits[sizeof(digits) - 1 - count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    put(writer, digits + sizeof(digits) - count, count);
+}
+
+void jw_int(JsonWriter *writer, long value) {
+    if (value < 0) {
+        begin_item(writer);
+        put_char(writer, '-');
+        writer->after_key = 1;  // 부호 뒤에 쉼표가 오지 않도록
+        jw_uint64(writer, (uint64_t)0 - (uint64_t)value);
+        return;
+    }
+    jw_uint64(writer, (uint64_t)value);
+}
+
+void jw_bool(JsonWriter *writer, int value) {
+    begin_item(writer);
+    if (value) {
+        put(writer, "true", 4);
+    } else {
+        put(writer, "false", 5);
+    }
+}
+
+/*
+ * @brief 문자열 값을 씁니다
+ * @param writer JSON 출력기
+ * @param text NUL 종료 문자열 (UTF-8)
+ * @returns 없음 (void)
+ */
+void jw_string(JsonWriter *writer, const char *text) {
+    static const char hex[] = "0123456789abcdef";
+    const char *run = text;
+
+    begin_item(writer);
+    put_char(writer, '"');
+    for (const char *p = text; *p; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        put(writer, run, (size_t)(p - run));
+        run = p + 1;
+        if (c == '"' || c == '\\') {
+            char escaped[2] = { '\\', (char)c };
+            put(writer, escaped, 2);
+        } else if (c == '\n') {
+            put(writer, "\\n", 2);
+        } else {
+            char escaped[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+            put(writer, escaped, 6);
+        }
+    }
+    put(writer, run, strlen(run));
+    put_char(writer, '"');
+}
+
+/*
+ * @brief 0~255 정수 배열을 씁니다
+ * @param writer JSON 출력기
+ * @param bytes 값
+ * @param count 개수
+ * @returns 없음 (void)
+ */
+void jw_byte_array(JsonWriter *writer, const uint8_t *bytes, size_t count) {
+    jw_begin_array(writer);
+    for (size_t i = 0; i < count; i++) {
+        char digits[4];
+        size_t length = 0;
+        uint8_t value = bytes[i];
+
+        if (i) {
+            digits[length++] = ',';
+        }
+        if (value >= 100) {
+            digits[length++] = (char)('0' + value / 100);
+        }
+        if (value >= 10) {
+            digits[length++] = (char)('0' + value / 10 % 10);
+        }
+        digits[length++] = (char)('0' + value % 10);
+        put(writer, digits, length);
+    }
+    jw_end_array(writer);
+}
+
+/*
+ * @brief 출력을 끝냅니다
+ * @param writer JSON 출력기
+ * @returns 쓴 길이, 공간이 모자랐거나 중첩이 맞지 않으면 0
+ */
+size_t jw_finish(const JsonWriter *writer) {
+    if (writer->overflow || writer->depth != 0) {
+        return 0;
+    }
+    return writer->length;
+}
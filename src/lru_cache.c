@@ -0,0 +1,233 @@
+/* src/lru_cache.c - 메모리 상한이 있는 내용 주소 LRU 캐시 구현
+ * ------------------------------------------------------------
+ * 해시 버킷 체인으로 찾고, 이중 연결 목록으로 사용 순서를 유지합니다.
+ * 조회/저장/퇴출 모두 O(1)이며, 항목 수가 버킷 수를 넘으면 버킷을 두 배로 늘립니다.
+ * Test Case: tests/lru_cache_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/lru_cache.h"
+#include "include/hash.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LRU_BUCKETS_INITIAL 64U
+#define LRU_HASH_SEED       0x4C5255ULL    /* "LRU" */
+#define LRU_VALUE_ALIGN     8U              /* 값을 구조체로 바로 읽을 수 있게 정렬 */
+
+struct LruEntry {
+    LruEntry *prev;             /* 사용 순서 (head 쪽이 최근) */
+    LruEntry *next;
+    LruEntry *chain;            /* 같은 버킷의 다음 항목 */
+    uint64_t hash;
+    size_t key_length;
+    size_t value_length;
+    uint64_t data[];            /* 키, 정렬 여백, 값 */
+};
+
+static size_t value_offset(size_t key_length) {
+    return (key_length + LRU_VALUE_ALIGN - 1) & ~(size_t)(LRU_VALUE_ALIGN - 1);
+}
+
+static size_t entry_size(size_t key_length, size_t value_length) {
+    return sizeof(LruEntry) + value_offset(key_length) + value_length;
+}
+
+static void list_unlink(LruCache *cache, LruEntry *entry) {
+    if (entry->prev) entry->prev->next = entry->next;
+    else cache->head = entry->next;
+    if (entry->next) entry->next->prev = entry->prev;
+    else cache->tail = entry->prev;
+}
+
+static void list_push_front(LruCache *cache, LruEntry *entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head) cache->head->prev = entry;
+    else cache->tail = entry;
+    cache->head = entry;
+}
+
+/*
+ * @brief 키가 같은 항목을 가리키는 체인 링크를 찾습니다 (없으면 체인 끝의 NULL 링크)
+ */
+static LruEntry** find_link(LruCache *cache, const void *key, size_t key_length, uint64_t hash) {
+    LruEntry **link = &cache->buckets[hash & (cache->bucket_count - 1)];
+
+    while (*link) {
+        LruEntry *entry = *link;
+        if (entry->hash == hash && entry->key_length == key_length &&
+            memcmp(entry->data, key, key_length) == 0) {
+            break;
+        }
+        link = &entry->chain;
+    }
+    return link;
+}
+
+/*
+ * @brief 항목을 버킷과 사용 목록에서 빼고 해제합니다
+ */
+static void remove_entry(LruCache *cache, LruEntry *entry) {
+    LruEntry **link = &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+
+    while (*link != entry) {
+        link = &(*link)->chain;
+    }
+    *link = entry->chain;
+    list_unlink(cache, entry);
+    cache->bytes -= entry_size(entry->key_length, entry->value_length);
+    cache->entry_count--;
+    free(entry);
+}
+
+static void grow_buckets(LruCache *cache) {
+    size_t new_count = cache->bucket_count * 2;
+    LruEntry **grown = calloc(new_count, sizeof(LruEntry *));
+
+    if (!grown) {
+        return; // 체인이 길어질 뿐 동작은 그대로
+    }
+    for (size_t i = 0; i < cache->bucket_count; i++) {
+        LruEntry *entry = cache->buckets[i];
+        while (entry) {
+            LruEntry *chain = entry->chain;
+            LruEntry **slot = &grown[entry->hash & (new_count - 1)];
+            entry->chain = *slot;
+            *slot = entry;
+            entry = chain;
+        }
+    }
+    free(cache->buckets);
+    cache->buckets = grown;
+    cache->bucket_count = new_count;
+}
+
+/*
+ * @brief 빈 캐시를 만듭니다
+ * @param cache 초기화할 캐시
+ * @param max_bytes 항목 전체 크기 상한 (바이트)
+ * @returns 성공 시 0, 메모리 부족 시 -1
+ */
+int lru_init(LruCache *cache, size_t max_bytes) {
+    memset(cache, 0, sizeof(*cache));
+    cache->buckets = calloc(LRU_BUCKETS_INITIAL, sizeof(LruEntry *));
+    if (!cache->buckets) {
+        return -1;
+    }
+    cache->bucket_count = LRU_BUCKETS_INITIAL;
+    cache->max_bytes = max_bytes;
+    return 0;
+}
+
+/*
+ * @brief 모든 항목을 버립니다 (통계는 유지)
+ * @param cache 대상 캐시
+ * @returns 없음 (void)
+ */
+void lru_clear(LruCache *cache) {
+    LruEntry *entry = cache->head;
+
+    while (entry) {
+        LruEntry *next = entry->next;
+        free(entry);
+        entry = next;
+    }
+    if (cache->buckets) {
+        memset(cache->buckets, 0, cache->bucket_count * sizeof(LruEntry *));
+    }
+    cache->head = NULL;
+    cache->tail = NULL;
+    cache->entry_count = 0;
+    cache->bytes = 0;
+}
+
+/*
+ * @brief 항목과 버킷 배열을 해제합니다
+ * @param cache 대상 캐시
+ * @returns 없음 (void)
+ */
+void lru_free(LruCache *cache) {
+    lru_clear(cache);
+    free(cache->buckets);
+    memset(cache, 0, sizeof(*cache));
+}
+
+/*
+ * @brief 키의 값을 찾고 그 항목을 가장 최근으로 옮깁니다
+ * @param cache 대상 캐시
+ * @param key 키 바이트열
+ * @param key_length 키 길이
+ * @param value_length 값 길이 (NULL 가능)
+ * @returns 값 포인터, 없으면 NULL
+ */
+const void* lru_get(LruCache *cache, const void *key, size_t key_length, size_t *value_length) {
+    LruEntry *entry = *find_link(cache, key, key_length, hash64(key, key_length, LRU_HASH_SEED));
+
+    if (!entry) {
+        cache->stats.misses++;
+        return NULL;
+    }
+    cache->stats.hits++;
+    if (cache->head != entry) {
+        list_unlink(cache, entry);
+        list_push_front(cache, entry);
+    }
+    if (value_length) {
+        *value_length = entry->value_length;
+    }
+    return (const uint8_t *)entry->data + value_offset(entry->key_length);
+}
+
+/*
+ * @brief 키에 값을 저장합니다 (같은 키가 있으면 교체)
+ * @param cache 대상 캐시
+ * @param key 키 바이트열
+ * @param key_length 키 길이
+ * @param value 값 바이트열
+ * @param value_length 값 길이
+ * @returns 저장하면 0, 항목이 상한보다 크거나 메모리 부족이면 -1
+ *
+ * @details
+ * 새 항목을 넣을 자리가 생길 때까지 tail(가장 오래된 항목)부터 버립니다.
+ */
+int lru_put(LruCache *cache, const void *key, size_t key_length, const void *value, size_t value_length) {
+    size_t size = entry_size(key_length, value_length);
+    uint64_t hash = hash64(key, key_length, LRU_HASH_SEED);
+
+    if (size > cache->max_bytes) {
+        return -1;
+    }
+
+    LruEntry *existing = *find_link(cache, key, key_length, hash);
+    if (existing) {
+        remove_entry(cache, existing);
+    }
+    while (cache->bytes + size > cache->max_bytes && cache->tail) {
+        remove_entry(cache, cache->tail);
+        cache->stats.evictions++;
+    }
+
+    LruEntry *entry = malloc(size);
+    if (!entry) {
+        return -1;
+    }
+    entry->hash = hash;
+    entry->key_length = key_length;
+    entry->value_length = value_length;
+    memcpy(entry->data, key, key_length);
+    memcpy((uint8_t *)entry->data + value_offset(key_length), value, value_length);
+
+    if (cache->entry_count >= cache->bucket_count) {
+        grow_buckets(cache);
+    }
+    LruEntry **slot = &cache->buckets[hash & (cache->bucket_count - 1)];
+    entry->chain = *slot;
+    *slot = entry;
+    list_push_front(cache, entry);
+    cache->entry_count++;
+    cache->bytes += size;
+    cache->stats.insertions++;
+    return 0;
+}
@@ -1,19 +1,19 @@
 #include "include/websocket_server.h"
 #include "include/cpu.h"
+#include "include/alu_table.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <signal.h>
 #include <unistd.h>
+#include <string.h>
 
 /*
- * @brief 신호 처리기 - 서버 종료 시 정리 작업을 수행합니다
+ * @brief 신호 처리기 - 서비스 스레드를 멈추게 합니다 (정리는 ws_server_run이 돌아온 뒤 main에서)
  * @param sig 신호 번호
  * @returns 없음 (void)
  */
 static void signal_handler(int sig) {
-    printf("\n서버를 종료합니다...\n");
-    ws_server_cleanup();
-    exit(0);
+    ws_server_stop();
 }
 
 /*
@@ -24,6 +24,8 @@ static void signal_handler(int sig) {
  */
 int main(int argc, char *argv[]) {
     int port = WS_PORT;
+    int threads = 0;
+    int workers = 0;
     
     // 명령행 인자로 포트 지정 가능
     if (argc > 1) {
@@ -34,16 +36,41 @@ int main(int argc, char *argv[]) {
         }
     }
     
+    // ALU 백엔드 선택 (CPU_ALU_BACKEND=table이면 테이블 조회)
+    const char *backend = getenv("CPU_ALU_BACKEND");
+    if (backend && strcmp(backend, "table") == 0) {
+        alu_set_backend(ALU_BACKEND_TABLE);
+    }
+    
+    // 서비스 스레드 수 (CPU_WS_THREADS, 기본은 코어 수)
+    const char *thread_env = getenv("CPU_WS_THREADS");
+    if (thread_env) {
+        threads = atoi(thread_env);
+    }
+    
+    // 워커 스레드 수 (CPU_WS_WORKERS, 기본은 코어 수, 음수면 워커 없이 서비스 스레드에서 실행)
+    const char *worker_env = getenv("CPU_WS_WORKERS");
+    if (worker_env) {
+        workers = atoi(worker_env);
+    }
+    
+    // 트레이스 파일 디렉터리 (CPU_WS_TRACE_DIR, 기본은 현재 디렉터리, 클라이언트는 이름만 고름)
+    ws_server_set_trace_dir(getenv("CPU_WS_TRACE_DIR"));
+    
+    // 이미지 디렉터리 (CPU_WS_IMAGE_DIR, 없으면 load_image를 받지 않음, 클라이언트는 이름만 고름)
+    ws_server_set_image_dir(getenv("CPU_WS_IMAGE_DIR"));
+    
     // 신호 핸들러 등록
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
     
     printf("CPU WebSocket 서버 시작\n");
     printf("포트: %d\n", port);
+    printf("ALU 백엔드: %s\n", alu_backend_name(alu_get_backend()));
     printf("Ctrl+C로 종료\n\n");
     
     // WebSocket 서버 초기화
-    if (ws_server_init(port) != 0) {
+    if (ws_server_init(port, threads, workers) != 0) {
         fprintf(stderr, "서버 초기화 실패\n");
         return 1;
     }
@@ -52,6 +79,7 @@ int main(int argc, char *argv[]) {
     int result = ws_server_run();
     
     // 정리
+    printf("\n서버를 종료합니다...\n");
     ws_server_cleanup();
     
     return result;
@@ -7,6 +7,7 @@
 */
 
 #include "include/memory.h"
+#include "include/trace.h"
 
 #include <stdint.h>
 #include <string.h>
@@ -18,6 +19,18 @@
  */
 void init_memory(Memory *memory) {
     memset(memory->data, 0, MEMORY_SIZE);
+    memory->cache_enabled = 1;
+    memory->access_log_pos = 0;
+}
+
+/*
+ * @brief 캐시 모델 없이 접근한 주소를 링 버퍼에 기록합니다 (캐시 워밍용)
+ * @param memory Memory 구조체 포인터
+ * @param entry 주소 | 쓰기 비트
+ * @returns 없음 (void)
+ */
+static inline void log_access(Memory *memory, uint32_t entry) {
+    memory->access_log[memory->access_log_pos++ & (MEMORY_ACCESS_LOG_SIZE - 1)] = entry;
 }
 
 /*
@@ -30,6 +43,17 @@ uint8_t memory_read(Memory *memory, uint16_t address) {
     if(address >= MEMORY_SIZE) {
         return 0; // 잘못된 주소 접근 시 0 반환
     }
+    if(!memory->cache_enabled) {
+        log_access(memory, address);
+        if(TRACE_ACTIVE()) trace_note_access(address, memory->data[address], 0, 0);
+        return memory->data[address];
+    }
+    if(TRACE_ACTIVE()) {
+        uint64_t misses = memory->cache.stats.misses;
+        uint8_t value = cache_read(&memory->cache, memory->data, MEMORY_SIZE, address);
+        trace_note_access(address, value, 0, memory->cache.stats.misses != misses);
+        return value;
+    }
     return cache_read(&memory->cache, memory->data, MEMORY_SIZE, address);
 }
 
@@ -44,5 +68,73 @@ void memory_write(Memory *memory, uint16_t address, uint8_t value) {
     if(address >= MEMORY_SIZE) {
         return; // 잘못된 주소 접근 시 아무 작업도 하지 않음
     }
+    if(!memory->cache_enabled) {
+        log_access(memory, address | MEMORY_ACCESS_WRITE);
+        if(TRACE_ACTIVE()) trace_note_access(address, value, 1, 0);
+        memory->data[address] = value;
+        return;
+    }
+    if(TRACE_ACTIVE()) {
+        uint64_t misses = memory->cache.stats.misses;
+        cache_write(&memory->cache, memory->data, MEMORY_SIZE, address, value);
+        trace_note_access(address, value, 1, memory->cache.stats.misses != misses);
+        return;
+    }
     cache_write(&memory->cache, memory->data, MEMORY_SIZE, address, value);
 }
+
+/*
+ * @brief 캐시 상태/통계를 바꾸지 않고 메모리 값을 확인합니다 (UI/디버깅용)
+ * @param memory Memory 구조체 포인터 (캐시 + 실제 메모리 포함)
+ * @param address 확인할 메모리 주소
+ * @returns 캐시를 반영한 최신 값 (1바이트), 주소가 잘못된 경우 0 반환
+ */
+uint8_t memory_peek(const Memory *memory, uint16_t address) {
+    if(address >= MEMORY_SIZE) {
+        return 0;
+    }
+    return cache_peek(&memory->cache, memory->data, MEMORY_SIZE, address);
+}
+
+/*
+ * @brief 캐시 모델을 켜거나 끕니다
+ * @param memory Memory 구조체 포인터
+ * @param enabled 1이면 캐시 모델 사용, 0이면 data[]에 직접 접근
+ * @param warmup_accesses 켤 때 다시 재생할 최근 접근 수 (최대 MEMORY_ACCESS_LOG_SIZE)
+ * @returns 없음 (void)
+ *
+ * @details
+ * 끌 때는 dirty 라인을 먼저 메모리에 반영해 data[]가 최신이 되도록 합니다.
+ * 켤 때는 캐시 없이 실행한 마지막 N개의 접근을 재생해 캐시를 데운 뒤 통계를 0으로 만듭니다.
+ */
+void memory_set_cache_enabled(Memory *memory, int enabled, unsigned warmup_accesses) {
+    if(!enabled) {
+        if(memory->cache_enabled) {
+            cache_flush(&memory->cache, memory->data, MEMORY_SIZE);
+            memory->cache_enabled = 0;
+            memory->access_log_pos = 0;
+        }
+        return;
+    }
+    if(memory->cache_enabled) {
+        return;
+    }
+
+    uint32_t count = memory->access_log_pos;
+    if(count > MEMORY_ACCESS_LOG_SIZE) count = MEMORY_ACCESS_LOG_SIZE;
+    if(count > warmup_accesses) count = warmup_accesses;
+
+    cache_init(&memory->cache);
+    for(uint32_t i = memory->access_log_pos - count; i != memory->access_log_pos; i++) {
+        uint32_t entry = memory->access_log[i & (MEMORY_ACCESS_LOG_SIZE - 1)];
+        uint16_t address = entry & 0xFFFF;
+        if(entry & MEMORY_ACCESS_WRITE) {
+            // 이미 data[]에 기록된 값을 다시 쓰면 write-allocate + dirty 상태가 재현됨
+            cache_write(&memory->cache, memory->data, MEMORY_SIZE, address, memory->data[address]);
+        } else {
+            cache_read(&memory->cache, memory->data, MEMORY_SIZE, address);
+        }
+    }
+    memset(&memory->cache.stats, 0, sizeof(memory->cache.stats));
+    memory->cache_enabled = 1;
+}
@@ -0,0 +1,760 @@
+/* src/ooo.c - 비순차(Out-of-Order) 슈퍼스칼라 코어 구현
+ * ------------------------------------------------------------
+ * 명령어를 micro-op으로 쪼개 RAT로 리네이밍한 뒤 기능 유닛별 예약 스테이션에 issue하고,
+ * 실행이 끝난 결과는 CDB로 브로드캐스트, ROB 순서대로 커밋합니다.
+ * Test Case: tests/ooo_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/ooo.h"
+#include "include/alu.h"
+#include "include/cpu.h"
+#include "include/cache.h"
+#include "include/flags.h"
+#include "include/isa.h"
+#include "include/simd.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char *fu_names[OOO_FU_COUNT] = { "ADD/SUB", "MUL", "DIV", "LOAD/STORE" };
+
+/*
+ * @brief 기본 코어 구성 값을 채웁니다 (2-wide, ROB 16)
+ * @param config 채울 구성 구조체 포인터
+ * @returns 없음 (void)
+ */
+void ooo_default_config(OOO_Config *config) {
+    memset(config, 0, sizeof(*config));
+    config->issue_width = 2;
+    config->commit_width = 2;
+    config->rob_size = 16;
+
+    config->rs_size[OOO_FU_ADD] = 4;
+    config->rs_size[OOO_FU_MUL] = 2;
+    config->rs_size[OOO_FU_DIV] = 2;
+    config->rs_size[OOO_FU_LS]  = 4;
+
+    config->fu_units[OOO_FU_ADD] = 2;
+    config->fu_units[OOO_FU_MUL] = 1;
+    config->fu_units[OOO_FU_DIV] = 1;
+    config->fu_units[OOO_FU_LS]  = 1;
+
+    config->latency[OOO_FU_ADD] = 1;
+    config->latency[OOO_FU_MUL] = 3;
+    config->latency[OOO_FU_DIV] = 8;
+    config->latency[OOO_FU_LS]  = 2;
+}
+
+/*
+ * @brief 구성 값을 지원 범위로 잘라냅니다
+ * @param config 보정할 구성 구조체 포인터
+ * @returns 없음 (void)
+ */
+static void clamp_config(OOO_Config *config) {
+    if (config->issue_width < 1) config->issue_width = 1;
+    if (config->issue_width > OOO_MAX_ISSUE_WIDTH) config->issue_width = OOO_MAX_ISSUE_WIDTH;
+    if (config->commit_width < 1) config->commit_width = 1;
+    if (config->rob_size < 1) config->rob_size = 1;
+    if (config->rob_size > OOO_MAX_ROB_SIZE) config->rob_size = OOO_MAX_ROB_SIZE;
+
+    for (int fu = 0; fu < OOO_FU_COUNT; fu++) {
+        if (config->rs_size[fu] < 1) config->rs_size[fu] = 1;
+        if (config->rs_size[fu] > OOO_MAX_RS_SIZE) config->rs_size[fu] = OOO_MAX_RS_SIZE;
+        if (config->fu_units[fu] < 1) config->fu_units[fu] = 1;
+        if (config->fu_units[fu] > OOO_MAX_FU_UNITS) config->fu_units[fu] = OOO_MAX_FU_UNITS;
+        if (config->latency[fu] < 1) config->latency[fu] = 1;
+    }
+}
+
+/*
+ * @brief 파이프라인(ROB, 예약 스테이션, RAT, 디코드 버퍼)을 비웁니다
+ * @param core 대상 코어
+ * @returns 없음 (void)
+ */
+static void clear_pipeline(OOO_Core *core) {
+    memset(core->rob, 0, sizeof(core->rob));
+    memset(core->rs, 0, sizeof(core->rs));
+    memset(core->fu_busy, 0, sizeof(core->fu_busy));
+    core->rob_head = 0;
+    core->rob_count = 0;
+    core->pending_count = 0;
+    core->pending_pos = 0;
+    for (int r = 0; r < 8; r++) {
+        core->rat[r] = -1;
+    }
+}
+
+/*
+ * @brief OoO 코어를 초기화합니다
+ * @param core 초기화할 코어
+ * @param config 사용할 구성 (NULL이면 기본값)
+ * @returns 없음 (void)
+ */
+void ooo_init(OOO_Core *core, const OOO_Config *config) {
+    memset(core, 0, sizeof(*core));
+    if (config) {
+        core->config = *config;
+    } else {
+        ooo_default_config(&core->config);
+    }
+    clamp_config(&core->config);
+    isa_init();
+
+    reset_registers(&core->regs);
+    init_memory(&core->memory);
+    cache_init(&core->memory.cache);
+    clear_pipeline(core);
+}
+
+/*
+ * @brief 코어 전용 메모리에 프로그램을 로드합니다
+ * @param core 대상 코어
+ * @param program 프로그램 바이트 배열
+ * @param size 프로그램 크기 (바이트)
+ * @returns 없음 (void)
+ */
+void ooo_load_program(OOO_Core *core, const uint8_t *program, size_t size) {
+    if (size <= MEMORY_SIZE) {
+        memcpy(core->memory.data, program, size);
+    }
+}
+
+/*
+ * @brief ALU opcode를 담당 기능 유닛으로 매핑합니다
+ * @param alu_op ALU opcode (0~3)
+ * @returns 기능 유닛 종류
+ */
+static OOO_FuClass alu_fu_class(uint8_t alu_op) {
+    switch (alu_op) {
+        case 2:  return OOO_FU_MUL;
+        case 3:  return OOO_FU_DIV;
+        default: return OOO_FU_ADD;
+    }
+}
+
+/*
+ * @brief 16비트 명령어를 micro-op 목록으로 쪼갭니다 (decode_and_execute와 동일한 의미)
+ * @param pc 명령어 주소
+ * @param instruction 16비트 명령어
+ * @param uops 출력 micro-op 배열 (OOO_MAX_UOPS 이상)
+ * @returns 생성된 micro-op 수
+ */
+static unsigned crack_instruction(uint16_t pc, uint16_t instruction, OOO_Uop *uops) {
+    uint8_t opcode = (instruction >> 12) & 0xF;
+    IsaId id = isa_decode(instruction);
+    unsigned n = 0;
+
+    memset(uops, 0, sizeof(OOO_Uop) * OOO_MAX_UOPS);
+
+    switch (isa_table[id].format) {
+    // LOAD/STORE: 직접 주소 또는 레지스터 간접 주소
+    case ISA_FMT_MEM: {
+        uint8_t reg_num = (instruction >> 8) & 0x7;
+        uint8_t addr_reg = 0;
+        uint8_t address = instruction & 0xFF;
+
+        if ((instruction >> 8) & MEM_MODE_INDIRECT) {
+            addr_reg = instruction & 0xF;
+            address = 0;
+            if (addr_reg < 1 || addr_reg > 7) break;
+        }
+        if (reg_num < 1) break;
+
+        if (id == ISA_LOAD) {
+            uops[n].type = OOO_UOP_LOAD;
+            uops[n].dest = reg_num;
+            uops[n].src1 = addr_reg;
+            uops[n].imm1 = address;
+        } else {
+            uops[n].type = OOO_UOP_STORE;
+            uops[n].src1 = reg_num;
+            uops[n].src2 = addr_reg;
+            uops[n].imm2 = address;
+        }
+        n++;
+        break;
+    }
+
+    // MOV 레지스터, 즉시값
+    case ISA_FMT_RI:
+        uops[n].type = OOO_UOP_MOVI;
+        uops[n].dest = (instruction >> 8) & 0xF;
+        uops[n].imm1 = instruction & 0xFF;
+        n++;
+        break;
+
+    // ALU 레지스터 포맷: 결과는 R7
+    case ISA_FMT_RR:
+        uops[n].type = OOO_UOP_ALU;
+        uops[n].alu_op = opcode;
+        uops[n].dest = 7;
+        uops[n].src1 = (instruction >> 8) & 0xF;
+        uops[n].src2 = (instruction >> 4) & 0xF;
+        n++;
+        break;
+
+    // 기존 포맷: 6비트 피연산자는 항상 즉시값/주소
+    case ISA_FMT_I6: {
+        uint8_t reg1_val = (instruction >> 6) & 0x3F;
+        uint8_t reg2_val = instruction & 0x3F;
+
+        if (id == ISA_MOV_I6) {
+            uops[n].type = OOO_UOP_STORE;
+            uops[n].imm1 = reg2_val;
+            uops[n].imm2 = reg1_val;
+            n++;
+            break;
+        }
+
+        // R1 = 첫 번째, R2 = 두 번째, R7 = 결과, 메모리[70 + opcode] = 결과
+        uops[n].type = OOO_UOP_MOVI; uops[n].dest = 1; uops[n].imm1 = reg1_val; n++;
+        uops[n].type = OOO_UOP_MOVI; uops[n].dest = 2; uops[n].imm1 = reg2_val; n++;
+
+        uops[n].type = OOO_UOP_ALU;
+        uops[n].alu_op = opcode;
+        uops[n].dest = 7;
+        uops[n].imm1 = reg1_val;
+        uops[n].imm2 = reg2_val;
+        n++;
+
+        uops[n].type = OOO_UOP_STORE;
+        uops[n].src1 = 7;
+        uops[n].imm2 = 70 + opcode;
+        n++;
+        break;
+    }
+
+    // 패킹 SIMD/벡터 메모리: 벡터 레지스터는 리네이밍하지 않으므로 커밋 시 순차 실행
+    case ISA_FMT_PACKED:
+    case ISA_FMT_VMEM:
+        uops[n].type = OOO_UOP_SIMD;
+        uops[n].word = instruction;
+        n++;
+        break;
+
+    // MARK, 알 수 없는 워드는 NOP
+    default:
+        break;
+    }
+
+    if (n == 0) {
+        uops[n].type = OOO_UOP_NOP;
+        n++;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        uops[i].pc = pc;
+    }
+    uops[n - 1].last = 1;
+    return n;
+}
+
+/*
+ * @brief 다음 명령어를 fetch/decode하여 디코드 버퍼를 채웁니다
+ * @param core 대상 코어
+ * @returns 디코드 버퍼에 micro-op이 있으면 1, 없으면 0
+ */
+static int fill_decode_buffer(OOO_Core *core) {
+    if (core->pending_pos < core->pending_count) {
+        return 1;
+    }
+    if (core->fetch_halted) {
+        return 0;
+    }
+    if (core->fetch_pc >= MEMORY_SIZE - 1) {
+        core->fetch_halted = 1;
+        return 0;
+    }
+
+    uint16_t instruction = (memory_read(&core->memory, core->fetch_pc) << 8) |
+                           memory_read(&core->memory, core->fetch_pc + 1);
+
+    // 순차 코어와 마찬가지로 빈 명령어(0x0000)에서 멈춤
+    if (instruction == 0) {
+        core->fetch_halted = 1;
+        return 0;
+    }
+
+    core->pending_count = crack_instruction(core->fetch_pc, instruction, core->pending);
+    core->pending_pos = 0;
+    core->fetch_pc += 2;
+    return 1;
+}
+
+/*
+ * @brief 소스 피연산자를 리네이밍합니다 (값 또는 생산자 ROB 태그)
+ * @param core 대상 코어
+ * @param reg 소스 레지스터 (0 = 즉시값)
+ * @param imm 즉시값
+ * @param value 준비된 값을 받을 포인터
+ * @returns 생산자 ROB 인덱스, 값이 이미 준비되었으면 -1
+ */
+static int rename_source(OOO_Core *core, uint8_t reg, uint8_t imm, uint8_t *value) {
+    if (reg == 0) {
+        *value = imm;
+        return -1;
+    }
+
+    int tag = core->rat[reg];
+    if (tag < 0) {
+        *value = get_register(&core->regs, reg);
+        return -1;
+    }
+    if (core->rob[tag].ready) {
+        *value = core->rob[tag].value;
+        return -1;
+    }
+    *value = 0;
+    return tag;
+}
+
+/*
+ * @brief 기능 유닛 종류에서 비어 있는 예약 스테이션을 찾습니다
+ * @param core 대상 코어
+ * @param fu 기능 유닛 종류
+ * @returns 예약 스테이션 인덱스, 없으면 -1
+ */
+static int find_free_rs(OOO_Core *core, OOO_FuClass fu) {
+    for (unsigned i = 0; i < core->config.rs_size[fu]; i++) {
+        if (!core->rs[fu][i].busy) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * @brief issue 단계: 디코드된 micro-op을 ROB와 예약 스테이션에 배치합니다
+ * @param core 대상 코어
+ * @returns 없음 (void)
+ */
+static void issue_stage(OOO_Core *core) {
+    for (unsigned slot = 0; slot < core->config.issue_width; slot++) {
+        if (!fill_decode_buffer(core)) {
+            return;
+        }
+
+        if (core->rob_count >= core->config.rob_size) {
+            core->stats.rob_full_stalls++;
+            return;
+        }
+
+        OOO_Uop *uop = &core->pending[core->pending_pos];
+        int is_mem = (uop->type == OOO_UOP_LOAD || uop->type == OOO_UOP_STORE);
+        int needs_fu = (uop->type == OOO_UOP_ALU || is_mem);
+        OOO_FuClass fu = is_mem ? OOO_FU_LS : alu_fu_class(uop->alu_op);
+        int rs_index = -1;
+
+        if (needs_fu) {
+            rs_index = find_free_rs(core, fu);
+            if (rs_index < 0) {
+                core->stats.rs_full_stalls[fu]++;
+                return;
+            }
+        }
+
+        unsigned tail = (core->rob_head + core->rob_count) % core->config.rob_size;
+        OOO_RobEntry *entry = &core->rob[tail];
+        memset(entry, 0, sizeof(*entry));
+        entry->busy = 1;
+        entry->type = uop->type;
+        entry->dest = uop->dest;
+        entry->pc = uop->pc;
+        entry->last = uop->last;
+        entry->word = uop->word;
+        entry->writes_flag = (uop->type == OOO_UOP_ALU);
+
+        if (needs_fu) {
+            OOO_RSEntry *rs = &core->rs[fu][rs_index];
+            memset(rs, 0, sizeof(*rs));
+            rs->busy = 1;
+            rs->alu_op = uop->alu_op;
+            rs->rob = (int)tail;
+            rs->seq = core->seq++;
+            // 소스 리네이밍은 목적지 RAT 갱신 전에 해야 자기 자신을 참조하지 않음
+            rs->qj = rename_source(core, uop->src1, uop->imm1, &rs->vj);
+            rs->qk = (uop->type == OOO_UOP_LOAD) ? -1 : rename_source(core, uop->src2, uop->imm2, &rs->vk);
+        } else {
+            // MOVI/NOP은 기능 유닛 없이 바로 완료 (SIMD는 커밋 시 실행)
+            entry->value = uop->imm1;
+            entry->ready = 1;
+        }
+
+        if (uop->dest >= 1 && uop->dest <= 7) {
+            core->rat[uop->dest] = (int)tail;
+        }
+
+        core->rob_count++;
+        core->pending_pos++;
+    }
+}
+
+/*
+ * @brief 완료된 결과를 CDB로 브로드캐스트해 대기 중인 피연산자를 깨웁니다
+ * @param core 대상 코어
+ * @param rob ROB 인덱스
+ * @param value 결과 값
+ * @returns 없음 (void)
+ */
+static void broadcast_result(OOO_Core *core, int rob, uint8_t value) {
+    for (int fu = 0; fu < OOO_FU_COUNT; fu++) {
+        for (unsigned i = 0; i < core->config.rs_size[fu]; i++) {
+            OOO_RSEntry *rs = &core->rs[fu][i];
+            if (!rs->busy) continue;
+            if (rs->qj == rob) { rs->vj = value; rs->qj = -1; }
+            if (rs->qk == rob) { rs->vk = value; rs->qk = -1; }
+        }
+    }
+}
+
+/*
+ * @brief ROB 엔트리가 커밋 시 메모리에 기록하는지 확인합니다 (STORE, VSTORE)
+ * @param entry ROB 엔트리
+ * @returns 기록하면 1, 아니면 0
+ */
+static int writes_memory(const OOO_RobEntry *entry) {
+    if (entry->type == OOO_UOP_SIMD) {
+        return isa_table[isa_decode(entry->word)].format == ISA_FMT_VMEM &&
+               ((entry->word >> 8) & VMEM_STORE) != 0;
+    }
+    return entry->type == OOO_UOP_STORE;
+}
+
+/*
+ * @brief LOAD보다 앞선 STORE가 아직 커밋되지 않았는지 확인합니다
+ * @param core 대상 코어
+ * @param rob LOAD의 ROB 인덱스
+ * @returns 커밋 대기 중인 STORE가 있으면 1, 없으면 0
+ *
+ * @details
+ * STORE는 커밋 시점에 메모리에 기록하므로, 주소 비교 없이 보수적으로 기다립니다.
+ */
+static int older_store_pending(const OOO_Core *core, int rob) {
+    for (unsigned i = core->rob_head; (int)i != rob; i = (i + 1) % core->config.rob_size) {
+        if (writes_memory(&core->rob[i])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * @brief 실행/쓰기 단계: 진행 중인 연산을 진행시키고, 끝난 결과를 기록한 뒤 새 연산을 시작합니다
+ * @param core 대상 코어
+ * @returns 없음 (void)
+ */
+static void execute_stage(OOO_Core *core) {
+    // 1) 진행 중인 연산 완료 처리 (write result)
+    for (int fu = 0; fu < OOO_FU_COUNT; fu++) {
+        for (unsigned i = 0; i < core->config.rs_size[fu]; i++) {
+            OOO_RSEntry *rs = &core->rs[fu][i];
+            if (!rs->busy || !rs->executing) continue;
+            if (--rs->remaining > 0) continue;
+
+            OOO_RobEntry *entry = &core->rob[rs->rob];
+            if (entry->type == OOO_UOP_STORE) {
+                entry->value = rs->vj;
+            } else if (entry->type == OOO_UOP_LOAD) {
+                // 값은 실행 시작 시 캐시에서 읽어 둠
+            } else {
+                entry->value = alu_compute(rs->alu_op, rs->vj, rs->vk, NULL);
+                entry->alu_op = rs->alu_op;
+                entry->flag_a = rs->vj;
+                entry->flag_b = rs->vk;
+            }
+            entry->ready = 1;
+
+            rs->busy = 0;
+            core->fu_busy[fu]--;
+            broadcast_result(core, rs->rob, entry->value);
+        }
+    }
+
+    // 2) 피연산자가 준비된 가장 오래된 연산부터 유닛에 배정
+    for (int fu = 0; fu < OOO_FU_COUNT; fu++) {
+        for (;;) {
+            OOO_RSEntry *oldest = NULL;
+            for (unsigned i = 0; i < core->config.rs_size[fu]; i++) {
+                OOO_RSEntry *rs = &core->rs[fu][i];
+                if (!rs->busy || rs->executing || rs->qj >= 0 || rs->qk >= 0) continue;
+                if (core->rob[rs->rob].type == OOO_UOP_LOAD && older_store_pending(core, rs->rob)) {
+                    core->stats.memory_order_stalls++;
+                    continue;
+                }
+                if (!oldest || rs->seq < oldest->seq) oldest = rs;
+            }
+            if (!oldest) break;
+
+            if (core->fu_busy[fu] >= core->config.fu_units[fu]) {
+                core->stats.fu_busy_stalls[fu]++;
+                break;
+            }
+
+            oldest->executing = 1;
+            oldest->remaining = core->config.latency[fu];
+            core->fu_busy[fu]++;
+
+            OOO_RobEntry *entry = &core->rob[oldest->rob];
+            if (entry->type == OOO_UOP_LOAD) {
+                // 캐시 미스면 블록을 가져오는 만큼 실행이 길어짐
+                uint64_t misses = core->memory.cache.stats.misses;
+                entry->address = oldest->vj;
+                entry->value = memory_read(&core->memory, entry->address);
+                if (core->memory.cache.stats.misses != misses) {
+                    oldest->remaining += CACHE_MISS_PENALTY;
+                }
+            } else if (entry->type == OOO_UOP_STORE) {
+                entry->address = oldest->vk;
+            }
+        }
+    }
+}
+
+/*
+ * @brief 패킹 SIMD/벡터 메모리 명령어를 실행합니다 (커밋 단계)
+ * @param core 대상 코어
+ * @param entry ROB head의 SIMD 엔트리
+ * @returns 이미 fetch된 명령어를 VSTORE가 덮어썼으면 1, 아니면 0
+ *
+ * @details
+ * 앞선 micro-op이 모두 커밋된 뒤이므로 순차 코어(exec_packed/exec_vmem)와 같은 상태에서 실행됩니다.
+ */
+static int commit_simd(OOO_Core *core, const OOO_RobEntry *entry) {
+    uint16_t instruction = entry->word;
+
+    if (isa_table[isa_decode(instruction)].format == ISA_FMT_PACKED) {
+        uint8_t vd = (instruction >> 10) & 0x3;
+        uint8_t vs = (instruction >> 8) & 0x3;
+        uint8_t op = (instruction >> PACKED_OP_SHIFT) & 0x3;
+        unsigned lanes = (instruction & PACKED_LANES8) ? 8 : 4;
+
+        simd_packed_op(op, (instruction & PACKED_SATURATE) != 0, lanes, core->regs.vreg[vd], core->regs.vreg[vs]);
+        return 0;
+    }
+
+    uint8_t control = (instruction >> 8) & 0xF;
+    uint8_t *vreg = core->regs.vreg[control & 0x3];
+    unsigned lanes = (control & VMEM_LANES8) ? 8 : 4;
+    int overwrote = 0;
+
+    for (unsigned i = 0; i < lanes; i++) {
+        uint16_t lane_address = ((instruction & 0xFF) + i) % MEMORY_SIZE;
+        if (control & VMEM_STORE) {
+            memory_write(&core->memory, lane_address, vreg[i]);
+            if (lane_address >= entry->pc + 2 && lane_address <= core->fetch_pc + 1) {
+                overwrote = 1;
+            }
+        } else {
+            vreg[i] = memory_read(&core->memory, lane_address);
+        }
+    }
+    return overwrote;
+}
+
+/*
+ * @brief 커밋 단계: ROB head부터 순서대로 아키텍처 상태에 반영합니다
+ * @param core 대상 코어
+ * @returns 없음 (void)
+ */
+static void commit_stage(OOO_Core *core) {
+    for (unsigned n = 0; n < core->config.commit_width && core->rob_count > 0; n++) {
+        int index = (int)core->rob_head;
+        OOO_RobEntry *entry = &core->rob[index];
+        if (!entry->ready) {
+            return;
+        }
+
+        if (entry->dest >= 1 && entry->dest <= 7) {
+            set_register(&core->regs, entry->dest, entry->value);
+            if (core->rat[entry->dest] == index) {
+                core->rat[entry->dest] = -1;
+            }
+        }
+        if (entry->writes_flag) {
+            flags_record(&core->regs, FLAG_OP_ADD + entry->alu_op, entry->flag_a, entry->flag_b, entry->value);
+        }
+
+        core->rob_head = (core->rob_head + 1) % core->config.rob_size;
+        core->rob_count--;
+        core->stats.uops++;
+
+        int flush = 0;
+        if (entry->type == OOO_UOP_STORE) {
+            memory_write(&core->memory, entry->address, entry->value);
+
+            // 이미 fetch된(또는 멈춘 위치의) 명령어를 덮어썼다면 다음 명령어부터 다시 fetch
+            if (entry->address >= entry->pc + 2 && entry->address <= core->fetch_pc + 1) {
+                flush = 1;
+            }
+        } else if (entry->type == OOO_UOP_SIMD) {
+            flush = commit_simd(core, entry);
+        }
+
+        if (entry->last) {
+            core->stats.instructions++;
+            core->regs.pc = entry->pc + 2;
+        }
+
+        if (flush) {
+            uint16_t next_pc = entry->pc + 2;   // clear_pipeline이 entry를 지우기 전에 보관
+            clear_pipeline(core);
+            core->fetch_pc = next_pc;
+            core->fetch_halted = 0;
+            core->stats.pipeline_flushes++;
+            return;
+        }
+    }
+}
+
+/*
+ * @brief 코어를 한 사이클 진행합니다
+ * @param core 대상 코어
+ * @returns 아직 실행할 것이 남아 있으면 1, 완료되었으면 0
+ */
+int ooo_cycle(OOO_Core *core) {
+    if (ooo_is_done(core)) {
+        return 0;
+    }
+
+    // 같은 사이클 안에서 결과가 앞 단계로 새지 않도록 역순으로 진행
+    commit_stage(core);
+    execute_stage(core);
+    issue_stage(core);
+
+    core->stats.cycles++;
+    return !ooo_is_done(core);
+}
+
+/*
+ * @brief 프로그램이 끝나거나 최대 사이클에 도달할 때까지 실행합니다
+ * @param core 대상 코어
+ * @param max_cycles 최대 사이클 수 (0 = 제한 없음)
+ * @returns 실행한 사이클 수
+ */
+uint64_t ooo_run(OOO_Core *core, uint64_t max_cycles) {
+    uint64_t start = core->stats.cycles;
+    while (!ooo_is_done(core)) {
+        if (max_cycles && core->stats.cycles - start >= max_cycles) {
+            break;
+        }
+        ooo_cycle(core);
+    }
+    return core->stats.cycles - start;
+}
+
+/*
+ * @brief 모든 명령어가 커밋되었는지 확인합니다
+ * @param core 대상 코어
+ * @returns 완료 시 1, 아니면 0
+ */
+int ooo_is_done(const OOO_Core *core) {
+    return core->fetch_halted && core->rob_count == 0 &&
+           core->pending_pos >= core->pending_count;
+}
+
+/*
+ * @brief 사이클당 커밋된 명령어 수(IPC)를 계산합니다
+ * @param core 대상 코어
+ * @returns IPC, 사이클이 0이면 0
+ */
+double ooo_ipc(const OOO_Core *core) {
+    if (core->stats.cycles == 0) {
+        return 0.0;
+    }
+    return (double)core->stats.instructions / (double)core->stats.cycles;
+}
+
+/*
+ * @brief 실행 통계(IPC, 구조적 해저드 스톨)를 출력합니다
+ * @param core 대상 코어
+ * @returns 없음 (void)
+ */
+void ooo_print_stats(const OOO_Core *core) {
+    const OOO_Stats *s = &core->stats;
+
+    printf("=== OoO 코어 통계 (issue %u, ROB %u) ===\n",
+           core->config.issue_width, core->config.rob_size);
+    printf("사이클: %llu, 명령어: %llu, micro-op: %llu, IPC: %.3f\n",
+           (unsigned long long)s->cycles, (unsigned long long)s->instructions,
+           (unsigned long long)s->uops, ooo_ipc(core));
+    printf("ROB 가득 참 스톨: %llu\n", (unsigned long long)s->rob_full_stalls);
+    for (int fu = 0; fu < OOO_FU_COUNT; fu++) {
+        printf("  %-10s RS 가득 참: %llu, 유닛 대기: %llu\n", fu_names[fu],
+               (unsigned long long)s->rs_full_stalls[fu],
+               (unsigned long long)s->fu_busy_stalls[fu]);
+    }
+    printf("파이프라인 비움: %llu, 메모리 순서 대기: %llu\n",
+           (unsigned long long)s->pipeline_flushes, (unsigned long long)s->memory_order_stalls);
+    printf("캐시 히트: %llu, 미스: %llu\n",
+           (unsigned long long)core->memory.cache.stats.hits,
+           (unsigned long long)core->memory.cache.stats.misses);
+}
+
+/*
+ * @brief 같은 프로그램을 순차 코어(cpu_step)와 OoO 코어로 실행해 아키텍처 상태를 비교합니다
+ * @param program 프로그램 바이트 배열
+ * @param size 프로그램 크기 (바이트)
+ * @param config OoO 코어 구성 (NULL이면 기본값)
+ * @returns 일치하면 0, 불일치하면 -1
+ *
+ * @details
+ * 두 코어 모두 스택의 지역 상태에서 실행하므로 호출자의 CPU 상태는 바뀌지 않습니다.
+ */
+int ooo_verify_against_sequential(const uint8_t *program, size_t size, const OOO_Config *config) {
+    OOO_Core core;
+    CPU_Context seq_ctx;
+
+    // 순차 코어 실행 (cpu_init은 핸들러 테이블 초기화용, 전환한 뒤 불러야 호출자 상태를 건드리지 않음)
+    cpu_context_init(&seq_ctx);
+    CPU_Context *previous = cpu_set_context(&seq_ctx);
+    cpu_init();
+    cpu_load_program(program, size);
+    for (unsigned steps = 0; steps < MEMORY_SIZE && seq_ctx.regs.pc < MEMORY_SIZE - 1; steps++) {
+        if (fetch_instruction() == 0) break;
+        cpu_step();
+    }
+    cpu_set_context(previous);
+    cache_flush(&seq_ctx.memory.cache, seq_ctx.memory.data, MEMORY_SIZE);
+    CPU_Registers seq_regs = seq_ctx.regs;
+    uint8_t seq_data[MEMORY_SIZE];
+    memcpy(seq_data, seq_ctx.memory.data, MEMORY_SIZE);
+
+    // OoO 코어 실행
+    ooo_init(&core, config);
+    ooo_load_program(&core, program, size);
+    ooo_run(&core, 0);
+    cache_flush(&core.memory.cache, core.memory.data, MEMORY_SIZE);
+
+    int mismatch = 0;
+    for (uint8_t r = 0; r <= 7; r++) {
+        if (get_register(&seq_regs, r) != get_register(&core.regs, r)) {
+            printf("❌ OoO 검증 실패: R%d 순차=%d, OoO=%d\n", r,
+                   get_register(&seq_regs, r), get_register(&core.regs, r));
+            mismatch = 1;
+        }
+    }
+    if (get_flags(&seq_regs) != get_flags(&core.regs)) {
+        printf("❌ OoO 검증 실패: 플래그 순차=0x%X, OoO=0x%X\n",
+               get_flags(&seq_regs), get_flags(&core.regs));
+        mismatch = 1;
+    }
+    for (int v = 0; v < VREG_COUNT; v++) {
+        if (memcmp(seq_regs.vreg[v], core.regs.vreg[v], VREG_LANES) != 0) {
+            printf("❌ OoO 검증 실패: V%d 불일치\n", v);
+            mismatch = 1;
+        }
+    }
+    for (int i = 0; i < MEMORY_SIZE; i++) {
+        if (seq_data[i] != core.memory.data[i]) {
+            printf("❌ OoO 검증 실패: 메모리[%d] 순차=%d, OoO=%d\n", i, seq_data[i], core.memory.data[i]);
+            mismatch = 1;
+        }
+    }
+
+    if (!mismatch) {
+        printf("✅ OoO 검증 성공: %llu 명령어, %llu 사이클 (IPC %.3f)\n",
+               (unsigned long long)core.stats.instructions,
+               (unsigned long long)core.stats.cycles, ooo_ipc(&core));
+    }
+    return mismatch ? -1 : 0;
+}
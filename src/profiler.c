@@ -0,0 +1,276 @@
+/* src/profiler.c - PC별 실행 프로파일러 구현
+ * ------------------------------------------------------------
+ * cpu_step()은 profiler_record()로 카운터만 올리고, 사이클 계산·정렬·디스어셈블리는
+ * 모두 보고 시점에 합니다. 프로파일은 현재 스레드의 CPU 컨텍스트에 붙습니다.
+ * Test Case: tests/profiler_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/profiler.h"
+#include "include/cpu.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char *opcode_names[PROFILE_OPCODES] = {
+    "ADD", "SUB", "MUL", "DIV", "MOV", "LOAD", "STORE", "OP7",
+    "PACKED", "VMEM", "OP10", "OP11", "OP12", "OP13", "OP14", "SYS"
+};
+
+/*
+ * @brief 현재 컨텍스트에서 프로파일링을 켭니다
+ * @param 없음
+ * @returns 성공 시 PROFILER_OK, 메모리 할당 실패 시 PROFILER_ERR_NOMEM
+ *
+ * @details
+ * 처음 켤 때 카운터를 할당하고 0으로 시작합니다. 다시 켜면 이전 결과에 이어서 셉니다.
+ * 실패를 출력하지 않으므로 호출자가 반환값으로 알립니다.
+ */
+int profiler_enable(void) {
+    CPU_Context *ctx = cpu_get_context();
+
+    if (!ctx->profile) {
+        ctx->profile = calloc(1, sizeof(Profile));
+        if (!ctx->profile) {
+            return PROFILER_ERR_NOMEM;
+        }
+    }
+    ctx->profiling = 1;
+    return PROFILER_OK;
+}
+
+/*
+ * @brief 현재 컨텍스트의 프로파일링을 끕니다 (결과는 남김)
+ * @param 없음
+ * @returns 없음 (void)
+ */
+void profiler_disable(void) {
+    cpu_get_context()->profiling = 0;
+}
+
+/*
+ * @brief 현재 컨텍스트에서 프로파일링이 켜져 있는지 확인합니다
+ * @param 없음
+ * @returns 켜져 있으면 1, 아니면 0
+ */
+int profiler_is_enabled(void) {
+    return cpu_get_context()->profiling;
+}
+
+/*
+ * @brief 현재 컨텍스트의 프로파일 카운터를 0으로 되돌립니다
+ * @param 없음
+ * @returns 없음 (void)
+ */
+void profiler_reset(void) {
+    Profile *profile = cpu_get_context()->profile;
+
+    if (profile) {
+        memset(profile, 0, sizeof(*profile));
+    }
+}
+
+/*
+ * @brief 현재 컨텍스트의 프로파일을 반환합니다
+ * @param 없음
+ * @returns 프로파일 포인터 (한 번도 켜지 않았으면 NULL)
+ */
+Profile* profiler_get(void) {
+    return cpu_get_context()->profile;
+}
+
+/*
+ * @brief PC의 명령어 워드를 읽습니다 (캐시 상태는 건드리지 않음)
+ */
+static uint16_t profile_word(const Memory *memory, uint16_t pc) {
+    if (pc + 1 >= MEMORY_SIZE) {
+        return 0;
+    }
+    return (uint16_t)((memory_peek(memory, pc) << 8) | memory_peek(memory, (uint16_t)(pc + 1)));
+}
+
+static uint64_t profile_cycles(uint64_t count, uint64_t misses) {
+    return count * CPU_BASE_CYCLES + misses * CACHE_MISS_PENALTY;
+}
+
+static int compare_hotspots(const void *a, const void *b) {
+    const ProfileHotspot *x = a;
+    const ProfileHotspot *y = b;
+
+    if (x->cycles != y->cycles) {
+        return x->cycles < y->cycles ? 1 : -1;
+    }
+    return (int)x->pc - (int)y->pc;
+}
+
+/*
+ * @brief 실행된 PC들을 사이클이 많은 순서로 정렬해 돌려줍니다
+ * @param profile 프로파일
+ * @param memory 명령어를 읽을 메모리
+ * @param out 결과 배열
+ * @param max_count out에 담을 최대 개수
+ * @returns out에 담은 개수
+ */
+int profiler_hotspots(const Profile *profile, const Memory *memory, ProfileHotspot *out, int max_count) {
+    ProfileHotspot all[MEMORY_SIZE];
+    int n = 0;
+
+    if (!profile || !out || max_count <= 0) {
+        return 0;
+    }
+
+    for (uint16_t pc = 0; pc < MEMORY_SIZE; pc++) {
+        if (profile->count[pc] == 0) {
+            continue;
+        }
+        all[n].pc = pc;
+        all[n].word = profile_word(memory, pc);
+        all[n].count = profile->count[pc];
+        all[n].misses = profile->misses[pc];
+        all[n].cycles = profile_cycles(profile->count[pc], profile->misses[pc]);
+        n++;
+    }
+
+    qsort(all, (size_t)n, sizeof(all[0]), compare_hotspots);
+    if (n > max_count) {
+        n = max_count;
+    }
+    memcpy(out, all, (size_t)n * sizeof(all[0]));
+    return n;
+}
+
+/*
+ * @brief PC별 카운터를 opcode(상위 4비트)별로 합칩니다
+ * @param profile 프로파일
+ * @param memory 명령어를 읽을 메모리
+ * @param out opcode별 합계 (PROFILE_OPCODES개)
+ * @returns 없음 (void)
+ */
+void profiler_opcodes(const Profile *profile, const Memory *memory, ProfileOpcode out[PROFILE_OPCODES]) {
+    memset(out, 0, sizeof(ProfileOpcode) * PROFILE_OPCODES);
+    if (!profile) {
+        return;
+    }
+
+    for (uint16_t pc = 0; pc < MEMORY_SIZE; pc++) {
+        if (profile->count[pc] == 0) {
+            continue;
+        }
+        ProfileOpcode *op = &out[profile_word(memory, pc) >> 12];
+        op->count += profile->count[pc];
+        op->misses += profile->misses[pc];
+        op->cycles += profile_cycles(profile->count[pc], profile->misses[pc]);
+    }
+}
+
+/*
+ * @brief opcode 이름을 반환합니다
+ * @param opcode 4비트 opcode
+ * @returns 이름 문자열
+ */
+const char* profiler_opcode_name(uint8_t opcode) {
+    return opcode_names[opcode & 0xF];
+}
+
+/*
+ * @brief 명령어 워드를 어셈블리 문자열로 바꿉니다 (disasm이 NULL이거나 실패하면 16진수)
+ */
+static void profile_disasm(uint16_t word, profiler_disasm_fn disasm, char *out, int max_length) {
+    uint8_t bytes[2] = { (uint8_t)(word >> 8), (uint8_t)(word & 0xFF) };
+
+    if (!disasm || !disasm(bytes, 2, out, max_length)) {
+        snprintf(out, (size_t)max_length, "0x%04X", word);
+    }
+}
+
+/*
+ * @brief 핫스팟 보고서를 출력합니다
+ * @param profile 프로파일
+ * @param memory 명령어를 읽을 메모리
+ * @param out 출력 스트림
+ * @param top_n 출력할 최대 PC 수
+ * @param disasm 디스어셈블러 (NULL이면 16진수)
+ * @returns 없음 (void)
+ */
+void profiler_print_report(const Profile *profile, const Memory *memory, FILE *out, int top_n,
+                           profiler_disasm_fn disasm) {
+    ProfileHotspot hot[MEMORY_SIZE];
+    ProfileOpcode ops[PROFILE_OPCODES];
+    uint64_t total_cycles = 0;
+    uint64_t total_count = 0;
+    char assembly[64];
+
+    if (!profile) {
+        fprintf(out, "⚠️ 프로파일 결과가 없습니다\n");
+        return;
+    }
+
+    int n = profiler_hotspots(profile, memory, hot, MEMORY_SIZE);
+    for (int i = 0; i < n; i++) {
+        total_cycles += hot[i].cycles;
+        total_count += hot[i].count;
+    }
+    if (top_n > 0 && n > top_n) {
+        n = top_n;
+    }
+
+    fprintf(out, "\n=== 📊 핫스팟 (명령어 %llu개, 사이클 %llu) ===\n",
+            (unsigned long long)total_count, (unsigned long long)total_cycles);
+    fprintf(out, "%6s  %-20s %10s %10s %8s %7s\n", "PC", "명령어", "실행", "사이클", "미스", "비율");
+    for (int i = 0; i < n; i++) {
+        profile_disasm(hot[i].word, disasm, assembly, sizeof(assembly));
+        fprintf(out, "0x%04X  %-20s %10llu %10llu %8llu %6.2f%%\n",
+                hot[i].pc, assembly,
+                (unsigned long long)hot[i].count, (unsigned long long)hot[i].cycles,
+                (unsigned long long)hot[i].misses,
+                total_cycles ? 100.0 * (double)hot[i].cycles / (double)total_cycles : 0.0);
+    }
+
+    profiler_opcodes(profile, memory, ops);
+    fprintf(out, "\n=== opcode별 ===\n");
+    for (int op = 0; op < PROFILE_OPCODES; op++) {
+        if (ops[op].count == 0) {
+            continue;
+        }
+        fprintf(out, "%-8s %10llu %10llu %8llu %6.2f%%\n", opcode_names[op],
+                (unsigned long long)ops[op].count, (unsigned long long)ops[op].cycles,
+                (unsigned long long)ops[op].misses,
+                total_cycles ? 100.0 * (double)ops[op].cycles / (double)total_cycles : 0.0);
+    }
+    fprintf(out, "================================\n\n");
+}
+
+/*
+ * @brief flamegraph 도구가 읽는 folded stack 형식으로 기록합니다
+ * @param profile 프로파일
+ * @param memory 명령어를 읽을 메모리
+ * @param out 출력 스트림
+ * @param disasm 디스어셈블러 (NULL이면 16진수)
+ * @returns 기록한 줄 수
+ *
+ * @details
+ * 한 줄에 "cpu;OPCODE;0xPC 어셈블리 사이클" 형식이며, 프레임 이름에 들어가는 ';'는 ','로 바꿉니다.
+ */
+int profiler_write_folded(const Profile *profile, const Memory *memory, FILE *out, profiler_disasm_fn disasm) {
+    char assembly[64];
+    int lines = 0;
+
+    if (!profile) {
+        return 0;
+    }
+
+    for (uint16_t pc = 0; pc < MEMORY_SIZE; pc++) {
+        if (profile->count[pc] == 0) {
+            continue;
+        }
+        uint16_t word = profile_word(memory, pc);
+        profile_disasm(word, disasm, assembly, sizeof(assembly));
+        for (char *c = assembly; *c; c++) {
+            if (*c == ';') *c = ',';
+        }
+        fprintf(out, "cpu;%s;0x%04X %s %llu\n", opcode_names[word >> 12], pc, assembly,
+                (unsigned long long)profile_cycles(profile->count[pc], profile->misses[pc]));
+        lines++;
+    }
+    return lines;
+}
@@ -1,5 +1,7 @@
 #include "register.h"
+#include "flags.h"
 #include <stdint.h>
+#include <string.h>
 
 /*
  * @brief 레지스터에 값을 설정합니다
@@ -60,7 +62,12 @@ void reset_registers(CPU_Registers* regs) {
     regs->register5 = 0;
     regs->register6 = 0;
     regs->register7 = 0;
-    regs->overflow_flag = false;  // 캐리 플래그도 초기화
+    regs->flags = 0;              // 플래그도 초기화
+    regs->flag_op = FLAG_OP_NONE;
+    regs->flag_a = 0;
+    regs->flag_b = 0;
+    regs->flag_result = 0;
+    memset(regs->vreg, 0, sizeof(regs->vreg));
 }
 
 /*
@@ -70,8 +77,7 @@ void reset_registers(CPU_Registers* regs) {
  * @returns 없음 (void)
  */
 void set_overflow_flag(CPU_Registers* regs, bool value) {
-    if (!regs) return;
-    regs->overflow_flag = value;
+    set_flag(regs, FLAG_OF, value);
 }
 
 /*
@@ -80,6 +86,5 @@ void set_overflow_flag(CPU_Registers* regs, bool value) {
  * @returns 오버플로우 플래그 값 (true/false)
  */
 bool get_overflow_flag(const CPU_Registers* regs) {
-    if (!regs) return false;
-    return regs->overflow_flag;
+    return (get_flags(regs) & FLAG_OF) != 0;
 }
@@ -0,0 +1,353 @@
+/* src/sampling.c - 샘플링 시뮬레이션 구현
+ * ------------------------------------------------------------
+ * 1) 별도 CPU 컨텍스트에서 기능 모드로 실행하며 N 명령어마다 체크포인트 저장
+ * 2) 전체 구간 중 K개를 계통 추출(systematic sampling)로 선택
+ * 3) 워커 스레드마다 자기 컨텍스트에 체크포인트를 복원해 상세 모드로 N 명령어 실행
+ * 4) 명령어 수로 가중한 CPI/미스율과 95% 신뢰구간(유한 모집단 보정)으로 전체를 외삽
+ * Test Case: tests/sampling_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/sampling.h"
+#include "include/cpu.h"
+#include "include/memory.h"
+#include "include/log.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 워커 스레드가 공유하는 작업 목록 */
+typedef struct {
+    const SampleConfig *config;
+    const SampleCheckpoint *checkpoints;
+    SampleInterval *intervals;
+    unsigned count;
+    unsigned next;                  /* 다음에 가져갈 구간 (mutex로 보호) */
+    pthread_mutex_t lock;
+} SampleWork;
+
+/* 워커 스레드 하나의 상태 */
+typedef struct {
+    pthread_t thread;
+    SampleWork *work;
+    CPU_Context ctx;
+} SampleWorker;
+
+/*
+ * @brief 기본 샘플링 구성을 채웁니다 (구간 16 명령어, 8개 샘플, 4 스레드)
+ * @param config 채울 구성 구조체 포인터
+ * @returns 없음 (void)
+ */
+void sample_default_config(SampleConfig *config) {
+    memset(config, 0, sizeof(*config));
+    config->interval_length = 16;
+    config->max_samples = 8;
+    config->threads = 4;
+    config->warmup_accesses = 256;
+    config->max_instructions = 0;
+}
+
+/*
+ * @brief 현재 컨텍스트가 더 실행할 명령어가 없는지 확인합니다
+ * @param ctx 확인할 컨텍스트
+ * @returns 종료 상태면 1, 아니면 0
+ */
+static int sample_halted(const CPU_Context *ctx) {
+    if (ctx->regs.pc >= MEMORY_SIZE - 1) {
+        return 1;
+    }
+    return memory_peek(&ctx->memory, ctx->regs.pc) == 0 &&
+           memory_peek(&ctx->memory, ctx->regs.pc + 1) == 0;
+}
+
+/*
+ * @brief 기능 모드로 프로그램을 실행하며 구간마다 체크포인트를 저장합니다
+ * @param ctx 기능 모드 실행에 사용할 컨텍스트 (현재 스레드에 설정되어 있어야 함)
+ * @param config 샘플링 구성
+ * @param checkpoints 체크포인트 배열 (SAMPLE_MAX_CHECKPOINTS개)
+ * @param total_instructions 실행한 전체 명령어 수를 받을 포인터
+ * @returns 저장한 체크포인트 수
+ */
+static unsigned sample_functional_pass(CPU_Context *ctx, const SampleConfig *config,
+                                       SampleCheckpoint *checkpoints, uint64_t *total_instructions) {
+    unsigned count = 0;
+    uint64_t executed = 0;
+
+    cpu_set_mode(CPU_MODE_FUNCTIONAL, 0);
+
+    while (!sample_halted(ctx)) {
+        if (config->max_instructions && executed >= config->max_instructions) {
+            break;
+        }
+        if (executed % config->interval_length == 0) {
+            if (count == SAMPLE_MAX_CHECKPOINTS) {
+                break;  // 체크포인트 공간을 넘는 부분은 모집단에서 제외
+            }
+            checkpoints[count].start_instruction = executed;
+            checkpoints[count].regs = ctx->regs;
+            checkpoints[count].memory = ctx->memory;
+            count++;
+        }
+        cpu_step();
+        executed++;
+    }
+
+    cpu_set_mode(CPU_MODE_DETAILED, 0);
+    *total_instructions = executed;
+    return count;
+}
+
+/*
+ * @brief 체크포인트 하나를 상세 모드로 한 구간 실행합니다
+ * @param ctx 워커 전용 컨텍스트 (현재 스레드에 설정되어 있어야 함)
+ * @param config 샘플링 구성
+ * @param checkpoint 시작 상태
+ * @param interval 결과를 채울 구간 구조체
+ * @returns 없음 (void)
+ *
+ * @details
+ * 체크포인트는 기능 모드 상태(캐시 꺼짐 + 접근 기록)이므로, 기능 모드로 복원한 뒤
+ * cpu_set_mode()로 상세 모드에 들어가면 최근 접근으로 캐시가 데워지고 통계가 0부터 시작합니다.
+ */
+static void sample_run_interval(CPU_Context *ctx, const SampleConfig *config,
+                                const SampleCheckpoint *checkpoint, SampleInterval *interval) {
+    ctx->regs = checkpoint->regs;
+    ctx->memory = checkpoint->memory;
+    ctx->mode = CPU_MODE_FUNCTIONAL;
+    ctx->saved_log_enabled = 0;
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+
+    cpu_set_mode(CPU_MODE_DETAILED, config->warmup_accesses);
+
+    for (uint64_t i = 0; i < config->interval_length && !sample_halted(ctx); i++) {
+        cpu_step();
+    }
+
+    interval->instructions = ctx->stats.instructions;
+    interval->cycles = ctx->stats.cycles;
+    interval->hits = ctx->memory.cache.stats.hits;
+    interval->misses = ctx->memory.cache.stats.misses;
+    interval->cpi = interval->instructions ? (double)interval->cycles / (double)interval->instructions : 0.0;
+    uint64_t accesses = interval->hits + interval->misses;
+    interval->miss_rate = accesses ? (double)interval->misses / (double)accesses : 0.0;
+}
+
+/*
+ * @brief 워커 스레드: 작업 목록에서 구간을 하나씩 가져와 실행합니다
+ * @param arg SampleWorker 포인터
+ * @returns NULL
+ */
+static void* sample_worker_main(void *arg) {
+    SampleWorker *worker = (SampleWorker*)arg;
+    SampleWork *work = worker->work;
+
+    cpu_log_enabled = 0;    // 스레드 로컬: 다른 스레드의 로그 설정에 영향 없음
+    cpu_context_init(&worker->ctx);
+    cpu_set_context(&worker->ctx);
+
+    for (;;) {
+        pthread_mutex_lock(&work->lock);
+        unsigned index = work->next < work->count ? work->next++ : work->count;
+        pthread_mutex_unlock(&work->lock);
+        if (index >= work->count) {
+            break;
+        }
+
+        SampleInterval *interval = &work->intervals[index];
+        sample_run_interval(&worker->ctx, work->config, &work->checkpoints[interval->checkpoint], interval);
+    }
+
+    cpu_set_context(NULL);
+    return NULL;
+}
+
+/*
+ * @brief 비율 추정량(분자 합 / 분모 합)과 95% 신뢰구간 반폭을 계산합니다
+ * @param numerators 구간별 분자 (사이클, 미스)
+ * @param denominators 구간별 분모 (명령어, 접근)
+ * @param n 표본 수
+ * @param population 모집단(전체 구간) 크기
+ * @param ratio 비율을 받을 포인터
+ * @param half_width 신뢰구간 반폭을 받을 포인터
+ * @returns 없음 (void)
+ *
+ * @details
+ * 구간 비율의 단순 평균은 명령어가 적은 마지막 구간을 다른 구간과 같은 무게로 세므로,
+ * 분모로 가중한 비율을 씁니다. 분산은 잔차 y - R·x로 계산합니다 (비율 추정량의 1차 근사).
+ */
+static void sample_ratio(const double *numerators, const double *denominators, unsigned n, unsigned population,
+                         double *ratio, double *half_width) {
+    double sum_y = 0.0;
+    double sum_x = 0.0;
+    double sq = 0.0;
+
+    *ratio = 0.0;
+    *half_width = 0.0;
+    for (unsigned i = 0; i < n; i++) {
+        sum_y += numerators[i];
+        sum_x += denominators[i];
+    }
+    if (sum_x == 0.0) {
+        return;
+    }
+    *ratio = sum_y / sum_x;
+    if (n < 2) {
+        return;
+    }
+
+    for (unsigned i = 0; i < n; i++) {
+        double residual = numerators[i] - *ratio * denominators[i];
+        sq += residual * residual;
+    }
+    double mean_x = sum_x / n;
+    double stddev = sqrt(sq / (n - 1)) / mean_x;
+    double fpc = population > 1 ? sqrt((double)(population - n) / (double)(population - 1)) : 0.0;
+    *half_width = SAMPLE_Z_95 * stddev / sqrt((double)n) * fpc;
+}
+
+/*
+ * @brief 샘플링 시뮬레이션을 실행하고 전체 CPI/미스율/사이클을 외삽합니다
+ * @param program 프로그램 바이트 배열
+ * @param size 프로그램 크기 (바이트)
+ * @param config 샘플링 구성 (NULL이면 기본값)
+ * @param result 결과를 받을 구조체
+ * @returns 성공 시 0, 실패 시 -1
+ *
+ * @details
+ * 모든 단계가 전용 CPU 컨텍스트에서 실행되므로 호출 스레드의 CPU 상태는 바뀌지 않습니다.
+ */
+int cpu_sample_run(const uint8_t *program, size_t size, const SampleConfig *config, SampleResult *result) {
+    SampleConfig defaults;
+    SampleWork work;
+    SampleWorker *workers = NULL;
+    SampleCheckpoint *checkpoints = NULL;
+    CPU_Context *functional_ctx = NULL;
+    double cycles[SAMPLE_MAX_CHECKPOINTS];
+    double instructions[SAMPLE_MAX_CHECKPOINTS];
+    double misses[SAMPLE_MAX_CHECKPOINTS];
+    double accesses[SAMPLE_MAX_CHECKPOINTS];
+    unsigned started = 0;
+    int status = -1;
+
+    if (!config) {
+        sample_default_config(&defaults);
+        config = &defaults;
+    }
+    if (!program || !result || config->interval_length == 0) {
+        return -1;
+    }
+    memset(result, 0, sizeof(*result));
+
+    unsigned threads = config->threads ? config->threads : 1;
+    if (threads > SAMPLE_MAX_THREADS) {
+        threads = SAMPLE_MAX_THREADS;
+    }
+
+    checkpoints = malloc(sizeof(SampleCheckpoint) * SAMPLE_MAX_CHECKPOINTS);
+    functional_ctx = malloc(sizeof(CPU_Context));
+    workers = calloc(threads, sizeof(SampleWorker));
+    if (!checkpoints || !functional_ctx || !workers) {
+        printf("❌ 샘플링 메모리 할당 실패\n");
+        goto cleanup;
+    }
+
+    // 1단계: 기능 모드 실행 + 체크포인트
+    cpu_init();     // 공용 ALU 핸들러 테이블 초기화
+    cpu_context_init(functional_ctx);
+    CPU_Context *previous = cpu_set_context(functional_ctx);
+    int saved_log_enabled = cpu_log_enabled;
+    cpu_load_program(program, size);
+    unsigned total = sample_functional_pass(functional_ctx, config, checkpoints, &result->total_instructions);
+    cpu_log_enabled = saved_log_enabled;
+    cpu_set_context(previous);
+
+    result->total_intervals = total;
+    if (total == 0) {
+        status = 0;
+        goto cleanup;
+    }
+
+    // 2단계: 계통 추출 (각 층의 가운데 구간 선택)
+    unsigned samples = config->max_samples && config->max_samples < total ? config->max_samples : total;
+    for (unsigned i = 0; i < samples; i++) {
+        result->intervals[i].checkpoint = (unsigned)(((uint64_t)i * total + total / 2) / samples);
+    }
+    result->sampled_intervals = samples;
+
+    // 3단계: 상세 구간 병렬 실행
+    work.config = config;
+    work.checkpoints = checkpoints;
+    work.intervals = result->intervals;
+    work.count = samples;
+    work.next = 0;
+    pthread_mutex_init(&work.lock, NULL);
+
+    if (threads > samples) {
+        threads = samples;
+    }
+    for (unsigned i = 0; i < threads; i++) {
+        workers[i].work = &work;
+        if (pthread_create(&workers[i].thread, NULL, sample_worker_main, &workers[i]) != 0) {
+            printf("⚠️ 샘플링 워커 스레드 %u 생성 실패\n", i);
+            break;
+        }
+        started++;
+    }
+    if (started == 0) {
+        // 스레드를 하나도 만들지 못하면 호출 스레드에서 직접 실행
+        CPU_Context *caller = cpu_get_context();
+        int caller_log = cpu_log_enabled;
+        workers[0].work = &work;
+        sample_worker_main(&workers[0]);
+        cpu_set_context(caller);
+        cpu_log_enabled = caller_log;
+    }
+    for (unsigned i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    pthread_mutex_destroy(&work.lock);
+
+    // 4단계: 집계 및 외삽 (명령어/접근 수로 가중)
+    for (unsigned i = 0; i < samples; i++) {
+        const SampleInterval *interval = &result->intervals[i];
+        cycles[i] = (double)interval->cycles;
+        instructions[i] = (double)interval->instructions;
+        misses[i] = (double)interval->misses;
+        accesses[i] = (double)(interval->hits + interval->misses);
+    }
+    sample_ratio(cycles, instructions, samples, total, &result->cpi_mean, &result->cpi_ci);
+    sample_ratio(misses, accesses, samples, total, &result->miss_rate_mean, &result->miss_rate_ci);
+    result->estimated_cycles = result->cpi_mean * (double)result->total_instructions;
+    result->estimated_cycles_ci = result->cpi_ci * (double)result->total_instructions;
+    status = 0;
+
+cleanup:
+    free(workers);
+    free(functional_ctx);
+    free(checkpoints);
+    return status;
+}
+
+/*
+ * @brief 샘플링 결과를 출력합니다
+ * @param result 출력할 결과
+ * @returns 없음 (void)
+ */
+void sample_print_result(const SampleResult *result) {
+    printf("\n=== 샘플링 시뮬레이션 결과 ===\n");
+    printf("전체 명령어: %llu, 구간: %u개 중 %u개 상세 실행\n",
+           (unsigned long long)result->total_instructions, result->total_intervals, result->sampled_intervals);
+    for (unsigned i = 0; i < result->sampled_intervals; i++) {
+        const SampleInterval *interval = &result->intervals[i];
+        printf("  구간 #%u: 명령어 %llu, 사이클 %llu, CPI %.3f, 미스율 %.1f%%\n",
+               interval->checkpoint, (unsigned long long)interval->instructions,
+               (unsigned long long)interval->cycles, interval->cpi, interval->miss_rate * 100.0);
+    }
+    printf("CPI: %.3f ± %.3f (95%%)\n", result->cpi_mean, result->cpi_ci);
+    printf("미스율: %.1f%% ± %.1f%% (95%%)\n", result->miss_rate_mean * 100.0, result->miss_rate_ci * 100.0);
+    printf("예상 전체 사이클: %.0f ± %.0f\n", result->estimated_cycles, result->estimated_cycles_ci);
+    printf("==============================\n");
+}
@@ -0,0 +1,219 @@
+/* src/send_queue.c - 클라이언트별 전송 대기열과 참조 카운트 프레임 구현
+ * ------------------------------------------------------------
+ * 대기열은 고정 크기 원형 버퍼라 넣기/꺼내기가 O(1)이고 할당이 없습니다.
+ * 프레임은 헤더+여유+본문을 한 번에 할당하고, 다 쓰면 크기 등급별 스레드 풀에 보관했다가 다시 씁니다.
+ * 풀은 스레드마다 따로라 락이 없고, 참조 카운트가 0이 된 프레임은 다른 스레드가 볼 수 없으므로
+ * 만든 스레드와 놓는 스레드가 달라도 놓는 스레드의 풀에 넣으면 됩니다.
+ * 합치기를 시작할 때 대기 중인 상태 프레임을 빼고 이벤트 프레임만 순서대로 앞으로 당깁니다.
+ * Test Case: tests/send_queue_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/send_queue.h"
+#include "include/log.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// 본문 용량 등급 (작은 확인/오류, 바이너리 상태, JSON 상태)
+#define OUT_FRAME_CLASSES 3
+static const size_t class_capacity[OUT_FRAME_CLASSES] = { 512, 4096, 16384 };
+
+typedef struct {
+    OutFrame *head;
+    unsigned count;
+} FramePool;
+
+static CPU_THREAD_LOCAL FramePool frame_pools[OUT_FRAME_CLASSES];
+
+/*
+ * @brief 본문 capacity바이트를 쓸 수 있는 참조 1개짜리 빈 프레임을 꺼냅니다
+ * @param capacity 본문 최대 길이
+ * @param headroom 본문 앞에 비워 둘 바이트 (LWS_PRE)
+ * @param binary 1이면 바이너리 프레임
+ * @returns 프레임 (length 0, state 0), 메모리 부족이면 NULL
+ *
+ * @details
+ * 등급에 맞는 풀에 빈 프레임이 있으면 그대로 쓰고, 없으면 등급 크기로 새로 할당합니다.
+ * 여유가 OUT_FRAME_HEADROOM_MAX보다 크거나 가장 큰 등급보다 큰 프레임은 풀 밖에서 딱 맞게 할당합니다.
+ */
+OutFrame* out_frame_alloc(size_t capacity, size_t headroom, int binary) {
+    int pool_class = -1;
+    OutFrame *frame = NULL;
+
+    if (headroom <= OUT_FRAME_HEADROOM_MAX) {
+        for (int i = 0; i < OUT_FRAME_CLASSES; i++) {
+            if (capacity <= class_capacity[i]) {
+                pool_class = i;
+                break;
+            }
+        }
+    }
+    if (pool_class >= 0) {
+        FramePool *pool = &frame_pools[pool_class];
+        frame = pool->head;
+        if (frame) {
+            pool->head = frame->next_free;
+            pool->count--;
+        } else {
+            frame = malloc(sizeof(OutFrame) + OUT_FRAME_HEADROOM_MAX + class_capacity[pool_class]);
+        }
+        capacity = class_capacity[pool_class] + OUT_FRAME_HEADROOM_MAX - headroom;
+    } else {
+        frame = malloc(sizeof(OutFrame) + headroom + capacity);
+    }
+    if (!frame) {
+        return NULL;
+    }
+    frame->refs = 1;
+    frame->binary = binary;
+    frame->state = 0;
+    frame->pool_class = pool_class;
+    frame->length = 0;
+    frame->capacity = capacity;
+    frame->headroom = headroom;
+    frame->next_free = NULL;
+    return frame;
+}
+
+/*
+ * @brief 본문을 복사해 참조 1개짜리 프레임을 만듭니다
+ * @param payload 본문
+ * @param length 본문 길이
+ * @param headroom 본문 앞에 비워 둘 바이트 (LWS_PRE)
+ * @param binary 1이면 바이너리 프레임
+ * @returns 프레임, 메모리 부족이면 NULL
+ */
+OutFrame* out_frame_create(const void *payload, size_t length, size_t headroom, int binary) {
+    OutFrame *frame = out_frame_alloc(length, headroom, binary);
+
+    if (!frame) {
+        return NULL;
+    }
+    frame->length = length;
+    memcpy(frame->data + headroom, payload, length);
+    return frame;
+}
+
+void out_frame_retain(OutFrame *frame) {
+    __atomic_add_fetch(&frame->refs, 1, __ATOMIC_RELAXED);
+}
+
+void out_frame_release(OutFrame *frame) {
+    if (!frame || __atomic_sub_fetch(&frame->refs, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+    if (frame->pool_class >= 0 && frame_pools[frame->pool_class].count < OUT_FRAME_POOL_DEPTH) {
+        FramePool *pool = &frame_pools[frame->pool_class];
+        frame->next_free = pool->head;
+        pool->head = frame;
+        pool->count++;
+        return;
+    }
+    free(frame);
+}
+
+void out_frame_pool_trim(void) {
+    for (int i = 0; i < OUT_FRAME_CLASSES; i++) {
+        FramePool *pool = &frame_pools[i];
+        while (pool->head) {
+            OutFrame *next = pool->head->next_free;
+            free(pool->head);
+            pool->head = next;
+        }
+        pool->count = 0;
+    }
+}
+
+void send_queue_init(SendQueue *queue) {
+    memset(queue, 0, sizeof(*queue));
+}
+
+/*
+ * @brief 대기 중인 상태 프레임을 버리고 이벤트 프레임만 남깁니다 (순서 유지)
+ */
+static void drop_state_frames(SendQueue *queue) {
+    unsigned kept = 0;
+
+    for (unsigned i = 0; i < queue->count; i++) {
+        OutFrame *frame = queue->frames[(queue->head + i) % SEND_QUEUE_DEPTH];
+        if (frame->state) {
+            out_frame_release(frame);
+            queue->coalesced++;
+        } else {
+            queue->frames[(queue->head + kept++) % SEND_QUEUE_DEPTH] = frame;
+        }
+    }
+    for (unsigned i = kept; i < queue->count; i++) {
+        queue->frames[(queue->head + i) % SEND_QUEUE_DEPTH] = NULL;
+    }
+    queue->count = kept;
+}
+
+/*
+ * @brief 프레임을 대기열 끝에 넣습니다
+ * @param queue 대기열
+ * @param frame 프레임 (넣으면 참조 +1)
+ * @returns SEND_QUEUED, SEND_COALESCED 또는 SEND_DROPPED
+ */
+SendResult send_queue_push(SendQueue *queue, OutFrame *frame) {
+    if (frame->state && (queue->coalescing || queue->count >= SEND_QUEUE_HIGH_WATER)) {
+        if (!queue->coalescing) {
+            queue->coalescing = 1;
+            drop_state_frames(queue);
+        }
+        queue->coalesced++;
+        return SEND_COALESCED;
+    }
+    if (queue->count == SEND_QUEUE_DEPTH) {
+        queue->dropped++;
+        return SEND_DROPPED;
+    }
+    out_frame_retain(frame);
+    queue->frames[(queue->head + queue->count) % SEND_QUEUE_DEPTH] = frame;
+    queue->count++;
+    if (queue->count > queue->peak) {
+        queue->peak = queue->count;
+    }
+    return SEND_QUEUED;
+}
+
+/*
+ * @brief 맨 앞 프레임을 꺼냅니다
+ * @param queue 대기열
+ * @returns 프레임 (호출자가 out_frame_release), 비어 있으면 NULL
+ */
+OutFrame* send_queue_pop(SendQueue *queue) {
+    if (queue->count == 0) {
+        return NULL;
+    }
+    OutFrame *frame = queue->frames[queue->head];
+    queue->frames[queue->head] = NULL;
+    queue->head = (queue->head + 1) % SEND_QUEUE_DEPTH;
+    queue->count--;
+    queue->sent++;
+    return frame;
+}
+
+/*
+ * @brief 합치기 상태에서 대기열이 SEND_QUEUE_LOW_WATER 이하로 비었으면 합치기를 끝냅니다
+ * @param queue 대기열
+ * @returns 끝냈으면 1 (호출자가 최신 상태 프레임을 넣어야 함), 아니면 0
+ */
+int send_queue_resume(SendQueue *queue) {
+    if (!queue->coalescing || queue->count > SEND_QUEUE_LOW_WATER) {
+        return 0;
+    }
+    queue->coalescing = 0;
+    return 1;
+}
+
+void send_queue_clear(SendQueue *queue) {
+    for (unsigned i = 0; i < queue->count; i++) {
+        unsigned slot = (queue->head + i) % SEND_QUEUE_DEPTH;
+        out_frame_release(queue->frames[slot]);
+        queue->frames[slot] = NULL;
+    }
+    queue->head = 0;
+    queue->count = 0;
+}
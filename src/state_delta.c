@@ -0,0 +1,165 @@
+/* src/state_delta.c - 상태 변화(delta) 계산 구현
+ * ------------------------------------------------------------
+ * 단계마다 보이는 상태(약 1KB)를 캡처해 shadow와 바이트 단위로 비교합니다.
+ * 메모리는 연속 구간으로 묶고, 캐시는 라인 단위로 비교합니다.
+ * 키프레임은 shadow와 상관없이 모든 항목을 바뀐 것으로 표시합니다.
+ * Test Case: tests/state_delta_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/state_delta.h"
+#include "include/flags.h"
+
+#include <string.h>
+
+/*
+ * @brief 상태 추적기를 초기화합니다 (첫 delta는 키프레임)
+ * @param tracker 상태 추적기
+ * @param keyframe_interval 키프레임 사이의 delta 수 (0이면 STATE_KEYFRAME_INTERVAL)
+ * @returns 없음 (void)
+ */
+void state_tracker_init(StateTracker *tracker, unsigned keyframe_interval) {
+    memset(tracker, 0, sizeof(*tracker));
+    tracker->keyframe_interval = keyframe_interval ? keyframe_interval : STATE_KEYFRAME_INTERVAL;
+    tracker->need_keyframe = 1;
+}
+
+/*
+ * @brief 다음 delta를 키프레임으로 만듭니다
+ * @param tracker 상태 추적기
+ * @returns 없음 (void)
+ */
+void state_tracker_resync(StateTracker *tracker) {
+    tracker->need_keyframe = 1;
+}
+
+/*
+ * @brief 컨텍스트의 보이는 상태를 캡처합니다
+ * @param snapshot 결과
+ * @param ctx CPU 컨텍스트
+ * @returns 없음 (void)
+ */
+void state_snapshot_capture(StateSnapshot *snapshot, const CPU_Context *ctx) {
+    const CPU_Registers *regs = &ctx->regs;
+
+    snapshot->pc = regs->pc;
+    snapshot->registers[0] = 0;
+    for (uint8_t r = 1; r <= 7; r++) {
+        snapshot->registers[r] = get_register(regs, r);
+    }
+    snapshot->flags = get_flags(regs);
+    memcpy(snapshot->vreg, regs->vreg, sizeof(snapshot->vreg));
+    snapshot->mode = ctx->mode;
+    snapshot->instructions = ctx->stats.instructions;
+    snapshot->cycles = ctx->stats.cycles;
+    for (unsigned i = 0; i < MEMORY_SIZE; i++) {
+        snapshot->memory[i] = memory_peek(&ctx->memory, (uint16_t)i);
+    }
+    memcpy(snapshot->lines, ctx->memory.cache.lines, sizeof(snapshot->lines));
+    snapshot->cache_stats = ctx->memory.cache.stats;
+}
+
+/*
+ * @brief 바뀐 메모리 바이트를 연속 구간으로 묶습니다
+ */
+static void diff_memory(const uint8_t *before, const uint8_t *after, int all, StateDelta *delta) {
+    unsigned i = 0;
+
+    delta->run_count = 0;
+    while (i < MEMORY_SIZE) {
+        if (!all && before[i] == after[i]) {
+            i++;
+            continue;
+        }
+        unsigned start = i;
+        while (i < MEMORY_SIZE && (all || before[i] != after[i])) {
+            i++;
+        }
+        delta->runs[delta->run_count].address = (uint16_t)start;
+        delta->runs[delta->run_count].length = (uint16_t)(i - start);
+        delta->run_count++;
+    }
+}
+
+/*
+ * @brief 현재 상태를 캡처해 shadow와 비교하고 shadow를 갱신합니다
+ * @param tracker 상태 추적기
+ * @param ctx 비교할 CPU 컨텍스트
+ * @param delta 바뀐 항목 (값은 tracker->current)
+ * @returns 바뀐 항목 수 (키프레임이면 전체 항목 수)
+ *
+ * @details
+ * PC와 명령어/사이클 수는 거의 매 단계 바뀌므로 항목 수에 세지 않고 항상 보내는 것으로 봅니다.
+ */
+unsigned state_tracker_next(StateTracker *tracker, const CPU_Context *ctx, StateDelta *delta) {
+    StateSnapshot *now = &tracker->current;
+    const StateSnapshot *before = &tracker->shadow;
+    unsigned changes = 0;
+
+    state_snapshot_capture(now, ctx);
+
+    int all = tracker->need_keyframe || tracker->since_keyframe + 1 >= tracker->keyframe_interval;
+    delta->sequence = tracker->sequence++;
+    delta->keyframe = all;
+    tracker->since_keyframe = all ? 0 : tracker->since_keyframe + 1;
+    tracker->need_keyframe = 0;
+
+    delta->register_mask = 0;
+    for (unsigned r = 1; r <= 7; r++) {
+        if (all || now->registers[r] != before->registers[r]) {
+            delta->register_mask |= (uint8_t)(1U << r);
+            changes++;
+        }
+    }
+    delta->vreg_mask = 0;
+    for (unsigned v = 0; v < VREG_COUNT; v++) {
+        if (all || memcmp(now->vreg[v], before->vreg[v], VREG_LANES) != 0) {
+            delta->vreg_mask |= (uint8_t)(1U << v);
+            changes++;
+        }
+    }
+    delta->flags_changed = all || now->flags != before->flags;
+    delta->mode_changed = all || now->mode != before->mode;
+    delta->cache_stats_changed = all || memcmp(&now->cache_stats, &before->cache_stats, sizeof(CacheStats)) != 0;
+    changes += (unsigned)(delta->flags_changed + delta->mode_changed + delta->cache_stats_changed);
+
+    diff_memory(before->memory, now->memory, all, delta);
+    for (unsigned i = 0; i < delta->run_count; i++) {
+        changes += delta->runs[i].length;
+    }
+
+    delta->line_count = 0;
+    for (unsigned i = 0; i < CACHE_NUM_LINES; i++) {
+        const CacheLine *a = &before->lines[i];
+        const CacheLine *b = &now->lines[i];
+        if (all || a->tag != b->tag || a->valid != b->valid || a->dirty != b->dirty ||
+            memcmp(a->block, b->block, CACHE_LINE_SIZE) != 0) {
+            delta->lines[delta->line_count++] = (uint8_t)i;
+        }
+    }
+    changes += delta->line_count;
+
+    tracker->shadow = *now;
+    return changes;
+}
+
+/*
+ * @brief 마지막으로 보낸 상태 전체를 키프레임으로 만듭니다
+ * @param tracker 상태 추적기
+ * @param delta 결과
+ * @returns 없음 (void)
+ */
+void state_tracker_keyframe(const StateTracker *tracker, StateDelta *delta) {
+    delta->sequence = tracker->sequence ? tracker->sequence - 1 : 0;
+    delta->keyframe = 1;
+    delta->register_mask = 0xFE;                /* R1~R7 */
+    delta->vreg_mask = (uint8_t)((1U << VREG_COUNT) - 1);
+    delta->flags_changed = 1;
+    delta->mode_changed = 1;
+    delta->cache_stats_changed = 1;
+    diff_memory(tracker->current.memory, tracker->current.memory, 1, delta);
+    delta->line_count = CACHE_NUM_LINES;
+    for (unsigned i = 0; i < CACHE_NUM_LINES; i++) {
+        delta->lines[i] = (uint8_t)i;
+    }
+}
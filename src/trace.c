@@ -0,0 +1,469 @@
+/* src/trace.c - 비동기 바이너리 실행 트레이스 구현
+ * ------------------------------------------------------------
+ * 생산자(시뮬레이션 스레드)는 링 버퍼에 레코드를 복사만 하고,
+ * 작성 스레드가 링을 비우며 압축·기록합니다. head/tail은 각자 한 스레드만 쓰므로
+ * acquire/release 원자 연산만으로 잠금 없이 동기화됩니다 (SPSC).
+ *
+ * 파일 형식: TRACE_MAGIC(8바이트) 뒤에 레코드마다
+ *   [mask] [seq 차이] [pc 차이] [word] [op] [reg, value] [addr 차이, value, count] [flags] [events]
+ * mask 비트가 켜진 필드만 기록하며, 차이는 zigzag varint입니다.
+ * Test Case: tests/trace_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/trace.h"
+#include "include/isa.h"
+#include "include/register.h"
+#include "include/flags.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 인코딩 mask 비트
+#define TRACE_F_SEQ    0x01   /* seq가 1 증가가 아님 */
+#define TRACE_F_PC     0x02   /* pc가 2 증가가 아님 */
+#define TRACE_F_WORD   0x04
+#define TRACE_F_OP     0x08
+#define TRACE_F_DEST   0x10   /* 이 레코드에 레지스터 쓰기가 있음 */
+#define TRACE_F_MEM    0x20   /* 이 레코드에 데이터 접근이 있음 */
+#define TRACE_F_FLAGS  0x40
+#define TRACE_F_EVENTS 0x80
+
+#define TRACE_WRITE_BUFFER 65536U   /* 작성 스레드의 fwrite 단위 */
+#define TRACE_IDLE_US      1000     /* 링이 비었을 때 작성 스레드 대기 시간 */
+
+/* 트레이서 전체 상태 (한 번에 하나) */
+typedef struct {
+    TraceRecord *ring;
+    uint64_t mask;
+    uint64_t head;              /* 생산자만 씀 */
+    char pad1[56];              /* head/tail이 같은 캐시 라인을 공유하지 않도록 */
+    uint64_t tail;              /* 작성 스레드만 씀 */
+    char pad2[56];
+    int stop;
+    uint64_t dropped;           /* 생산자만 씀 */
+    uint64_t bytes;             /* 작성 스레드만 씀 */
+    FILE *file;
+    pthread_t writer;
+    int running;
+} Tracer;
+
+static Tracer tracer;
+
+CPU_THREAD_LOCAL int trace_producer = 0;
+
+// 생산자 스레드의 진행 중인 레코드 (스레드별: 다른 스레드의 cpu_step/memory_* 훅이 건드리지 않도록)
+static CPU_THREAD_LOCAL TraceRecord pending;
+static CPU_THREAD_LOCAL int pending_open = 0;
+static CPU_THREAD_LOCAL uint64_t next_seq = 0;
+
+/*
+ * @brief 부호 있는 값을 zigzag 변환 후 varint로 기록합니다
+ * @param out 출력 버퍼
+ * @param value 기록할 값
+ * @returns 기록한 바이트 수
+ */
+static size_t put_varint(uint8_t *out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+static uint64_t zigzag(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+/*
+ * @brief 파일에서 varint 하나를 읽습니다
+ * @param in 입력 파일
+ * @param value 값을 받을 포인터
+ * @returns 성공 시 1, 파일 끝/오류 시 0
+ */
+static int get_varint(FILE *in, uint64_t *value) {
+    uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        int c = fgetc(in);
+        if (c == EOF) return 0;
+        result |= (uint64_t)(c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            *value = result;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * @brief 인코더/디코더의 이전 레코드 상태를 초기화합니다
+ * @param codec 초기화할 상태
+ * @returns 없음 (void)
+ */
+void trace_codec_init(TraceCodec *codec) {
+    memset(codec, 0, sizeof(*codec));
+    codec->previous.seq = (uint64_t)-1;     // 첫 레코드의 seq 0이 "1 증가"가 되도록
+    codec->previous.pc = (uint16_t)-2;      // 첫 레코드의 pc 0이 "2 증가"가 되도록
+}
+
+/*
+ * @brief 레코드 하나를 이전 레코드와의 차이로 인코딩합니다
+ * @param codec 인코더 상태
+ * @param record 인코딩할 레코드
+ * @param out 출력 버퍼 (TRACE_MAX_ENCODED 바이트 이상)
+ * @returns 기록한 바이트 수
+ */
+size_t trace_encode_record(TraceCodec *codec, const TraceRecord *record, uint8_t *out) {
+    TraceRecord *prev = &codec->previous;
+    uint8_t mask = 0;
+    size_t n = 1;
+
+    if (record->seq != prev->seq + 1) {
+        mask |= TRACE_F_SEQ;
+        n += put_varint(out + n, record->seq - prev->seq);
+    }
+    if (record->pc != (uint16_t)(prev->pc + 2)) {
+        mask |= TRACE_F_PC;
+        n += put_varint(out + n, zigzag((int64_t)record->pc - prev->pc));
+    }
+    if (record->word != prev->word) {
+        mask |= TRACE_F_WORD;
+        out[n++] = (uint8_t)(record->word >> 8);
+        out[n++] = (uint8_t)record->word;
+    }
+    if (record->op != prev->op) {
+        mask |= TRACE_F_OP;
+        out[n++] = record->op;
+    }
+    if (record->dest_reg != TRACE_NO_REG) {
+        mask |= TRACE_F_DEST;
+        out[n++] = record->dest_reg;
+        out[n++] = record->dest_value;
+    }
+    if (record->mem_count) {
+        mask |= TRACE_F_MEM;
+        n += put_varint(out + n, zigzag((int64_t)record->mem_addr - prev->mem_addr));
+        out[n++] = record->mem_value;
+        out[n++] = record->mem_count;
+    }
+    if (record->flags != prev->flags) {
+        mask |= TRACE_F_FLAGS;
+        out[n++] = record->flags;
+    }
+    if (record->events != prev->events) {
+        mask |= TRACE_F_EVENTS;
+        out[n++] = record->events;
+    }
+    out[0] = mask;
+
+    uint16_t mem_addr = record->mem_count ? record->mem_addr : prev->mem_addr;
+    *prev = *record;
+    prev->mem_addr = mem_addr;
+    return n;
+}
+
+/*
+ * @brief 파일에서 레코드 하나를 디코딩합니다
+ * @param codec 디코더 상태
+ * @param in 입력 파일 (머리 다음 위치)
+ * @param record 결과를 받을 레코드
+ * @returns 성공 시 1, 파일 끝이면 0, 형식 오류면 -1
+ */
+int trace_decode_record(TraceCodec *codec, FILE *in, TraceRecord *record) {
+    TraceRecord *prev = &codec->previous;
+    uint64_t value;
+    int c = fgetc(in);
+    if (c == EOF) return 0;
+    uint8_t mask = (uint8_t)c;
+
+    *record = *prev;
+    record->seq = prev->seq + 1;
+    record->pc = (uint16_t)(prev->pc + 2);
+    record->dest_reg = TRACE_NO_REG;
+    record->dest_value = 0;
+    record->mem_value = 0;
+    record->mem_count = 0;
+
+    if (mask & TRACE_F_SEQ) {
+        if (!get_varint(in, &value)) return -1;
+        record->seq = prev->seq + value;
+    }
+    if (mask & TRACE_F_PC) {
+        if (!get_varint(in, &value)) return -1;
+        record->pc = (uint16_t)(prev->pc + unzigzag(value));
+    }
+    if (mask & TRACE_F_WORD) {
+        int hi = fgetc(in), lo = fgetc(in);
+        if (lo == EOF || hi == EOF) return -1;
+        record->word = (uint16_t)((hi << 8) | lo);
+    }
+    if (mask & TRACE_F_OP) {
+        if ((c = fgetc(in)) == EOF) return -1;
+        record->op = (uint8_t)c;
+    }
+    if (mask & TRACE_F_DEST) {
+        int reg = fgetc(in), val = fgetc(in);
+        if (reg == EOF || val == EOF) return -1;
+        record->dest_reg = (uint8_t)reg;
+        record->dest_value = (uint8_t)val;
+    }
+    if (mask & TRACE_F_MEM) {
+        if (!get_varint(in, &value)) return -1;
+        int val = fgetc(in), count = fgetc(in);
+        if (val == EOF || count == EOF) return -1;
+        record->mem_addr = (uint16_t)(prev->mem_addr + unzigzag(value));
+        record->mem_value = (uint8_t)val;
+        record->mem_count = (uint8_t)count;
+    }
+    if (mask & TRACE_F_FLAGS) {
+        if ((c = fgetc(in)) == EOF) return -1;
+        record->flags = (uint8_t)c;
+    }
+    if (mask & TRACE_F_EVENTS) {
+        if ((c = fgetc(in)) == EOF) return -1;
+        record->events = (uint8_t)c;
+    }
+
+    *prev = *record;
+    return 1;
+}
+
+/*
+ * @brief 레코드를 한 줄 텍스트로 만듭니다
+ * @param record 레코드
+ * @param buffer 출력 버퍼
+ * @param size 버퍼 크기
+ * @returns 없음 (void)
+ */
+void trace_format_record(const TraceRecord *record, char *buffer, size_t size) {
+    static const char *op_names[16] = {
+        "ADD", "SUB", "MUL", "DIV", "MOV", "LOAD", "STORE", "OP7",
+        "PACKED", "VMEM", "OP10", "OP11", "OP12", "OP13", "OP14", "SYS"
+    };
+    char dest[24] = "";
+    char mem[48] = "";
+
+    if (record->dest_reg != TRACE_NO_REG) {
+        snprintf(dest, sizeof(dest), " R%d<-%d", record->dest_reg, record->dest_value);
+    }
+    if (record->mem_count) {
+        snprintf(mem, sizeof(mem), " %s[%d]=%d x%d%s",
+                 (record->events & TRACE_EV_MEM_WRITE) ? "W" : "R", record->mem_addr, record->mem_value,
+                 record->mem_count, (record->events & TRACE_EV_MEM_MISS) ? " miss" : " hit");
+    }
+
+    snprintf(buffer, size, "#%llu PC=%03d 0x%04X %-6s%s%s flags=%c%c%c%c%s",
+             (unsigned long long)record->seq, record->pc, record->word, op_names[record->op & 0xF], dest, mem,
+             (record->flags & FLAG_CF) ? 'C' : '-', (record->flags & FLAG_ZF) ? 'Z' : '-',
+             (record->flags & FLAG_SF) ? 'S' : '-', (record->flags & FLAG_OF) ? 'O' : '-',
+             (record->events & TRACE_EV_FETCH_MISS) ? " fetch-miss" : "");
+}
+
+/*
+ * @brief 작성 스레드: 링을 비우며 압축한 레코드를 파일에 씁니다
+ * @param arg 사용하지 않음
+ * @returns NULL
+ */
+static void* trace_writer_main(void *arg) {
+    (void)arg;
+    TraceCodec codec;
+    uint8_t *buffer = malloc(TRACE_WRITE_BUFFER);
+    size_t used = 0;
+
+    trace_codec_init(&codec);
+    if (!buffer) return NULL;
+
+    for (;;) {
+        int stopping = __atomic_load_n(&tracer.stop, __ATOMIC_ACQUIRE);
+        uint64_t head = __atomic_load_n(&tracer.head, __ATOMIC_ACQUIRE);
+        uint64_t tail = tracer.tail;
+
+        if (tail == head) {
+            if (stopping) break;    // stop 이후 읽은 head까지 모두 비웠음
+            usleep(TRACE_IDLE_US);
+            continue;
+        }
+
+        while (tail != head) {
+            if (used + TRACE_MAX_ENCODED > TRACE_WRITE_BUFFER) {
+                tracer.bytes += fwrite(buffer, 1, used, tracer.file);
+                used = 0;
+            }
+            used += trace_encode_record(&codec, &tracer.ring[tail & tracer.mask], buffer + used);
+            tail++;
+        }
+        __atomic_store_n(&tracer.tail, tail, __ATOMIC_RELEASE);
+    }
+
+    tracer.bytes += fwrite(buffer, 1, used, tracer.file);
+    free(buffer);
+    return NULL;
+}
+
+/*
+ * @brief 트레이스를 시작하고 호출 스레드를 생산자로 지정합니다
+ * @param path 출력 파일 경로
+ * @param ring_capacity 링 용량 (2의 거듭제곱으로 올림, 0이면 기본값)
+ * @returns 성공 시 0, 실패 시 -1
+ */
+int trace_start(const char *path, unsigned ring_capacity) {
+    if (tracer.running) {
+        printf("⚠️ 트레이스가 이미 실행 중입니다\n");
+        return -1;
+    }
+
+    uint64_t capacity = 1;
+    while (capacity < (ring_capacity ? ring_capacity : TRACE_DEFAULT_RING)) capacity <<= 1;
+
+    memset(&tracer, 0, sizeof(tracer));
+    tracer.ring = malloc(sizeof(TraceRecord) * capacity);
+    tracer.mask = capacity - 1;
+    tracer.file = fopen(path, "wb");
+    if (!tracer.ring || !tracer.file) {
+        printf("❌ 트레이스 시작 실패: %s\n", path);
+        free(tracer.ring);
+        if (tracer.file) fclose(tracer.file);
+        memset(&tracer, 0, sizeof(tracer));
+        return -1;
+    }
+
+    tracer.bytes = fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC), tracer.file);
+    if (pthread_create(&tracer.writer, NULL, trace_writer_main, NULL) != 0) {
+        printf("❌ 트레이스 작성 스레드 생성 실패\n");
+        fclose(tracer.file);
+        free(tracer.ring);
+        memset(&tracer, 0, sizeof(tracer));
+        return -1;
+    }
+
+    tracer.running = 1;
+    pending_open = 0;
+    next_seq = 0;
+    trace_producer = 1;
+    printf("📝 트레이스 시작: %s (링 %llu개)\n", path, (unsigned long long)capacity);
+    return 0;
+}
+
+/*
+ * @brief 남은 레코드를 모두 기록하고 트레이스를 끝냅니다
+ * @param stats 통계를 받을 포인터 (NULL 가능)
+ * @returns 없음 (void)
+ */
+void trace_stop(TraceStats *stats) {
+    if (!tracer.running) {
+        if (stats) memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    trace_producer = 0;
+    __atomic_store_n(&tracer.stop, 1, __ATOMIC_RELEASE);
+    pthread_join(tracer.writer, NULL);
+    fclose(tracer.file);
+
+    if (stats) {
+        stats->records = tracer.head;
+        stats->dropped = tracer.dropped;
+        stats->bytes = tracer.bytes;
+    }
+    printf("📝 트레이스 종료: 레코드 %llu개, 버림 %llu개, %llu바이트\n",
+           (unsigned long long)tracer.head, (unsigned long long)tracer.dropped,
+           (unsigned long long)tracer.bytes);
+
+    free(tracer.ring);
+    memset(&tracer, 0, sizeof(tracer));
+}
+
+/*
+ * @brief 명령어 실행 직전 상태를 기록합니다 (cpu_step에서 fetch 후 호출)
+ * @param pc 명령어 주소
+ * @param word 명령어
+ * @param fetch_miss fetch가 캐시 미스였는지
+ * @returns 없음 (void)
+ */
+void trace_step_begin(uint16_t pc, uint16_t word, int fetch_miss) {
+    memset(&pending, 0, sizeof(pending));
+    pending.seq = next_seq++;
+    pending.pc = pc;
+    pending.word = word;
+    pending.op = (uint8_t)(word >> 12);
+    pending.events = fetch_miss ? TRACE_EV_FETCH_MISS : 0;
+    pending_open = 1;
+}
+
+/*
+ * @brief 실행 중 데이터 접근을 기록합니다 (memory_read/memory_write에서 호출)
+ * @param address 주소
+ * @param value 읽거나 쓴 값
+ * @param write 쓰기이면 1
+ * @param miss 캐시 미스이면 1
+ * @returns 없음 (void)
+ */
+void trace_note_access(uint16_t address, uint8_t value, int write, int miss) {
+    if (!pending_open) return;     // fetch나 프로그램 적재 중 접근은 제외
+    if (pending.mem_count == 0) {
+        pending.mem_addr = address;
+        pending.mem_value = value;
+    }
+    if (pending.mem_count < UINT8_MAX) pending.mem_count++;
+    pending.events |= write ? TRACE_EV_MEM_WRITE : TRACE_EV_MEM_READ;
+    if (miss) pending.events |= TRACE_EV_MEM_MISS;
+}
+
+/*
+ * @brief 명령어가 결과를 쓰는 스칼라 레지스터를 디코딩한 명령어에서 구합니다
+ * @param word 명령어
+ * @param mem_count 실행 중 데이터 접근 수 (범위 밖 주소의 LOAD는 레지스터를 쓰지 않음)
+ * @returns 레지스터 번호 (1~7), 쓰지 않으면 TRACE_NO_REG
+ *
+ * @details
+ * 값이 바뀐 레지스터로 찾으면 I6 ALU(R1, R2, R7을 모두 씀)에서 결과 대신 R1을 고르고,
+ * 전과 같은 값을 쓴 명령어는 목적지가 빠지므로 명령어 형식으로 정합니다.
+ */
+static uint8_t written_register(uint16_t word, uint8_t mem_count) {
+    switch (isa_decode(word)) {
+        case ISA_ADD_RR: case ISA_ADD_I6:
+        case ISA_SUB_RR: case ISA_SUB_I6:
+        case ISA_MUL_RR: case ISA_MUL_I6:
+        case ISA_DIV_RR: case ISA_DIV_I6:
+            return 7;
+        case ISA_MOV_RI:
+            return (uint8_t)((word >> 8) & 0xF);
+        case ISA_LOAD:
+            return mem_count ? (uint8_t)((word >> 8) & 0x7) : TRACE_NO_REG;
+        default:
+            return TRACE_NO_REG;
+    }
+}
+
+/*
+ * @brief 실행 결과를 채워 레코드를 링에 넣습니다 (가득 차면 버림, 대기하지 않음)
+ * @param regs 실행 후 레지스터
+ * @returns 없음 (void)
+ */
+void trace_step_end(const CPU_Registers *regs) {
+    if (!pending_open) return;
+    pending_open = 0;
+
+    pending.dest_reg = written_register(pending.word, pending.mem_count);
+    if (pending.dest_reg != TRACE_NO_REG) {
+        pending.dest_value = get_register(regs, pending.dest_reg);
+    }
+    pending.flags = get_flags(regs);
+
+    uint64_t head = tracer.head;
+    uint64_t tail = __atomic_load_n(&tracer.tail, __ATOMIC_ACQUIRE);
+    if (head - tail > tracer.mask) {
+        tracer.dropped++;
+        return;
+    }
+    tracer.ring[head & tracer.mask] = pending;
+    __atomic_store_n(&tracer.head, head + 1, __ATOMIC_RELEASE);
+}
@@ -1,6 +1,18 @@
 #include "include/websocket_server.h"
 #include "include/cpu.h"
 #include "include/cache.h"
+#include "include/flags.h"
+#include "include/fastforward.h"
+#include "include/isa.h"
+#include "include/assembler.h"
+#include "include/image.h"
+#include "include/trace.h"
+#include "include/profiler.h"
+#include "include/lru_cache.h"
+#include "include/state_delta.h"
+#include "include/wire.h"
+#include "include/json_writer.h"
+#include "include/log.h"
 #include <libwebsockets.h>
 #include <json-c/json.h>
 #include <string.h>
@@ -8,10 +20,25 @@
 #include <stdlib.h>
 #include <pthread.h>
 #include <unistd.h>
+#include <limits.h>
 
 // 전역 서버 컨텍스트
 static ws_server_context_t server_ctx;
-static int server_running = 0;
+static int server_running = 0;                  // 서비스 스레드가 __atomic으로 읽음
+static const char *trace_dir = WS_TRACE_DIR;    // 클라이언트가 고른 트레이스 이름은 이 디렉터리 안에만
+static const char *image_dir = NULL;            // 클라이언트가 고른 이미지 이름은 이 디렉터리 안에서만 (NULL이면 끔)
+
+// 이 스레드가 서비스하는 lws 스레드 번호, 지금 처리 중인 요청의 세션과 요청한 클라이언트
+// (상태 변화는 이 세션을 보는 클라이언트 모두에게, 확인/오류/조회 응답은 요청한 클라이언트에게만,
+//  세션은 요청 동안 lock을 잡고 있음)
+static CPU_THREAD_LOCAL int service_tsi = -1;
+static CPU_THREAD_LOCAL ws_cpu_session_t *current_session = NULL;
+static CPU_THREAD_LOCAL ws_client_session_t *current_requester = NULL;
+
+// 이 스레드가 쓰고 있는 JSON 메시지의 전송 프레임 (begin_json이 풀에서 꺼내 본문에 바로 쓰고,
+// send_json이 대기열로 넘김, 넘친 메시지의 프레임은 다음 메시지가 다시 씀)
+#define WS_JSON_CAPACITY (16 * 1024)
+static CPU_THREAD_LOCAL OutFrame *json_frame = NULL;
 
 /*
  * @brief CPU 프로토콜 콜백 함수
@@ -24,13 +51,26 @@ static int server_running = 0;
  */
 static int callback_cpu_protocol(struct lws *wsi, enum lws_callback_reasons reason,
                                 void *user, void *in, size_t len);
+static int callback_cpu_binary(struct lws *wsi, enum lws_callback_reasons reason,
+                               void *user, void *in, size_t len);
+static void send_catch_up_keyframe(ws_client_session_t *client, ws_cpu_session_t *session);
+static void run_job_interrupt(void);
+static void notify_service_threads(void *arg);
+static void job_free(struct ws_job *job);
+static void job_abandon(ws_cpu_session_t *session);
 
-// 프로토콜 정의
+// 프로토콜 정의 (클라이언트가 Sec-WebSocket-Protocol로 선택, 기본은 JSON)
 static struct lws_protocols protocols[] = {
     {
         "cpu-protocol",
         callback_cpu_protocol,
-        0,
+        sizeof(ws_client_session_t),    // 연결 정보 + 자기 CPU 세션 (per-session user data)
+        MAX_PAYLOAD_SIZE,
+    },
+    {
+        "cpu-binary",               // 고정 레이아웃 리틀엔디언 프레임 (include/wire.h)
+        callback_cpu_binary,
+        sizeof(ws_client_session_t),
         MAX_PAYLOAD_SIZE,
     },
     { NULL, NULL, 0, 0 } // 종료자
@@ -39,23 +79,48 @@ static struct lws_protocols protocols[] = {
 /*
  * @brief WebSocket 서버를 초기화합니다
  * @param port 서버 포트 번호
+ * @param threads 서비스 스레드 수 (0이면 온라인 코어 수)
+ * @param workers 워커 스레드 수 (0이면 온라인 코어 수, 음수면 워커 없이 서비스 스레드에서 실행)
  * @returns 초기화 성공 시 0, 실패 시 -1
+ *
+ * @details
+ * lws는 연결을 받은 스레드에서만 그 연결을 서비스하므로, 연결의 CPU 세션도 한 스레드에 고정됩니다.
+ * libwebsockets가 LWS_MAX_SMP=1로 빌드됐으면 스레드는 하나로 줄어듭니다.
+ * 긴 실행과 큰 어셈블은 워커 풀에서 하고, 결과는 lws_cancel_service로 깨운 세션 스레드가 적용합니다.
  */
-int ws_server_init(int port) {
+int ws_server_init(int port, int threads, int workers) {
     struct lws_context_creation_info info;
     
+    if (threads <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cores > 0 ? (int)cores : 1;
+    }
+    if (threads > WS_MAX_SERVICE_THREADS) {
+        threads = WS_MAX_SERVICE_THREADS;
+    }
+    
     memset(&info, 0, sizeof(info));
     info.port = port;
     info.protocols = protocols;
     info.gid = -1;
     info.uid = -1;
+    info.count_threads = (unsigned int)threads;
     
     // 서버 컨텍스트 초기화
     memset(&server_ctx, 0, sizeof(server_ctx));
     pthread_mutex_init(&server_ctx.mutex, NULL);
+    pthread_mutex_init(&server_ctx.cache_mutex, NULL);
+    pthread_cond_init(&server_ctx.unpinned, NULL);
+    server_ctx.trace_tsi = -1;
     
-    // CPU 초기화
+    // CPU 초기화 (공용 테이블, 연결마다의 CPU는 session_open에서)
     cpu_init();
+    if (handle_table_init(&server_ctx.clients, WS_CLIENTS_INITIAL, WS_MAX_CONNECTIONS) != 0 ||
+        lru_init(&server_ctx.program_cache, PROGRAM_CACHE_BYTES) != 0 ||
+        lru_init(&server_ctx.run_cache, RUN_CACHE_BYTES) != 0) {
+        fprintf(stderr, "연결 테이블/결과 캐시 생성 실패\n");
+        return -1;
+    }
     
     server_ctx.context = lws_create_context(&info);
     if (!server_ctx.context) {
@@ -63,893 +128,2970 @@ int ws_server_init(int port) {
         return -1;
     }
     
-    printf("WebSocket 서버가 포트 %d에서 시작되었습니다\n", port);
-    server_running = 1;
+    server_ctx.thread_count = lws_get_count_threads(server_ctx.context);
+    if (server_ctx.thread_count < threads) {
+        printf("libwebsockets 빌드 설정(LWS_MAX_SMP)으로 서비스 스레드를 %d개에서 %d개로 줄임\n",
+               threads, server_ctx.thread_count);
+    }
+    
+    for (int i = 0; i < WS_MAX_SERVICE_THREADS; i++) {
+        mpsc_init(&server_ctx.done[i]);
+    }
+    if (workers >= 0 &&
+        worker_pool_init(&server_ctx.workers, (unsigned)workers, notify_service_threads, server_ctx.context) != 0) {
+        printf("❌ 워커 스레드 생성 실패 - 긴 실행도 서비스 스레드에서 처리\n");
+    }
+    
+    printf("WebSocket 서버가 포트 %d에서 시작되었습니다 (서비스 스레드 %d개, 워커 %u개)\n", port,
+           server_ctx.thread_count, server_ctx.workers.thread_count);
+    __atomic_store_n(&server_running, 1, __ATOMIC_RELEASE);
     return 0;
 }
 
 /*
- * @brief WebSocket 서버를 정리합니다
- * @param 없음
+ * @brief 트레이스 파일을 쓸 디렉터리를 정합니다 (클라이언트는 이 디렉터리 안의 이름만 고름)
+ * @param dir 디렉터리 (NULL이나 빈 문자열이면 WS_TRACE_DIR)
  * @returns 없음 (void)
  */
-void ws_server_cleanup(void) {
-    server_running = 0;
-    if (server_ctx.context) {
-        lws_context_destroy(server_ctx.context);
-        server_ctx.context = NULL;
-    }
-    pthread_mutex_destroy(&server_ctx.mutex);
+void ws_server_set_trace_dir(const char *dir) {
+    trace_dir = dir && dir[0] ? dir : WS_TRACE_DIR;
 }
 
 /*
- * @brief 새로운 클라이언트를 추가합니다
- * @param wsi WebSocket 인스턴스
- * @returns 클라이언트 ID, 실패 시 -1
+ * @brief 이미지를 읽을 디렉터리를 정합니다 (클라이언트는 이 디렉터리 안의 이름만 고름)
+ * @param dir 디렉터리 (NULL이나 빈 문자열이면 이미지 적재를 받지 않음)
+ * @returns 없음 (void)
  */
-static int add_client(struct lws *wsi) {
-    pthread_mutex_lock(&server_ctx.mutex);
+void ws_server_set_image_dir(const char *dir) {
+    image_dir = dir && dir[0] ? dir : NULL;
+}
+
+/*
+ * @brief 클라이언트가 준 파일 이름을 서버가 정한 디렉터리 안의 경로로 만듭니다
+ * @param dir 서버 설정 디렉터리
+ * @param name 클라이언트가 준 이름 (영문자, 숫자, '_', '-', '.'만, '.'으로 시작하거나 ".."을 포함하면 거부)
+ * @param suffix 이름 뒤에 붙일 확장자 ("" 가능)
+ * @param out 경로 버퍼
+ * @param size 버퍼 크기
+ * @returns 성공 시 0, 허용하지 않는 이름이면 -1
+ *
+ * @details
+ * '/'를 받지 않으므로 절대 경로나 하위/상위 디렉터리로 나갈 수 없습니다.
+ */
+static int resolve_client_file(const char *dir, const char *name, const char *suffix, char *out, size_t size) {
+    size_t length = name ? strlen(name) : 0;
     
-    if (server_ctx.client_count >= MAX_CLIENTS) {
-        pthread_mutex_unlock(&server_ctx.mutex);
+    if (length == 0 || length > WS_FILE_NAME_MAX || name[0] == '.' || strstr(name, "..")) {
         return -1;
     }
-    
-    int client_id = server_ctx.client_count;
-    server_ctx.clients[client_id].wsi = wsi;
-    server_ctx.clients[client_id].session_id = client_id;
-    server_ctx.clients[client_id].is_connected = 1;
-    
-    // 클라이언트 IP 주소 얻기
-    char client_name[128], client_ip[128];
-    lws_get_peer_addresses(wsi, lws_get_socket_fd(wsi), client_name, sizeof(client_name), client_ip, sizeof(client_ip));
-    strncpy(server_ctx.clients[client_id].ip_addr, client_ip, sizeof(server_ctx.clients[client_id].ip_addr) - 1);
-    
-    server_ctx.client_count++;
-    
-    printf("클라이언트 연결됨: %s (세션 ID: %d)\n", client_ip, client_id);
-    
-    pthread_mutex_unlock(&server_ctx.mutex);
-    return client_id;
+    for (size_t i = 0; i < length; i++) {
+        char c = name[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+              c == '_' || c == '-' || c == '.')) {
+            return -1;
+        }
+    }
+    int written = snprintf(out, size, "%s/%s%s", dir, name, suffix);
+    return written > 0 && (size_t)written < size ? 0 : -1;
 }
 
 /*
- * @brief 클라이언트를 제거합니다
- * @param wsi WebSocket 인스턴스
+ * @brief 서비스 스레드를 모두 멈추게 합니다 (신호 처리기에서 불러도 됨)
+ * @param 없음
  * @returns 없음 (void)
  */
-static void remove_client(struct lws *wsi) {
-    pthread_mutex_lock(&server_ctx.mutex);
-    
-    for (int i = 0; i < server_ctx.client_count; i++) {
-        if (server_ctx.clients[i].wsi == wsi) {
-            printf("클라이언트 연결 해제: %s (세션 ID: %d)\n", 
-                   server_ctx.clients[i].ip_addr, server_ctx.clients[i].session_id);
-            
-            // 배열에서 제거 (마지막 요소를 현재 위치로 이동)
-            if (i < server_ctx.client_count - 1) {
-                server_ctx.clients[i] = server_ctx.clients[server_ctx.client_count - 1];
-            }
-            server_ctx.client_count--;
-            break;
-        }
+void ws_server_stop(void) {
+    __atomic_store_n(&server_running, 0, __ATOMIC_RELEASE);
+    if (server_ctx.context) {
+        lws_cancel_service(server_ctx.context);
     }
-    
-    pthread_mutex_unlock(&server_ctx.mutex);
 }
 
 /*
- * @brief 모든 클라이언트에게 메시지를 전송합니다
- * @param message 전송할 메시지
+ * @brief WebSocket 서버를 정리합니다
+ * @param 없음
  * @returns 없음 (void)
  */
-static void broadcast_message(const char* message) {
-    pthread_mutex_lock(&server_ctx.mutex);
-    
-    for (int i = 0; i < server_ctx.client_count; i++) {
-        if (server_ctx.clients[i].is_connected) {
-            size_t msg_len = strlen(message);
-            unsigned char *buf = malloc(LWS_PRE + msg_len);
-            
-            if (buf) {
-                memcpy(&buf[LWS_PRE], message, msg_len);
-                lws_write(server_ctx.clients[i].wsi, &buf[LWS_PRE], msg_len, LWS_WRITE_TEXT);
-                free(buf);
-            }
+void ws_server_cleanup(void) {
+    __atomic_store_n(&server_running, 0, __ATOMIC_RELEASE);
+    // 워커를 먼저 멈춤 (실행 중인 작업은 취소되어 done 큐로 돌아오고, notify는 아직 살아 있는 컨텍스트를 깨움)
+    worker_pool_shutdown(&server_ctx.workers);
+    if (server_ctx.context) {
+        lws_context_destroy(server_ctx.context);
+        server_ctx.context = NULL;
+    }
+    for (int i = 0; i < WS_MAX_SERVICE_THREADS; i++) {
+        WorkItem *item = mpsc_take_all(&server_ctx.done[i]);
+        while (item) {
+            WorkItem *next = item->next;
+            job_free((struct ws_job *)item);
+            item = next;
         }
     }
-    
-    pthread_mutex_unlock(&server_ctx.mutex);
+    // 컨텍스트를 닫으면 연결마다 LWS_CALLBACK_CLOSED가 오지만, 남은 것이 있으면 대기열만 정리
+    for (uint32_t i = 0; i < server_ctx.clients.capacity; i++) {
+        ws_client_session_t *client = handle_table_at(&server_ctx.clients, i);
+        if (client) {
+            send_queue_clear(&client->queue);
+        }
+    }
+    handle_table_free(&server_ctx.clients);
+    out_frame_release(json_frame);
+    json_frame = NULL;
+    out_frame_pool_trim();
+    lru_free(&server_ctx.program_cache);
+    lru_free(&server_ctx.run_cache);
+    pthread_mutex_destroy(&server_ctx.cache_mutex);
+    pthread_cond_destroy(&server_ctx.unpinned);
+    pthread_mutex_destroy(&server_ctx.mutex);
 }
 
 /*
- * @brief 레지스터 이름을 번호로 변환합니다
- * @param reg_str 레지스터 문자열 (예: "R1")
- * @returns 레지스터 번호 (1-7), 실패 시 -1
+ * @brief 연결의 CPU 세션을 초기화합니다
+ * @param session 연결의 CPU 세션 (lws가 0으로 채워 둔 per-session user data 안)
+ * @returns 성공 시 0, 실패 시 -1
  */
-int parse_register(const char* reg_str) {
-    if (reg_str[0] == 'R' && strlen(reg_str) == 2) {
-        int reg_num = reg_str[1] - '0';
-        if (reg_num >= 1 && reg_num <= 7) {
-            return reg_num; // R1=1, R2=2, ..., R7=7
-        }
+static int session_open(ws_cpu_session_t *session) {
+    cpu_context_init(&session->cpu);
+    memset(&session->exec, 0, sizeof(session->exec));
+    if (asm_session_init(&session->editor, MEMORY_SIZE) != 0) {
+        return -1;
     }
-    return -1; // 레지스터가 아님
+    session->editor_source = NULL;
+    state_tracker_init(&session->tracker, STATE_KEYFRAME_INTERVAL);
+    session->view = session;
+    session->viewers = NULL;
+    session->viewer_count[0] = session->viewer_count[1] = 0;
+    pthread_mutex_init(&session->lock, NULL);
+    session->ready = 1;
+    return 0;
 }
 
 /*
- * @brief 어셈블리 코드를 바이트로 변환합니다
- * @param assembly 어셈블리 코드 문자열
- * @param output_bytes 출력 바이트 배열
- * @param max_length 최대 출력 길이
- * @returns 생성된 바이트 수, 실패 시 0
+ * @brief 연결의 CPU 세션을 정리합니다 (열리지 않은 세션이면 아무것도 하지 않음)
  */
-int decode_assembly_to_bytes(const char* assembly, uint8_t* output_bytes, int max_length) {
-    if (!assembly || !output_bytes || max_length < 2) {
-        return 0;
-    }
-    
-    char instruction[32];
-    char operand1_str[32], operand2_str[32];
-    
-    int parsed = sscanf(assembly, "%s %31[^,], %31s", instruction, operand1_str, operand2_str);
-    
-    if (parsed < 2) {
-        printf("❌ 파싱 실패: %s\n", assembly);
-        return 0;
-    }
-    
-    uint8_t opcode = 0;
-    if (strcmp(instruction, "ADD") == 0) opcode = 0;
-    else if (strcmp(instruction, "SUB") == 0) opcode = 1;
-    else if (strcmp(instruction, "MUL") == 0) opcode = 2;
-    else if (strcmp(instruction, "DIV") == 0) opcode = 3;
-    else if (strcmp(instruction, "MOV") == 0) opcode = 4;
-    else {
-        printf("❌ 알 수 없는 명령어: %s\n", instruction);
-        return 0;
-    }
-    
-    // 🎯 MOV 명령어 특별 처리 (레지스터 + 8비트 즉시값 지원)
-    if (opcode == 4) {
-        // MOV 레지스터, 즉시값 형태 처리
-        if (operand1_str[0] == 'R' && strlen(operand1_str) == 2) {
-            int reg_num = operand1_str[1] - '0';
-            if (reg_num >= 1 && reg_num <= 7) {
-                int immediate_val = atoi(operand2_str);
-                if (immediate_val < 0 || immediate_val > 255) {
-                    printf("❌ 즉시값 범위 오류 (0-255): %d\n", immediate_val);
-                    return 0;
-                }
-                
-                // MOV 레지스터, 즉시값: 4비트 opcode + 4비트 레지스터 + 8비트 즉시값
-                uint16_t instruction_word = (opcode << 12) | (reg_num << 8) | (immediate_val & 0xFF);
-                
-                output_bytes[0] = (instruction_word >> 8) & 0xFF;
-                output_bytes[1] = instruction_word & 0xFF;
-                
-                printf("🎯 MOV 인코딩: %s -> 레지스터=%d, 즉시값=%d -> 바이트: 0x%02X 0x%02X\n", 
-                       assembly, reg_num, immediate_val, output_bytes[0], output_bytes[1]);
-                
-                return 2;
-            } else {
-                printf("❌ 잘못된 레지스터: %s\n", operand1_str);
-                return 0;
-            }
-        }
-        // MOV 메모리, 즉시값 형태는 기존 방식 사용
-        else {
-            uint8_t reg1_val = atoi(operand1_str);
-            uint8_t reg2_val = (parsed == 3) ? atoi(operand2_str) : 0;
-            
-            if (reg1_val > 63) reg1_val = 63;
-            if (reg2_val > 63) reg2_val = 63;
-            
-            uint16_t instruction_word = (opcode << 12) | ((reg1_val & 0x3F) << 6) | (reg2_val & 0x3F);
-            
-            output_bytes[0] = (instruction_word >> 8) & 0xFF;
-            output_bytes[1] = instruction_word & 0xFF;
-            
-            printf("📊 MOV 메모리 인코딩: %s -> 바이트: 0x%02X 0x%02X\n", assembly, output_bytes[0], output_bytes[1]);
-            return 2;
-        }
-    }
-    
-    // 🚀 ADD/SUB/MUL/DIV 명령어 - 레지스터 지원 향상
-    if (opcode >= 0 && opcode <= 3) {
-        // 두 피연산자가 모두 레지스터인지 확인
-        if (operand1_str[0] == 'R' && operand2_str[0] == 'R' && 
-            strlen(operand1_str) == 2 && strlen(operand2_str) == 2) {
-            
-            int reg1_num = operand1_str[1] - '0';
-            int reg2_num = operand2_str[1] - '0';
-            
-            if (reg1_num >= 1 && reg1_num <= 7 && reg2_num >= 1 && reg2_num <= 7) {
-                // 새로운 레지스터 포맷: 4비트 opcode + 4비트 reg1 + 4비트 reg2 + 4비트 플래그(1111)
-                uint16_t instruction_word = (opcode << 12) | (reg1_num << 8) | (reg2_num << 4) | 0xF;
-                
-                output_bytes[0] = (instruction_word >> 8) & 0xFF;
-                output_bytes[1] = instruction_word & 0xFF;
-                
-                printf("🚀 ALU 레지스터 인코딩: %s -> reg1=%d, reg2=%d -> 바이트: 0x%02X 0x%02X\n", 
-                       assembly, reg1_num, reg2_num, output_bytes[0], output_bytes[1]);
-                
-                return 2;
-            }
-        }
-    }
-    
-    // 다른 명령어들 (기존 방식)
-    uint8_t reg1_val, reg2_val = 0;
-    
-    // 첫 번째 피연산자: 레지스터인지 확인
-    if (operand1_str[0] == 'R' && strlen(operand1_str) == 2) {
-        int reg_num = operand1_str[1] - '0';
-        if (reg_num >= 1 && reg_num <= 7) {
-            reg1_val = 100 + reg_num;  // R1=101, R2=102, ..., R7=107
-            printf("🎯 첫 번째: %s -> 인코딩 %d\n", operand1_str, reg1_val);
-        } else {
-            printf("❌ 잘못된 레지스터: %s\n", operand1_str);
-            return 0;
-        }
-    } else {
-        reg1_val = atoi(operand1_str);
-        if (reg1_val > 63) reg1_val = 63;
-        printf("📊 첫 번째: 즉시값 %d\n", reg1_val);
-    }
-    
-    // 두 번째 피연산자
-    if (parsed == 3) {
-        if (operand2_str[0] == 'R' && strlen(operand2_str) == 2) {
-            int reg_num = operand2_str[1] - '0';
-            if (reg_num >= 1 && reg_num <= 7) {
-                reg2_val = 100 + reg_num;
-                printf("🎯 두 번째: %s -> 인코딩 %d\n", operand2_str, reg2_val);
-            } else {
-                printf("❌ 잘못된 레지스터: %s\n", operand2_str);
-                return 0;
-            }
-        } else {
-            reg2_val = atoi(operand2_str);
-            if (reg2_val > 63) reg2_val = 63;
-            printf("📊 두 번째: 즉시값 %d\n", reg2_val);
-        }
+static void session_close(ws_cpu_session_t *session) {
+    if (!session || !session->ready) {
+        return;
     }
-    
-    // 인코딩
-    uint16_t instruction_word = (opcode << 12) | ((reg1_val & 0x3F) << 6) | (reg2_val & 0x3F);
-    
-    output_bytes[0] = (instruction_word >> 8) & 0xFF;
-    output_bytes[1] = instruction_word & 0xFF;
-    
-    printf("파싱 성공: %s -> 바이트: 0x%02X 0x%02X\n", assembly, output_bytes[0], output_bytes[1]);
-    
-    return 2;
+    lws_sul_cancel(&session->run.timer);    // 실행 중인 run_all (세션 스레드에서 닫으므로 타이머와 겹치지 않음)
+    job_abandon(session);                   // 워커 결과는 핸들이 풀렸으므로 돌아와도 버려짐
+    free(session->run.memo_key);
+    session->run.memo_key = NULL;
+    session->run.state = RUN_IDLE;
+    asm_session_free(&session->editor);
+    free(session->editor_source);
+    session->editor_source = NULL;
+    free(session->cpu.profile);
+    session->cpu.profile = NULL;
+    pthread_mutex_destroy(&session->lock);
+    session->ready = 0;
 }
 
 /*
- * @brief 바이트를 어셈블리 코드로 변환합니다
- * @param bytes 입력 바이트 배열
- * @param byte_count 바이트 개수
- * @param output_assembly 출력 어셈블리 문자열
- * @param max_length 최대 출력 길이
- * @returns 변환 성공 시 1, 실패 시 0
+ * @brief 요청을 처리하는 동안 세션의 CPU를 현재 컨텍스트로 삼습니다
+ * @param session 처리할 세션
+ * @returns 없음 (void)
+ *
+ * @details
+ * 코어 함수(cpu_step, get_cpu_registers 등)는 현재 컨텍스트에서 동작하고,
+ * 상태 변화(ws_send_*_state, delta)는 current_session을 보는 클라이언트 모두에게 보내고,
+ * 확인/오류는 request_enter()로 정한 요청자에게만 보냅니다.
+ * 세션 lock은 소유 연결의 스레드만 잡으면 경합이 없고, 다른 스레드의 관전자가 요청할 때만 기다립니다.
+ * 한 번에 세션 하나의 lock만 잡습니다 (watch/resync처럼 다른 세션을 보는 요청은 세션 밖에서 처리).
  */
-int decode_bytes_to_assembly(const uint8_t* bytes, int byte_count, char* output_assembly, int max_length) {
-    if (!bytes || byte_count < 2 || !output_assembly || max_length < 32) {
-        return 0;
-    }
-    
-    uint16_t instruction_word = (bytes[0] << 8) | bytes[1];
-    
-    // 4비트 opcode 추출
-    uint8_t opcode = (instruction_word >> 12) & 0xF;
-    
-    const char* op_name;
-    switch (opcode) {
-        case 0: op_name = "ADD"; break;
-        case 1: op_name = "SUB"; break;
-        case 2: op_name = "MUL"; break;
-        case 3: op_name = "DIV"; break;
-        case 4: op_name = "MOV"; break;
-        default: return 0;
-    }
-    
-    // 🎯 MOV 명령어 특별 처리
-    if (opcode == 4) {
-        // MOV 레지스터, 즉시값: 4비트 opcode + 4비트 레지스터 + 8비트 즉시값
-        uint8_t reg_num = (instruction_word >> 8) & 0xF;
-        uint8_t immediate_val = instruction_word & 0xFF;
-        
-        // 레지스터 번호가 1-7 범위인지 확인
-        if (reg_num >= 1 && reg_num <= 7) {
-            snprintf(output_assembly, max_length, "%s R%d, %d", op_name, reg_num, immediate_val);
-            printf("🎯 MOV 디코딩: 바이트 0x%02X 0x%02X -> %s\n", bytes[0], bytes[1], output_assembly);
-            return 1;
-        }
-        // 기존 방식 (메모리 주소)으로 디코딩 시도
-        else {
-            uint8_t reg1_val = (instruction_word >> 6) & 0x3F;
-            uint8_t reg2_val = instruction_word & 0x3F;
-            
-            char reg1_str[16], reg2_str[16];
-            
-            if (reg1_val > 100) {
-                snprintf(reg1_str, sizeof(reg1_str), "R%d", reg1_val - 100);
-            } else {
-                snprintf(reg1_str, sizeof(reg1_str), "%d", reg1_val);
-            }
-            
-            if (reg2_val > 100) {
-                snprintf(reg2_str, sizeof(reg2_str), "R%d", reg2_val - 100);
-            } else {
-                snprintf(reg2_str, sizeof(reg2_str), "%d", reg2_val);
-            }
-            
-            snprintf(output_assembly, max_length, "%s %s, %s", op_name, reg1_str, reg2_str);
-            printf("📊 MOV 메모리 디코딩: 바이트 0x%02X 0x%02X -> %s\n", bytes[0], bytes[1], output_assembly);
-            return 1;
-        }
-    }
-    
-    // 다른 명령어들 (기존 방식): 4비트 opcode + 6비트 reg1 + 6비트 reg2
-    uint8_t reg1_val = (instruction_word >> 6) & 0x3F;
-    uint8_t reg2_val = instruction_word & 0x3F;
-    
-    char reg1_str[16], reg2_str[16];
-    
-    if (reg1_val > 100) {
-        snprintf(reg1_str, sizeof(reg1_str), "R%d", reg1_val - 100);
-    } else {
-        snprintf(reg1_str, sizeof(reg1_str), "%d", reg1_val);
-    }
-    
-    if (reg2_val > 100) {
-        snprintf(reg2_str, sizeof(reg2_str), "R%d", reg2_val - 100);
-    } else {
-        snprintf(reg2_str, sizeof(reg2_str), "%d", reg2_val);
+static void session_enter(ws_cpu_session_t *session) {
+    pthread_mutex_lock(&session->lock);
+    current_session = session;
+    cpu_set_context(&session->cpu);
+    // 로그 설정은 스레드 로컬이므로 세션의 모드에 맞춤 (기능 모드 세션은 로그 없음)
+    cpu_log_enabled = session->cpu.mode == CPU_MODE_FUNCTIONAL ? 0 : session->cpu.saved_log_enabled;
+}
+
+static void session_leave(void) {
+    CPU_Context *ctx = cpu_set_context(NULL);
+    if (ctx->mode != CPU_MODE_FUNCTIONAL) {
+        ctx->saved_log_enabled = cpu_log_enabled;
     }
-    
-    snprintf(output_assembly, max_length, "%s %s, %s", op_name, reg1_str, reg2_str);
-    return 1;
+    cpu_log_enabled = cpu_get_context()->saved_log_enabled;
+    pthread_mutex_unlock(&current_session->lock);
+    current_session = NULL;
 }
 
 /*
- * @brief CPU 상태 JSON 메시지를 생성합니다
- * @param 없음
- * @returns JSON 객체 포인터
+ * @brief 클라이언트의 요청을 처리하는 동안 세션에 들어가고 응답 받을 클라이언트를 정합니다
+ * @param client 요청한 클라이언트 (ws_send_ack/ws_send_error는 이 클라이언트에게만)
+ * @param session 처리할 세션 (관전 중이면 보고 있는 세션)
+ * @returns 없음 (void)
  */
-json_object* create_state_message(void) {
-    json_object *root = json_object_new_object();
-    json_object *type = json_object_new_string("state");
-    json_object *payload = json_object_new_object();
-    
-    CPU_Registers *regs = get_cpu_registers();
-    
-    json_object *pc = json_object_new_int(regs->pc);
-    json_object *reg1 = json_object_new_int(regs->register1);
-    json_object *reg2 = json_object_new_int(regs->register2);
-    json_object *reg3 = json_object_new_int(regs->register3);
-    json_object *reg4 = json_object_new_int(regs->register4);
-    json_object *reg5 = json_object_new_int(regs->register5);
-    json_object *reg6 = json_object_new_int(regs->register6);
-    json_object *reg7 = json_object_new_int(regs->register7);
-    json_object *overflow_flag = json_object_new_boolean(regs->overflow_flag);
-    
-    json_object_object_add(payload, "pc", pc);
-    json_object_object_add(payload, "register1", reg1);
-    json_object_object_add(payload, "register2", reg2);
-    json_object_object_add(payload, "register3", reg3);
-    json_object_object_add(payload, "register4", reg4);
-    json_object_object_add(payload, "register5", reg5);
-    json_object_object_add(payload, "register6", reg6);
-    json_object_object_add(payload, "register7", reg7);
-    json_object_object_add(payload, "overflow_flag", overflow_flag);
-    
-    json_object_object_add(root, "type", type);
-    json_object_object_add(root, "payload", payload);
-    
-    return root;
+static void request_enter(ws_client_session_t *client, ws_cpu_session_t *session) {
+    session_enter(session);
+    current_requester = client;
 }
 
+static void request_leave(void) {
+    current_requester = NULL;
+    session_leave();
+}
+
+// 워커에서 실행하는 요청 종류
+typedef enum {
+    WS_JOB_LOAD_PROGRAM,
+    WS_JOB_RUN_ALL,
+    WS_JOB_FAST_FORWARD
+} ws_job_kind_t;
+
 /*
- * @brief 메모리 상태 JSON 메시지를 생성합니다
- * @param 없음
- * @returns JSON 객체 포인터
+ * 워커 풀에 맡긴 요청 하나.
+ * 워커는 세션을 건드리지 않고 여기 복사해 둔 CPU(또는 새 편집 세션)만 바꾸며,
+ * 끝나면 세션 주인 스레드의 done 큐로 돌아와 그 스레드가 세션에 적용합니다.
+ * 세션은 포인터 대신 세대가 붙은 핸들로 찾으므로, 그사이 닫힌 연결의 결과는 그냥 버려집니다.
  */
-json_object* create_memory_message(void) {
-    json_object *root = json_object_new_object();
-    json_object *type = json_object_new_string("memory");
-    json_object *payload = json_object_new_object();
-    
-    Memory *memory = get_cpu_memory();
-    json_object *memory_array = json_object_new_array();
-    
-    for (int i = 0; i < MEMORY_SIZE && i < 64; i++) { // 처음 64바이트만 전송
-        json_object *byte_val = json_object_new_int(memory->data[i]);
-        json_object_array_add(memory_array, byte_val);
-    }
-    
-    json_object_object_add(payload, "data", memory_array);
-    json_object_object_add(root, "type", type);
-    json_object_object_add(root, "payload", payload);
-    
-    return root;
-}
+typedef struct ws_job {
+    WorkItem item;                  // 첫 멤버 (WorkItem* ↔ ws_job_t*)
+    ws_job_kind_t kind;
+    uint32_t id;
+    Handle owner;                   // 세션 주인 연결의 session_id
+    int stopping;                   // cancel/stop 요청 (세션 lock 안에서만)
+    CPU_Context cpu;                // 실행 작업: 세션 CPU의 복사본
+    uint64_t budget;                // run_all: 이번 작업의 단계 한도 (0이면 없음)
+    uint64_t steps;                 // run_all: 실행한 단계
+    int halted;                     // run_all: 빈 명령어나 메모리 끝에 도달
+    int last_pc;                    // run_all: 마지막으로 실행한 명령어
+    uint8_t last_bytes[2];
+    FastForwardConfig ff_config;
+    FastForwardResult ff_result;
+    char *source;                   // load_program: 소스 사본
+    size_t length;
+    AsmSession editor;              // load_program: 새로 적재한 편집 세션 (적용하면 세션으로 옮김)
+    AsmEdit edit;
+    int editor_ready;               // editor를 해제해야 함
+    int load_failed;                // 메모리 부족
+} ws_job_t;
 
 /*
- * @brief 캐시 상태 JSON 메시지를 생성합니다
- * @param 없음
- * @returns JSON 객체 포인터
+ * @brief 워커가 결과를 넣은 뒤 서비스 스레드를 깨웁니다 (워커 스레드에서 호출)
  */
-json_object* create_cache_message(void) {
-    json_object *root = json_object_new_object();
-    json_object *type = json_object_new_string("cache");
-    json_object *payload = json_object_new_object();
-    
-    Memory *memory = get_cpu_memory();
-    Cache *cache = &memory->cache;
-    
-    json_object *cache_lines = json_object_new_array();
-    
-    // 처음 16개 캐시 라인만 전송 (화면에 보여줄 수 있는 적당한 양)
-    for (int i = 0; i < 16 && i < 64; i++) {
-        CacheLine *line = &cache->lines[i];
-        
-        json_object *line_obj = json_object_new_object();
-        json_object *index = json_object_new_int(i);
-        json_object *tag = json_object_new_int(line->tag);
-        json_object *valid = json_object_new_boolean(line->valid);
-        json_object *dirty = json_object_new_boolean(line->dirty);
-        
-        // 캐시 라인의 4바이트 데이터
-        json_object *data_array = json_object_new_array();
-        for (int j = 0; j < 4; j++) {
-            json_object *byte_val = json_object_new_int(line->block[j]);
-            json_object_array_add(data_array, byte_val);
-        }
-        
-        json_object_object_add(line_obj, "index", index);
-        json_object_object_add(line_obj, "tag", tag);
-        json_object_object_add(line_obj, "valid", valid);
-        json_object_object_add(line_obj, "dirty", dirty);
-        json_object_object_add(line_obj, "data", data_array);
-        
-        json_object_array_add(cache_lines, line_obj);
-    }
-    
-    json_object_object_add(payload, "lines", cache_lines);
-    json_object_object_add(root, "type", type);
-    json_object_object_add(root, "payload", payload);
-    
-    return root;
+static void notify_service_threads(void *arg) {
+    lws_cancel_service((struct lws_context *)arg);
 }
 
 /*
- * @brief 실행 단계 JSON 메시지를 생성합니다
- * @param instruction 실행된 명령어 문자열
- * @param bytes 명령어 바이트 배열
- * @param byte_count 바이트 개수
- * @returns JSON 객체 포인터
+ * @brief 현재 세션의 워커 작업을 만듭니다
+ * @param kind 작업 종류
+ * @param run 워커에서 실행할 함수
+ * @param deadline_ms 마감 시간 (0이면 없음)
+ * @returns 작업, 메모리가 부족하면 NULL
  */
-json_object* create_execution_message(const char* instruction, const uint8_t* bytes, int byte_count) {
-    json_object *root = json_object_new_object();
-    json_object *type = json_object_new_string("execution");
-    json_object *payload = json_object_new_object();
-    
-    json_object *inst_str = json_object_new_string(instruction);
-    json_object *bytes_array = json_object_new_array();
-    
-    for (int i = 0; i < byte_count; i++) {
-        json_object *byte_val = json_object_new_int(bytes[i]);
-        json_object_array_add(bytes_array, byte_val);
+static ws_job_t* job_new(ws_job_kind_t kind, WorkStatus (*run)(WorkItem *), uint32_t deadline_ms) {
+    ws_client_session_t *owner = lws_container_of(current_session, ws_client_session_t, session);
+    ws_job_t *job = calloc(1, sizeof(*job));
+
+    if (!job) {
+        return NULL;
     }
-    
-    json_object_object_add(payload, "instruction", inst_str);
-    json_object_object_add(payload, "bytes", bytes_array);
-    
-    json_object_object_add(root, "type", type);
-    json_object_object_add(root, "payload", payload);
-    
-    return root;
+    job->kind = kind;
+    job->id = __atomic_add_fetch(&server_ctx.next_job_id, 1, __ATOMIC_RELAXED);
+    job->owner = owner->session_id;
+    job->item.run = run;
+    job->item.reply = &server_ctx.done[owner->tsi];
+    job->item.deadline_us = deadline_ms ? work_now_us() + (uint64_t)deadline_ms * 1000U : 0;
+    return job;
+}
+
+static void job_free(ws_job_t *job) {
+    if (job->editor_ready) {
+        asm_session_free(&job->editor);
+    }
+    free(job->source);
+    free(job);
 }
 
 /*
- * @brief 확인 JSON 메시지를 생성합니다
- * @param message 확인 메시지 문자열
- * @returns JSON 객체 포인터
+ * @brief 실행 작업을 워커에 맡겨도 되는지 확인합니다
+ * @returns 맡겨도 되면 1
+ *
+ * @details
+ * 프로파일은 세션의 profile을 단계마다 갱신하고, 트레이스는 이 스레드가 생산자이므로 이 스레드에서 실행합니다.
  */
-json_object* create_ack_message(const char* message) {
-    json_object *root = json_object_new_object();
-    json_object *type = json_object_new_string("ack");
-    json_object *payload = json_object_new_string(message);
-    
-    json_object_object_add(root, "type", type);
-    json_object_object_add(root, "payload", payload);
-    
-    return root;
+static int job_offloadable(void) {
+    return server_ctx.workers.thread_count > 0 && !cpu_get_context()->profiling && !TRACE_ACTIVE();
 }
 
 /*
- * @brief 에러 JSON 메시지를 생성합니다
- * @param error 에러 메시지 문자열
- * @returns JSON 객체 포인터
+ * @brief 세션 CPU를 복사해 작업에 넣습니다 (워커는 이 복사본만 실행)
  */
-json_object* create_error_message(const char* error) {
-    json_object *root = json_object_new_object();
-    json_object *type = json_object_new_string("error");
-    json_object *payload = json_object_new_string(error);
-    
-    json_object_object_add(root, "type", type);
-    json_object_object_add(root, "payload", payload);
-    
-    return root;
+static void job_copy_cpu(ws_job_t *job) {
+    job->cpu = *cpu_get_context();
+    job->cpu.profile = NULL;
+    job->cpu.profiling = 0;
 }
 
-// 메시지 전송 함수들
 /*
- * @brief CPU 상태를 모든 클라이언트에 전송합니다
- * @param 없음
- * @returns 없음 (void)
+ * @brief 작업이 실행한 CPU 상태를 세션에 적용합니다 (프로파일 설정은 세션 것을 유지)
  */
-void ws_send_cpu_state(void) {
-    json_object *msg = create_state_message();
-    const char *json_str = json_object_to_json_string(msg);
-    broadcast_message(json_str);
-    json_object_put(msg);
+static void job_apply_cpu(const ws_job_t *job) {
+    CPU_Context *ctx = cpu_get_context();
+    struct Profile *profile = ctx->profile;
+    int profiling = ctx->profiling;
+
+    *ctx = job->cpu;
+    ctx->profile = profile;
+    ctx->profiling = profiling;
 }
 
 /*
- * @brief 메모리 상태를 모든 클라이언트에 전송합니다
- * @param 없음
- * @returns 없음 (void)
+ * @brief 작업을 워커에 넘기고 현재 세션의 작업으로 둡니다
+ * @param job 작업
+ * @returns 성공 시 0, 실패하면 -1 (작업은 해제됨, 호출자는 이 스레드에서 실행)
  */
-void ws_send_memory_state(void) {
-    json_object *msg = create_memory_message();
-    const char *json_str = json_object_to_json_string(msg);
-    broadcast_message(json_str);
+static int job_submit(ws_job_t *job) {
+    if (worker_pool_submit(&server_ctx.workers, &job->item) != 0) {
+        job_free(job);
+        return -1;
+    }
+    current_session->job = job;
+    printf("워커 작업 %u 제출\n", job->id);
+    return 0;
+}
+
+/*
+ * @brief 세션의 워커 작업을 버립니다 (상태를 바꾸는 요청 앞, 세션을 닫을 때)
+ * @param session 세션 (lock을 잡았거나 세션 주인 스레드에서 닫는 중)
+ * @returns 없음 (void)
+ *
+ * @details
+ * 워커는 다음 확인에서 멈추고, 돌아온 결과는 session->job과 다르므로 적용하지 않고 해제됩니다.
+ */
+static void job_abandon(ws_cpu_session_t *session) {
+    if (session->job) {
+        work_item_cancel(&session->job->item);
+        session->job = NULL;
+    }
+}
+
+/*
+ * @brief 워커 작업 세션 적용 (종류별로 아래 처리기 근처에 정의)
+ */
+static void program_load_complete(ws_job_t *job);
+static void run_all_complete(ws_job_t *job);
+static void fast_forward_complete(ws_job_t *job);
+
+/*
+ * @brief 이 스레드 세션의 끝난 워커 작업을 적용합니다 (LWS_CALLBACK_EVENT_WAIT_CANCELLED)
+ * @param 없음
+ * @returns 없음 (void)
+ *
+ * @details
+ * 작업은 세션 주인 스레드의 큐로 돌아오고 세션은 그 스레드에서만 닫히므로,
+ * 핸들로 찾은 세션은 적용하는 동안 사라지지 않습니다.
+ */
+static void drain_thread_jobs(void) {
+    if (service_tsi < 0) {
+        return;
+    }
+    WorkItem *item = mpsc_take_all(&server_ctx.done[service_tsi]);
+    while (item) {
+        ws_job_t *job = (ws_job_t *)item;
+        item = item->next;
+
+        pthread_mutex_lock(&server_ctx.mutex);
+        ws_client_session_t *owner = handle_get(&server_ctx.clients, job->owner);
+        pthread_mutex_unlock(&server_ctx.mutex);
+        if (owner) {
+            // 작업 완료 응답은 작업을 요청한 소유 연결에게
+            request_enter(owner, &owner->session);
+            if (owner->session.job == job) {
+                owner->session.job = NULL;
+                printf("워커 작업 %u 끝 (상태 %d)\n", job->id, job->item.status);
+                switch (job->kind) {
+                    case WS_JOB_LOAD_PROGRAM: program_load_complete(job); break;
+                    case WS_JOB_RUN_ALL:      run_all_complete(job); break;
+                    case WS_JOB_FAST_FORWARD: fast_forward_complete(job); break;
+                }
+            }
+            request_leave();
+        }
+        job_free(job);
+    }
+}
+
+/*
+ * @brief 워커 스레드에서 작업의 CPU를 현재 컨텍스트로 삼습니다 (session_enter와 같은 로그 규칙)
+ */
+static void job_enter_cpu(ws_job_t *job) {
+    cpu_set_context(&job->cpu);
+    cpu_log_enabled = job->cpu.mode == CPU_MODE_FUNCTIONAL ? 0 : job->cpu.saved_log_enabled;
+}
+
+static void job_leave_cpu(void) {
+    CPU_Context *ctx = cpu_set_context(NULL);
+    if (ctx->mode != CPU_MODE_FUNCTIONAL) {
+        ctx->saved_log_enabled = cpu_log_enabled;
+    }
+}
+
+/*
+ * @brief 워커: 소스 전체를 새 편집 세션에 어셈블합니다
+ * @details 어셈블 도중에는 멈출 수 없으므로 취소/마감은 끝난 뒤에 확인합니다.
+ */
+static WorkStatus job_load_program(WorkItem *item) {
+    ws_job_t *job = (ws_job_t *)item;
+
+    if (asm_session_init(&job->editor, MEMORY_SIZE) != 0) {
+        job->load_failed = 1;
+        return WORK_DONE;
+    }
+    job->editor_ready = 1;
+    if (asm_session_load(&job->editor, job->source, job->length, &job->edit) != 0) {
+        job->load_failed = 1;
+    }
+    return work_item_check(item);
+}
+
+/*
+ * @brief 워커: 프로그램 끝이나 단계 한도까지 실행합니다 (WS_JOB_CHECK_STEPS마다 취소/마감 확인)
+ */
+static WorkStatus job_run_all(WorkItem *item) {
+    ws_job_t *job = (ws_job_t *)item;
+    WorkStatus status = WORK_DONE;
+
+    job_enter_cpu(job);
+    CPU_Registers *regs = get_cpu_registers();
+    Memory *memory = get_cpu_memory();
+    for (;;) {
+        if (regs->pc >= MEMORY_SIZE - 1 ||
+            (memory_peek(memory, regs->pc) == 0 && memory_peek(memory, regs->pc + 1) == 0)) {
+            job->halted = 1;
+            break;
+        }
+        if (job->budget && job->steps >= job->budget) {
+            break;
+        }
+        if (job->steps % WS_JOB_CHECK_STEPS == 0 && (status = work_item_check(item)) != WORK_DONE) {
+            break;
+        }
+        job->last_pc = regs->pc;
+        job->last_bytes[0] = memory_peek(memory, regs->pc);
+        job->last_bytes[1] = memory_peek(memory, regs->pc + 1);
+        cpu_step();
+        job->steps++;
+    }
+    job_leave_cpu();
+    return status;
+}
+
+static int job_should_stop(void *arg) {
+    return work_item_check(arg) != WORK_DONE;
+}
+
+/*
+ * @brief 워커: 멈춤 조건이나 취소/마감까지 fast-forward합니다
+ */
+static WorkStatus job_fast_forward(WorkItem *item) {
+    ws_job_t *job = (ws_job_t *)item;
+
+    job->ff_config.should_stop = job_should_stop;
+    job->ff_config.stop_arg = item;
+    job_enter_cpu(job);
+    job->ff_result = cpu_fast_forward(&job->ff_config);
+    job_leave_cpu();
+    return job->ff_result.reason == FF_STOP_CANCELLED ? work_item_check(item) : WORK_DONE;
+}
+
+/*
+ * @brief 요청 옵션의 마감 시간을 읽습니다
+ * @param options 요청 payload (NULL 가능)
+ * @returns "deadline_ms" 값 (0이면 없음), 없거나 음수면 WS_JOB_DEADLINE_MS
+ */
+static uint32_t job_deadline_option(json_object *options) {
+    json_object *value;
+
+    if (options && json_object_object_get_ex(options, "deadline_ms", &value)) {
+        int64_t ms = json_object_get_int64(value);
+        if (ms >= 0) {
+            return ms > UINT32_MAX ? UINT32_MAX : (uint32_t)ms;
+        }
+    }
+    return WS_JOB_DEADLINE_MS;
+}
+
+/*
+ * @brief 연결을 세션의 구독자 목록에 넣습니다 (락을 잡은 상태에서 호출)
+ */
+static void viewer_attach(ws_cpu_session_t *session, ws_client_session_t *client) {
+    __atomic_store_n(&client->session.view, session, __ATOMIC_RELEASE);
+    client->prev_viewer = NULL;
+    client->next_viewer = session->viewers;
+    if (session->viewers) {
+        session->viewers->prev_viewer = client;
+    }
+    session->viewers = client;
+    session->viewer_count[client->binary]++;
+}
+
+/*
+ * @brief 연결을 지금 구독 중인 세션의 목록에서 뺍니다 (락을 잡은 상태에서 호출)
+ */
+static void viewer_detach(ws_client_session_t *client) {
+    ws_cpu_session_t *session = client->session.view;
+    
+    if (client->prev_viewer) {
+        client->prev_viewer->next_viewer = client->next_viewer;
+    } else {
+        session->viewers = client->next_viewer;
+    }
+    if (client->next_viewer) {
+        client->next_viewer->prev_viewer = client->prev_viewer;
+    }
+    client->next_viewer = client->prev_viewer = NULL;
+    session->viewer_count[client->binary]--;
+}
+
+/*
+ * @brief 연결이 보는 세션을 고정합니다 (view_unpin까지 그 세션의 연결이 닫혀도 메모리가 남음)
+ * @param client 요청한 연결
+ * @returns 보고 있는 세션
+ *
+ * @details
+ * 자기 세션은 이 스레드에서만 닫히므로 고정하지 않습니다.
+ * 관전 중이면 세션 주인이 다른 스레드에서 닫힐 수 있어, 락 안에서 읽고 pins를 올립니다.
+ */
+static ws_cpu_session_t* view_pin(ws_client_session_t *client) {
+    ws_cpu_session_t *view = __atomic_load_n(&client->session.view, __ATOMIC_ACQUIRE);
+    
+    if (view == &client->session) {
+        return view;
+    }
+    pthread_mutex_lock(&server_ctx.mutex);
+    view = client->session.view;    // 그사이 세션 주인이 닫혀 자기 세션으로 돌아왔을 수 있음
+    if (view != &client->session) {
+        view->pins++;
+    }
+    pthread_mutex_unlock(&server_ctx.mutex);
+    return view;
+}
+
+static void view_unpin(ws_client_session_t *client, ws_cpu_session_t *view) {
+    if (view == &client->session) {
+        return;
+    }
+    pthread_mutex_lock(&server_ctx.mutex);
+    if (--view->pins == 0) {
+        pthread_cond_broadcast(&server_ctx.unpinned);
+    }
+    pthread_mutex_unlock(&server_ctx.mutex);
+}
+
+/*
+ * @brief 새로운 클라이언트를 추가합니다
+ * @param wsi WebSocket 인스턴스
+ * @param binary 1이면 바이너리 서브프로토콜
+ * @param client 연결의 per-session user data
+ * @returns 성공 시 0, 연결 상한에 닿았거나 메모리가 부족하면 -1
+ *
+ * @details
+ * 클라이언트 정보는 lws가 연결마다 할당한 user 영역에 있으므로 콜백에서 바로 찾고,
+ * 핸들 테이블은 세션 ID(관전 대상 지정)와 전체 순회에만 씁니다.
+ */
+static int add_client(struct lws *wsi, int binary, ws_client_session_t *client) {
+    if (session_open(&client->session) != 0) {
+        return -1;
+    }
+    
+    pthread_mutex_lock(&server_ctx.mutex);
+    Handle session_id = handle_alloc(&server_ctx.clients, client);
+    if (session_id == HANDLE_INVALID) {
+        pthread_mutex_unlock(&server_ctx.mutex);
+        session_close(&client->session);
+        printf("❌ 연결 거부: 동시 연결 상한(%u)\n", (unsigned)WS_MAX_CONNECTIONS);
+        return -1;
+    }
+    client->wsi = wsi;
+    client->session_id = session_id;
+    client->is_connected = 1;
+    client->binary = binary;
+    client->tsi = lws_get_tsi(wsi);
+    send_queue_init(&client->queue);
+    viewer_attach(&client->session, client);
+    pthread_mutex_unlock(&server_ctx.mutex);
+    
+    // 클라이언트 IP 주소 얻기
+    char client_name[128], client_ip[128];
+    lws_get_peer_addresses(wsi, lws_get_socket_fd(wsi), client_name, sizeof(client_name), client_ip, sizeof(client_ip));
+    strncpy(client->ip_addr, client_ip, sizeof(client->ip_addr) - 1);
+    
+    printf("클라이언트 연결됨: %s (세션 ID: %u, %s, 연결 %u개)\n", client_ip, session_id,
+           binary ? "바이너리" : "JSON", server_ctx.clients.count);
+    return 0;
+}
+
+/*
+ * @brief 수신 조각을 연결의 버퍼에 모아 메시지가 끝났는지 알려 줍니다
+ * @param client 연결의 per-session user data
+ * @param wsi WebSocket 인스턴스
+ * @param in 이번 조각
+ * @param len 조각 길이
+ * @param message 완성된 메시지 (뒤에 '\0', 다음 RECEIVE 콜백 전까지 유효)
+ * @param length 완성된 메시지 길이
+ * @returns 메시지가 완성되면 1, 조각을 더 기다리면 0, WS_MAX_MESSAGE_BYTES를 넘었으면 -1
+ *
+ * @details
+ * lws는 rx_buffer_size(MAX_PAYLOAD_SIZE)보다 큰 메시지를 여러 번의 RECEIVE로 나눠 주므로,
+ * lws_is_final_fragment()이고 lws_remaining_packet_payload()가 0일 때까지 모읍니다.
+ * 상한을 넘은 메시지는 마지막 조각까지 버린 뒤 한 번만 -1을 돌려줍니다.
+ */
+static int receive_fragment(ws_client_session_t *client, struct lws *wsi, const void *in, size_t len,
+                            char **message, size_t *length) {
+    int final = lws_is_final_fragment(wsi) && lws_remaining_packet_payload(wsi) == 0;
+    
+    if (client->rx_length == 0 && client->rx_capacity > MAX_PAYLOAD_SIZE) {
+        // 지난 큰 메시지의 버퍼는 새 메시지를 시작할 때 놓음
+        free(client->rx_buffer);
+        client->rx_buffer = NULL;
+        client->rx_capacity = 0;
+    }
+    if (!client->rx_overflow) {
+        if (len > WS_MAX_MESSAGE_BYTES - client->rx_length) {
+            client->rx_overflow = 1;
+        } else if (client->rx_length + len + 1 > client->rx_capacity) {
+            size_t capacity = client->rx_capacity ? client->rx_capacity : MAX_PAYLOAD_SIZE;
+            char *buffer;
+            
+            while (capacity < client->rx_length + len + 1) {
+                capacity *= 2;
+            }
+            buffer = realloc(client->rx_buffer, capacity);
+            if (!buffer) {
+                client->rx_overflow = 1;
+            } else {
+                client->rx_buffer = buffer;
+                client->rx_capacity = capacity;
+            }
+        }
+        if (!client->rx_overflow) {
+            memcpy(client->rx_buffer + client->rx_length, in, len);
+            client->rx_length += len;
+        }
+    }
+    if (!final) {
+        return 0;
+    }
+    
+    *length = client->rx_length;
+    client->rx_length = 0;
+    if (client->rx_overflow) {
+        client->rx_overflow = 0;
+        return -1;
+    }
+    client->rx_buffer[*length] = '\0';
+    *message = client->rx_buffer;
+    return 1;
+}
+
+/*
+ * @brief 클라이언트를 제거합니다
+ * @param client 연결의 per-session user data
+ * @returns 없음 (void)
+ *
+ * @details
+ * 이 연결의 세션을 관전하던 연결은 자기 세션으로 되돌리고 키프레임을 보냅니다 (관전자 수에 비례).
+ */
+static void remove_client(ws_client_session_t *client) {
+    ws_client_session_t *detached = NULL;
+    
+    if (!client->is_connected) {
+        return;
+    }
+    
+    pthread_mutex_lock(&server_ctx.mutex);
+    printf("클라이언트 연결 해제: %s (세션 ID: %u)\n", client->ip_addr, client->session_id);
+    
+    viewer_detach(client);
+    if (client->wake_pending) {
+        ws_client_session_t **link = &server_ctx.wake[client->tsi];
+        while (*link != client) {
+            link = &(*link)->next_wake;
+        }
+        *link = client->next_wake;
+    }
+    while (client->session.viewers) {
+        ws_client_session_t *spectator = client->session.viewers;
+        viewer_detach(spectator);
+        viewer_attach(&spectator->session, spectator);
+        spectator->session.pins++;            // 다른 스레드의 연결이면 키프레임을 보낼 때까지 닫히지 않게
+        spectator->next_viewer = detached;    // 자기 세션 목록에 혼자이므로 임시 목록으로 재사용
+        detached = spectator;
+    }
+    
+    // 보내지 못한 프레임의 참조를 놓고 세션 ID를 해제 (같은 슬롯을 다시 써도 세대가 달라짐)
+    send_queue_clear(&client->queue);
+    handle_release(&server_ctx.clients, client->session_id);
+    client->is_connected = 0;
+    // lws가 user 영역을 해제하기 전에, 이 세션을 쓰던 다른 스레드의 관전자 요청이 끝나기를 기다림
+    while (client->session.pins > 0) {
+        pthread_cond_wait(&server_ctx.unpinned, &server_ctx.mutex);
+    }
+    pthread_mutex_unlock(&server_ctx.mutex);
+    session_close(&client->session);
+    free(client->rx_buffer);
+    client->rx_buffer = NULL;
+    client->rx_length = client->rx_capacity = 0;
+    
+    while (detached) {
+        ws_client_session_t *next = detached->next_viewer;
+        detached->next_viewer = NULL;
+        send_catch_up_keyframe(detached, &detached->session);
+        pthread_mutex_lock(&server_ctx.mutex);
+        if (--detached->session.pins == 0) {
+            pthread_cond_broadcast(&server_ctx.unpinned);
+        }
+        pthread_mutex_unlock(&server_ctx.mutex);
+        detached = next;
+    }
+}
+
+/*
+ * @brief 클라이언트의 쓰기 가능 콜백을 요청합니다 (server_ctx.mutex를 잡은 상태에서 호출)
+ * @param client 받을 클라이언트
+ * @returns 없음 (void)
+ *
+ * @details
+ * lws_callback_on_writable은 연결을 서비스하는 스레드에서만 부를 수 있습니다.
+ * 다른 스레드(관전 대상 세션의 스레드)에서 넣은 프레임은 연결을 그 스레드의 wake 목록에 올리고
+ * lws_cancel_service_pt로 깨워, LWS_CALLBACK_EVENT_WAIT_CANCELLED에서 대신 요청하게 합니다.
+ */
+static void request_writable(ws_client_session_t *client) {
+    if (client->tsi == service_tsi) {
+        lws_callback_on_writable(client->wsi);
+        return;
+    }
+    if (!client->wake_pending) {
+        client->wake_pending = 1;
+        client->next_wake = server_ctx.wake[client->tsi];
+        server_ctx.wake[client->tsi] = client;
+        lws_cancel_service_pt(client->wsi);
+    }
+}
+
+/*
+ * @brief 다른 스레드가 깨운 이 스레드의 연결에 쓰기 가능 콜백을 요청합니다
+ * @param 없음
+ * @returns 없음 (void)
+ */
+static void wake_thread_clients(void) {
+    if (service_tsi < 0) {
+        return;
+    }
+    pthread_mutex_lock(&server_ctx.mutex);
+    ws_client_session_t *client = server_ctx.wake[service_tsi];
+    server_ctx.wake[service_tsi] = NULL;
+    while (client) {
+        ws_client_session_t *next = client->next_wake;
+        client->next_wake = NULL;
+        client->wake_pending = 0;
+        lws_callback_on_writable(client->wsi);
+        client = next;
+    }
+    pthread_mutex_unlock(&server_ctx.mutex);
+}
+
+/*
+ * @brief 프레임을 받을 클라이언트의 대기열에 넣고 쓰기 가능 콜백을 요청합니다
+ * @param frame 프레임 (호출자의 참조는 여기서 놓음)
+ * @param target 받을 클라이언트 (NULL이면 현재 세션을 보는 같은 형식의 클라이언트 모두)
+ * @returns 없음 (void)
+ *
+ * @details
+ * 받을 연결은 세션의 구독자 목록만 따라가므로 전체 연결 수와 상관없이 구독자 수에 비례합니다.
+ * 락은 대기열에 포인터를 넣는 동안만 잡고, 소켓 I/O는 flush_client에서 락 없이 합니다.
+ * 느린 클라이언트는 상태 프레임을 합치므로(include/send_queue.h) 대기열과 지연이 한없이 늘지 않고,
+ * 합친 뒤에도 쓰기 가능 콜백을 요청해 대기열이 비는 순간 최신 상태를 보낼 수 있게 합니다.
+ */
+static void enqueue_frame(OutFrame *frame, ws_client_session_t *target) {
+    pthread_mutex_lock(&server_ctx.mutex);
+    ws_client_session_t *client = target ? target : (current_session ? current_session->viewers : NULL);
+    for (; client; client = target ? NULL : client->next_viewer) {
+        if (!client->is_connected || client->binary != frame->binary) {
+            continue;
+        }
+        int was_coalescing = client->queue.coalescing;
+        switch (send_queue_push(&client->queue, frame)) {
+            case SEND_QUEUED:
+                request_writable(client);
+                break;
+            case SEND_COALESCED:
+                if (!was_coalescing) {
+                    printf("느린 클라이언트: %s (세션 ID: %u), 따라잡을 때까지 상태를 합칩니다\n",
+                           client->ip_addr, client->session_id);
+                }
+                request_writable(client);
+                break;
+            case SEND_DROPPED:
+                printf("❌ 전송 대기열 가득 참: %s (세션 ID: %u, 버린 프레임 %llu개)\n", client->ip_addr,
+                       client->session_id, (unsigned long long)client->queue.dropped);
+                break;
+        }
+    }
+    pthread_mutex_unlock(&server_ctx.mutex);
+    out_frame_release(frame);
+}
+
+/*
+ * @brief JSON 클라이언트에게 메시지를 전송합니다
+ * @param message 전송할 메시지
+ * @param target 받을 클라이언트 (조회 응답), NULL이면 현재 세션을 보는 JSON 클라이언트 모두
+ * @returns 없음 (void)
+ *
+ * @details
+ * json-c로 만드는 드문 메시지(프로파일, 서버 캐시, 프로그램 패치)용입니다. json-c가 가진 문자열이라
+ * 풀 프레임으로 한 번 복사합니다. 모두 이벤트로 보냅니다.
+ */
+static void send_message(const char* message, ws_client_session_t *target) {
+    size_t length = strlen(message);
+    OutFrame *frame = out_frame_create(message, length, LWS_PRE, 0);
+    
+    if (!frame) {
+        printf("❌ 전송 프레임 할당 실패 (%zu바이트)\n", length);
+        return;
+    }
+    enqueue_frame(frame, target);
+}
+
+/*
+ * @brief wire 인코더가 바로 쓸 바이너리 프레임(본문 MAX_PAYLOAD_SIZE바이트)을 풀에서 꺼냅니다
+ * @returns 프레임 (본문은 out_frame_payload), 메모리 부족이면 NULL
+ */
+static OutFrame* begin_frame(void) {
+    OutFrame *frame = out_frame_alloc(MAX_PAYLOAD_SIZE, LWS_PRE, 1);
+    
+    if (!frame) {
+        printf("❌ 전송 프레임 할당 실패 (%u바이트)\n", (unsigned)MAX_PAYLOAD_SIZE);
+    }
+    return frame;
+}
+
+/*
+ * @brief begin_frame으로 꺼내 인코딩한 프레임을 대기열에 넣습니다
+ * @param frame 프레임 (NULL이면 무시, 호출자의 참조는 여기서 놓음)
+ * @param length 인코딩한 길이 (0이면 보내지 않음)
+ * @param state 1이면 상태 프레임 (느린 클라이언트에서는 합침), 0이면 이벤트
+ * @param target 받을 클라이언트 (NULL이면 현재 세션을 보는 바이너리 클라이언트 모두)
+ * @returns 없음 (void)
+ */
+static void send_frame(OutFrame *frame, size_t length, int state, ws_client_session_t *target) {
+    if (!frame) {
+        return;
+    }
+    if (length == 0) {
+        out_frame_release(frame);
+        return;
+    }
+    frame->length = length;
+    frame->state = state;
+    enqueue_frame(frame, target);
+}
+
+static void broadcast_frame(OutFrame *frame, size_t length, int state) {
+    send_frame(frame, length, state, NULL);
+}
+
+/*
+ * @brief 쓰기 가능해진 클라이언트에 대기 중인 프레임 하나를 보냅니다
+ * @param client 연결의 per-session user data
+ * @returns 계속하면 0, 전송에 실패해 연결을 닫아야 하면 -1
+ *
+ * @details
+ * libwebsockets는 쓰기 가능 콜백 한 번에 lws_write 한 번을 권장하므로,
+ * 더 남아 있으면 다시 lws_callback_on_writable을 요청합니다.
+ * 프레임은 대기열에서 꺼낸 뒤 락을 풀고 보내므로 느린 소켓이 다른 클라이언트를 막지 않습니다.
+ * 상태를 합치던 클라이언트의 대기열이 충분히 비면 건너뛴 상태 대신 최신 키프레임 하나를 넣습니다.
+ */
+static int flush_client(ws_client_session_t *client) {
+    struct lws *wsi = client->wsi;
+    
+    pthread_mutex_lock(&server_ctx.mutex);
+    OutFrame *frame = send_queue_pop(&client->queue);
+    int resume = send_queue_resume(&client->queue);
+    int more = client->queue.count > 0;
+    pthread_mutex_unlock(&server_ctx.mutex);
+    
+    if (resume) {
+        ws_cpu_session_t *view = view_pin(client);
+        send_catch_up_keyframe(client, view);
+        view_unpin(client, view);
+    }
+    if (!frame) {
+        return 0;
+    }
+    int written = lws_write(wsi, out_frame_payload(frame), frame->length,
+                            frame->binary ? LWS_WRITE_BINARY : LWS_WRITE_TEXT);
+    int complete = written >= (int)frame->length;
+    out_frame_release(frame);
+    if (!complete) {
+        printf("❌ 프레임 전송 실패 (%d바이트)\n", written);
+        return -1;
+    }
+    if (more) {
+        lws_callback_on_writable(wsi);
+    }
+    return 0;
+}
+
+/*
+ * @brief 받을 클라이언트 중 해당 형식이 있는지 확인합니다 (없으면 그 형식으로 만들지 않음)
+ * @param binary 1이면 바이너리, 0이면 JSON
+ * @param target 받을 클라이언트 (NULL이면 현재 세션을 보는 클라이언트 모두)
+ */
+static int has_clients(int binary, ws_client_session_t *target) {
+    if (target) {
+        return target->binary == binary;
+    }
+    pthread_mutex_lock(&server_ctx.mutex);
+    int found = current_session && current_session->viewer_count[binary] > 0;
+    pthread_mutex_unlock(&server_ctx.mutex);
+    return found;
+}
+
+/*
+ * @brief 어셈블리 코드를 바이트로 변환합니다
+ * @param assembly 어셈블리 코드 문자열
+ * @param output_bytes 출력 바이트 배열
+ * @param max_length 최대 출력 길이
+ * @returns 생성된 바이트 수, 실패 시 0
+ *
+ * @details
+ * 한 줄짜리 소스로 어셈블러(include/assembler.h)를 호출합니다.
+ * 같은 텍스트는 서버 전체 프로그램 캐시에서 바로 가져옵니다.
+ */
+int decode_assembly_to_bytes(const char* assembly, uint8_t* output_bytes, int max_length) {
+    if (!assembly || !output_bytes || max_length < 2) {
+        return 0;
+    }
+    
+    size_t length = strlen(assembly);
+    size_t cached_size;
+    pthread_mutex_lock(&server_ctx.cache_mutex);
+    const uint8_t *cached = lru_get(&server_ctx.program_cache, assembly, length, &cached_size);
+    int hit = cached && cached_size <= (size_t)max_length;
+    if (hit) {
+        memcpy(output_bytes, cached, cached_size);
+    }
+    pthread_mutex_unlock(&server_ctx.cache_mutex);
+    if (hit) {
+        return (int)cached_size;
+    }
+    
+    AsmResult result;
+    if (asm_assemble(assembly, length, output_bytes, (size_t)max_length, &result) != 0) {
+        asm_print_errors(&result);
+        return 0;
+    }
+    if (result.size == 0) {
+        printf("❌ 파싱 실패: %s\n", assembly);
+        return 0;
+    }
+    pthread_mutex_lock(&server_ctx.cache_mutex);
+    lru_put(&server_ctx.program_cache, assembly, length, output_bytes, result.size);
+    pthread_mutex_unlock(&server_ctx.cache_mutex);
+    
+    printf("파싱 성공: %s -> 바이트: 0x%02X 0x%02X\n", assembly, output_bytes[0], output_bytes[1]);
+    return (int)result.size;
+}
+
+/*
+ * @brief 바이트를 어셈블리 코드로 변환합니다
+ * @param bytes 입력 바이트 배열
+ * @param byte_count 바이트 개수
+ * @param output_assembly 출력 어셈블리 문자열
+ * @param max_length 최대 출력 길이
+ * @returns 변환 성공 시 1, 실패 시 0
+ */
+int decode_bytes_to_assembly(const uint8_t* bytes, int byte_count, char* output_assembly, int max_length) {
+    if (!bytes || byte_count < 2 || !output_assembly || max_length < 32) {
+        return 0;
+    }
+    
+    return isa_disassemble((uint16_t)((bytes[0] << 8) | bytes[1]), output_assembly, max_length);
+}
+
+/*
+ * @brief 이 스레드의 JSON 전송 프레임 본문에 바로 쓰도록 출력기를 초기화합니다
+ * @param writer JSON 출력기
+ * @returns 없음 (void)
+ *
+ * @details
+ * 프레임을 꺼내지 못하면 용량 0으로 초기화하므로 출력은 넘침으로 끝나고 보내지 않습니다.
+ */
+static void begin_json(JsonWriter *writer) {
+    if (!json_frame) {
+        json_frame = out_frame_alloc(WS_JSON_CAPACITY, LWS_PRE, 0);
+    }
+    if (json_frame) {
+        jw_init(writer, (char *)out_frame_payload(json_frame), WS_JSON_CAPACITY);
+    } else {
+        jw_init(writer, NULL, 0);
+    }
+}
+
+/*
+ * @brief begin_json으로 쓴 메시지의 프레임을 복사 없이 대기열에 넣습니다
+ * @param writer 메시지를 다 쓴 출력기
+ * @param state 1이면 상태 메시지 (느린 클라이언트에서는 합침), 0이면 이벤트
+ * @param target 받을 클라이언트 (NULL이면 현재 세션을 보는 JSON 클라이언트 모두)
+ * @returns 없음 (void)
+ */
+static void send_json(const JsonWriter *writer, int state, ws_client_session_t *target) {
+    size_t length = jw_finish(writer);
+    
+    if (length == 0) {
+        if (json_frame) {
+            printf("❌ JSON 메시지가 출력 버퍼(%u바이트)를 넘습니다\n", (unsigned)WS_JSON_CAPACITY);
+        } else {
+            printf("❌ 전송 프레임 할당 실패 (%u바이트)\n", (unsigned)WS_JSON_CAPACITY);
+        }
+        return;
+    }
+    OutFrame *frame = json_frame;
+    json_frame = NULL;
+    frame->length = length;
+    frame->state = state;
+    enqueue_frame(frame, target);
+}
+
+static void broadcast_json(const JsonWriter *writer, int state) {
+    send_json(writer, state, NULL);
+}
+
+/*
+ * @brief 플래그 객체 {"cf", "zf", "sf", "of"}를 씁니다
+ */
+static void write_flags(JsonWriter *writer, uint8_t flag_bits) {
+    jw_begin_object(writer);
+    jw_key(writer, "cf");
+    jw_bool(writer, (flag_bits & FLAG_CF) != 0);
+    jw_key(writer, "zf");
+    jw_bool(writer, (flag_bits & FLAG_ZF) != 0);
+    jw_key(writer, "sf");
+    jw_bool(writer, (flag_bits & FLAG_SF) != 0);
+    jw_key(writer, "of");
+    jw_bool(writer, (flag_bits & FLAG_OF) != 0);
+    jw_end_object(writer);
+}
+
+/*
+ * @brief CPU 상태 JSON 메시지를 씁니다
+ * @param writer JSON 출력기
+ * @returns 없음 (void)
+ */
+void write_state_message(JsonWriter *writer) {
+    CPU_Registers *regs = get_cpu_registers();
+    CPU_Stats *stats = get_cpu_stats();
+    uint8_t flag_bits = get_flags(regs);  // 지연 평가된 플래그를 여기서 한 번만 계산
+    
+    jw_begin_object(writer);
+    jw_key(writer, "type");
+    jw_string(writer, "state");
+    jw_key(writer, "payload");
+    jw_begin_object(writer);
+    jw_key(writer, "pc");
+    jw_int(writer, regs->pc);
+    jw_key(writer, "register1");
+    jw_int(writer, regs->register1);
+    jw_key(writer, "register2");
+    jw_int(writer, regs->register2);
+    jw_key(writer, "register3");
+    jw_int(writer, regs->register3);
+    jw_key(writer, "register4");
+    jw_int(writer, regs->register4);
+    jw_key(writer, "register5");
+    jw_int(writer, regs->register5);
+    jw_key(writer, "register6");
+    jw_int(writer, regs->register6);
+    jw_key(writer, "register7");
+    jw_int(writer, regs->register7);
+    jw_key(writer, "overflow_flag");
+    jw_bool(writer, (flag_bits & FLAG_OF) != 0);
+    jw_key(writer, "flags");
+    write_flags(writer, flag_bits);
+    
+    // 벡터 레지스터: [[V0 레인 8개], [V1 ...], ...]
+    jw_key(writer, "vregs");
+    jw_begin_array(writer);
+    for (int v = 0; v < VREG_COUNT; v++) {
+        jw_byte_array(writer, regs->vreg[v], VREG_LANES);
+    }
+    jw_end_array(writer);
+    
+    jw_key(writer, "mode");
+    jw_string(writer, cpu_get_mode() == CPU_MODE_FUNCTIONAL ? "functional" : "detailed");
+    jw_key(writer, "instructions");
+    jw_uint64(writer, stats->instructions);
+    jw_key(writer, "cycles");
+    jw_uint64(writer, stats->cycles);
+    jw_end_object(writer);
+    jw_end_object(writer);
+}
+
+/*
+ * @brief 메모리 상태 JSON 메시지를 씁니다
+ * @param writer JSON 출력기
+ * @returns 없음 (void)
+ */
+void write_memory_message(JsonWriter *writer) {
+    Memory *memory = get_cpu_memory();
+    uint8_t data[64];
+    
+    for (int i = 0; i < MEMORY_SIZE && i < 64; i++) { // 처음 64바이트만 전송
+        // write-back 캐시의 dirty 값까지 반영해 보여줌 (캐시 통계에는 영향 없음)
+        data[i] = memory_peek(memory, i);
+    }
+    
+    jw_begin_object(writer);
+    jw_key(writer, "type");
+    jw_string(writer, "memory");
+    jw_key(writer, "payload");
+    jw_begin_object(writer);
+    jw_key(writer, "data");
+    jw_byte_array(writer, data, sizeof(data));
+    jw_end_object(writer);
+    jw_end_object(writer);
+}
+
+/*
+ * @brief 캐시 라인 하나를 JSON 객체로 씁니다
+ */
+static void write_cache_line(JsonWriter *writer, int index, const CacheLine *line) {
+    jw_begin_object(writer);
+    jw_key(writer, "index");
+    jw_int(writer, index);
+    jw_key(writer, "tag");
+    jw_int(writer, line->tag);
+    jw_key(writer, "valid");
+    jw_bool(writer, line->valid);
+    jw_key(writer, "dirty");
+    jw_bool(writer, line->dirty);
+    jw_key(writer, "data");
+    jw_byte_array(writer, line->block, CACHE_LINE_SIZE);
+    jw_end_object(writer);
+}
+
+/*
+ * @brief 캐시 통계를 JSON 객체로 씁니다
+ */
+static void write_cache_stats(JsonWriter *writer, const CacheStats *stats) {
+    jw_begin_object(writer);
+    jw_key(writer, "hits");
+    jw_uint64(writer, stats->hits);
+    jw_key(writer, "misses");
+    jw_uint64(writer, stats->misses);
+    jw_key(writer, "writebacks");
+    jw_uint64(writer, stats->writebacks);
+    jw_end_object(writer);
+}
+
+/*
+ * @brief 캐시 상태 JSON 메시지를 씁니다
+ * @param writer JSON 출력기
+ * @returns 없음 (void)
+ */
+void write_cache_message(JsonWriter *writer) {
+    Cache *cache = &get_cpu_memory()->cache;
+    
+    jw_begin_object(writer);
+    jw_key(writer, "type");
+    jw_string(writer, "cache");
+    jw_key(writer, "payload");
+    jw_begin_object(writer);
+    
+    // 처음 16개 캐시 라인만 전송 (화면에 보여줄 수 있는 적당한 양)
+    jw_key(writer, "lines");
+    jw_begin_array(writer);
+    for (int i = 0; i < 16 && i < 64; i++) {
+        write_cache_line(writer, i, &cache->lines[i]);
+    }
+    jw_end_array(writer);
+    jw_key(writer, "stats");
+    write_cache_stats(writer, &cache->stats);
+    
+    jw_end_object(writer);
+    jw_end_object(writer);
+}
+
+/*
+ * @brief 단계 하나의 상태 변화 JSON 메시지를 씁니다
+ * @param writer JSON 출력기
+ * @param delta 바뀐 항목 (state_tracker_next 결과)
+ * @param now 현재 상태 (StateTracker.current)
+ * @param step 실행 단계 설명 (NULL이면 생략)
+ * @param bytes 실행한 명령어 바이트
+ * @param byte_count 바이트 개수
+ * @param warning 경고 (오버플로우 등, NULL이면 생략)
+ * @returns 없음 (void)
+ *
+ * @details
+ * state/memory/cache/execution/ack 다섯 메시지를 하나로 합치고, 바뀐 항목만 담습니다.
+ *   seq, keyframe, pc, instructions, cycles: 항상
+ *   registers {"registerN": 값}, flags, vregs {"N": [레인]}, mode, cache_stats: 바뀐 것만
+ *   memory [{"address", "data": [...]}]: 바뀐 연속 구간, cache_lines: 바뀐 라인 (캐시 메시지의 라인 형식)
+ * keyframe이 true면 모든 항목이 들어 있으므로 클라이언트는 상태를 통째로 바꿉니다.
+ */
+void write_delta_message(JsonWriter *writer, const StateDelta *delta, const StateSnapshot *now, const char *step,
+                         const uint8_t *bytes, int byte_count, const char *warning) {
+    jw_begin_object(writer);
+    jw_key(writer, "type");
+    jw_string(writer, "delta");
+    jw_key(writer, "payload");
+    jw_begin_object(writer);
+    
+    jw_key(writer, "seq");
+    jw_uint64(writer, delta->sequence);
+    jw_key(writer, "keyframe");
+    jw_bool(writer, delta->keyframe);
+    jw_key(writer, "pc");
+    jw_int(writer, now->pc);
+    jw_key(writer, "instructions");
+    jw_uint64(writer, now->instructions);
+    jw_key(writer, "cycles");
+    jw_uint64(writer, now->cycles);
+    
+    if (delta->register_mask) {
+        static const char *names[8] = { NULL, "register1", "register2", "register3", "register4",
+                                        "register5", "register6", "register7" };
+        jw_key(writer, "registers");
+        jw_begin_object(writer);
+        for (int r = 1; r <= 7; r++) {
+            if (delta->register_mask & (1U << r)) {
+                jw_key(writer, names[r]);
+                jw_int(writer, now->registers[r]);
+            }
+        }
+        jw_end_object(writer);
+    }
+    if (delta->flags_changed) {
+        jw_key(writer, "flags");
+        write_flags(writer, now->flags);
+    }
+    if (delta->vreg_mask) {
+        static const char *names[VREG_COUNT] = { "0", "1", "2", "3" };
+        jw_key(writer, "vregs");
+        jw_begin_object(writer);
+        for (int v = 0; v < VREG_COUNT; v++) {
+            if (delta->vreg_mask & (1U << v)) {
+                jw_key(writer, names[v]);
+                jw_byte_array(writer, now->vreg[v], VREG_LANES);
+            }
+        }
+        jw_end_object(writer);
+    }
+    if (delta->mode_changed) {
+        jw_key(writer, "mode");
+        jw_string(writer, now->mode == CPU_MODE_FUNCTIONAL ? "functional" : "detailed");
+    }
+    
+    if (delta->run_count) {
+        jw_key(writer, "memory");
+        jw_begin_array(writer);
+        for (unsigned i = 0; i < delta->run_count; i++) {
+            jw_begin_object(writer);
+            jw_key(writer, "address");
+            jw_int(writer, delta->runs[i].address);
+            jw_key(writer, "data");
+            jw_byte_array(writer, now->memory + delta->runs[i].address, delta->runs[i].length);
+            jw_end_object(writer);
+        }
+        jw_end_array(writer);
+    }
+    if (delta->line_count) {
+        jw_key(writer, "cache_lines");
+        jw_begin_array(writer);
+        for (unsigned i = 0; i < delta->line_count; i++) {
+            write_cache_line(writer, delta->lines[i], &now->lines[delta->lines[i]]);
+        }
+        jw_end_array(writer);
+    }
+    if (delta->cache_stats_changed) {
+        jw_key(writer, "cache_stats");
+        write_cache_stats(writer, &now->cache_stats);
+    }
+    
+    if (step) {
+        jw_key(writer, "step");
+        jw_string(writer, step);
+        jw_key(writer, "bytes");
+        jw_byte_array(writer, bytes, bytes && byte_count > 0 ? (size_t)byte_count : 0);
+    }
+    if (warning) {
+        jw_key(writer, "warning");
+        jw_string(writer, warning);
+    }
+    
+    jw_end_object(writer);
+    jw_end_object(writer);
+}
+
+/*
+ * @brief 실행 단계 JSON 메시지를 씁니다
+ * @param writer JSON 출력기
+ * @param instruction 실행된 명령어 문자열
+ * @param bytes 명령어 바이트 배열
+ * @param byte_count 바이트 개수
+ * @returns 없음 (void)
+ */
+void write_execution_message(JsonWriter *writer, const char* instruction, const uint8_t* bytes, int byte_count) {
+    jw_begin_object(writer);
+    jw_key(writer, "type");
+    jw_string(writer, "execution");
+    jw_key(writer, "payload");
+    jw_begin_object(writer);
+    jw_key(writer, "instruction");
+    jw_string(writer, instruction);
+    jw_key(writer, "bytes");
+    jw_byte_array(writer, bytes, bytes && byte_count > 0 ? (size_t)byte_count : 0);
+    jw_end_object(writer);
+    jw_end_object(writer);
+}
+
+/*
+ * @brief 문자열 하나를 payload로 갖는 JSON 메시지(ack, error)를 씁니다
+ * @param writer JSON 출력기
+ * @param type 메시지 종류
+ * @param text 메시지 문자열
+ * @returns 없음 (void)
+ */
+void write_text_message(JsonWriter *writer, const char* type, const char* text) {
+    jw_begin_object(writer);
+    jw_key(writer, "type");
+    jw_string(writer, type);
+    jw_key(writer, "payload");
+    jw_string(writer, text);
+    jw_end_object(writer);
+}
+
+// 메시지 전송 함수들
+/*
+ * @brief CPU 상태를 전송합니다
+ * @param target 받을 클라이언트 (조회 응답), NULL이면 현재 세션을 보는 클라이언트 모두 (상태 변화)
+ * @returns 없음 (void)
+ */
+static void send_cpu_state(ws_client_session_t *target) {
+    if (has_clients(0, target)) {
+        JsonWriter writer;
+        begin_json(&writer);
+        write_state_message(&writer);
+        send_json(&writer, 1, target);
+    }
+    if (has_clients(1, target)) {
+        OutFrame *frame = begin_frame();
+        StateSnapshot state;
+        if (frame) {
+            state_snapshot_capture(&state, cpu_get_context());
+            send_frame(frame, wire_encode_state(out_frame_payload(frame), MAX_PAYLOAD_SIZE, &state), 1, target);
+        }
+    }
+}
+
+/*
+ * @brief 메모리 상태를 전송합니다
+ * @param target 받을 클라이언트 (조회 응답), NULL이면 현재 세션을 보는 클라이언트 모두 (상태 변화)
+ * @returns 없음 (void)
+ *
+ * @details
+ * 바이너리 클라이언트에는 JSON의 앞 64바이트 대신 전체 메모리를 보냅니다 (260바이트 프레임).
+ */
+static void send_memory_state(ws_client_session_t *target) {
+    if (has_clients(0, target)) {
+        JsonWriter writer;
+        begin_json(&writer);
+        write_memory_message(&writer);
+        send_json(&writer, 1, target);
+    }
+    if (has_clients(1, target)) {
+        OutFrame *frame = begin_frame();
+        uint8_t data[MEMORY_SIZE];
+        Memory *memory = get_cpu_memory();
+        for (int i = 0; i < MEMORY_SIZE; i++) {
+            data[i] = memory_peek(memory, i);
+        }
+        if (frame) {
+            send_frame(frame, wire_encode_memory(out_frame_payload(frame), MAX_PAYLOAD_SIZE, data, 0, MEMORY_SIZE),
+                       1, target);
+        }
+    }
+}
+
+/*
+ * @brief 캐시 상태를 전송합니다
+ * @param target 받을 클라이언트 (조회 응답), NULL이면 현재 세션을 보는 클라이언트 모두 (상태 변화)
+ * @returns 없음 (void)
+ */
+static void send_cache_state(ws_client_session_t *target) {
+    if (has_clients(0, target)) {
+        JsonWriter writer;
+        begin_json(&writer);
+        write_cache_message(&writer);
+        send_json(&writer, 1, target);
+    }
+    if (has_clients(1, target)) {
+        OutFrame *frame = begin_frame();
+        Cache *cache = &get_cpu_memory()->cache;
+        if (frame) {
+            send_frame(frame, wire_encode_cache(out_frame_payload(frame), MAX_PAYLOAD_SIZE, cache->lines,
+                                                &cache->stats, 0, CACHE_NUM_LINES), 1, target);
+        }
+    }
+}
+
+/*
+ * @brief CPU 상태를 현재 세션을 보는 모든 클라이언트에 전송합니다
+ * @param 없음
+ * @returns 없음 (void)
+ */
+void ws_send_cpu_state(void) {
+    send_cpu_state(NULL);
+}
+
+/*
+ * @brief 메모리 상태를 현재 세션을 보는 모든 클라이언트에 전송합니다
+ * @param 없음
+ * @returns 없음 (void)
+ */
+void ws_send_memory_state(void) {
+    send_memory_state(NULL);
+}
+
+/*
+ * @brief 캐시 상태를 현재 세션을 보는 모든 클라이언트에 전송합니다
+ * @param 없음
+ * @returns 없음 (void)
+ */
+void ws_send_cache_state(void) {
+    send_cache_state(NULL);
+}
+
+/*
+ * @brief 실행 단계 정보를 모든 클라이언트에 전송합니다
+ * @param instruction 실행된 명령어 문자열
+ * @param bytes 명령어 바이트 배열
+ * @param byte_count 바이트 개수
+ * @returns 없음 (void)
+ */
+void ws_send_execution_step(const char* instruction, const uint8_t* bytes, int byte_count) {
+    if (has_clients(0, NULL)) {
+        JsonWriter writer;
+        begin_json(&writer);
+        write_execution_message(&writer, instruction, bytes, byte_count);
+        broadcast_json(&writer, 1);
+    }
+    if (has_clients(1, NULL)) {
+        OutFrame *frame = begin_frame();
+        if (frame) {
+            broadcast_frame(frame, wire_encode_step(out_frame_payload(frame), MAX_PAYLOAD_SIZE, instruction,
+                                                    bytes, byte_count), 1);
+        }
+    }
+}
+
+/*
+ * @brief 요청한 클라이언트 하나에만 문자열 메시지(ack, error)를 보냅니다
+ */
+static void send_text_to(ws_client_session_t *client, const char *json_type, WireType wire_type, const char *text) {
+    if (client->binary) {
+        OutFrame *frame = begin_frame();
+        if (frame) {
+            send_frame(frame, wire_encode_text(out_frame_payload(frame), MAX_PAYLOAD_SIZE, wire_type, text), 0, client);
+        }
+    } else {
+        JsonWriter writer;
+        begin_json(&writer);
+        write_text_message(&writer, json_type, text);
+        send_json(&writer, 0, client);
+    }
+}
+
+/*
+ * @brief 문자열 메시지를 요청한 클라이언트에게, 요청 밖이면 두 형식의 클라이언트 모두에 전송합니다
+ */
+static void send_text(const char *json_type, WireType wire_type, const char *text) {
+    if (current_requester) {
+        send_text_to(current_requester, json_type, wire_type, text);
+        return;
+    }
+    if (has_clients(0, NULL)) {
+        JsonWriter writer;
+        begin_json(&writer);
+        write_text_message(&writer, json_type, text);
+        broadcast_json(&writer, 0);
+    }
+    if (has_clients(1, NULL)) {
+        OutFrame *frame = begin_frame();
+        if (frame) {
+            broadcast_frame(frame, wire_encode_text(out_frame_payload(frame), MAX_PAYLOAD_SIZE, wire_type, text), 0);
+        }
+    }
+}
+
+/*
+ * @brief 확인 메시지를 요청한 클라이언트에 전송합니다
+ * @param message 확인 메시지 문자열
+ * @returns 없음 (void)
+ */
+void ws_send_ack(const char* message) {
+    send_text("ack", WIRE_ACK, message);
+}
+
+/*
+ * @brief 에러 메시지를 요청한 클라이언트에 전송합니다
+ * @param error_msg 에러 메시지 문자열
+ * @returns 없음 (void)
+ */
+void ws_send_error(const char* error_msg) {
+    send_text("error", WIRE_ERROR, error_msg);
+}
+
+/*
+ * @brief 마지막 delta 이후 바뀐 상태를 모든 클라이언트에 한 메시지로 전송합니다
+ * @param step 실행 단계 설명 (NULL이면 생략)
+ * @param bytes 실행한 명령어 바이트
+ * @param byte_count 바이트 개수
+ * @param warning 경고 (NULL이면 생략)
+ * @returns 없음 (void)
+ *
+ * @details
+ * 바이너리 클라이언트에는 DELTA 프레임 뒤에 STEP/WARNING 프레임을 따로 보냅니다.
+ * 두 형식 모두 같은 추적기를 쓰므로 순서 번호가 같습니다.
+ * 프레임마다 풀에서 꺼낸 전송 프레임에 바로 직렬화하고, 그 프레임 하나를 모든 클라이언트가 공유합니다.
+ * delta와 단계는 상태 프레임이라 느린 클라이언트에서는 합쳐지고, 경고는 항상 전달됩니다.
+ */
+void ws_send_state_delta(const char* step, const uint8_t* bytes, int byte_count, const char* warning) {
+    StateDelta delta;
+    const StateSnapshot *now = &current_session->tracker.current;
+    
+    state_tracker_next(&current_session->tracker, cpu_get_context(), &delta);
+    if (has_clients(0, NULL)) {
+        JsonWriter writer;
+        begin_json(&writer);
+        write_delta_message(&writer, &delta, now, step, bytes, byte_count, warning);
+        broadcast_json(&writer, warning == NULL);   // 경고가 담긴 delta는 합치지 않음
+    }
+    if (has_clients(1, NULL)) {
+        // 프레임마다 따로 꺼냄 (앞 프레임은 아직 대기열에서 공유 중)
+        OutFrame *frame = begin_frame();
+        if (frame) {
+            broadcast_frame(frame, wire_encode_delta(out_frame_payload(frame), MAX_PAYLOAD_SIZE, &delta, now), 1);
+        }
+        if (step && (frame = begin_frame()) != NULL) {
+            broadcast_frame(frame, wire_encode_step(out_frame_payload(frame), MAX_PAYLOAD_SIZE, step, bytes,
+                                                    byte_count), 1);
+        }
+        if (warning && (frame = begin_frame()) != NULL) {
+            broadcast_frame(frame, wire_encode_text(out_frame_payload(frame), MAX_PAYLOAD_SIZE, WIRE_WARNING,
+                                                    warning), 0);
+        }
+    }
+}
+
+/*
+ * @brief 클라이언트 하나에 세션의 마지막으로 보낸 상태 전체를 키프레임으로 보냅니다
+ * @param client 받을 클라이언트
+ * @param session 클라이언트가 보는 세션
+ * @returns 없음 (void)
+ *
+ * @details
+ * 상태를 합치던 클라이언트가 따라잡았을 때, 관전을 시작하거나 끝냈을 때 씁니다.
+ * 같은 세션의 다른 클라이언트와 같은 순서 번호를 쓰므로 이후 delta는 이 키프레임 위에 그대로 적용됩니다.
+ * 아직 delta를 보낸 적이 없으면 현재 상태를 캡처해 보냅니다.
+ * 세션 lock을 직접 잡으므로 요청 처리(session_enter) 밖에서 부릅니다.
+ */
+static void send_catch_up_keyframe(ws_client_session_t *client, ws_cpu_session_t *session) {
+    StateDelta delta;
+    const StateSnapshot *now = &session->tracker.current;
+    
+    pthread_mutex_lock(&session->lock);
+    if (session->tracker.sequence == 0) {
+        state_snapshot_capture(&session->tracker.current, &session->cpu);
+    }
+    state_tracker_keyframe(&session->tracker, &delta);
+    if (client->binary) {
+        OutFrame *frame = begin_frame();
+        if (frame) {
+            send_frame(frame, wire_encode_delta(out_frame_payload(frame), MAX_PAYLOAD_SIZE, &delta, now), 1, client);
+        }
+    } else {
+        JsonWriter writer;
+        begin_json(&writer);
+        write_delta_message(&writer, &delta, now, NULL, NULL, 0, NULL);
+        send_json(&writer, 1, client);
+    }
+    pthread_mutex_unlock(&session->lock);
+}
+
+/*
+ * @brief 어셈블리 코드를 처리합니다
+ * @param assembly_code 어셈블리 코드 문자열
+ * @returns 처리 성공 시 0, 실패 시 -1
+ */
+int ws_handle_assembly_code(const char* assembly_code) {
+    uint8_t bytes[256];
+    int byte_count = decode_assembly_to_bytes(assembly_code, bytes, sizeof(bytes));
+    
+    if (byte_count <= 0) {
+        ws_send_error("어셈블리 디코딩 실패");
+        return -1;
+    }
+    
+    // CPU에 프로그램 로드 (진행 중인 run_all은 멈춤)
+    run_job_interrupt();
+    cpu_load_program(bytes, byte_count);
+    
+    // 실행 단계 전송
+    ws_send_execution_step(assembly_code, bytes, byte_count);
+    
+    // CPU 한 단계 실행
+    cpu_step();
+    
+    // 상태 전송
+    ws_send_cpu_state();
+    ws_send_memory_state();
+    ws_send_cache_state();
+    
+    return 0;
+}
+
+/*
+ * @brief 어셈블한 이미지를 CPU에 적재하고 결과를 보냅니다
+ * @param all_bytes 이미지
+ * @param image_size 이미지 크기
+ * @returns 적재 성공 시 0, 빈 이미지면 -1
+ */
+static int program_load_image(const uint8_t *all_bytes, size_t image_size) {
+    int total_byte_count = (int)image_size;
+    
+    if (total_byte_count > 0) {
+        // CPU 초기화 (모든 레지스터와 메모리)
+        cpu_reset();
+        
+        // CPU에 전체 프로그램 로드 (실행하지 않고 메모리에만 로드)
+        cpu_load_program(all_bytes, total_byte_count);
+        
+        // 성공 메시지 전송
+        char success_msg[256];
+        snprintf(success_msg, sizeof(success_msg), "프로그램 로드 완료: %d 바이트 (실행 대기 중)", total_byte_count);
+        ws_send_ack(success_msg);
+        
+        // 실행 단계 전송
+        ws_send_execution_step("프로그램 로드됨 - 단계 실행 준비", all_bytes, total_byte_count);
+        
+        // 상태 전송
+        ws_send_cpu_state();
+        ws_send_memory_state();
+        ws_send_cache_state();
+        
+        printf("프로그램 로드 성공: %d 바이트 (단계 실행 준비)\n", total_byte_count);
+    } else {
+        ws_send_error("프로그램에서 유효한 명령어를 찾을 수 없습니다");
+        return -1;
+    }
+    
+    return 0;
+}
+
+/*
+ * @brief 편집 세션에 적재한 결과를 확인하고 캐시에 넣은 뒤 CPU에 적재합니다
+ * @param program_code 소스 (캐시 키)
+ * @param length 소스 길이
+ * @param edit asm_session_load 결과
+ * @returns 적재 성공 시 0, 어셈블 오류면 -1
+ */
+static int program_load_assembled(const char *program_code, size_t length, const AsmEdit *edit) {
+    size_t image_size;
+    
+    if (edit->error_lines) {
+        AsmError error;
+        char error_msg[256];
+        asm_session_errors(&current_session->editor, &error, 1);
+        printf("❌ %u:%u: %s\n", error.line, error.column, error.message);
+        snprintf(error_msg, sizeof(error_msg), "%u:%u: %s (오류 줄 %u개)", error.line, error.column,
+                 error.message, edit->error_lines);
+        ws_send_error(error_msg);
+        return -1;
+    }
+    const uint8_t *all_bytes = asm_session_image(&current_session->editor, &image_size);
+    pthread_mutex_lock(&server_ctx.cache_mutex);
+    lru_put(&server_ctx.program_cache, program_code, length, all_bytes, image_size);
+    pthread_mutex_unlock(&server_ctx.cache_mutex);
+    return program_load_image(all_bytes, image_size);
+}
+
+/*
+ * @brief 워커에서 어셈블한 편집 세션을 세션에 옮기고 적재합니다 (세션 안에서 호출)
+ * @param job 끝난 load_program 작업
+ * @returns 없음 (void)
+ */
+static void program_load_complete(ws_job_t *job) {
+    char message[128];
+    
+    if (job->item.status != WORK_DONE) {
+        snprintf(message, sizeof(message), "프로그램 어셈블 작업 %u %s", job->id,
+                 job->item.status == WORK_EXPIRED ? "시간 제한 초과" : "취소");
+        if (job->item.status == WORK_EXPIRED) {
+            ws_send_error(message);
+        } else {
+            ws_send_ack(message);
+        }
+        return;
+    }
+    if (job->load_failed) {
+        ws_send_error("프로그램을 적재할 메모리가 부족합니다");
+        return;
+    }
+    asm_session_free(&current_session->editor);
+    current_session->editor = job->editor;
+    job->editor_ready = 0;
+    free(current_session->editor_source);
+    current_session->editor_source = NULL;
+    program_load_assembled(job->source, job->length, &job->edit);
+}
+
+// 프로그램 로드 처리 (여러 줄 어셈블리)
+/*
+ * @brief 프로그램을 로드합니다
+ * @param program_code 프로그램 코드 문자열
+ * @returns 로드 성공(또는 워커에 맡김) 시 0, 실패 시 -1
+ *
+ * @details
+ * WS_ASM_OFFLOAD_BYTES보다 긴 소스는 워커가 새 편집 세션에 어셈블하고, 끝나면 세션 스레드가 옮겨 적재합니다.
+ * 그동안 세션은 이전 프로그램 상태 그대로이며, 상태를 바꾸는 다른 요청이 오면 어셈블 결과는 버려집니다.
+ */
+int ws_handle_program_load(const char* program_code) {
+    if (!program_code) {
+        ws_send_error("프로그램 코드가 없습니다");
+        return -1;
+    }
+    
+    printf("프로그램 로드 요청: %s\n", program_code);
+    run_job_interrupt();
+    
+    // 같은 소스는 캐시된 이미지를 쓰고, 편집 세션 적재는 첫 edit_program까지 미룸
+    // 캐시 항목은 다른 스레드가 밀어낼 수 있으므로 락 안에서 복사
+    size_t length = strlen(program_code);
+    size_t image_size;
+    uint8_t image[MEMORY_SIZE];
+    pthread_mutex_lock(&server_ctx.cache_mutex);
+    const uint8_t *all_bytes = lru_get(&server_ctx.program_cache, program_code, length, &image_size);
+    if (all_bytes && image_size <= sizeof(image)) {
+        memcpy(image, all_bytes, image_size);
+        all_bytes = image;
+    } else {
+        all_bytes = NULL;
+    }
+    pthread_mutex_unlock(&server_ctx.cache_mutex);
+    if (all_bytes) {
+        char *source = malloc(length + 1);
+        if (!source) {
+            ws_send_error("프로그램을 적재할 메모리가 부족합니다");
+            return -1;
+        }
+        memcpy(source, program_code, length + 1);
+        free(current_session->editor_source);
+        current_session->editor_source = source;
+        printf("프로그램 캐시 히트: %zu 바이트\n", image_size);
+        return program_load_image(all_bytes, image_size);
+    }
+    
+    // 큰 소스는 워커에서 어셈블 (실패하면 아래에서 바로)
+    if (length > WS_ASM_OFFLOAD_BYTES && server_ctx.workers.thread_count > 0) {
+        ws_job_t *job = job_new(WS_JOB_LOAD_PROGRAM, job_load_program, WS_JOB_DEADLINE_MS);
+        if (job) {
+            job->source = malloc(length + 1);
+            job->length = length;
+            if (job->source) {
+                memcpy(job->source, program_code, length + 1);
+            }
+        }
+        if (job && job->source) {
+            uint32_t id = job->id;
+            if (job_submit(job) == 0) {
+                char message[128];
+                snprintf(message, sizeof(message), "프로그램 어셈블 작업 %u 시작 (%zu 바이트)", id, length);
+                ws_send_ack(message);
+                return 0;
+            }
+        } else if (job) {
+            job_free(job);
+        }
+    }
+    
+    // 편집 세션에 전체를 적재 (이후 edit_program은 이 줄 목록에 대한 diff)
+    AsmEdit edit;
+    free(current_session->editor_source);
+    current_session->editor_source = NULL;
+    if (asm_session_load(&current_session->editor, program_code, length, &edit) != 0) {
+        ws_send_error("프로그램을 적재할 메모리가 부족합니다");
+        return -1;
+    }
+    return program_load_assembled(program_code, length, &edit);
+}
+
+/*
+ * @brief 바이너리 프로그램 이미지 파일을 적재합니다 (tools/asm_image로 만든 파일)
+ * @param name 서버 이미지 디렉터리(ws_server_set_image_dir) 안의 파일 이름
+ * @returns 적재 성공 시 0, 실패 시 -1
+ *
+ * @details
+ * 파일을 mmap해 검사만 하고 세그먼트를 CPU 메모리로 바로 복사하므로 어셈블이나 JSON 파싱이 없습니다.
+ * 이미지에는 소스가 없으므로 편집 세션은 빈 프로그램으로 되돌립니다.
+ * 경로나 ".."이 든 이름은 받지 않고, 열 수 없는 경우와 이미지가 아닌 경우를 같은 오류로 돌려주어
+ * 클라이언트가 서버 파일의 존재를 알아낼 수 없게 합니다 (자세한 이유는 서버 로그에만).
+ */
+int ws_handle_image_load(const char* name) {
+    ProgramImage image;
+    char path[PATH_MAX];
+    char error[160];
+
+    if (!image_dir) {
+        ws_send_error("이미지 디렉터리가 설정되지 않았습니다 (CPU_WS_IMAGE_DIR)");
+        return -1;
+    }
+    if (resolve_client_file(image_dir, name, "", path, sizeof(path)) != 0) {
+        ws_send_error("이미지 이름은 영문자, 숫자, '_', '-', '.'만 쓸 수 있습니다 (경로 불가)");
+        return -1;
+    }
+    if (image_open(path, &image, error, sizeof(error)) != 0) {
+        printf("❌ 이미지 적재 실패: %s\n", error);
+        ws_send_error("이미지를 적재할 수 없습니다");
+        return -1;
+    }
+    run_job_interrupt();
+    if (cpu_load_image(&image) != 0) {
+        image_close(&image);
+        ws_send_error("이미지 세그먼트가 CPU 메모리 범위를 벗어납니다");
+        return -1;
+    }
+
+    unsigned segment_count = image.header->segment_count;
+    unsigned symbol_count = image.header->symbol_count;
+    uint16_t entry_pc = image.header->entry_pc;
+    image_close(&image);
+
+    AsmEdit edit;
+    free(current_session->editor_source);
+    current_session->editor_source = NULL;
+    asm_session_load(&current_session->editor, "", 0, &edit);
+
+    char success_msg[256];
+    snprintf(success_msg, sizeof(success_msg), "이미지 로드 완료: 세그먼트 %u개, 심볼 %u개, 진입 PC %u",
+             segment_count, symbol_count, entry_pc);
+    ws_send_ack(success_msg);
+    ws_send_cpu_state();
+    ws_send_memory_state();
+    ws_send_cache_state();
+
+    printf("이미지 로드 성공: %s (%s)\n", path, success_msg);
+    return 0;
+}
+
+/*
+ * @brief LRU 캐시 하나의 통계를 JSON 객체로 만듭니다
+ */
+static json_object* lru_stats_object(const LruCache *cache) {
+    json_object *object = json_object_new_object();
+    
+    json_object_object_add(object, "hits", json_object_new_int64((int64_t)cache->stats.hits));
+    json_object_object_add(object, "misses", json_object_new_int64((int64_t)cache->stats.misses));
+    json_object_object_add(object, "evictions", json_object_new_int64((int64_t)cache->stats.evictions));
+    json_object_object_add(object, "entries", json_object_new_int64((int64_t)cache->entry_count));
+    json_object_object_add(object, "bytes", json_object_new_int64((int64_t)cache->bytes));
+    json_object_object_add(object, "max_bytes", json_object_new_int64((int64_t)cache->max_bytes));
+    return object;
+}
+
+/*
+ * @brief 지금 세션을 보는 클라이언트별 전송 대기열 통계 배열을 만듭니다 (연결 수가 많아도 구독자만)
+ */
+static json_object* client_queue_array(void) {
+    json_object *array = json_object_new_array();
+    
+    pthread_mutex_lock(&server_ctx.mutex);
+    const ws_client_session_t *client = current_session ? current_session->viewers : NULL;
+    for (; client; client = client->next_viewer) {
+        json_object *object = json_object_new_object();
+        json_object_object_add(object, "session_id", json_object_new_int64(client->session_id));
+        json_object_object_add(object, "ip", json_object_new_string(client->ip_addr));
+        json_object_object_add(object, "binary", json_object_new_boolean(client->binary));
+        json_object_object_add(object, "depth", json_object_new_int((int)client->queue.count));
+        json_object_object_add(object, "peak", json_object_new_int((int)client->queue.peak));
+        json_object_object_add(object, "coalescing", json_object_new_boolean(client->queue.coalescing));
+        json_object_object_add(object, "sent", json_object_new_int64((int64_t)client->queue.sent));
+        json_object_object_add(object, "coalesced", json_object_new_int64((int64_t)client->queue.coalesced));
+        json_object_object_add(object, "dropped", json_object_new_int64((int64_t)client->queue.dropped));
+        json_object_array_add(array, object);
+    }
+    pthread_mutex_unlock(&server_ctx.mutex);
+    return array;
+}
+
+/*
+ * @brief 서버 캐시(프로그램, 실행 결과)와 클라이언트별 전송 대기열 통계 JSON 메시지를 생성합니다
+ * @param 없음
+ * @returns JSON 객체 포인터
+ */
+json_object* create_server_cache_message(void) {
+    json_object *root = json_object_new_object();
+    json_object *payload = json_object_new_object();
+    
+    pthread_mutex_lock(&server_ctx.cache_mutex);
+    json_object_object_add(payload, "program", lru_stats_object(&server_ctx.program_cache));
+    json_object_object_add(payload, "run", lru_stats_object(&server_ctx.run_cache));
+    pthread_mutex_unlock(&server_ctx.cache_mutex);
+    json_object_object_add(payload, "connections", json_object_new_int64(server_ctx.clients.count));
+    json_object_object_add(payload, "clients", client_queue_array());
+    json_object_object_add(root, "type", json_object_new_string("server_cache"));
+    json_object_object_add(root, "payload", payload);
+    
+    return root;
+}
+
+/*
+ * @brief 편집 결과(바뀐 메모리 범위와 오류) JSON 메시지를 생성합니다
+ * @param edit asm_session_edit 결과
+ * @returns JSON 객체 포인터
+ */
+json_object* create_program_patch_message(const AsmEdit *edit) {
+    json_object *root = json_object_new_object();
+    json_object *payload = json_object_new_object();
+    json_object *data = json_object_new_array();
+    json_object *errors = json_object_new_array();
+    const uint8_t *image = asm_session_image(&current_session->editor, NULL);
+    AsmError error_list[ASM_MAX_ERRORS];
+    unsigned error_count = asm_session_errors(&current_session->editor, error_list, ASM_MAX_ERRORS);
+    
+    for (size_t address = edit->dirty_start; address < edit->dirty_end; address++) {
+        json_object_array_add(data, json_object_new_int(image[address]));
+    }
+    for (unsigned i = 0; i < error_count; i++) {
+        json_object *error = json_object_new_object();
+        json_object_object_add(error, "line", json_object_new_int((int)error_list[i].line));
+        json_object_object_add(error, "column", json_object_new_int((int)error_list[i].column));
+        json_object_object_add(error, "message", json_object_new_string(error_list[i].message));
+        json_object_array_add(errors, error);
+    }
+    
+    json_object_object_add(payload, "start", json_object_new_int((int)edit->dirty_start));
+    json_object_object_add(payload, "data", data);
+    json_object_object_add(payload, "assembled", json_object_new_int((int)edit->assembled));
+    json_object_object_add(payload, "relocated", json_object_new_int((int)edit->relocated));
+    json_object_object_add(payload, "error_lines", json_object_new_int((int)edit->error_lines));
+    json_object_object_add(payload, "errors", errors);
+    json_object_object_add(root, "type", json_object_new_string("program_patch"));
+    json_object_object_add(root, "payload", payload);
+    
+    return root;
+}
+
+/*
+ * @brief 줄 단위 diff를 적용해 바뀐 줄만 다시 어셈블하고 메모리에 반영합니다
+ * @param edit {"start": 줄 번호(0부터), "delete": 지울 줄 수, "text": 넣을 줄들('\n' 구분, 없으면 삽입 없음)}
+ * @returns 성공 시 0, 실패 시 -1
+ *
+ * @details
+ * load_program과 달리 cpu_reset()을 하지 않으므로 레지스터/PC/캐시 통계가 유지되고,
+ * 바뀐 주소 범위만 메모리에 쓰고(그 범위의 캐시 라인만 무효화) 그 범위만 전송합니다.
+ * 오류가 있는 줄이 있어도 나머지 줄의 결과는 반영하고 오류 목록을 함께 보냅니다.
+ */
+int ws_handle_program_edit(json_object *edit) {
+    json_object *value;
+    int start = 0;
+    int delete_count = 0;
+    const char *text = NULL;
+    
+    if (!edit) {
+        ws_send_error("편집 내용이 없습니다");
+        return -1;
+    }
+    run_job_interrupt();
+    if (json_object_object_get_ex(edit, "start", &value)) {
+        start = json_object_get_int(value);
+    }
+    if (json_object_object_get_ex(edit, "delete", &value)) {
+        delete_count = json_object_get_int(value);
+    }
+    if (json_object_object_get_ex(edit, "text", &value)) {
+        text = json_object_get_string(value);
+    }
+    
+    AsmEdit result;
+    if (current_session->editor_source) {
+        // 캐시 히트로 적재한 프로그램: 이미지는 이미 메모리에 있으므로 세션만 채움
+        int loaded = asm_session_load(&current_session->editor, current_session->editor_source,
+                                      strlen(current_session->editor_source), &result);
+        free(current_session->editor_source);
+        current_session->editor_source = NULL;
+        if (loaded != 0) {
+            ws_send_error("편집 세션을 적재할 메모리가 부족합니다");
+            return -1;
+        }
+    }
+    if (start < 0 || delete_count < 0 ||
+        asm_session_edit(&current_session->editor, (size_t)start, (size_t)delete_count, text,
+                         text ? strlen(text) : 0, &result) != 0) {
+        char error_msg[128];
+        snprintf(error_msg, sizeof(error_msg), "편집을 적용할 수 없습니다: 줄 %d부터 %d줄 (전체 %zu줄)",
+                 start, delete_count, current_session->editor.line_count);
+        ws_send_error(error_msg);
+        return -1;
+    }
+    
+    if (result.dirty_start < result.dirty_end) {
+        const uint8_t *image = asm_session_image(&current_session->editor, NULL);
+        cpu_patch_program((uint16_t)result.dirty_start, image + result.dirty_start,
+                          result.dirty_end - result.dirty_start);
+    }
+    printf("편집 반영: 줄 %d (-%d), 다시 어셈블 %u줄, 이동 %u줄, 메모리 [%zu, %zu)\n", start, delete_count,
+           result.assembled, result.relocated, result.dirty_start, result.dirty_end);
+    
+    json_object *msg = create_program_patch_message(&result);
+    send_message(json_object_to_json_string(msg), NULL);
     json_object_put(msg);
+    return 0;
+}
+
+// 단계별 실행 처리
+/*
+ * @brief CPU를 한 단계 실행합니다
+ * @param 없음
+ * @returns 실행 성공 시 0, 실패 시 -1
+ */
+int ws_handle_step_execution(void) {
+    printf("단계 실행 요청\n");
+    run_job_interrupt();
+    
+    // 실행 전 PC 저장
+    CPU_Registers *regs = get_cpu_registers();
+    int prev_pc = regs->pc;
+    
+    // 현재 PC 위치의 명령어 가져오기 (실행 전)
+    Memory *memory = get_cpu_memory();
+    char current_instruction[64] = "알 수 없는 명령어";
+    
+    if (prev_pc < MEMORY_SIZE - 1) {
+        uint8_t instruction_bytes[2];
+        instruction_bytes[0] = memory_peek(memory, prev_pc);
+        instruction_bytes[1] = memory_peek(memory, prev_pc + 1);
+        
+        // 바이트를 어셈블리로 변환
+        if (decode_bytes_to_assembly(instruction_bytes, 2, current_instruction, sizeof(current_instruction))) {
+            printf("실행할 명령어: %s (PC: %d)\n", current_instruction, prev_pc);
+        }
+    }
+    
+    // 실행 전 오버플로우 플래그 상태 저장
+    bool prev_overflow_flag = get_overflow_flag(regs);
+    
+    // CPU 한 단계 실행
+    cpu_step();
+    
+    // 실행 후 PC와 플래그 상태 확인
+    regs = get_cpu_registers();
+    uint8_t current_flags = get_flags(regs);
+    bool current_overflow_flag = (current_flags & FLAG_OF) != 0;
+    
+    // 오버플로우 플래그가 새로 설정됨 - 오버플로우/언더플로우 발생
+    const char *warning = NULL;
+    if (current_overflow_flag && !prev_overflow_flag) {
+        if (strstr(current_instruction, "SUB") || strstr(current_instruction, "sub")) {
+            warning = "🚨 뺄셈 오버플로우 발생: 부호 있는 정수 범위를 벗어났습니다 (OF=1)";
+        } else if (strstr(current_instruction, "ADD") || strstr(current_instruction, "add")) {
+            warning = "🚨 덧셈 오버플로우 발생: 부호 있는 정수 범위를 벗어났습니다 (OF=1)";
+        } else if (strstr(current_instruction, "MUL") || strstr(current_instruction, "mul")) {
+            warning = "🚨 곱셈 오버플로우 발생: 부호 있는 정수 범위를 벗어났습니다 (OF=1)";
+        } else if (strstr(current_instruction, "DIV") || strstr(current_instruction, "div")) {
+            warning = "🚨 나눗셈 에러가 발생했습니다 (OF=1)";
+        }
+    }
+    
+    // 실행된 명령어 정보
+    char step_msg[256];
+    snprintf(step_msg, sizeof(step_msg), "실행: %s | PC: %d -> %d [CF=%d ZF=%d SF=%d OF=%d]", 
+             current_instruction, prev_pc, regs->pc,
+             (current_flags & FLAG_CF) != 0, (current_flags & FLAG_ZF) != 0,
+             (current_flags & FLAG_SF) != 0, current_overflow_flag);
+    
+    uint8_t executed_bytes[2] = {0, 0};
+    if (prev_pc < MEMORY_SIZE - 1) {
+        executed_bytes[0] = memory_peek(memory, prev_pc);
+        executed_bytes[1] = memory_peek(memory, prev_pc + 1);
+    }
+    
+    // 실행 단계, 바뀐 레지스터/메모리/캐시 라인, 경고를 한 메시지로 전송
+    ws_send_state_delta(step_msg, executed_bytes, 2, warning);
+    printf("단계 실행 성공: %s | PC %d -> %d\n", current_instruction, prev_pc, regs->pc);
+    
+    return 0;
 }
 
+// CPU 리셋 처리
 /*
- * @brief 캐시 상태를 모든 클라이언트에 전송합니다
+ * @brief CPU를 리셋합니다
  * @param 없음
- * @returns 없음 (void)
+ * @returns 리셋 성공 시 0
  */
-void ws_send_cache_state(void) {
-    json_object *msg = create_cache_message();
-    const char *json_str = json_object_to_json_string(msg);
-    broadcast_message(json_str);
-    json_object_put(msg);
+int ws_handle_cpu_reset(void) {
+    printf("CPU 리셋 요청\n");
+    run_job_interrupt();
+    
+    // CPU 초기화
+    cpu_reset();
+    
+    // 상태 전송
+    ws_send_cpu_state();
+    ws_send_memory_state();
+    ws_send_cache_state();
+    
+    // 실행 단계 전송
+    ws_send_execution_step("CPU 리셋 완료", NULL, 0);
+    
+    ws_send_ack("CPU 리셋 완료");
+    printf("CPU 리셋 성공\n");
+    
+    return 0;
 }
 
+// 전체 프로그램 일괄 실행 처리
+/* run_all 결과 캐시 키: 실행 결과를 정하는 상태 전부 (통계 카운터는 제외) */
+typedef struct RunMemoKey {
+    CPU_Registers regs;
+    uint8_t data[MEMORY_SIZE];
+    CacheLine lines[CACHE_NUM_LINES];
+    uint64_t budget;
+} RunMemoKey;
+
+/* run_all 결과 캐시 값: 최종 상태와 실행 중 늘어난 통계 */
+typedef struct {
+    CPU_Registers regs;
+    uint8_t data[MEMORY_SIZE];
+    CacheLine lines[CACHE_NUM_LINES];
+    CacheStats cache_delta;
+    CPU_Stats stats_delta;
+    uint64_t steps;
+} RunMemoValue;
+
 /*
- * @brief 실행 단계 정보를 모든 클라이언트에 전송합니다
- * @param instruction 실행된 명령어 문자열
- * @param bytes 명령어 바이트 배열
- * @param byte_count 바이트 개수
- * @returns 없음 (void)
+ * @brief 현재 상태로 run_all 결과 캐시 키를 만듭니다
+ * @param key 채울 키
+ * @param budget 단계 한도 (0이면 없음)
+ * @returns 결과가 초기 상태만으로 정해지면 1, 캐시하면 안 되면 0
+ *
+ * @details
+ * 트레이스/프로파일은 단계마다 부수 효과가 있고, 기능 모드는 캐시 대신 접근 기록을 남기므로 제외합니다.
+ * 패딩까지 0으로 채워야 같은 상태가 같은 키가 됩니다.
  */
-void ws_send_execution_step(const char* instruction, const uint8_t* bytes, int byte_count) {
-    json_object *msg = create_execution_message(instruction, bytes, byte_count);
-    const char *json_str = json_object_to_json_string(msg);
-    broadcast_message(json_str);
-    json_object_put(msg);
+static int run_memo_key(RunMemoKey *key, uint64_t budget) {
+    CPU_Context *ctx = cpu_get_context();
+    
+    if (ctx->mode != CPU_MODE_DETAILED || !ctx->memory.cache_enabled || ctx->profiling || TRACE_ACTIVE()) {
+        return 0;
+    }
+    memset(key, 0, sizeof(*key));
+    key->regs = ctx->regs;
+    memcpy(key->data, ctx->memory.data, sizeof(key->data));
+    memcpy(key->lines, ctx->memory.cache.lines, sizeof(key->lines));
+    key->budget = budget;
+    return 1;
 }
 
 /*
- * @brief 확인 메시지를 모든 클라이언트에 전송합니다
- * @param message 확인 메시지 문자열
+ * @brief 실행을 마친 상태를 run_all 결과 캐시에 저장합니다
+ * @param key 실행 전에 만든 키
+ * @param steps 실행한 단계 수
+ * @param cache_before 실행 전 캐시 통계
+ * @param stats_before 실행 전 CPU 통계
  * @returns 없음 (void)
  */
-void ws_send_ack(const char* message) {
-    json_object *msg = create_ack_message(message);
-    const char *json_str = json_object_to_json_string(msg);
-    broadcast_message(json_str);
-    json_object_put(msg);
+static void run_memo_store(const RunMemoKey *key, uint64_t steps, const CacheStats *cache_before,
+                           const CPU_Stats *stats_before) {
+    CPU_Context *ctx = cpu_get_context();
+    const CacheStats *cache_after = &ctx->memory.cache.stats;
+    RunMemoValue value;
+    
+    memset(&value, 0, sizeof(value));
+    value.regs = ctx->regs;
+    memcpy(value.data, ctx->memory.data, sizeof(value.data));
+    memcpy(value.lines, ctx->memory.cache.lines, sizeof(value.lines));
+    value.cache_delta.hits = cache_after->hits - cache_before->hits;
+    value.cache_delta.misses = cache_after->misses - cache_before->misses;
+    value.cache_delta.writebacks = cache_after->writebacks - cache_before->writebacks;
+    value.stats_delta.instructions = ctx->stats.instructions - stats_before->instructions;
+    value.stats_delta.cycles = ctx->stats.cycles - stats_before->cycles;
+    value.steps = steps;
+    pthread_mutex_lock(&server_ctx.cache_mutex);
+    lru_put(&server_ctx.run_cache, key, sizeof(*key), &value, sizeof(value));
+    pthread_mutex_unlock(&server_ctx.cache_mutex);
 }
 
 /*
- * @brief 에러 메시지를 모든 클라이언트에 전송합니다
- * @param error_msg 에러 메시지 문자열
+ * @brief 캐시된 최종 상태를 현재 CPU에 적용합니다 (통계는 실행한 것처럼 누적)
+ * @param memo 캐시된 값
  * @returns 없음 (void)
  */
-void ws_send_error(const char* error_msg) {
-    json_object *msg = create_error_message(error_msg);
-    const char *json_str = json_object_to_json_string(msg);
-    broadcast_message(json_str);
-    json_object_put(msg);
+static void run_memo_apply(const RunMemoValue *memo) {
+    CPU_Context *ctx = cpu_get_context();
+    CacheStats *cache_stats = &ctx->memory.cache.stats;
+    
+    ctx->regs = memo->regs;
+    memcpy(ctx->memory.data, memo->data, sizeof(memo->data));
+    memcpy(ctx->memory.cache.lines, memo->lines, sizeof(memo->lines));
+    cache_stats->hits += memo->cache_delta.hits;
+    cache_stats->misses += memo->cache_delta.misses;
+    cache_stats->writebacks += memo->cache_delta.writebacks;
+    ctx->stats.instructions += memo->stats_delta.instructions;
+    ctx->stats.cycles += memo->stats_delta.cycles;
 }
 
 /*
- * @brief 어셈블리 코드를 처리합니다
- * @param assembly_code 어셈블리 코드 문자열
- * @returns 처리 성공 시 0, 실패 시 -1
+ * @brief run_all 작업을 끝내고 최종 상태와 완료 메시지를 보냅니다 (세션 안에서 호출)
+ * @param job 끝낼 작업
+ * @param completed 1이면 프로그램 끝/단계 한도 도달 (결과를 캐시), 0이면 중지
+ * @returns 없음 (void)
  */
-int ws_handle_assembly_code(const char* assembly_code) {
-    uint8_t bytes[256];
-    int byte_count = decode_assembly_to_bytes(assembly_code, bytes, sizeof(bytes));
+static void run_job_finish(ws_run_job_t *job, int completed) {
+    char completion_msg[256];
     
-    if (byte_count <= 0) {
-        ws_send_error("어셈블리 디코딩 실패");
-        return -1;
+    lws_sul_cancel(&job->timer);
+    if (completed && job->memo_key) {
+        run_memo_store(job->memo_key, job->steps, &job->cache_before, &job->stats_before);
     }
+    free(job->memo_key);
+    job->memo_key = NULL;
+    job->state = RUN_IDLE;
     
-    // CPU에 프로그램 로드
-    cpu_load_program(bytes, byte_count);
-    
-    // 실행 단계 전송
-    ws_send_execution_step(assembly_code, bytes, byte_count);
-    
-    // CPU 한 단계 실행
-    cpu_step();
-    
-    // 상태 전송
+    // 최종 상태 전송
     ws_send_cpu_state();
     ws_send_memory_state();
     ws_send_cache_state();
     
-    return 0;
+    // 완료 메시지 전송
+    if (!completed) {
+        snprintf(completion_msg, sizeof(completion_msg), "실행 중지: %llu단계 실행 (PC: %d)",
+                 (unsigned long long)job->steps, get_cpu_registers()->pc);
+    } else if (job->budget && job->steps >= job->budget) {
+        snprintf(completion_msg, sizeof(completion_msg),
+                "전체 실행 완료 (단계 한도 도달): %llu단계 실행", (unsigned long long)job->steps);
+    } else {
+        snprintf(completion_msg, sizeof(completion_msg), "전체 실행 완료: %llu단계 실행 (PC: %d -> %d)",
+                 (unsigned long long)job->steps, job->initial_pc, get_cpu_registers()->pc);
+    }
+    
+    ws_send_execution_step(completion_msg, NULL, 0);
+    ws_send_ack(completion_msg);
+    printf("%s\n", completion_msg);
 }
 
-// 프로그램 로드 처리 (여러 줄 어셈블리)
+static void run_job_tick(lws_sorted_usec_list_t *timer);
+
 /*
- * @brief 프로그램을 로드합니다
- * @param program_code 프로그램 코드 문자열
- * @returns 로드 성공 시 0, 실패 시 -1
+ * @brief 최대 속도 run_all의 남은 부분을 워커에 맡깁니다 (세션 안에서 호출)
+ * @param run run_all 작업
+ * @returns 맡겼으면 0, 맡길 수 없으면 -1 (타이머 조각으로 실행)
  */
-int ws_handle_program_load(const char* program_code) {
-    if (!program_code) {
-        ws_send_error("프로그램 코드가 없습니다");
+static int run_job_offload(ws_run_job_t *run) {
+    if (!job_offloadable()) {
+        return -1;
+    }
+    ws_job_t *job = job_new(WS_JOB_RUN_ALL, job_run_all, run->deadline_ms);
+    if (!job) {
         return -1;
     }
+    job_copy_cpu(job);
+    job->budget = run->budget ? run->budget - run->steps : 0;
+    job->last_pc = get_cpu_registers()->pc;
+    return job_submit(job);
+}
+
+/*
+ * @brief 일시 정지한 지점의 상태와 확인 메시지를 보냅니다
+ */
+static void run_job_paused(const ws_run_job_t *job) {
+    char message[128];
     
-    printf("프로그램 로드 요청: %s\n", program_code);
+    snprintf(message, sizeof(message), "실행 일시 정지: %llu단계 (PC: %d)", (unsigned long long)job->steps,
+             get_cpu_registers()->pc);
+    ws_send_cpu_state();
+    ws_send_ack(message);
+}
+
+/*
+ * @brief 워커가 실행한 run_all 결과를 세션에 적용합니다 (세션 안에서 호출)
+ * @param job 끝난 작업 (끝까지 실행, 취소, 마감 시각 초과)
+ * @returns 없음 (void)
+ *
+ * @details
+ * 취소/마감으로 멈춰도 워커는 단계 경계에서 멈추므로 그 지점까지의 상태를 적용합니다 (pause/stop과 같음).
+ */
+static void run_all_complete(ws_job_t *job) {
+    ws_run_job_t *run = &current_session->run;
     
-    // 프로그램을 한 줄씩 나누어 처리
-    char *program_copy = strdup(program_code);
-    char *line = strtok(program_copy, "\n");
-    uint8_t all_bytes[1024];
-    int total_byte_count = 0;
-    
-    while (line != NULL && total_byte_count < sizeof(all_bytes) - 2) {
-        // 공백 제거
-        while (*line == ' ' || *line == '\t') line++;
-        if (strlen(line) == 0) {
-            line = strtok(NULL, "\n");
-            continue;
+    job_apply_cpu(job);
+    run->steps += job->steps;
+    if (job->steps > 0) {
+        char current_instruction[64] = "알 수 없는 명령어";
+        char step_msg[256];
+        decode_bytes_to_assembly(job->last_bytes, 2, current_instruction, sizeof(current_instruction));
+        snprintf(step_msg, sizeof(step_msg), "단계 %llu: %s | PC: %d -> %d", (unsigned long long)run->steps,
+                 current_instruction, job->last_pc, get_cpu_registers()->pc);
+        ws_send_state_delta(step_msg, job->last_bytes, 2, NULL);
+    }
+    if (run->state == RUN_IDLE) {
+        return;
+    }
+    if (job->item.status == WORK_DONE) {
+        run_job_finish(run, 1);
+    } else if (job->item.status == WORK_EXPIRED) {
+        ws_send_error("실행 시간 제한 초과 (deadline_ms)");
+        run_job_finish(run, 0);
+    } else if (run->state == RUN_PAUSED && !job->stopping) {
+        run_job_paused(run);
+    } else {
+        run_job_finish(run, 0);
+    }
+}
+
+/*
+ * @brief 다음 실행 조각을 예약합니다
+ * @param job 작업
+ * @returns 없음 (void)
+ *
+ * @details
+ * rate가 타이머 간격 하한보다 빠르면 RUN_MIN_INTERVAL_US마다 여러 단계를 실행하고,
+ * rate가 0이면 워커에 맡겨 서비스 스레드는 결과만 적용합니다.
+ * 워커에 맡길 수 없으면(트레이스/프로파일 중) 바로 다음 서비스 루프에서 이어 가 다른 연결의 이벤트가 그 사이에 처리됩니다.
+ */
+static void run_job_schedule(ws_run_job_t *job) {
+    lws_usec_t delay = 1;
+    
+    if (job->rate == 0 && run_job_offload(job) == 0) {
+        return;
+    }
+    if (job->rate > 0 && job->rate <= LWS_US_PER_SEC / RUN_MIN_INTERVAL_US) {
+        delay = LWS_US_PER_SEC / job->rate;
+    } else if (job->rate > 0) {
+        delay = RUN_MIN_INTERVAL_US;
+    }
+    lws_sul_schedule(server_ctx.context, job->tsi, &job->timer, run_job_tick, delay);
+}
+
+/*
+ * @brief 타이머 한 번에 실행할 단계 수를 정합니다
+ */
+static uint64_t run_job_slice(const ws_run_job_t *job) {
+    uint64_t slice;
+    
+    if (job->rate == 0) {
+        slice = RUN_SLICE_STEPS;
+    } else if (job->rate > LWS_US_PER_SEC / RUN_MIN_INTERVAL_US) {
+        slice = job->rate / (LWS_US_PER_SEC / RUN_MIN_INTERVAL_US);
+    } else {
+        slice = 1;
+    }
+    if (job->budget && job->budget - job->steps < slice) {
+        slice = job->budget - job->steps;
+    }
+    return slice;
+}
+
+/*
+ * @brief run_all 타이머 콜백: 한 조각을 실행하고 바뀐 상태를 보냅니다
+ * @param timer 작업의 lws_sul
+ * @returns 없음 (void)
+ *
+ * @details
+ * 세션을 서비스하는 스레드의 이벤트 루프에서 호출되므로, 조각 사이에 다른 연결의 요청과 전송이 처리됩니다.
+ * 한 조각에 여러 단계를 실행하면 delta는 마지막에 한 번만 보냅니다 (트래커가 조각 전체의 변화를 계산).
+ */
+static void run_job_tick(lws_sorted_usec_list_t *timer) {
+    ws_run_job_t *job = lws_container_of(timer, ws_run_job_t, timer);
+    ws_cpu_session_t *session = lws_container_of(job, ws_cpu_session_t, run);
+    
+    // 완료 응답은 실행을 요청할 수 있는 소유 연결에게 (관전자는 delta로 진행을 봄)
+    request_enter(lws_container_of(session, ws_client_session_t, session), session);
+    CPU_Registers *regs = get_cpu_registers();
+    Memory *memory = get_cpu_memory();
+    uint64_t slice = run_job_slice(job);
+    int finished = 0;
+    char current_instruction[64] = "알 수 없는 명령어";
+    uint8_t instruction_bytes[2] = { 0, 0 };
+    int prev_pc = regs->pc;
+    uint64_t executed = 0;
+    
+    for (; executed < slice; executed++) {
+        // 현재 명령어 확인
+        if (regs->pc >= MEMORY_SIZE - 1) {
+            finished = 1;
+            break;
+        }
+        if (memory_peek(memory, regs->pc) == 0 && memory_peek(memory, regs->pc + 1) == 0) {
+            printf("빈 명령어 도달 - 실행 종료 (PC: %d)\n", regs->pc);
+            finished = 1;
+            break;
         }
         
-        // 각 줄을 바이트로 변환
-        uint8_t line_bytes[16];
-        int line_byte_count = decode_assembly_to_bytes(line, line_bytes, sizeof(line_bytes));
+        // 실행 전 PC와 명령어 저장
+        prev_pc = regs->pc;
+        instruction_bytes[0] = memory_peek(memory, prev_pc);
+        instruction_bytes[1] = memory_peek(memory, prev_pc + 1);
         
-        if (line_byte_count > 0) {
-            memcpy(all_bytes + total_byte_count, line_bytes, line_byte_count);
-            total_byte_count += line_byte_count;
-            printf("라인 처리: %s -> %d 바이트\n", line, line_byte_count);
-        } else {
-            printf("라인 디코딩 실패: %s\n", line);
+        // CPU 한 단계 실행
+        cpu_step();
+        job->steps++;
+    }
+    
+    if (executed > 0) {
+        // 조각의 마지막 명령어와 바뀐 상태 전송
+        char step_msg[256];
+        decode_bytes_to_assembly(instruction_bytes, 2, current_instruction, sizeof(current_instruction));
+        snprintf(step_msg, sizeof(step_msg), "단계 %llu: %s | PC: %d -> %d",
+                 (unsigned long long)job->steps, current_instruction, prev_pc, regs->pc);
+        if (slice == 1) {
+            printf("실행 중: %s (PC: %d, 단계: %llu)\n", current_instruction, prev_pc,
+                   (unsigned long long)job->steps);
         }
-        
-        line = strtok(NULL, "\n");
+        ws_send_state_delta(step_msg, instruction_bytes, 2, NULL);
     }
     
-    if (total_byte_count > 0) {
-        // CPU 초기화 (모든 레지스터와 메모리)
-        cpu_reset();
-        
-        // CPU에 전체 프로그램 로드 (실행하지 않고 메모리에만 로드)
-        cpu_load_program(all_bytes, total_byte_count);
-        
-        // 성공 메시지 전송
-        char success_msg[256];
-        snprintf(success_msg, sizeof(success_msg), "프로그램 로드 완료: %d 바이트 (실행 대기 중)", total_byte_count);
-        ws_send_ack(success_msg);
-        
-        // 실행 단계 전송
-        ws_send_execution_step("프로그램 로드됨 - 단계 실행 준비", all_bytes, total_byte_count);
-        
-        // 상태 전송
-        ws_send_cpu_state();
-        ws_send_memory_state();
-        ws_send_cache_state();
-        
-        printf("프로그램 로드 성공: %d 바이트 (단계 실행 준비)\n", total_byte_count);
+    if (finished || (job->budget && job->steps >= job->budget)) {
+        run_job_finish(job, 1);
+    } else {
+        run_job_schedule(job);
+    }
+    request_leave();
+}
+
+/*
+ * @brief 진행 중인 run_all을 멈춥니다 (상태를 바꾸는 다른 요청 앞에서 호출)
+ * @param 없음
+ * @returns 없음 (void)
+ *
+ * @details
+ * 작업 도중 CPU 상태가 바뀌면 결과를 캐시할 수 없으므로 캐시 없이 끝냅니다.
+ * 워커에 맡긴 run_all은 stop처럼 취소한 뒤 멈춘 지점의 상태를 돌려받아 적용하고 나서 새 요청을 처리합니다.
+ * 아직 대기열에 있던 작업은 work_item_cancel이 바로 끝내므로(CPU 사본은 그대로라 적용할 것이 없음)
+ * 다른 세션의 작업이 워커를 차지하고 있어도 서비스 스레드가 기다리지 않고,
+ * 실행 중인 작업만 WS_JOB_CHECK_STEPS 단계 안에 멈출 때까지 기다립니다.
+ * fast_forward와 load_program은 결과를 버리므로, 세션은 새 요청이 바꾼 상태에서 이어집니다.
+ */
+static void run_job_interrupt(void) {
+    ws_job_t *job;
+
+    if (!current_session) {
+        return;
+    }
+    job = current_session->job;
+    if (job && job->kind == WS_JOB_RUN_ALL) {
+        // 작업은 done 큐로도 돌아오지만 session->job과 다르므로 drain_thread_jobs가 해제만 함
+        job->stopping = 1;
+        work_item_cancel(&job->item);
+        work_item_wait(&job->item);
+        current_session->job = NULL;
+        run_all_complete(job);
+    } else {
+        job_abandon(current_session);
+    }
+    if (current_session->run.state != RUN_IDLE) {
+        run_job_finish(&current_session->run, 0);
+    }
+}
+
+/*
+ * @brief run_all 작업을 시작합니다
+ * @param rate 초당 단계 수 (0이면 최대한 빨리)
+ * @param budget 단계 한도 (0이면 프로그램이 끝날 때까지)
+ * @param deadline_ms 최대 속도로 워커에서 실행할 때 마감 시간 (0이면 없음)
+ * @returns 실행 성공 시 0, 이미 실행 중이면 -1
+ *
+ * @details
+ * 같은 프로그램/초기 상태/단계 한도로 끝까지 실행한 적이 있으면 타이머 없이 최종 상태만 적용합니다.
+ */
+static int run_all_start(uint32_t rate, uint64_t budget, uint32_t deadline_ms) {
+    ws_run_job_t *job = &current_session->run;
+    
+    printf("전체 프로그램 실행 요청 (초당 %u단계, 한도 %llu)\n", rate, (unsigned long long)budget);
+    if (job->state != RUN_IDLE) {
+        ws_send_error("이미 실행 중입니다 (pause/resume/stop)");
+        return -1;
+    }
+    
+    job_abandon(current_session);   // 워커의 fast_forward/load_program보다 나중 요청이 우선
+    memset(job, 0, sizeof(*job));
+    job->tsi = service_tsi;
+    job->rate = rate;
+    job->budget = budget;
+    job->deadline_ms = deadline_ms;
+    job->initial_pc = get_cpu_registers()->pc;
+    job->cache_before = get_cpu_memory()->cache.stats;
+    job->stats_before = cpu_get_context()->stats;
+    
+    RunMemoKey memo_key;
+    if (run_memo_key(&memo_key, budget)) {
+        pthread_mutex_lock(&server_ctx.cache_mutex);
+        const RunMemoValue *memo = lru_get(&server_ctx.run_cache, &memo_key, sizeof(memo_key), NULL);
+        if (memo) {
+            run_memo_apply(memo);
+            job->steps = memo->steps;
+        }
+        pthread_mutex_unlock(&server_ctx.cache_mutex);
+        if (memo) {
+            printf("실행 결과 캐시 히트: %llu단계 생략\n", (unsigned long long)job->steps);
+            run_job_finish(job, 1);     // memo_key가 없으므로 다시 저장하지 않음
+            return 0;
+        }
+        job->memo_key = malloc(sizeof(memo_key));
+        if (job->memo_key) {
+            *job->memo_key = memo_key;
+        }
+    }
+    
+    // 실행 시작 메시지 전송 후 첫 조각 예약 (요청 콜백은 바로 돌아감)
+    ws_send_execution_step("전체 프로그램 실행 시작", NULL, 0);
+    job->state = RUN_RUNNING;
+    run_job_schedule(job);
+    return 0;
+}
+
+/*
+ * @brief CPU를 모든 명령어가 완료될 때까지 실행하는 작업을 시작합니다
+ * @param options {"rate": 초당 단계 (0이면 최대한 빨리), "budget": 단계 한도 (0이면 없음),
+ *                 "deadline_ms": 최대 속도 실행의 마감 시간 (0이면 없음)}, NULL이면 기본값
+ * @returns 실행 성공 시 0, 실패 시 -1
+ *
+ * @details
+ * 단계 사이에 잠들지 않고 lws_sul 타이머로 이어서 실행하므로, 실행 중에도 같은 스레드의 다른 연결이 멈추지 않습니다.
+ * 최대 속도(rate 0)는 워커 풀에서 실행하고 끝나거나 멈춘 지점의 상태만 보냅니다.
+ */
+int ws_handle_run_all(json_object *options) {
+    int64_t rate = RUN_DEFAULT_RATE;
+    int64_t budget = 0;
+    
+    if (options) {
+        json_object *value;
+        if (json_object_object_get_ex(options, "rate", &value)) {
+            rate = json_object_get_int64(value);
+        }
+        if (json_object_object_get_ex(options, "budget", &value)) {
+            budget = json_object_get_int64(value);
+        }
+    }
+    if (rate < 0 || rate > UINT32_MAX || budget < 0) {
+        ws_send_error("잘못된 실행 옵션 (rate, budget은 0 이상)");
+        return -1;
+    }
+    return run_all_start((uint32_t)rate, (uint64_t)budget, job_deadline_option(options));
+}
+
+/*
+ * @brief 진행 중인 run_all을 일시 정지합니다
+ * @param 없음
+ * @returns 성공 시 0, 실행 중이 아니면 -1
+ */
+int ws_handle_run_pause(void) {
+    ws_run_job_t *job = &current_session->run;
+    
+    if (job->state != RUN_RUNNING) {
+        ws_send_error("실행 중인 작업이 없습니다");
+        return -1;
+    }
+    job->state = RUN_PAUSED;
+    if (current_session->job) {
+        // 워커가 멈춘 지점의 상태를 돌려주면 run_all_complete에서 알림
+        work_item_cancel(&current_session->job->item);
+        return 0;
+    }
+    lws_sul_cancel(&job->timer);
+    run_job_paused(job);
+    return 0;
+}
+
+/*
+ * @brief 일시 정지한 run_all을 이어서 실행합니다
+ * @param 없음
+ * @returns 성공 시 0, 일시 정지 상태가 아니면 -1
+ */
+int ws_handle_run_resume(void) {
+    ws_run_job_t *job = &current_session->run;
+    
+    if (job->state != RUN_PAUSED) {
+        ws_send_error("일시 정지한 작업이 없습니다");
+        return -1;
+    }
+    if (current_session->job) {
+        ws_send_error("일시 정지를 처리하는 중입니다 (잠시 뒤 다시 시도)");
+        return -1;
+    }
+    job->state = RUN_RUNNING;
+    job->tsi = service_tsi;
+    run_job_schedule(job);
+    ws_send_ack("실행 재개");
+    return 0;
+}
+
+/*
+ * @brief run_all을 멈추고 지금 상태를 보냅니다
+ * @param 없음
+ * @returns 성공 시 0, 작업이 없으면 -1
+ */
+int ws_handle_run_stop(void) {
+    if (current_session->run.state == RUN_IDLE) {
+        ws_send_error("실행 중인 작업이 없습니다");
+        return -1;
+    }
+    if (current_session->job) {
+        // 최종 상태와 완료 메시지는 워커가 멈춘 지점을 돌려준 뒤 run_all_complete에서
+        current_session->job->stopping = 1;
+        work_item_cancel(&current_session->job->item);
+        return 0;
+    }
+    run_job_finish(&current_session->run, 0);
+    return 0;
+}
+
+/*
+ * @brief 워커에서 실행 중인 작업을 취소합니다 (run_all이면 stop과 같음)
+ * @param payload 취소할 작업 번호 (NULL이면 세션의 작업)
+ * @returns 성공 시 0, 그런 작업이 없으면 -1
+ *
+ * @details
+ * 워커는 다음 확인(WS_JOB_CHECK_STEPS 단계마다)에서 멈추고, 실행 작업은 멈춘 지점까지의 상태를 돌려줍니다.
+ * 결과와 확인 메시지는 그 상태가 돌아왔을 때 보냅니다.
+ */
+int ws_handle_cancel(json_object *payload) {
+    ws_job_t *job = current_session->job;
+    
+    if (!job && current_session->run.state != RUN_IDLE && !payload) {
+        return ws_handle_run_stop();
+    }
+    if (!job || (payload && json_object_get_int64(payload) != job->id)) {
+        ws_send_error("진행 중인 작업이 없습니다");
+        return -1;
+    }
+    job->stopping = 1;
+    work_item_cancel(&job->item);
+    return 0;
+}
+
+/*
+ * @brief fast-forward 결과 상태와 완료 메시지를 보냅니다
+ * @param result 멈춘 이유와 실행한 단계 수
+ * @param status 워커 작업 결과 (바로 실행했으면 WORK_DONE)
+ * @returns 없음 (void)
+ */
+static void fast_forward_report(const FastForwardResult *result, WorkStatus status) {
+    char completion_msg[256];
+    
+    if (status == WORK_DONE) {
+        snprintf(completion_msg, sizeof(completion_msg),
+                 "fast-forward 완료: %llu단계 (멈춘 이유: %s, PC: %d) - 상세 모드 전환",
+                 (unsigned long long)result->steps, ff_stop_reason_name(result->reason), get_cpu_registers()->pc);
+    } else {
+        snprintf(completion_msg, sizeof(completion_msg), "fast-forward %s: %llu단계 (PC: %d) - 상세 모드 전환",
+                 status == WORK_EXPIRED ? "시간 제한 초과" : "취소", (unsigned long long)result->steps,
+                 get_cpu_registers()->pc);
+    }
+    
+    ws_send_cpu_state();
+    ws_send_memory_state();
+    ws_send_cache_state();
+    if (status == WORK_EXPIRED) {
+        ws_send_error(completion_msg);
     } else {
-        ws_send_error("프로그램에서 유효한 명령어를 찾을 수 없습니다");
-        free(program_copy);
-        return -1;
+        ws_send_ack(completion_msg);
     }
     
-    free(program_copy);
-    return 0;
+    printf("%s\n", completion_msg);
 }
 
-// 단계별 실행 처리
 /*
- * @brief CPU를 한 단계 실행합니다
- * @param 없음
- * @returns 실행 성공 시 0, 실패 시 -1
+ * @brief 워커가 fast-forward한 상태를 세션에 적용합니다 (세션 안에서 호출)
+ * @param job 끝난 작업 (취소/마감으로 멈췄어도 상세 모드로 돌아온 상태)
+ * @returns 없음 (void)
  */
-int ws_handle_step_execution(void) {
-    printf("단계 실행 요청\n");
-    
-    // 실행 전 PC 저장
-    CPU_Registers *regs = get_cpu_registers();
-    int prev_pc = regs->pc;
-    
-    // 현재 PC 위치의 명령어 가져오기 (실행 전)
-    Memory *memory = get_cpu_memory();
-    char current_instruction[64] = "알 수 없는 명령어";
-    
-    if (prev_pc < MEMORY_SIZE - 1) {
-        uint8_t instruction_bytes[2];
-        instruction_bytes[0] = memory->data[prev_pc];
-        instruction_bytes[1] = memory->data[prev_pc + 1];
-        
-        // 바이트를 어셈블리로 변환
-        if (decode_bytes_to_assembly(instruction_bytes, 2, current_instruction, sizeof(current_instruction))) {
-            printf("실행할 명령어: %s (PC: %d)\n", current_instruction, prev_pc);
+static void fast_forward_complete(ws_job_t *job) {
+    job_apply_cpu(job);
+    fast_forward_report(&job->ff_result, job->item.status);
+}
+
+// 관심 구간까지 기능 모드로 빠르게 실행
+/*
+ * @brief 멈춤 조건까지 fast-forward한 뒤 상세 모드로 전환합니다
+ * @param options 멈춤 조건 JSON 객체 (pc, steps, marker, warmup, deadline_ms), NULL이면 기본값
+ * @returns 실행 성공(또는 워커에 맡김) 시 0
+ *
+ * @details
+ * 워커가 세션 CPU의 복사본을 실행하고, 끝나면 세션 스레드가 복사본을 세션에 적용해 결과를 보냅니다.
+ */
+int ws_handle_fast_forward(json_object *options) {
+    FastForwardConfig config;
+    ff_default_config(&config);
+    run_job_interrupt();
+    
+    if (options) {
+        json_object *value;
+        if (json_object_object_get_ex(options, "pc", &value)) {
+            config.stop_pc = json_object_get_int(value);
+        }
+        if (json_object_object_get_ex(options, "steps", &value)) {
+            config.max_steps = (uint64_t)json_object_get_int64(value);
+        }
+        if (json_object_object_get_ex(options, "marker", &value)) {
+            config.stop_at_marker = json_object_get_boolean(value);
+        }
+        if (json_object_object_get_ex(options, "warmup", &value)) {
+            config.warmup_accesses = (unsigned)json_object_get_int(value);
         }
     }
     
-    // 실행 전 오버플로우 플래그 상태 저장
-    bool prev_overflow_flag = get_overflow_flag(regs);
-    
-    // CPU 한 단계 실행
-    cpu_step();
-    
-    // 실행 후 PC와 플래그 상태 확인
-    regs = get_cpu_registers();
-    bool current_overflow_flag = get_overflow_flag(regs);
-    
-    // 오버플로우 플래그 변화 감지 및 에러 메시지 전송
-    if (current_overflow_flag && !prev_overflow_flag) {
-        // 오버플로우 플래그가 새로 설정됨 - 오버플로우/언더플로우 발생
-        if (strstr(current_instruction, "SUB") || strstr(current_instruction, "sub")) {
-            ws_send_error("🚨 뺄셈 오버플로우 발생: 부호 있는 정수 범위를 벗어났습니다 (OF=1)");
-        } else if (strstr(current_instruction, "ADD") || strstr(current_instruction, "add")) {
-            ws_send_error("🚨 덧셈 오버플로우 발생: 부호 있는 정수 범위를 벗어났습니다 (OF=1)");
-        } else if (strstr(current_instruction, "MUL") || strstr(current_instruction, "mul")) {
-            ws_send_error("🚨 곱셈 오버플로우 발생: 부호 있는 정수 범위를 벗어났습니다 (OF=1)");
-        } else if (strstr(current_instruction, "DIV") || strstr(current_instruction, "div")) {
-            ws_send_error("🚨 나눗셈 에러가 발생했습니다 (OF=1)");
+    printf("fast-forward 요청 (pc=%d, steps=%llu, marker=%d, warmup=%u)\n", config.stop_pc,
+           (unsigned long long)config.max_steps, config.stop_at_marker, config.warmup_accesses);
+    
+    if (job_offloadable()) {
+        ws_job_t *job = job_new(WS_JOB_FAST_FORWARD, job_fast_forward, job_deadline_option(options));
+        if (job) {
+            uint32_t id = job->id;
+            job_copy_cpu(job);
+            job->ff_config = config;
+            if (job_submit(job) == 0) {
+                char message[128];
+                snprintf(message, sizeof(message), "fast-forward 작업 %u 시작", id);
+                ws_send_ack(message);
+                return 0;
+            }
         }
     }
     
-    // 실행된 명령어 정보 전송
-    char step_msg[256];
-    const char* flag_status = current_overflow_flag ? " [OF=1]" : " [OF=0]";
-    snprintf(step_msg, sizeof(step_msg), "실행: %s | PC: %d -> %d%s", 
-             current_instruction, prev_pc, regs->pc, flag_status);
-    
-    // 실행 단계 전송 (실행된 명령어와 바이트 정보 포함)
-    uint8_t executed_bytes[2] = {0, 0};
-    if (prev_pc < MEMORY_SIZE - 1) {
-        executed_bytes[0] = memory->data[prev_pc];
-        executed_bytes[1] = memory->data[prev_pc + 1];
+    FastForwardResult result = cpu_fast_forward(&config);
+    fast_forward_report(&result, WORK_DONE);
+    return 0;
+}
+
+/*
+ * @brief 실행 트레이스를 시작하거나 끝냅니다
+ * @param options {"action": "start"|"stop", "name": 파일 이름 (기본 "cpu_trace"), "ring": 링 용량}
+ * @returns 성공 시 0, 실패 시 -1
+ *
+ * @details
+ * 파일은 서버가 정한 트레이스 디렉터리(ws_server_set_trace_dir) 안의 "<name>.trace"에만 씁니다.
+ * 클라이언트는 경로를 고를 수 없으므로 서버의 다른 파일을 만들거나 덮어쓸 수 없습니다.
+ * 트레이스 생산자는 cpu_step()을 호출하는 스레드여야 하므로,
+ * 요청을 처리하는 서비스 스레드에서 시작하고, 그 스레드의 연결만 기록·종료할 수 있습니다.
+ */
+int ws_handle_trace(json_object *options) {
+    const char *action = "start";
+    const char *name = "cpu_trace";
+    char path[PATH_MAX];
+    unsigned ring = 0;
+    
+    if (options) {
+        json_object *value;
+        if (json_object_object_get_ex(options, "action", &value)) {
+            action = json_object_get_string(value);
+        }
+        if (json_object_object_get_ex(options, "name", &value)) {
+            name = json_object_get_string(value);
+        }
+        if (json_object_object_get_ex(options, "ring", &value)) {
+            ring = (unsigned)json_object_get_int(value);
+        }
     }
-    ws_send_execution_step(step_msg, executed_bytes, 2);
     
-    // 상태 전송
-    ws_send_cpu_state();
-    ws_send_memory_state();
-    ws_send_cache_state();
+    char completion_msg[256];
+    pthread_mutex_lock(&server_ctx.mutex);
+    int trace_tsi = server_ctx.trace_tsi;
+    pthread_mutex_unlock(&server_ctx.mutex);
+    if (trace_tsi >= 0 && trace_tsi != service_tsi) {
+        ws_send_error("다른 서비스 스레드에서 트레이스 중입니다");
+        return -1;
+    }
     
-    // 완료 메시지에 플래그 상태 포함
-    char completion_msg[128];
-    if (current_overflow_flag) {
-        snprintf(completion_msg, sizeof(completion_msg), "단계 실행 완료 (경고: 오버플로우 플래그 설정됨)");
+    if (strcmp(action, "stop") == 0) {
+        TraceStats stats;
+        trace_stop(&stats);
+        pthread_mutex_lock(&server_ctx.mutex);
+        server_ctx.trace_tsi = -1;
+        pthread_mutex_unlock(&server_ctx.mutex);
+        snprintf(completion_msg, sizeof(completion_msg), "트레이스 종료: 레코드 %llu개 (버림 %llu개), %llu바이트",
+                 (unsigned long long)stats.records, (unsigned long long)stats.dropped,
+                 (unsigned long long)stats.bytes);
     } else {
-        snprintf(completion_msg, sizeof(completion_msg), "단계 실행 완료");
+        if (resolve_client_file(trace_dir, name, ".trace", path, sizeof(path)) != 0) {
+            ws_send_error("트레이스 이름은 영문자, 숫자, '_', '-', '.'만 쓸 수 있습니다 (경로 불가)");
+            return -1;
+        }
+        // 다른 스레드가 동시에 시작하지 못하도록 확인과 시작을 한 번에
+        pthread_mutex_lock(&server_ctx.mutex);
+        int started = server_ctx.trace_tsi < 0 && trace_start(path, ring) == 0;
+        if (started) {
+            server_ctx.trace_tsi = service_tsi;
+        }
+        pthread_mutex_unlock(&server_ctx.mutex);
+        if (!started) {
+            ws_send_error("트레이스를 시작할 수 없습니다");
+            return -1;
+        }
+        snprintf(completion_msg, sizeof(completion_msg), "트레이스 시작: %s.trace", name);
     }
-    ws_send_ack(completion_msg);
-    printf("단계 실행 성공: %s | PC %d -> %d\n", current_instruction, prev_pc, regs->pc);
     
+    ws_send_ack(completion_msg);
     return 0;
 }
 
-// CPU 리셋 처리
 /*
- * @brief CPU를 리셋합니다
- * @param 없음
- * @returns 리셋 성공 시 0
+ * @brief flamegraph용 folded stack을 문자열로 만듭니다
+ * @returns malloc한 NUL 종료 문자열 (호출자가 free), 실패 시 NULL
+ *
+ * @details
+ * 서버 파일 시스템에 쓰지 않도록 임시 스트림에 쓴 뒤 읽어 응답에 담습니다 (PC당 한 줄이라 수 KB).
  */
-int ws_handle_cpu_reset(void) {
-    printf("CPU 리셋 요청\n");
-    
-    // CPU 초기화
-    cpu_reset();
-    
-    // 상태 전송
-    ws_send_cpu_state();
-    ws_send_memory_state();
-    ws_send_cache_state();
-    
-    // 실행 단계 전송
-    ws_send_execution_step("CPU 리셋 완료", NULL, 0);
-    
-    ws_send_ack("CPU 리셋 완료");
-    printf("CPU 리셋 성공\n");
+static char* profile_folded_text(void) {
+    FILE *file = tmpfile();
+    char *text = NULL;
     
-    return 0;
+    if (!file) {
+        return NULL;
+    }
+    profiler_write_folded(profiler_get(), get_cpu_memory(), file, decode_bytes_to_assembly);
+    long length = ftell(file);
+    if (length >= 0 && (text = malloc((size_t)length + 1)) != NULL) {
+        rewind(file);
+        if (fread(text, 1, (size_t)length, file) != (size_t)length) {
+            free(text);
+            text = NULL;
+        } else {
+            text[length] = '\0';
+        }
+    }
+    fclose(file);
+    return text;
 }
 
-// 전체 프로그램 일괄 실행 처리
 /*
- * @brief CPU를 모든 명령어가 완료될 때까지 실행합니다
- * @param 없음
- * @returns 실행 성공 시 0, 실패 시 -1
+ * @brief 프로파일 핫스팟 JSON 메시지를 생성합니다
+ * @param top_n 보낼 최대 PC 수
+ * @param with_folded 1이면 flamegraph용 folded stack 문자열("folded")도 담음
+ * @returns JSON 객체 포인터
  */
-int ws_handle_run_all(void) {
-    printf("전체 프로그램 실행 요청\n");
-    
-    CPU_Registers *regs = get_cpu_registers();
+json_object* create_profile_message(int top_n, int with_folded) {
+    json_object *root = json_object_new_object();
+    json_object *payload = json_object_new_object();
+    Profile *profile = profiler_get();
     Memory *memory = get_cpu_memory();
-    int initial_pc = regs->pc;
-    int step_count = 0;
-    int max_steps = 16; // 최대 16단계까지 실행 (무한 루프 방지)
     
-    // 실행 시작 메시지 전송
-    ws_send_execution_step("전체 프로그램 실행 시작", NULL, 0);
+    static CPU_THREAD_LOCAL ProfileHotspot hot[MEMORY_SIZE];
+    ProfileOpcode ops[PROFILE_OPCODES];
+    int n = profiler_hotspots(profile, memory, hot, MEMORY_SIZE);
+    profiler_opcodes(profile, memory, ops);
     
-    // 프로그램이 끝날 때까지 단계별 실행
-    while (step_count < max_steps && regs->pc < MEMORY_SIZE - 1) {
-        // 현재 명령어 확인
-        if (memory->data[regs->pc] == 0 && memory->data[regs->pc + 1] == 0) {
-            printf("빈 명령어 도달 - 실행 종료 (PC: %d)\n", regs->pc);
-            break;
+    uint64_t total_cycles = 0;
+    for (int i = 0; i < n; i++) {
+        total_cycles += hot[i].cycles;
+    }
+    if (top_n > 0 && n > top_n) {
+        n = top_n;
+    }
+    
+    json_object *hotspots = json_object_new_array();
+    for (int i = 0; i < n; i++) {
+        char assembly[64];
+        uint8_t bytes[2] = { (uint8_t)(hot[i].word >> 8), (uint8_t)(hot[i].word & 0xFF) };
+        if (!decode_bytes_to_assembly(bytes, 2, assembly, sizeof(assembly))) {
+            snprintf(assembly, sizeof(assembly), "0x%04X", hot[i].word);
         }
         
-        // 실행 전 PC와 명령어 저장
-        int prev_pc = regs->pc;
-        char current_instruction[64] = "알 수 없는 명령어";
-        uint8_t instruction_bytes[2];
-        instruction_bytes[0] = memory->data[prev_pc];
-        instruction_bytes[1] = memory->data[prev_pc + 1];
-        
-        // 바이트를 어셈블리로 변환
-        decode_bytes_to_assembly(instruction_bytes, 2, current_instruction, sizeof(current_instruction));
-        
-        printf("실행 중: %s (PC: %d, 단계: %d)\n", current_instruction, prev_pc, step_count + 1);
-        
-        // CPU 한 단계 실행
-        cpu_step();
-        
-        // 실행 결과 메시지 생성
-        char step_msg[256];
-        snprintf(step_msg, sizeof(step_msg), "단계 %d: %s | PC: %d -> %d", 
-                step_count + 1, current_instruction, prev_pc, regs->pc);
-        
-        // 실행 단계 정보 전송
-        ws_send_execution_step(step_msg, instruction_bytes, 2);
-        
-        // 잠시 대기 (시각적 효과를 위해)
-        usleep(200000); // 200ms 대기
-        
-        step_count++;
+        json_object *entry = json_object_new_object();
+        json_object_object_add(entry, "pc", json_object_new_int(hot[i].pc));
+        json_object_object_add(entry, "asm", json_object_new_string(assembly));
+        json_object_object_add(entry, "count", json_object_new_int64((int64_t)hot[i].count));
+        json_object_object_add(entry, "cycles", json_object_new_int64((int64_t)hot[i].cycles));
+        json_object_object_add(entry, "misses", json_object_new_int64((int64_t)hot[i].misses));
+        json_object_object_add(entry, "percent", json_object_new_double(
+            total_cycles ? 100.0 * (double)hot[i].cycles / (double)total_cycles : 0.0));
+        json_object_array_add(hotspots, entry);
     }
     
-    // 최종 상태 전송
-    ws_send_cpu_state();
-    ws_send_memory_state();
-    ws_send_cache_state();
+    json_object *opcodes = json_object_new_array();
+    for (int op = 0; op < PROFILE_OPCODES; op++) {
+        if (ops[op].count == 0) {
+            continue;
+        }
+        json_object *entry = json_object_new_object();
+        json_object_object_add(entry, "opcode", json_object_new_string(profiler_opcode_name((uint8_t)op)));
+        json_object_object_add(entry, "count", json_object_new_int64((int64_t)ops[op].count));
+        json_object_object_add(entry, "cycles", json_object_new_int64((int64_t)ops[op].cycles));
+        json_object_object_add(entry, "misses", json_object_new_int64((int64_t)ops[op].misses));
+        json_object_array_add(opcodes, entry);
+    }
     
-    // 완료 메시지 전송
-    char completion_msg[256];
-    if (step_count >= max_steps) {
-        snprintf(completion_msg, sizeof(completion_msg), 
-                "전체 실행 완료 (최대 단계 도달): %d단계 실행", step_count);
-    } else {
-        snprintf(completion_msg, sizeof(completion_msg), 
-                "전체 실행 완료: %d단계 실행 (PC: %d -> %d)", step_count, initial_pc, regs->pc);
+    json_object_object_add(payload, "enabled", json_object_new_boolean(profiler_is_enabled()));
+    json_object_object_add(payload, "total_cycles", json_object_new_int64((int64_t)total_cycles));
+    json_object_object_add(payload, "hotspots", hotspots);
+    json_object_object_add(payload, "opcodes", opcodes);
+    if (with_folded) {
+        char *folded = profile_folded_text();
+        json_object_object_add(payload, "folded", folded ? json_object_new_string(folded) : NULL);
+        free(folded);
+    }
+    json_object_object_add(root, "type", json_object_new_string("profile"));
+    json_object_object_add(root, "payload", payload);
+    
+    return root;
+}
+
+/*
+ * @brief PC별 프로파일러를 켜고 끄거나 결과를 보냅니다
+ * @param options {"action": "start"|"stop"|"reset"|"report", "top": 핫스팟 수, "folded": true/false}
+ * @returns 성공 시 0, 실패 시 -1
+ *
+ * @details
+ * stop과 report는 요청한 클라이언트에게 핫스팟 메시지를 보내고, folded가 true면 flamegraph용
+ * folded stack을 같은 메시지에 문자열로 담습니다 (클라이언트가 준 경로로 서버에 파일을 쓰지 않음).
+ */
+int ws_handle_profile(json_object *options) {
+    const char *action = "report";
+    int with_folded = 0;
+    int top_n = 20;
+    
+    if (options) {
+        json_object *value;
+        if (json_object_object_get_ex(options, "action", &value)) {
+            action = json_object_get_string(value);
+        }
+        if (json_object_object_get_ex(options, "top", &value)) {
+            top_n = json_object_get_int(value);
+        }
+        if (json_object_object_get_ex(options, "folded", &value)) {
+            with_folded = json_object_get_boolean(value);
+        }
     }
     
-    ws_send_execution_step(completion_msg, NULL, 0);
-    ws_send_ack(completion_msg);
+    if (strcmp(action, "start") == 0) {
+        if (profiler_enable() != PROFILER_OK) {
+            ws_send_error("프로파일러를 시작할 수 없습니다 (메모리 부족)");
+            return -1;
+        }
+        ws_send_ack("프로파일러 시작");
+        return 0;
+    }
+    if (strcmp(action, "reset") == 0) {
+        profiler_reset();
+        ws_send_ack("프로파일 초기화");
+        return 0;
+    }
+    if (strcmp(action, "stop") == 0) {
+        profiler_disable();
+    }
     
-    printf("전체 실행 성공: %d단계 실행\n", step_count);
+    profiler_print_report(profiler_get(), get_cpu_memory(), stdout, top_n, decode_bytes_to_assembly);
+    
+    json_object *msg = create_profile_message(top_n, with_folded);
+    send_message(json_object_to_json_string(msg), current_requester);
+    json_object_put(msg);
     return 0;
 }
 
@@ -961,6 +3103,7 @@ int ws_handle_run_all(void) {
  */
 int ws_handle_single_instruction_load(const char* assembly_code) {
     printf("단일 명령어 로드 요청: %s\n", assembly_code);
+    run_job_interrupt();
     
     // CPU 리셋 (이전 상태 초기화)
     cpu_reset();
@@ -975,10 +3118,7 @@ int ws_handle_single_instruction_load(const char* assembly_code) {
     }
     
     // 메모리 시작 부분에 명령어 로드
-    Memory *memory = get_cpu_memory();
-    for (int i = 0; i < byte_count && i < MEMORY_SIZE; i++) {
-        memory->data[i] = bytes[i];
-    }
+    cpu_load_program(bytes, byte_count);
     
     // PC를 0으로 설정 (명령어 시작 위치)
     CPU_Registers *regs = get_cpu_registers();
@@ -994,84 +3134,208 @@ int ws_handle_single_instruction_load(const char* assembly_code) {
     return 0;
 }
 
+/*
+ * @brief 관전 중인 클라이언트에게도 허용하는 요청인지 확인합니다 (상태 조회, 재동기화, 관전 전환)
+ */
+static int spectator_allowed(const char *type) {
+    static const char *allowed[] = { "get_state", "get_memory", "get_cache", "get_server_cache",
+                                     "resync", "ping", "watch", "unwatch" };
+    
+    for (size_t i = 0; i < sizeof(allowed) / sizeof(allowed[0]); i++) {
+        if (strcmp(type, allowed[i]) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * @brief 다른 연결의 세션을 관전하기 시작합니다 (target_id가 HANDLE_INVALID면 자기 세션으로 돌아감)
+ * @param client 요청한 클라이언트
+ * @param target_id 관전할 세션 ID
+ * @returns 성공 시 0, 그런 세션이 없으면 -1
+ *
+ * @details
+ * 관전자는 대상 세션의 구독자 목록으로 옮겨 가 응답과 delta를 함께 받고, 상태를 바꾸는 요청은 거부됩니다.
+ * 세션 ID는 세대가 붙은 핸들이므로 이미 닫힌 연결의 ID로는 나중에 같은 슬롯을 받은 연결을 관전하지 못합니다.
+ * 전환 직후 새로 보게 된 세션의 키프레임을 보냅니다.
+ */
+static int handle_watch(ws_client_session_t *client, Handle target_id) {
+    ws_cpu_session_t *target = &client->session;
+    
+    pthread_mutex_lock(&server_ctx.mutex);
+    if (target_id != HANDLE_INVALID) {
+        ws_client_session_t *owner = handle_get(&server_ctx.clients, target_id);
+        target = owner ? &owner->session : NULL;
+    }
+    if (target && target != client->session.view) {
+        viewer_detach(client);
+        viewer_attach(target, client);
+    }
+    if (target && target != &client->session) {
+        target->pins++;
+    }
+    pthread_mutex_unlock(&server_ctx.mutex);
+    
+    if (!target) {
+        send_text_to(client, "error", WIRE_ERROR, "관전할 세션이 없습니다");
+        return -1;
+    }
+    send_text_to(client, "ack", WIRE_ACK, target == &client->session ? "관전 종료" : "관전 시작");
+    send_catch_up_keyframe(client, target);
+    view_unpin(client, target);
+    return 0;
+}
+
 // WebSocket 프로토콜 콜백
 static int callback_cpu_protocol(struct lws *wsi, enum lws_callback_reasons reason,
                                 void *user, void *in, size_t len) {
+    ws_client_session_t *client = user;
+    ws_cpu_session_t *session = client ? &client->session : NULL;
+    
     switch (reason) {
         case LWS_CALLBACK_ESTABLISHED:
-            add_client(wsi);
+            if (add_client(wsi, 0, client) < 0) {
+                return -1;
+            }
+            request_enter(client, session);
             ws_send_ack("연결됨");
-            ws_send_cpu_state();
+            send_cpu_state(client);
+            request_leave();
             break;
             
         case LWS_CALLBACK_CLOSED:
-            remove_client(wsi);
+            remove_client(client);
+            break;
+            
+        case LWS_CALLBACK_SERVER_WRITEABLE:
+            return flush_client(client);
+            
+        case LWS_CALLBACK_EVENT_WAIT_CANCELLED:
+            // lws_cancel_service(_pt)로 깨운 스레드 (모든 프로토콜에 오므로 여기서만 처리)
+            wake_thread_clients();
+            drain_thread_jobs();
             break;
             
         case LWS_CALLBACK_RECEIVE: {
-            char *message = malloc(len + 1);
-            if (message) {
-                memcpy(message, in, len);
-                message[len] = '\0';
-                
+            char *message;
+            size_t length;
+            int complete = receive_fragment(client, wsi, in, len, &message, &length);
+            
+            if (complete < 0) {
+                send_text_to(client, "error", WIRE_ERROR, "메시지가 너무 큽니다");
+            } else if (complete > 0) {
                 // JSON 파싱
                 json_object *root = json_tokener_parse(message);
-                if (root) {
+                if (!root) {
+                    send_text_to(client, "error", WIRE_ERROR, "JSON 메시지를 해석할 수 없습니다");
+                } else {
                     json_object *type_obj;
                     if (json_object_object_get_ex(root, "type", &type_obj)) {
                         const char *type = json_object_get_string(type_obj);
                         
-                        if (strcmp(type, "assembly") == 0) {
-                            json_object *payload_obj;
-                            if (json_object_object_get_ex(root, "payload", &payload_obj)) {
-                                const char *assembly = json_object_get_string(payload_obj);
-                                ws_handle_assembly_code(assembly);
-                            }
-                        } else if (strcmp(type, "load_program") == 0) {
-                            json_object *payload_obj;
-                            if (json_object_object_get_ex(root, "payload", &payload_obj)) {
-                                const char *program = json_object_get_string(payload_obj);
-                                ws_handle_program_load(program);
-                            }
-                        } else if (strcmp(type, "load_single_instruction") == 0) {
+                        // watch/unwatch/resync는 다른 세션의 lock을 잡으므로 요청 처리(session_enter) 밖에서
+                        if (strcmp(type, "watch") == 0) {
                             json_object *payload_obj;
                             if (json_object_object_get_ex(root, "payload", &payload_obj)) {
-                                const char *instruction = json_object_get_string(payload_obj);
-                                ws_handle_single_instruction_load(instruction);
+                                int64_t target_id = json_object_get_int64(payload_obj);
+                                handle_watch(client, target_id > 0 && target_id <= UINT32_MAX ? (Handle)target_id
+                                                                                              : HANDLE_INVALID);
                             }
-                        } else if (strcmp(type, "step") == 0) {
-                            ws_handle_step_execution();
-                        } else if (strcmp(type, "reset") == 0) {
-                            ws_handle_cpu_reset();
-                        } else if (strcmp(type, "run_all") == 0) {
-                            ws_handle_run_all();
-                        } else if (strcmp(type, "get_state") == 0) {
-                            ws_send_cpu_state();
-                        } else if (strcmp(type, "get_memory") == 0) {
-                            ws_send_memory_state();
-                        } else if (strcmp(type, "get_cache") == 0) {
-                            ws_send_cache_state();
-                        } else if (strcmp(type, "ping") == 0) {
-                            json_object *pong_msg = json_object_new_object();
-                            json_object *pong_type = json_object_new_string("pong");
-                            json_object_object_add(pong_msg, "type", pong_type);
-                            
-                            const char *pong_str = json_object_to_json_string(pong_msg);
-                            size_t pong_len = strlen(pong_str);
-                            unsigned char *buf = malloc(LWS_PRE + pong_len);
-                            
-                            if (buf) {
-                                memcpy(&buf[LWS_PRE], pong_str, pong_len);
-                                lws_write(wsi, &buf[LWS_PRE], pong_len, LWS_WRITE_TEXT);
-                                free(buf);
+                        } else if (strcmp(type, "unwatch") == 0) {
+                            handle_watch(client, HANDLE_INVALID);
+                        } else if (strcmp(type, "resync") == 0) {
+                            // 순서 번호가 건너뛴 클라이언트: 그 클라이언트에게만 키프레임을 바로 전송
+                            ws_cpu_session_t *view = view_pin(client);
+                            send_catch_up_keyframe(client, view);
+                            view_unpin(client, view);
+                        } else {
+                            ws_cpu_session_t *view = view_pin(client);
+                            request_enter(client, view);
+                            if (view != session && !spectator_allowed(type)) {
+                                send_text_to(client, "error", WIRE_ERROR, "관전 중에는 실행할 수 없습니다 (unwatch로 돌아가기)");
+                            } else if (strcmp(type, "assembly") == 0) {
+                                json_object *payload_obj;
+                                if (json_object_object_get_ex(root, "payload", &payload_obj)) {
+                                    const char *assembly = json_object_get_string(payload_obj);
+                                    ws_handle_assembly_code(assembly);
+                                }
+                            } else if (strcmp(type, "load_program") == 0) {
+                                json_object *payload_obj;
+                                if (json_object_object_get_ex(root, "payload", &payload_obj)) {
+                                    const char *program = json_object_get_string(payload_obj);
+                                    ws_handle_program_load(program);
+                                }
+                            } else if (strcmp(type, "load_image") == 0) {
+                                json_object *payload_obj;
+                                if (json_object_object_get_ex(root, "payload", &payload_obj)) {
+                                    ws_handle_image_load(json_object_get_string(payload_obj));
+                                }
+                            } else if (strcmp(type, "edit_program") == 0) {
+                                json_object *payload_obj = NULL;
+                                json_object_object_get_ex(root, "payload", &payload_obj);
+                                ws_handle_program_edit(payload_obj);
+                            } else if (strcmp(type, "load_single_instruction") == 0) {
+                                json_object *payload_obj;
+                                if (json_object_object_get_ex(root, "payload", &payload_obj)) {
+                                    const char *instruction = json_object_get_string(payload_obj);
+                                    ws_handle_single_instruction_load(instruction);
+                                }
+                            } else if (strcmp(type, "step") == 0) {
+                                ws_handle_step_execution();
+                            } else if (strcmp(type, "reset") == 0) {
+                                ws_handle_cpu_reset();
+                            } else if (strcmp(type, "run_all") == 0) {
+                                json_object *payload_obj = NULL;
+                                json_object_object_get_ex(root, "payload", &payload_obj);
+                                ws_handle_run_all(payload_obj);
+                            } else if (strcmp(type, "pause") == 0) {
+                                ws_handle_run_pause();
+                            } else if (strcmp(type, "resume") == 0) {
+                                ws_handle_run_resume();
+                            } else if (strcmp(type, "stop") == 0) {
+                                ws_handle_run_stop();
+                            } else if (strcmp(type, "cancel") == 0) {
+                                json_object *payload_obj = NULL;
+                                json_object_object_get_ex(root, "payload", &payload_obj);
+                                ws_handle_cancel(payload_obj);
+                            } else if (strcmp(type, "fast_forward") == 0) {
+                                json_object *payload_obj = NULL;
+                                json_object_object_get_ex(root, "payload", &payload_obj);
+                                ws_handle_fast_forward(payload_obj);
+                            } else if (strcmp(type, "trace") == 0) {
+                                json_object *payload_obj = NULL;
+                                json_object_object_get_ex(root, "payload", &payload_obj);
+                                ws_handle_trace(payload_obj);
+                            } else if (strcmp(type, "profile") == 0) {
+                                json_object *payload_obj = NULL;
+                                json_object_object_get_ex(root, "payload", &payload_obj);
+                                ws_handle_profile(payload_obj);
+                            } else if (strcmp(type, "get_state") == 0) {
+                                send_cpu_state(client);
+                            } else if (strcmp(type, "get_memory") == 0) {
+                                send_memory_state(client);
+                            } else if (strcmp(type, "get_cache") == 0) {
+                                send_cache_state(client);
+                            } else if (strcmp(type, "get_server_cache") == 0) {
+                                json_object *cache_msg = create_server_cache_message();
+                                send_message(json_object_to_json_string(cache_msg), client);
+                                json_object_put(cache_msg);
+                            } else if (strcmp(type, "ping") == 0) {
+                                JsonWriter writer;
+                                begin_json(&writer);
+                                jw_begin_object(&writer);
+                                jw_key(&writer, "type");
+                                jw_string(&writer, "pong");
+                                jw_end_object(&writer);
+                                send_json(&writer, 0, client);
                             }
-                            
-                            json_object_put(pong_msg);
+                            request_leave();
+                            view_unpin(client, view);
                         }
                     }
                     json_object_put(root);
                 }
-                free(message);
             }
             break;
         }
@@ -1083,15 +3347,199 @@ static int callback_cpu_protocol(struct lws *wsi, enum lws_callback_reasons reas
     return 0;
 }
 
+/*
+ * @brief 텍스트 명령의 payload를 NUL 종료 문자열로 복사해 처리기에 넘깁니다
+ */
+static void handle_text_command(const WireCommand *command, int (*handler)(const char *)) {
+    char *text = malloc(command->length + 1);
+    
+    if (!text) {
+        ws_send_error("명령을 처리할 메모리가 부족합니다");
+        return;
+    }
+    memcpy(text, command->text, command->length);
+    text[command->length] = '\0';
+    handler(text);
+    free(text);
+}
+
+/*
+ * @brief 바이너리 서브프로토콜 콜백 (명령 프레임을 JSON과 같은 처리 함수로 보냄)
+ * @param wsi WebSocket 인스턴스
+ * @param reason 콜백 이유
+ * @param user 사용자 데이터
+ * @param in 입력 데이터
+ * @param len 데이터 길이
+ * @returns 콜백 처리 결과 (int)
+ */
+static int callback_cpu_binary(struct lws *wsi, enum lws_callback_reasons reason,
+                               void *user, void *in, size_t len) {
+    OutFrame *frame;
+    WireCommand command;
+    ws_client_session_t *client = user;
+    ws_cpu_session_t *session = client ? &client->session : NULL;
+    ws_cpu_session_t *view;
+    char *message;
+    size_t length;
+    int complete;
+    
+    switch (reason) {
+        case LWS_CALLBACK_ESTABLISHED:
+            if (add_client(wsi, 1, client) < 0) {
+                return -1;
+            }
+            request_enter(client, session);
+            ws_send_ack("연결됨");
+            send_cpu_state(client);
+            request_leave();
+            break;
+            
+        case LWS_CALLBACK_CLOSED:
+            remove_client(client);
+            break;
+            
+        case LWS_CALLBACK_SERVER_WRITEABLE:
+            return flush_client(client);
+            
+        case LWS_CALLBACK_RECEIVE:
+            complete = receive_fragment(client, wsi, in, len, &message, &length);
+            if (complete == 0) {
+                break;
+            }
+            if (complete < 0) {
+                send_text_to(client, "error", WIRE_ERROR, "메시지가 너무 큽니다");
+                break;
+            }
+            if (!lws_frame_is_binary(wsi) || wire_decode_command((const uint8_t *)message, length, &command) != 0) {
+                send_text_to(client, "error", WIRE_ERROR, "알 수 없는 바이너리 명령");
+                break;
+            }
+            if (command.type == WIRE_CMD_RESYNC) {
+                // 다른 세션의 lock을 잡을 수 있으므로 요청 처리(session_enter) 밖에서
+                view = view_pin(client);
+                send_catch_up_keyframe(client, view);
+                view_unpin(client, view);
+                break;
+            }
+            view = view_pin(client);
+            request_enter(client, view);
+            switch (command.type) {
+                case WIRE_CMD_STEP:
+                    ws_handle_step_execution();
+                    break;
+                case WIRE_CMD_RESET:
+                    ws_handle_cpu_reset();
+                    break;
+                case WIRE_CMD_RUN_ALL:
+                    if (command.has_run_options) {
+                        run_all_start(command.rate, command.budget, WS_JOB_DEADLINE_MS);
+                    } else {
+                        ws_handle_run_all(NULL);
+                    }
+                    break;
+                case WIRE_CMD_PAUSE:
+                    ws_handle_run_pause();
+                    break;
+                case WIRE_CMD_RESUME:
+                    ws_handle_run_resume();
+                    break;
+                case WIRE_CMD_STOP:
+                    ws_handle_run_stop();
+                    break;
+                case WIRE_CMD_CANCEL:
+                    ws_handle_cancel(NULL);
+                    break;
+                case WIRE_CMD_GET_STATE:
+                    send_cpu_state(client);
+                    break;
+                case WIRE_CMD_GET_CACHE:
+                    send_cache_state(client);
+                    break;
+                case WIRE_CMD_GET_MEMORY: {
+                    uint8_t data[MEMORY_SIZE];
+                    Memory *memory = get_cpu_memory();
+                    if ((size_t)command.address + command.count > MEMORY_SIZE) {
+                        ws_send_error("메모리 범위 오류");
+                        break;
+                    }
+                    for (unsigned i = 0; i < command.count; i++) {
+                        data[command.address + i] = memory_peek(memory, (uint16_t)(command.address + i));
+                    }
+                    if ((frame = begin_frame()) != NULL) {
+                        send_frame(frame, wire_encode_memory(out_frame_payload(frame), MAX_PAYLOAD_SIZE, data,
+                                                             command.address, command.count), 0, client);
+                    }
+                    break;
+                }
+                case WIRE_CMD_PING:
+                    if ((frame = begin_frame()) != NULL) {
+                        send_frame(frame, wire_encode_empty(out_frame_payload(frame), MAX_PAYLOAD_SIZE, WIRE_PONG), 0,
+                                   client);
+                    }
+                    break;
+                case WIRE_CMD_LOAD_PROGRAM:
+                    handle_text_command(&command, ws_handle_program_load);
+                    break;
+                case WIRE_CMD_ASSEMBLY:
+                    handle_text_command(&command, ws_handle_assembly_code);
+                    break;
+                case WIRE_CMD_LOAD_IMAGE:
+                    handle_text_command(&command, ws_handle_image_load);
+                    break;
+                default:
+                    break;
+            }
+            request_leave();
+            view_unpin(client, view);
+            break;
+            
+        default:
+            break;
+    }
+    
+    return 0;
+}
+
+/*
+ * @brief 서비스 스레드 하나의 이벤트 루프 (ws_server_stop까지)
+ * @param arg 스레드 번호 (tsi)
+ * @returns NULL
+ */
+static void* service_thread_main(void *arg) {
+    service_tsi = (int)(intptr_t)arg;
+    while (__atomic_load_n(&server_running, __ATOMIC_ACQUIRE)) {
+        lws_service_tsi(server_ctx.context, 50, service_tsi);
+    }
+    out_frame_release(json_frame);
+    json_frame = NULL;
+    out_frame_pool_trim();
+    return NULL;
+}
+
 // 서버 실행
 /*
  * @brief WebSocket 서버를 실행합니다
  * @param 없음
  * @returns 서버 종료 상태 (int)
+ *
+ * @details
+ * 스레드 0은 호출한 스레드에서, 나머지는 새 스레드에서 서비스합니다.
+ * 연결은 받은 스레드에서만 처리되므로 그 연결의 CPU 세션도 한 코어에 머뭅니다.
  */
 int ws_server_run(void) {
-    while (server_running) {
-        lws_service(server_ctx.context, 50);
+    pthread_t threads[WS_MAX_SERVICE_THREADS];
+    int started = 1;
+    
+    for (; started < server_ctx.thread_count; started++) {
+        if (pthread_create(&threads[started], NULL, service_thread_main, (void *)(intptr_t)started) != 0) {
+            printf("❌ 서비스 스레드 %d 생성 실패\n", started);
+            ws_server_stop();
+            break;
+        }
+    }
+    service_thread_main((void *)(intptr_t)0);
+    for (int i = 1; i < started; i++) {
+        pthread_join(threads[i], NULL);
     }
     return 0;
 } 
\ No newline at end of file
@@ -0,0 +1,301 @@
+/* src/wire.c - 바이너리 WebSocket 프레임 인코딩/디코딩
+ * ------------------------------------------------------------
+ * 모든 값은 호스트 엔디언과 상관없이 바이트 단위로 리틀엔디언으로 씁니다.
+ * 인코더는 필요한 크기를 먼저 계산해 capacity를 넘으면 아무것도 쓰지 않습니다.
+ * Test Case: tests/wire_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/wire.h"
+
+#include <string.h>
+
+#define WIRE_STATE_SIZE (2U + 7U + 1U + 1U + VREG_COUNT * VREG_LANES + 8U + 8U)
+#define WIRE_STATS_SIZE 24U
+
+static uint8_t* put16(uint8_t *p, uint16_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+}
+
+static uint8_t* put32(uint8_t *p, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+    return p + 4;
+}
+
+static uint8_t* put64(uint8_t *p, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+    return p + 8;
+}
+
+static uint16_t get16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p) {
+    return (uint32_t)get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+/*
+ * @brief 헤더를 쓰고 payload 시작 위치를 돌려줍니다 (공간이 부족하면 NULL)
+ */
+static uint8_t* begin_frame(uint8_t *out, size_t capacity, WireType type, size_t payload) {
+    if (payload > WIRE_MAX_PAYLOAD || capacity < WIRE_HEADER_SIZE + payload) {
+        return NULL;
+    }
+    out[0] = (uint8_t)type;
+    out[1] = 0;
+    put16(out + 2, (uint16_t)payload);
+    return out + WIRE_HEADER_SIZE;
+}
+
+static uint8_t* put_line(uint8_t *p, const CacheLine *line) {
+    p = put16(p, line->tag);
+    *p++ = line->valid;
+    *p++ = line->dirty;
+    memcpy(p, line->block, CACHE_LINE_SIZE);
+    return p + CACHE_LINE_SIZE;
+}
+
+static uint8_t* put_stats(uint8_t *p, const CacheStats *stats) {
+    p = put64(p, stats->hits);
+    p = put64(p, stats->misses);
+    return put64(p, stats->writebacks);
+}
+
+/*
+ * @brief STATE 프레임 (레지스터, 플래그, 모드, 벡터 레지스터, 실행 통계)
+ * @returns 프레임 길이, 공간이 부족하면 0
+ */
+size_t wire_encode_state(uint8_t *out, size_t capacity, const StateSnapshot *state) {
+    uint8_t *p = begin_frame(out, capacity, WIRE_STATE, WIRE_STATE_SIZE);
+
+    if (!p) {
+        return 0;
+    }
+    p = put16(p, state->pc);
+    memcpy(p, &state->registers[1], 7);
+    p += 7;
+    *p++ = state->flags;
+    *p++ = (uint8_t)state->mode;
+    memcpy(p, state->vreg, VREG_COUNT * VREG_LANES);
+    p += VREG_COUNT * VREG_LANES;
+    p = put64(p, state->instructions);
+    p = put64(p, state->cycles);
+    return (size_t)(p - out);
+}
+
+/*
+ * @brief MEMORY 프레임 (memory[address]부터 count바이트)
+ * @returns 프레임 길이, 공간이 부족하면 0
+ */
+size_t wire_encode_memory(uint8_t *out, size_t capacity, const uint8_t *memory, uint16_t address, uint16_t count) {
+    uint8_t *p = begin_frame(out, capacity, WIRE_MEMORY, 4U + count);
+
+    if (!p) {
+        return 0;
+    }
+    p = put16(p, address);
+    p = put16(p, count);
+    memcpy(p, memory + address, count);
+    return (size_t)(p + count - out);
+}
+
+/*
+ * @brief CACHE 프레임 (lines[first]부터 count개와 통계)
+ * @returns 프레임 길이, 공간이 부족하면 0
+ */
+size_t wire_encode_cache(uint8_t *out, size_t capacity, const CacheLine *lines, const CacheStats *stats,
+                         uint8_t first, uint8_t count) {
+    uint8_t *p = begin_frame(out, capacity, WIRE_CACHE, 2U + WIRE_STATS_SIZE + (size_t)count * WIRE_LINE_SIZE);
+
+    if (!p) {
+        return 0;
+    }
+    *p++ = first;
+    *p++ = count;
+    p = put_stats(p, stats);
+    for (unsigned i = 0; i < count; i++) {
+        p = put_line(p, &lines[first + i]);
+    }
+    return (size_t)(p - out);
+}
+
+/*
+ * @brief STEP 프레임 (실행한 명령어 바이트와 설명)
+ * @returns 프레임 길이, 공간이 부족하면 0
+ */
+size_t wire_encode_step(uint8_t *out, size_t capacity, const char *text, const uint8_t *bytes, int byte_count) {
+    size_t length = text ? strlen(text) : 0;
+    uint8_t *p = begin_frame(out, capacity, WIRE_STEP, 3U + length);
+
+    if (!p) {
+        return 0;
+    }
+    if (!bytes || byte_count < 0) {
+        byte_count = 0;
+    }
+    *p++ = (uint8_t)(byte_count > 2 ? 2 : byte_count);
+    p[0] = byte_count > 0 ? bytes[0] : 0;
+    p[1] = byte_count > 1 ? bytes[1] : 0;
+    memcpy(p + 2, text, length);
+    return (size_t)(p + 2 + length - out);
+}
+
+/*
+ * @brief ACK/ERROR/WARNING 프레임
+ * @returns 프레임 길이, 공간이 부족하면 0
+ */
+size_t wire_encode_text(uint8_t *out, size_t capacity, WireType type, const char *text) {
+    size_t length = strlen(text);
+    uint8_t *p = begin_frame(out, capacity, type, length);
+
+    if (!p) {
+        return 0;
+    }
+    memcpy(p, text, length);
+    return WIRE_HEADER_SIZE + length;
+}
+
+/*
+ * @brief payload가 없는 프레임 (PONG)
+ * @returns 프레임 길이, 공간이 부족하면 0
+ */
+size_t wire_encode_empty(uint8_t *out, size_t capacity, WireType type) {
+    return begin_frame(out, capacity, type, 0) ? WIRE_HEADER_SIZE : 0;
+}
+
+/*
+ * @brief DELTA 프레임 (state_tracker_next 결과)
+ * @returns 프레임 길이, 공간이 부족하면 0
+ */
+size_t wire_encode_delta(uint8_t *out, size_t capacity, const StateDelta *delta, const StateSnapshot *now) {
+    size_t payload = 4U + 3U + 2U + 8U + 8U + 2U + 1U;
+    uint8_t bits = (uint8_t)((delta->keyframe ? WIRE_DELTA_KEYFRAME : 0) |
+                             (delta->flags_changed ? WIRE_DELTA_FLAGS : 0) |
+                             (delta->mode_changed ? WIRE_DELTA_MODE : 0) |
+                             (delta->cache_stats_changed ? WIRE_DELTA_CACHE_STATS : 0));
+
+    // 1) 크기 계산
+    payload += (delta->flags_changed ? 1U : 0U) + (delta->mode_changed ? 1U : 0U) +
+               (delta->cache_stats_changed ? WIRE_STATS_SIZE : 0U);
+    for (unsigned r = 1; r <= 7; r++) {
+        payload += (delta->register_mask >> r) & 1U;
+    }
+    for (unsigned v = 0; v < VREG_COUNT; v++) {
+        payload += ((delta->vreg_mask >> v) & 1U) * VREG_LANES;
+    }
+    for (unsigned i = 0; i < delta->run_count; i++) {
+        payload += 4U + delta->runs[i].length;
+    }
+    payload += (size_t)delta->line_count * (1U + WIRE_LINE_SIZE);
+
+    uint8_t *p = begin_frame(out, capacity, WIRE_DELTA, payload);
+    if (!p) {
+        return 0;
+    }
+
+    // 2) 쓰기
+    p = put32(p, delta->sequence);
+    *p++ = bits;
+    *p++ = delta->register_mask;
+    *p++ = delta->vreg_mask;
+    p = put16(p, now->pc);
+    p = put64(p, now->instructions);
+    p = put64(p, now->cycles);
+    if (delta->flags_changed) {
+        *p++ = now->flags;
+    }
+    if (delta->mode_changed) {
+        *p++ = (uint8_t)now->mode;
+    }
+    if (delta->cache_stats_changed) {
+        p = put_stats(p, &now->cache_stats);
+    }
+    for (unsigned r = 1; r <= 7; r++) {
+        if (delta->register_mask & (1U << r)) {
+            *p++ = now->registers[r];
+        }
+    }
+    for (unsigned v = 0; v < VREG_COUNT; v++) {
+        if (delta->vreg_mask & (1U << v)) {
+            memcpy(p, now->vreg[v], VREG_LANES);
+            p += VREG_LANES;
+        }
+    }
+    p = put16(p, (uint16_t)delta->run_count);
+    for (unsigned i = 0; i < delta->run_count; i++) {
+        p = put16(p, delta->runs[i].address);
+        p = put16(p, delta->runs[i].length);
+        memcpy(p, now->memory + delta->runs[i].address, delta->runs[i].length);
+        p += delta->runs[i].length;
+    }
+    *p++ = (uint8_t)delta->line_count;
+    for (unsigned i = 0; i < delta->line_count; i++) {
+        *p++ = delta->lines[i];
+        p = put_line(p, &now->lines[delta->lines[i]]);
+    }
+    return (size_t)(p - out);
+}
+
+/*
+ * @brief 클라이언트 명령 프레임을 해석합니다
+ * @param frame 받은 프레임
+ * @param length 프레임 길이
+ * @param command 결과
+ * @returns 성공 시 0, 형식 오류나 알 수 없는 명령이면 -1
+ */
+int wire_decode_command(const uint8_t *frame, size_t length, WireCommand *command) {
+    memset(command, 0, sizeof(*command));
+    if (length < WIRE_HEADER_SIZE || get16(frame + 2) != length - WIRE_HEADER_SIZE) {
+        return -1;
+    }
+
+    const uint8_t *payload = frame + WIRE_HEADER_SIZE;
+    size_t size = length - WIRE_HEADER_SIZE;
+    command->type = (WireType)frame[0];
+    switch (command->type) {
+        case WIRE_CMD_STEP:
+        case WIRE_CMD_RESET:
+        case WIRE_CMD_GET_STATE:
+        case WIRE_CMD_GET_CACHE:
+        case WIRE_CMD_RESYNC:
+        case WIRE_CMD_PING:
+        case WIRE_CMD_PAUSE:
+        case WIRE_CMD_RESUME:
+        case WIRE_CMD_STOP:
+        case WIRE_CMD_CANCEL:
+            return size == 0 ? 0 : -1;
+        case WIRE_CMD_RUN_ALL:
+            if (size == 0) {
+                return 0;
+            }
+            if (size != 8) {
+                return -1;
+            }
+            command->has_run_options = 1;
+            command->rate = get32(payload);
+            command->budget = get32(payload + 4);
+            return 0;
+        case WIRE_CMD_GET_MEMORY:
+            if (size != 4) {
+                return -1;
+            }
+            command->address = get16(payload);
+            command->count = get16(payload + 2);
+            return 0;
+        case WIRE_CMD_LOAD_PROGRAM:
+        case WIRE_CMD_ASSEMBLY:
+        case WIRE_CMD_LOAD_IMAGE:
+            command->text = (const char *)payload;
+            command->length = size;
+            return 0;
+        default:
+            return -1;
+    }
+}
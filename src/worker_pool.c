@@ -0,0 +1,262 @@
+/* src/worker_pool.c - 고정 크기 워커 풀과 결과 반환용 MPSC 큐 구현
+ * ------------------------------------------------------------
+ * 워커는 제출 대기열이 빌 때까지 작업을 꺼내 실행하고, 결과를 작업의 reply 큐에 넣은 뒤 notify를 부릅니다.
+ * 결과 큐는 소비자가 한 번에 전부 꺼내므로(exchange) 하나씩 꺼내는 스택의 ABA 문제가 없습니다.
+ * Test Case: tests/worker_pool_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/worker_pool.h"
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+uint64_t work_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000U + (uint64_t)now.tv_nsec / 1000U;
+}
+
+void mpsc_init(MpscQueue *queue) {
+    __atomic_store_n(&queue->head, NULL, __ATOMIC_RELAXED);
+}
+
+/*
+ * @brief 결과를 큐에 넣습니다 (어느 스레드에서든)
+ * @param queue 결과 큐
+ * @param item 끝난 작업
+ * @returns 없음 (void)
+ */
+void mpsc_push(MpscQueue *queue, WorkItem *item) {
+    WorkItem *head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+    do {
+        item->next = head;
+    } while (!__atomic_compare_exchange_n(&queue->head, &head, item, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+/*
+ * @brief 큐에 있는 항목을 모두 꺼냅니다
+ * @param queue 결과 큐
+ * @returns 넣은 순서대로 이은 목록 (next), 비어 있으면 NULL
+ */
+WorkItem* mpsc_take_all(MpscQueue *queue) {
+    WorkItem *stack = __atomic_exchange_n(&queue->head, NULL, __ATOMIC_ACQUIRE);
+    WorkItem *list = NULL;
+
+    while (stack) {
+        WorkItem *next = stack->next;
+        stack->next = list;
+        list = stack;
+        stack = next;
+    }
+    return list;
+}
+
+static void complete(WorkerPool *pool, WorkItem *item, WorkStatus status);
+
+/*
+ * @brief 작업에 취소를 알립니다
+ * @param item 제출한 작업
+ * @returns 없음 (void)
+ *
+ * @details
+ * 아직 워커가 꺼내지 않은 작업은 제출 대기열에서 빼고 바로 WORK_CANCELLED로 결과 큐에 넣으므로,
+ * 다른 작업이 워커를 모두 차지하고 있어도 work_item_wait()가 기다리지 않습니다.
+ * 실행 중인 작업은 다음 work_item_check()에서 멈춥니다.
+ */
+void work_item_cancel(WorkItem *item) {
+    WorkerPool *pool = item->pool;
+    int unlinked = 0;
+
+    __atomic_store_n(&item->cancelled, 1, __ATOMIC_RELEASE);
+    if (!pool) {
+        return;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    WorkItem *previous = NULL;
+    for (WorkItem *queued = pool->head; queued; previous = queued, queued = queued->next) {
+        if (queued != item) {
+            continue;
+        }
+        if (previous) {
+            previous->next = item->next;
+        } else {
+            pool->head = item->next;
+        }
+        if (pool->tail == item) {
+            pool->tail = previous;
+        }
+        item->next = NULL;
+        unlinked = 1;
+        break;
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    if (unlinked) {
+        complete(pool, item, WORK_CANCELLED);
+    }
+}
+
+WorkStatus work_item_check(const WorkItem *item) {
+    if (__atomic_load_n(&item->cancelled, __ATOMIC_ACQUIRE) ||
+        (item->pool && __atomic_load_n(&item->pool->stopping, __ATOMIC_ACQUIRE))) {
+        return WORK_CANCELLED;
+    }
+    if (item->deadline_us && work_now_us() >= item->deadline_us) {
+        return WORK_EXPIRED;
+    }
+    return WORK_DONE;
+}
+
+/*
+ * @brief 작업이 끝날 때까지 기다립니다
+ * @param item 제출한 작업
+ * @returns 작업 결과
+ *
+ * @details
+ * 결과 큐에 넣기 전에 finished를 켜므로, 기다린 쪽은 큐를 꺼내기 전에도 작업의 결과를 읽을 수 있습니다.
+ * 협력형 취소라 실행 중인 작업은 다음 work_item_check까지 걸립니다.
+ */
+WorkStatus work_item_wait(WorkItem *item) {
+    WorkerPool *pool = item->pool;
+
+    pthread_mutex_lock(&pool->mutex);
+    while (!item->finished) {
+        pthread_cond_wait(&pool->finished, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return item->status;
+}
+
+/*
+ * @brief 끝난 작업을 결과 큐에 넣고 소비자를 깨웁니다
+ */
+static void complete(WorkerPool *pool, WorkItem *item, WorkStatus status) {
+    item->status = status;
+    pthread_mutex_lock(&pool->mutex);
+    item->finished = 1;
+    pthread_cond_broadcast(&pool->finished);
+    pthread_mutex_unlock(&pool->mutex);
+    mpsc_push(item->reply, item);
+    if (pool->notify) {
+        pool->notify(pool->notify_arg);
+    }
+}
+
+/*
+ * @brief 워커 스레드: 대기열에서 작업을 꺼내 실행 (종료 중이고 대기열이 비면 끝)
+ */
+static void* worker_main(void *arg) {
+    WorkerPool *pool = arg;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->mutex);
+        while (!pool->head && !pool->stopping) {
+            pthread_cond_wait(&pool->ready, &pool->mutex);
+        }
+        WorkItem *item = pool->head;
+        if (!item) {
+            pthread_mutex_unlock(&pool->mutex);
+            return NULL;
+        }
+        pool->head = item->next;
+        if (!pool->head) {
+            pool->tail = NULL;
+        }
+        pthread_mutex_unlock(&pool->mutex);
+
+        // 기다리는 동안 취소됐거나 마감이 지났으면 실행하지 않음
+        WorkStatus status = work_item_check(item);
+        if (status == WORK_DONE) {
+            status = item->run(item);
+        }
+        complete(pool, item, status);
+    }
+}
+
+/*
+ * @brief 워커 풀을 시작합니다
+ * @param pool 워커 풀
+ * @param threads 워커 수 (0이면 온라인 코어 수)
+ * @param notify 결과를 넣은 뒤 부를 함수 (NULL 가능)
+ * @param arg notify 인자
+ * @returns 성공 시 0, 스레드를 하나도 만들지 못하면 -1
+ */
+int worker_pool_init(WorkerPool *pool, unsigned threads, void (*notify)(void *arg), void *arg) {
+    memset(pool, 0, sizeof(*pool));
+    if (threads == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cores > 0 ? (unsigned)cores : 1U;
+    }
+    if (threads > WORKER_MAX_THREADS) {
+        threads = WORKER_MAX_THREADS;
+    }
+    pool->notify = notify;
+    pool->notify_arg = arg;
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->ready, NULL);
+    pthread_cond_init(&pool->finished, NULL);
+
+    for (; pool->thread_count < threads; pool->thread_count++) {
+        if (pthread_create(&pool->threads[pool->thread_count], NULL, worker_main, pool) != 0) {
+            break;
+        }
+    }
+    if (pool->thread_count == 0) {
+        pthread_cond_destroy(&pool->finished);
+        pthread_cond_destroy(&pool->ready);
+        pthread_mutex_destroy(&pool->mutex);
+        return -1;
+    }
+    return 0;
+}
+
+int worker_pool_submit(WorkerPool *pool, WorkItem *item) {
+    item->next = NULL;
+    item->pool = pool;
+    item->cancelled = 0;
+    item->finished = 0;
+    item->status = WORK_DONE;
+
+    pthread_mutex_lock(&pool->mutex);
+    if (pool->stopping) {
+        pthread_mutex_unlock(&pool->mutex);
+        return -1;
+    }
+    if (pool->tail) {
+        pool->tail->next = item;
+    } else {
+        pool->head = item;
+    }
+    pool->tail = item;
+    pthread_cond_signal(&pool->ready);
+    pthread_mutex_unlock(&pool->mutex);
+    return 0;
+}
+
+/*
+ * @brief 워커 풀을 멈춥니다
+ * @param pool 워커 풀 (시작하지 않았으면 아무것도 하지 않음)
+ * @returns 없음 (void)
+ *
+ * @details
+ * stopping을 켜면 대기 중인 작업은 work_item_check에서, 실행 중인 작업은 다음 확인에서 WORK_CANCELLED가 됩니다.
+ * 모든 작업은 여전히 결과 큐로 돌아가므로 호출자가 꺼내 해제합니다.
+ */
+void worker_pool_shutdown(WorkerPool *pool) {
+    if (pool->thread_count == 0) {
+        return;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    __atomic_store_n(&pool->stopping, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&pool->ready);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (unsigned i = 0; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pool->thread_count = 0;
+    pthread_cond_destroy(&pool->finished);
+    pthread_cond_destroy(&pool->ready);
+    pthread_mutex_destroy(&pool->mutex);
+}
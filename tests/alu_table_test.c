@@ -0,0 +1,122 @@
+/* tests/alu_table_test.c - 테이블 ALU 백엔드 테스트
+ * ------------------------------------------------------------
+ * 1) ADD/SUB/MUL/DIV의 65,536개 입력 전부에 대해 분기 백엔드와 테이블 백엔드의
+ *    결과와 CF/ZF/SF/OF가 같은지 확인합니다.
+ * 2) 두 백엔드의 연산당 시간을 비교하는 간단한 벤치마크를 출력합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/alu_table.h"
+#include "include/cpu.h"
+#include "include/flags.h"
+#include "include/log.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_ROUNDS 64U
+
+static const char *op_names[ALU_TABLE_OPS] = { "ADD", "SUB", "MUL", "DIV" };
+
+/*
+ * @brief 현재 백엔드로 연산을 실행하고 결과와 플래그를 돌려줍니다
+ * @param op ALU opcode (0~3)
+ * @param a 첫 번째 피연산자
+ * @param b 두 번째 피연산자
+ * @param flags 플래그를 받을 포인터
+ * @returns 연산 결과
+ */
+static uint8_t run_op(unsigned op, uint8_t a, uint8_t b, uint8_t *flags) {
+    CPU_Registers *regs = get_cpu_registers();
+
+    // 이전 플래그가 섞이지 않도록 반대 값으로 채워 둠
+    set_flag(regs, FLAG_CF | FLAG_ZF | FLAG_SF | FLAG_OF, true);
+    uint8_t result = handler_table[op](a, b);
+    *flags = get_flags(regs);
+    return result;
+}
+
+/*
+ * @brief 모든 입력에 대해 두 백엔드가 같은 결과를 내는지 확인합니다
+ * @returns 불일치 개수
+ */
+static unsigned test_exhaustive_equivalence(void) {
+    unsigned mismatches = 0;
+
+    for (unsigned op = 0; op < ALU_TABLE_OPS; op++) {
+        for (unsigned index = 0; index < ALU_TABLE_ENTRIES; index++) {
+            uint8_t a = (uint8_t)(index >> 8);
+            uint8_t b = (uint8_t)index;
+            uint8_t branch_flags, table_flags;
+
+            alu_set_backend(ALU_BACKEND_BRANCH);
+            uint8_t branch_result = run_op(op, a, b, &branch_flags);
+            alu_set_backend(ALU_BACKEND_TABLE);
+            uint8_t table_result = run_op(op, a, b, &table_flags);
+
+            if (branch_result != table_result || branch_flags != table_flags) {
+                if (mismatches < 10) {
+                    printf("❌ %s %d, %d: 분기=%d/0x%X, 테이블=%d/0x%X\n", op_names[op], a, b,
+                           branch_result, branch_flags, table_result, table_flags);
+                }
+                mismatches++;
+            }
+        }
+        printf("%s %s: 65536개 입력 검사 완료\n", mismatches ? "❌" : "✅", op_names[op]);
+    }
+
+    alu_set_backend(ALU_BACKEND_BRANCH);
+    return mismatches;
+}
+
+/*
+ * @brief 현재 백엔드의 연산당 평균 시간을 측정합니다 (플래그 읽기 포함)
+ * @param op ALU opcode (0~3)
+ * @returns 연산당 나노초
+ */
+static double bench_op(unsigned op) {
+    CPU_Registers *regs = get_cpu_registers();
+    volatile unsigned sink = 0;
+
+    clock_t start = clock();
+    for (unsigned round = 0; round < BENCH_ROUNDS; round++) {
+        for (unsigned index = 0; index < ALU_TABLE_ENTRIES; index++) {
+            sink += handler_table[op]((uint8_t)(index >> 8), (uint8_t)index);
+            sink += get_flags(regs);
+        }
+    }
+    clock_t elapsed = clock() - start;
+
+    (void)sink;
+    return (double)elapsed / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_ROUNDS * ALU_TABLE_ENTRIES);
+}
+
+/*
+ * @brief 두 백엔드의 연산 시간을 비교해 출력합니다
+ * @returns 없음 (void)
+ */
+static void benchmark_backends(void) {
+    printf("\n=== 벤치마크 (연산 + 플래그 읽기, ns/op) ===\n");
+    for (unsigned op = 0; op < ALU_TABLE_OPS; op++) {
+        alu_set_backend(ALU_BACKEND_BRANCH);
+        double branch_ns = bench_op(op);
+        alu_set_backend(ALU_BACKEND_TABLE);
+        double table_ns = bench_op(op);
+        printf("%s: 분기 %.2f, 테이블 %.2f (%.2fx)\n", op_names[op], branch_ns, table_ns,
+               table_ns > 0 ? branch_ns / table_ns : 0.0);
+    }
+    alu_set_backend(ALU_BACKEND_BRANCH);
+}
+
+int main(void) {
+    printf("=== 테이블 ALU 테스트 시작 ===\n\n");
+
+    cpu_init();
+    cpu_log_enabled = 0;
+
+    unsigned mismatches = test_exhaustive_equivalence();
+    benchmark_backends();
+
+    printf("\n=== 테스트 %s (불일치 %u개) ===\n", mismatches ? "실패" : "성공", mismatches);
+    return mismatches ? 1 : 0;
+}
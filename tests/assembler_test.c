@@ -0,0 +1,363 @@
+/* tests/assembler_test.c - 2패스 어셈블러 테스트
+ * ------------------------------------------------------------
+ * 1) 라벨 전방 참조, .org/.byte/.equ, 주석, 대소문자를 섞은 소스가 기대한 이미지로 조립되는지 확인합니다.
+ * 2) 잘못된 소스의 오류가 올바른 줄/열로 보고되는지 확인합니다.
+ * 3) 생성한 수 MB 소스로 처리량(MB/s)을 측정합니다.
+ * 4) 편집 세션: 줄 diff 결과가 전체를 다시 어셈블한 이미지와 같고, 바뀐 줄과 그 심볼 사용자만
+ *    다시 인코딩하는지 확인하고, 프로그램 크기와 무관한 편집 지연을 측정합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/assembler.h"
+#include "include/asm_session.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_LINES 400000U
+#define SESSION_MAX_LINES   64U
+#define SESSION_RANDOM_EDITS 2000U
+#define EDIT_BENCH_LINES    20000U
+#define EDIT_BENCH_EDITS    1000U
+
+/*
+ * @brief 기대한 바이트열과 비교합니다
+ * @returns 실패 수
+ */
+static unsigned expect_bytes(const char *name, const uint8_t *actual, size_t actual_size,
+                             const uint8_t *expected, size_t expected_size) {
+    if (actual_size != expected_size || memcmp(actual, expected, expected_size) != 0) {
+        printf("❌ %s: 크기 %zu (기대 %zu)\n", name, actual_size, expected_size);
+        for (size_t i = 0; i < actual_size; i++) printf(" %02X", actual[i]);
+        printf("\n");
+        return 1;
+    }
+    return 0;
+}
+
+static unsigned test_program(void) {
+    static const char source[] =
+        "; 라벨과 지시어\n"
+        ".equ COUNT, 3\n"
+        ".equ BASE, 0x40\n"
+        "start:  mov r1, COUNT        # 주석\n"
+        "        MOV R2, end - start\n"
+        "loop:   ADD R1, R2\n"
+        "        store r7, [BASE + 2]\n"
+        "        LOAD R3, [R1]\n"
+        "        MARK\n"
+        "        .org 0x20\n"
+        "table:  .byte 1, -1, 0b101, loop, end\r\n"
+        "end:\n";
+    static const uint8_t expected[] = {
+        0x41, 0x03, 0x42, 0x25, 0x01, 0x2F, 0x67, 0x42, 0x5B, 0x01, 0xF0, 0x00,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0x01, 0xFF, 0x05, 0x04, 0x25,
+    };
+    uint8_t output[256];
+    AsmResult result;
+
+    if (asm_assemble(source, strlen(source), output, sizeof(output), &result) != 0) {
+        asm_print_errors(&result);
+        return 1;
+    }
+    unsigned failures = expect_bytes("프로그램", output, result.size, expected, sizeof(expected));
+    if (result.instructions != 6 || result.data_bytes != 5 || result.symbols != 6 || result.lines != 12) {
+        printf("❌ 통계: 명령어 %u, 데이터 %u, 심볼 %u, 줄 %u\n", result.instructions, result.data_bytes,
+               result.symbols, result.lines);
+        failures++;
+    }
+    printf("프로그램 조립: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_errors(void) {
+    static const char source[] =
+        "MOV R1, 5\n"
+        "  FOO R1, R2\n"
+        "x: ADD R1, R2\n"
+        "x: MOV R2, 300\n"
+        "LOAD R1, [missing]\n"
+        ".org later\n"
+        "later: .byte 256\n";
+    static const struct { unsigned line, column; } expected[] = {
+        { 2, 3 }, { 4, 1 }, { 6, 6 }, { 4, 4 }, { 5, 11 }, { 7, 14 },
+    };
+    uint8_t output[256];
+    AsmResult result;
+    unsigned failures = 0;
+
+    if (asm_assemble(source, strlen(source), output, sizeof(output), &result) == 0) {
+        printf("❌ 오류를 찾지 못함\n");
+        return 1;
+    }
+    asm_print_errors(&result);
+    if (result.error_count != sizeof(expected) / sizeof(expected[0])) {
+        printf("❌ 오류 수 %u (기대 %zu)\n", result.error_count, sizeof(expected) / sizeof(expected[0]));
+        return 1;
+    }
+    for (unsigned i = 0; i < result.error_count; i++) {
+        if (result.errors[i].line != expected[i].line || result.errors[i].column != expected[i].column) {
+            printf("❌ 오류 %u 위치 %u:%u (기대 %u:%u)\n", i, result.errors[i].line, result.errors[i].column,
+                   expected[i].line, expected[i].column);
+            failures++;
+        }
+    }
+    printf("오류 위치: 실패 %u개\n", failures);
+    return failures;
+}
+
+/*
+ * @brief 생성한 큰 소스의 조립 속도를 측정합니다
+ * @returns 실패 수
+ */
+static unsigned benchmark(void) {
+    size_t capacity = (size_t)BENCH_LINES * 48;
+    char *source = malloc(capacity);
+    uint8_t *output = malloc((size_t)BENCH_LINES * 2);
+    size_t length = 0;
+    AsmResult result;
+
+    if (!source || !output) {
+        free(source);
+        free(output);
+        return 1;
+    }
+
+    length += (size_t)sprintf(source + length, ".equ LIMIT, 200\n");
+    for (unsigned i = 0; i < BENCH_LINES; i += 4) {
+        length += (size_t)sprintf(source + length,
+                                  "L%u: MOV R%u, %u ; 반복 %u\n"
+                                  "    ADD R1, R2\n"
+                                  "    STORE R7, [LIMIT + %u]\n"
+                                  "    .byte L%u - L%u, 0x%02X\n",
+                                  i, 1 + i % 7, i % 256, i, i % 50, i + 4, i, i % 256);
+    }
+    length += (size_t)sprintf(source + length, "L%u:\n", BENCH_LINES);
+
+    clock_t start = clock();
+    int status = asm_assemble(source, length, output, (size_t)BENCH_LINES * 2, &result);
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    if (status != 0) {
+        asm_print_errors(&result);
+    }
+    printf("처리량: %.1f MB 소스, %u줄, 심볼 %u개 -> %.3f초 (%.1f MB/s)\n", (double)length / 1e6,
+           result.lines, result.symbols, seconds, seconds > 0 ? (double)length / 1e6 / seconds : 0.0);
+
+    free(source);
+    free(output);
+    return status != 0;
+}
+
+/* ---------------- 편집 세션 ---------------- */
+
+typedef struct {
+    char text[SESSION_MAX_LINES][32];
+    size_t count;
+} LineBuffer;
+
+static size_t join_lines(const LineBuffer *buffer, size_t first, size_t count, char *out) {
+    size_t length = 0;
+    for (size_t i = first; i < first + count; i++) {
+        length += (size_t)sprintf(out + length, "%s%s", i > first ? "\n" : "", buffer->text[i]);
+    }
+    return length;
+}
+
+/*
+ * @brief 줄 버퍼와 세션에 같은 편집을 적용합니다 (inserted줄은 lines에서)
+ * @returns asm_session_edit 결과
+ */
+static int apply_edit(AsmSession *session, LineBuffer *buffer, size_t first, size_t delete_count,
+                      const char *const *lines, size_t insert_count, AsmEdit *edit) {
+    char text[SESSION_MAX_LINES * 32];
+    LineBuffer inserted;
+
+    for (size_t i = 0; i < insert_count; i++) {
+        snprintf(inserted.text[i], sizeof(inserted.text[i]), "%s", lines[i]);
+    }
+    size_t length = join_lines(&inserted, 0, insert_count, text);
+
+    memmove(buffer->text[first + insert_count], buffer->text[first + delete_count],
+            (buffer->count - first - delete_count) * sizeof(buffer->text[0]));
+    memcpy(buffer->text[first], inserted.text, insert_count * sizeof(buffer->text[0]));
+    buffer->count = buffer->count - delete_count + insert_count;
+
+    return asm_session_edit(session, first, delete_count, insert_count ? text : NULL, length, edit);
+}
+
+/*
+ * @brief 세션 이미지를 전체 어셈블 결과와 비교합니다 (오류 유무도 같아야 함)
+ * @returns 실패 수
+ */
+static unsigned compare_with_batch(const char *name, const AsmSession *session, const LineBuffer *buffer) {
+    char source[SESSION_MAX_LINES * 32];
+    uint8_t expected[256];
+    AsmResult result;
+    size_t session_size;
+    const uint8_t *image = asm_session_image(session, &session_size);
+    size_t length = join_lines(buffer, 0, buffer->count, source);
+    int batch_failed = asm_assemble(source, length, expected, sizeof(expected), &result) != 0;
+    int session_failed = session->error_lines != 0;
+
+    if (batch_failed != session_failed) {
+        printf("❌ %s: 오류 여부가 다름 (전체 %u개, 세션 %u줄)\n%s\n", name, result.error_count,
+               session->error_lines, source);
+        return 1;
+    }
+    if (batch_failed) {
+        return 0;
+    }
+    return expect_bytes(name, image, session_size, expected, result.size);
+}
+
+static unsigned test_session(void) {
+    static const char *const program[] = {
+        ".equ COUNT, 3",
+        "start: MOV R1, COUNT",
+        "       MOV R2, end - start",
+        "loop:  ADD R1, R2",
+        "       STORE R7, [data]",
+        "       MARK",
+        "data:  .byte 1, 2, loop",
+        "end:",
+    };
+    static const char *const replacement[] = { "start: MOV R1, 7" };
+    static const char *const inserted[] = { "       SUB R1, R2" };
+    static const char *const end_label[] = { "end:" };
+    AsmSession session;
+    LineBuffer buffer = { .count = 0 };
+    AsmEdit edit;
+    unsigned failures = 0;
+
+    if (asm_session_init(&session, 256) != 0) {
+        return 1;
+    }
+    apply_edit(&session, &buffer, 0, 0, program, sizeof(program) / sizeof(program[0]), &edit);
+    failures += compare_with_batch("세션 적재", &session, &buffer);
+
+    // 크기가 같은 줄 교체: 그 줄만 다시 인코딩
+    apply_edit(&session, &buffer, 1, 1, replacement, 1, &edit);
+    failures += compare_with_batch("줄 교체", &session, &buffer);
+    if (edit.assembled != 1 || edit.relocated != 0 || edit.dirty_start != 0 || edit.dirty_end != 2) {
+        printf("❌ 줄 교체: 다시 어셈블 %u, 이동 %u, 범위 [%zu, %zu)\n", edit.assembled, edit.relocated,
+               edit.dirty_start, edit.dirty_end);
+        failures++;
+    }
+
+    // 삽입: 뒤 줄은 옮기기만 하고, 옮겨진 라벨(loop, data, end)을 읽는 줄만 다시 인코딩
+    // (STORE는 먼저 옮겨진 뒤 data가 옮겨지면서 다시 인코딩되므로 양쪽에 모두 셈)
+    apply_edit(&session, &buffer, 3, 0, inserted, 1, &edit);
+    failures += compare_with_batch("줄 삽입", &session, &buffer);
+    if (edit.assembled != 4 || edit.relocated != 4) {
+        printf("❌ 줄 삽입: 다시 어셈블 %u (기대 4), 이동 %u (기대 4)\n", edit.assembled, edit.relocated);
+        failures++;
+    }
+
+    // 라벨 삭제 → 사용하는 줄에 오류, 되살리면 사라짐
+    apply_edit(&session, &buffer, buffer.count - 1, 1, NULL, 0, &edit);
+    AsmError error;
+    if (edit.error_lines != 1 || asm_session_errors(&session, &error, 1) != 1 || error.line != 3) {
+        printf("❌ 라벨 삭제: 오류 줄 %u\n", edit.error_lines);
+        failures++;
+    }
+    apply_edit(&session, &buffer, buffer.count, 0, end_label, 1, &edit);
+    failures += compare_with_batch("라벨 복구", &session, &buffer);
+
+    // 무작위 편집을 전체 어셈블 결과와 대조 (중복/미정의 라벨 포함)
+    static const char *const pool[] = {
+        "ADD R1, R2", "A: MOV R3, 9", "B: .byte 7, A", "MOV R2, B", "C: SUB R1, R2",
+        "STORE R7, [C + 1]", ".equ K, 4", "MOV R1, K", "", "; 주석", "MARK", "D:",
+        "LOAD R3, [D]", ".byte D - A",
+    };
+    size_t pool_size = sizeof(pool) / sizeof(pool[0]);
+    unsigned seed = 12345;
+    unsigned mismatches = 0;
+    for (unsigned i = 0; i < SESSION_RANDOM_EDITS && mismatches < 3; i++) {
+        const char *lines[3];
+        seed = seed * 1103515245u + 12345u;
+        size_t first = (seed >> 8) % (buffer.count + 1);
+        size_t delete_count = first < buffer.count ? (seed >> 16) % 3 : 0;
+        size_t insert_count = (seed >> 20) % 3;
+        if (first + delete_count > buffer.count) delete_count = buffer.count - first;
+        if (buffer.count - delete_count + insert_count > 40) insert_count = 0;
+        for (size_t j = 0; j < insert_count; j++) {
+            seed = seed * 1103515245u + 12345u;
+            lines[j] = pool[(seed >> 8) % pool_size];
+        }
+        if (apply_edit(&session, &buffer, first, delete_count, lines, insert_count, &edit) != 0) {
+            printf("❌ 무작위 편집 %u 적용 실패\n", i);
+            mismatches++;
+            continue;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "무작위 편집 %u", i);
+        mismatches += compare_with_batch(name, &session, &buffer);
+    }
+    failures += mismatches;
+
+    asm_session_free(&session);
+    printf("편집 세션: 실패 %u개\n", failures);
+    return failures;
+}
+
+/*
+ * @brief 큰 프로그램에서 한 줄 편집의 지연이 전체 적재보다 훨씬 작은지 측정합니다
+ * @returns 실패 수
+ */
+static unsigned benchmark_session(void) {
+    size_t capacity = (size_t)EDIT_BENCH_LINES * 24;
+    char *source = malloc(capacity);
+    size_t length = 0;
+    AsmSession session;
+    AsmEdit edit;
+    unsigned failures = 0;
+
+    if (!source || asm_session_init(&session, (size_t)EDIT_BENCH_LINES * 2) != 0) {
+        free(source);
+        return 1;
+    }
+    for (unsigned i = 0; i < EDIT_BENCH_LINES; i++) {
+        length += (size_t)sprintf(source + length, i % 4 == 0 ? "L%u: MOV R1, %u\n" : "ADD R1, R2 ; %u %u\n",
+                                  i, i % 200);
+    }
+    length--;   // 마지막 줄바꿈 제외
+
+    clock_t start = clock();
+    asm_session_load(&session, source, length, &edit);
+    double load_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // 가운데 라벨 줄의 값만 바꾸는 편집 (크기 동일)
+    unsigned worst = 0;
+    start = clock();
+    for (unsigned i = 0; i < EDIT_BENCH_EDITS; i++) {
+        char line[32];
+        int line_length = snprintf(line, sizeof(line), "L%u: MOV R1, %u", EDIT_BENCH_LINES / 2, i % 200);
+        asm_session_edit(&session, EDIT_BENCH_LINES / 2, 1, line, (size_t)line_length, &edit);
+        if (edit.assembled > worst) worst = edit.assembled;
+    }
+    double edit_seconds = (double)(clock() - start) / CLOCKS_PER_SEC / EDIT_BENCH_EDITS;
+
+    if (worst != 1 || session.error_lines != 0) {
+        printf("❌ 편집당 다시 어셈블 최대 %u줄 (기대 1), 오류 줄 %u\n", worst, session.error_lines);
+        failures++;
+    }
+    printf("편집 지연: %u줄 적재 %.3f초, 한 줄 편집 평균 %.2fus\n", EDIT_BENCH_LINES, load_seconds,
+           edit_seconds * 1e6);
+
+    asm_session_free(&session);
+    free(source);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 어셈블러 테스트 시작 ===\n\n");
+
+    unsigned failures = test_program() + test_errors() + benchmark() + test_session() + benchmark_session();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,187 @@
+/* tests/datapath_test.c - 8/16/32비트 데이터패스 테스트
+ * ------------------------------------------------------------
+ * 1) dp8_alu가 8비트 ALU(alu_result + flags.c)와 ADD/SUB/MUL/DIV의 65,536개 입력 전부에서 같은지 확인합니다.
+ * 2) 임의 워드로 만든 프로그램을 dp8과 cpu_step()으로 실행해 레지스터, 플래그, 벡터 레지스터,
+ *    메모리, PC, 명령어 수, 사이클이 같은지 확인합니다.
+ * 3) dp16/dp32에서 넓은 즉시값, 워드 LOAD/STORE, 폭별 오버플로우 플래그를 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/datapath.h"
+#include "include/alu.h"
+#include "include/cpu.h"
+#include "include/flags.h"
+#include "include/log.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define RANDOM_PROGRAMS 2000U
+
+static const char *op_names[4] = { "ADD", "SUB", "MUL", "DIV" };
+
+/*
+ * @brief dp8_alu와 8비트 ALU를 모든 입력에서 비교합니다
+ * @returns 불일치 개수
+ */
+static unsigned test_alu8(void) {
+    CPU_Registers regs;
+    unsigned mismatches = 0;
+
+    reset_registers(&regs);
+    for (unsigned op = 0; op < 4; op++) {
+        for (unsigned index = 0; index < 65536U; index++) {
+            uint8_t a = (uint8_t)(index >> 8);
+            uint8_t b = (uint8_t)index;
+            uint8_t dp_flags;
+            uint8_t dp_result = dp8_alu(op, a, b, &dp_flags);
+            uint8_t result = alu_result((uint8_t)op, a, b);
+
+            flags_record(&regs, (uint8_t)(FLAG_OP_ADD + op), a, b, result);
+            if (dp_result != result || dp_flags != get_flags(&regs)) {
+                if (mismatches < 10) {
+                    printf("❌ %s %d, %d: dp8=%d/0x%X, ALU=%d/0x%X\n", op_names[op], a, b, dp_result, dp_flags,
+                           result, get_flags(&regs));
+                }
+                mismatches++;
+            }
+        }
+    }
+    printf("dp8 ALU 전체 입력: 불일치 %u개\n", mismatches);
+    return mismatches;
+}
+
+// 재현 가능한 xorshift32
+static uint32_t random_state = 0x9E3779B9U;
+
+static uint32_t next_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+/*
+ * @brief dp8 머신과 8비트 코어 컨텍스트의 상태를 비교합니다
+ * @returns 같으면 1, 다르면 0
+ */
+static int same_state(DP_Machine8 *machine, CPU_Context *ctx) {
+    cache_flush(&machine->memory.cache, machine->memory.data, MEMORY_SIZE);
+    cache_flush(&ctx->memory.cache, ctx->memory.data, MEMORY_SIZE);
+
+    for (uint8_t r = 1; r <= 7; r++) {
+        if (machine->regs.r[r] != get_register(&ctx->regs, r)) {
+            return 0;
+        }
+    }
+    return machine->regs.pc == ctx->regs.pc && machine->regs.flags == get_flags(&ctx->regs) &&
+           memcmp(machine->regs.v, ctx->regs.vreg, sizeof(machine->regs.v)) == 0 &&
+           memcmp(machine->memory.data, ctx->memory.data, MEMORY_SIZE) == 0 &&
+           machine->instructions == ctx->stats.instructions && machine->cycles == ctx->stats.cycles;
+}
+
+/*
+ * @brief 임의 프로그램을 dp8과 cpu_step()으로 실행해 비교합니다
+ * @returns 실패 개수
+ */
+static unsigned test_dp8_matches_cpu(void) {
+    static DP_Machine8 machine;
+    static CPU_Context ctx;
+    unsigned failures = 0;
+
+    for (unsigned n = 0; n < RANDOM_PROGRAMS; n++) {
+        uint8_t program[MEMORY_SIZE] = { 0 };
+        size_t size = 2U * (1U + next_random() % (MEMORY_SIZE / 2U - 1U));
+
+        for (size_t i = 0; i < size; i++) {
+            program[i] = (uint8_t)next_random();
+        }
+
+        dp8_init(&machine);
+        dp8_load_program(&machine, program, size);
+        dp8_run(&machine, MEMORY_SIZE);
+
+        cpu_context_init(&ctx);
+        CPU_Context *previous = cpu_set_context(&ctx);
+        cpu_load_program(program, size);
+        for (unsigned steps = 0; steps < MEMORY_SIZE && ctx.regs.pc < MEMORY_SIZE - 1; steps++) {
+            if ((memory_peek(&ctx.memory, ctx.regs.pc) | memory_peek(&ctx.memory, ctx.regs.pc + 1)) == 0) {
+                break;
+            }
+            cpu_step();
+        }
+        cpu_set_context(previous);
+
+        if (!same_state(&machine, &ctx)) {
+            if (failures < 10) {
+                printf("❌ 임의 프로그램 #%u (%zu바이트): dp8과 cpu_step 불일치 (PC %d/%d)\n", n, size,
+                       machine.regs.pc, ctx.regs.pc);
+            }
+            failures++;
+        }
+    }
+    printf("임의 프로그램 %u개 (dp8 vs cpu_step): 실패 %u개\n", RANDOM_PROGRAMS, failures);
+    return failures;
+}
+
+/*
+ * @brief 넓은 변형에서 즉시값, 워드 메모리 접근, 폭별 플래그를 확인합니다
+ * @returns 실패 개수
+ */
+static unsigned test_wide(void) {
+    static DP_Machine16 m16;
+    static DP_Machine32 m32;
+    uint8_t program[MEMORY_SIZE] = { 0 };
+    size_t size = 0;
+    unsigned failures = 0;
+
+    // R1 = 30000, R2 = 3000, R7 = R1 + R2 (16비트 부호 오버플로우), [200] ← R7, R3 ← [200]
+    size += dp16_encode_mov(1, 30000, program + size);
+    size += dp16_encode_mov(2, 3000, program + size);
+    size += dp16_encode_alu(0, 1, 2, program + size);
+    size += dp16_encode_mem(OPCODE_STORE, 7, 0, 200, program + size);
+    size += dp16_encode_mem(OPCODE_LOAD, 3, 0, 200, program + size);
+
+    dp16_init(&m16);
+    dp16_load_program(&m16, program, size);
+    dp16_run(&m16, 0);
+    cache_flush(&m16.memory.cache, m16.memory.data, MEMORY_SIZE);
+    if (m16.instructions != 5 || m16.regs.r[7] != 33000 || m16.regs.r[3] != 33000 ||
+        m16.memory.data[200] != (33000 >> 8) || !(m16.regs.flags & FLAG_OF) || (m16.regs.flags & FLAG_CF)) {
+        printf("❌ dp16: R7=%u, R3=%u, 플래그 0x%X\n", m16.regs.r[7], m16.regs.r[3], m16.regs.flags);
+        failures++;
+    }
+
+    // R1 = 0x80000000, R2 = 0xFFFFFFFF(-1), R7 = MIN / -1 (OF), 간접 STORE [R4]
+    memset(program, 0, sizeof(program));
+    size = 0;
+    size += dp32_encode_mov(1, 0x80000000U, program + size);
+    size += dp32_encode_mov(2, 0xFFFFFFFFU, program + size);
+    size += dp32_encode_alu(3, 1, 2, program + size);
+    size += dp32_encode_mov(4, 220, program + size);
+    size += dp32_encode_mem(OPCODE_STORE, 7, 1, 4, program + size);
+
+    dp32_init(&m32);
+    dp32_load_program(&m32, program, size);
+    dp32_run(&m32, 0);
+    cache_flush(&m32.memory.cache, m32.memory.data, MEMORY_SIZE);
+    if (m32.instructions != 5 || m32.regs.r[7] != 0x80000000U || !(m32.regs.flags & FLAG_OF) ||
+        m32.memory.data[220] != 0x80 || m32.memory.data[223] != 0x00) {
+        printf("❌ dp32: R7=0x%X, 플래그 0x%X\n", m32.regs.r[7], m32.regs.flags);
+        failures++;
+    }
+
+    printf("dp16/dp32: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 데이터패스 테스트 시작 ===\n\n");
+    cpu_init();
+    cpu_log_enabled = 0;
+
+    unsigned failures = test_alu8() + test_dp8_matches_cpu() + test_wide();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,195 @@
+/* tests/fastforward_test.c - 기능 모드 fast-forward 테스트
+ * ------------------------------------------------------------
+ * 1) N(1~전체)개 명령어를 fast-forward한 상태(레지스터, 플래그, 벡터 레지스터, 메모리, PC, 명령어 수)가
+ *    상세 모드로 N번 cpu_step()한 상태와 같은지 확인합니다.
+ * 2) 상세 모드로 돌아온 뒤 캐시가 문서대로인지 확인합니다:
+ *    warmup_accesses가 0이면 모든 라인이 비어 있고(cold), 기능 모드의 접근을 모두 재생하면
+ *    상세 모드로 실행한 캐시와 라인(유효/태그/dirty/데이터)이 같으며, 어느 경우든 통계는 0입니다.
+ * 3) PC, MARK, 빈 명령어 멈춤 조건을 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/fastforward.h"
+#include "include/assembler.h"
+#include "include/cache.h"
+#include "include/cpu.h"
+#include "include/flags.h"
+#include "include/log.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// 직접/간접 LOAD·STORE, 기존 6비트 포맷, 패킹 SIMD가 섞인 직선 프로그램 (MARK는 끝 근처 하나)
+static const char program_source[] =
+    "MOV R1, 180\n MOV R2, 7\n STORE R2, [R1]\n ADD R1, R2\n STORE R7, [190]\n"
+    "MUL 5, 6\n LOAD R3, [75]\n SUB R3, R2\n STORE R7, [R1]\n MOV 50, 9\n"
+    "VLOAD V0, [180]\n VLOAD4 V1, [72]\n PADDS V0, V1\n VSTORE V0, [200]\n LOAD R4, [201]\n"
+    "DIV R4, R2\n MOV R5, 240\n STORE R7, [R5]\n LOAD R6, [50]\n MUL R6, R6\n"
+    "PMUL4 V1, V0\n VSTORE4 V1, [244]\n LOAD R1, [246]\n ADD R1, R6\n MARK\n"
+    "MOV R2, 1\n";
+
+#define PROGRAM_INSTRUCTIONS 26U
+#define MARK_INDEX 24U
+
+static uint8_t program[MEMORY_SIZE];
+
+/*
+ * @brief ctx를 초기화하고 프로그램을 적재한 뒤 현재 컨텍스트로 만듭니다
+ */
+static void load(CPU_Context *ctx) {
+    cpu_context_init(ctx);
+    cpu_set_context(ctx);
+    cpu_load_program(program, sizeof(program));
+}
+
+/*
+ * @brief 두 컨텍스트의 아키텍처 상태를 비교합니다 (캐시는 반영한 뒤 data[] 비교)
+ * @returns 같으면 1, 다르면 0
+ */
+static int same_architectural_state(CPU_Context *a, CPU_Context *b) {
+    cache_flush(&a->memory.cache, a->memory.data, MEMORY_SIZE);
+    cache_flush(&b->memory.cache, b->memory.data, MEMORY_SIZE);
+
+    for (uint8_t r = 1; r <= 7; r++) {
+        if (get_register(&a->regs, r) != get_register(&b->regs, r)) {
+            return 0;
+        }
+    }
+    return a->regs.pc == b->regs.pc && get_flags(&a->regs) == get_flags(&b->regs) &&
+           memcmp(a->regs.vreg, b->regs.vreg, sizeof(a->regs.vreg)) == 0 &&
+           memcmp(a->memory.data, b->memory.data, MEMORY_SIZE) == 0 &&
+           a->stats.instructions == b->stats.instructions;
+}
+
+static int same_cache_lines(const Cache *a, const Cache *b) {
+    for (unsigned i = 0; i < CACHE_NUM_LINES; i++) {
+        const CacheLine *x = &a->lines[i];
+        const CacheLine *y = &b->lines[i];
+        if (x->valid != y->valid || (x->valid && (x->tag != y->tag || x->dirty != y->dirty ||
+                                                 memcmp(x->block, y->block, CACHE_LINE_SIZE) != 0))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int cache_is_cold(const Cache *cache) {
+    for (unsigned i = 0; i < CACHE_NUM_LINES; i++) {
+        if (cache->lines[i].valid) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int stats_are_zero(const CacheStats *stats) {
+    return stats->hits == 0 && stats->misses == 0 && stats->writebacks == 0;
+}
+
+/*
+ * @brief 모든 N에 대해 fast-forward와 상세 실행의 상태, 전환 후 캐시를 비교합니다
+ * @returns 실패 개수
+ */
+static unsigned test_equivalence(void) {
+    static CPU_Context fast, detailed;
+    unsigned failures = 0;
+
+    // max_steps 0은 제한 없음이므로 1부터
+    for (unsigned n = 1; n <= PROGRAM_INSTRUCTIONS; n++) {
+        FastForwardConfig config;
+        ff_default_config(&config);
+        config.max_steps = n;
+        config.stop_at_marker = 0;
+
+        for (unsigned warm = 0; warm < 2; warm++) {
+            // 기능 모드 접근(명령어당 fetch 2회 + 데이터 최대 8회)을 모두 담는 워밍 크기
+            config.warmup_accesses = warm ? MEMORY_ACCESS_LOG_SIZE : 0;
+
+            load(&detailed);
+            for (unsigned i = 0; i < n; i++) {
+                cpu_step();
+            }
+            Cache detailed_cache = detailed.memory.cache;
+
+            load(&fast);
+            FastForwardResult result = cpu_fast_forward(&config);
+            Cache fast_cache = fast.memory.cache;
+
+            if (result.steps != n || (n < PROGRAM_INSTRUCTIONS && result.reason != FF_STOP_STEPS) ||
+                cpu_get_mode() != CPU_MODE_DETAILED || !stats_are_zero(&fast_cache.stats) ||
+                !same_architectural_state(&fast, &detailed)) {
+                printf("❌ N=%u (워밍 %u): 상태 불일치 (단계 %llu, 이유 %s)\n", n, config.warmup_accesses,
+                       (unsigned long long)result.steps, ff_stop_reason_name(result.reason));
+                failures++;
+            }
+            if (warm ? !same_cache_lines(&fast_cache, &detailed_cache) : !cache_is_cold(&fast_cache)) {
+                printf("❌ N=%u: 전환 후 캐시가 %s\n", n, warm ? "상세 실행과 다름" : "비어 있지 않음");
+                failures++;
+            }
+        }
+    }
+    cpu_set_context(NULL);
+
+    printf("N=1~%u, cold/warm 전환: 실패 %u개\n", PROGRAM_INSTRUCTIONS, failures);
+    return failures;
+}
+
+/*
+ * @brief PC, MARK, 빈 명령어에서 멈추는지 확인합니다
+ * @returns 실패 개수
+ */
+static unsigned test_stop_conditions(void) {
+    static CPU_Context ctx;
+    FastForwardConfig config;
+    FastForwardResult result;
+    unsigned failures = 0;
+
+    load(&ctx);
+    ff_default_config(&config);
+    config.stop_pc = 10;
+    result = cpu_fast_forward(&config);
+    if (result.reason != FF_STOP_PC || result.steps != 5 || ctx.regs.pc != 10) {
+        printf("❌ PC 멈춤: 이유 %s, 단계 %llu\n", ff_stop_reason_name(result.reason), (unsigned long long)result.steps);
+        failures++;
+    }
+
+    // 이어서 실행하면 MARK 직후에 멈춤
+    ff_default_config(&config);
+    result = cpu_fast_forward(&config);
+    if (result.reason != FF_STOP_MARKER || ctx.stats.instructions != MARK_INDEX + 1) {
+        printf("❌ MARK 멈춤: 이유 %s, 명령어 %llu\n", ff_stop_reason_name(result.reason),
+               (unsigned long long)ctx.stats.instructions);
+        failures++;
+    }
+
+    result = cpu_fast_forward(&config);
+    if (result.reason != FF_STOP_HALT || ctx.stats.instructions != PROGRAM_INSTRUCTIONS) {
+        printf("❌ 빈 명령어 멈춤: 이유 %s, 명령어 %llu\n", ff_stop_reason_name(result.reason),
+               (unsigned long long)ctx.stats.instructions);
+        failures++;
+    }
+    cpu_set_context(NULL);
+
+    printf("멈춤 조건: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    AsmResult assembled;
+
+    printf("=== fast-forward 테스트 시작 ===\n\n");
+    cpu_init();
+    cpu_log_enabled = 0;
+
+    if (asm_assemble(program_source, strlen(program_source), program, sizeof(program), &assembled) != 0 ||
+        assembled.instructions != PROGRAM_INSTRUCTIONS) {
+        printf("❌ 프로그램 어셈블 실패 (명령어 %u개)\n", assembled.instructions);
+        asm_print_errors(&assembled);
+        return 1;
+    }
+
+    unsigned failures = test_equivalence() + test_stop_conditions();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+/* tests/flags_test.c - 지연 평가 플래그 테스트
+ * ------------------------------------------------------------
+ * 1) 경계값 표의 연산마다 alu_result()의 결과를 flags_record()로 기록하고,
+ *    get_flags()가 기대한 CF/ZF/SF/OF를 돌려주는지 확인합니다.
+ * 2) 기록된 연산이 남아 있을 때 set_flag()/set_carry_flag()가 그 시점의 플래그를 계산해
+ *    확정하고(FLAG_OP_NONE), 나중에 피연산자 필드가 바뀌어도 값이 그대로인지 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/flags.h"
+#include "include/register.h"
+#include "include/alu.h"
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    const char *name;
+    uint8_t op;         // FlagOp
+    uint8_t a;
+    uint8_t b;
+    uint8_t expected;   // FLAG_* 비트 조합
+} FlagCase;
+
+static const FlagCase cases[] = {
+    { "ADD 0x7F + 1",  FLAG_OP_ADD, 0x7F, 0x01, FLAG_SF | FLAG_OF },
+    { "ADD 0xFF + 1",  FLAG_OP_ADD, 0xFF, 0x01, FLAG_CF | FLAG_ZF },
+    { "SUB 0 - 1",     FLAG_OP_SUB, 0x00, 0x01, FLAG_CF | FLAG_SF },
+    { "SUB 0x80 - 1",  FLAG_OP_SUB, 0x80, 0x01, FLAG_OF },
+    { "MUL -128 * -1", FLAG_OP_MUL, 0x80, 0xFF, FLAG_CF | FLAG_SF | FLAG_OF },
+    { "MUL 16 * 16",   FLAG_OP_MUL, 0x10, 0x10, FLAG_CF | FLAG_ZF | FLAG_OF },
+    { "DIV 5 / 0",     FLAG_OP_DIV, 0x05, 0x00, FLAG_ZF | FLAG_OF },
+    { "DIV -128 / -1", FLAG_OP_DIV, 0x80, 0xFF, FLAG_SF | FLAG_OF },
+};
+
+#define CASE_COUNT (sizeof(cases) / sizeof(cases[0]))
+
+static unsigned test_boundaries(void) {
+    unsigned failures = 0;
+
+    for (unsigned i = 0; i < CASE_COUNT; i++) {
+        const FlagCase *c = &cases[i];
+        CPU_Registers regs;
+        uint8_t result = alu_result((uint8_t)(c->op - FLAG_OP_ADD), c->a, c->b);
+
+        memset(&regs, 0, sizeof(regs));
+        flags_record(&regs, c->op, c->a, c->b, result);
+        uint8_t flags = get_flags(&regs);
+        if (flags != c->expected) {
+            printf("❌ %s = 0x%02X: 플래그 0x%X, 기대 0x%X\n", c->name, result, flags, c->expected);
+            failures++;
+        }
+    }
+
+    printf("경계값 %u개: 실패 %u개\n", (unsigned)CASE_COUNT, failures);
+    return failures;
+}
+
+static unsigned test_pinning(void) {
+    CPU_Registers regs;
+    unsigned failures = 0;
+
+    // ADD 0xFF + 1이 남은 상태에서 OF를 켜면 CF|ZF에 OF가 더해져 확정
+    memset(&regs, 0, sizeof(regs));
+    flags_record(&regs, FLAG_OP_ADD, 0xFF, 0x01, 0x00);
+    set_flag(&regs, FLAG_OF, true);
+    regs.flag_a = regs.flag_b = regs.flag_result = 0x7F;    // 남은 필드는 더 이상 쓰이지 않아야 함
+    if (regs.flag_op != FLAG_OP_NONE || get_flags(&regs) != (FLAG_CF | FLAG_ZF | FLAG_OF)) {
+        printf("❌ set_flag 후 플래그 0x%X (op %u), 기대 0x%X\n", get_flags(&regs), regs.flag_op,
+               FLAG_CF | FLAG_ZF | FLAG_OF);
+        failures++;
+    }
+
+    // 같은 연산에서 CF만 끄면 ZF만 남음
+    flags_record(&regs, FLAG_OP_ADD, 0xFF, 0x01, 0x00);
+    set_carry_flag(&regs, false);
+    regs.flag_result = 0x80;
+    if (regs.flag_op != FLAG_OP_NONE || get_flags(&regs) != FLAG_ZF || get_carry_flag(&regs)) {
+        printf("❌ set_carry_flag 후 플래그 0x%X (op %u), 기대 0x%X\n", get_flags(&regs), regs.flag_op, FLAG_ZF);
+        failures++;
+    }
+
+    // 확정한 뒤 새 연산을 기록하면 다시 그 연산으로 계산
+    flags_record(&regs, FLAG_OP_SUB, 0x00, 0x01, 0xFF);
+    if (get_flags(&regs) != (FLAG_CF | FLAG_SF)) {
+        printf("❌ 확정 후 새 연산의 플래그 0x%X, 기대 0x%X\n", get_flags(&regs), FLAG_CF | FLAG_SF);
+        failures++;
+    }
+
+    printf("set_flag/set_carry_flag 확정: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 플래그 테스트 시작 ===\n\n");
+
+    unsigned failures = test_boundaries() + test_pinning();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,111 @@
+/* tests/handle_table_test.c - 핸들 테이블 테스트
+ * ------------------------------------------------------------
+ * 1) 등록한 항목이 핸들로 조회되고, 해제한 핸들은 같은 슬롯을 다시 써도 조회되지 않는지 확인합니다.
+ * 2) 작은 테이블에서 시작해 10000개를 등록/해제해도 핸들이 모두 다르고 항목이 옮겨지지 않는지 확인합니다.
+ * 3) max_slots 상한, 잘못된 핸들, 중복 해제를 거부하는지 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/handle_table.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_CONNECTIONS 10000U
+
+static unsigned test_reuse(void) {
+    HandleTable table;
+    int a = 1, b = 2;
+    unsigned failures = 0;
+
+    handle_table_init(&table, 1, 0);
+    Handle first = handle_alloc(&table, &a);
+    if (first == HANDLE_INVALID || handle_get(&table, first) != &a) {
+        printf("❌ 등록한 항목을 찾지 못함\n");
+        failures++;
+    }
+    handle_release(&table, first);
+    Handle second = handle_alloc(&table, &b);
+    if ((second & HANDLE_INDEX_MASK) != (first & HANDLE_INDEX_MASK) || second == first ||
+        handle_get(&table, first) != NULL || handle_get(&table, second) != &b) {
+        printf("❌ 다시 쓴 슬롯에서 옛 핸들이 조회됨 (0x%08X, 0x%08X)\n", first, second);
+        failures++;
+    }
+    handle_table_free(&table);
+
+    printf("슬롯 재사용: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_many(void) {
+    HandleTable table;
+    Handle *handles = malloc(TEST_CONNECTIONS * sizeof(Handle));
+    unsigned *items = malloc(TEST_CONNECTIONS * sizeof(unsigned));
+    unsigned failures = 0;
+
+    handle_table_init(&table, 16, 0);
+    for (unsigned i = 0; i < TEST_CONNECTIONS; i++) {
+        items[i] = i;
+        handles[i] = handle_alloc(&table, &items[i]);
+        failures += handles[i] == HANDLE_INVALID;
+    }
+    // 홀수 번째를 끊고 다시 연결
+    for (unsigned i = 1; i < TEST_CONNECTIONS; i += 2) {
+        failures += handle_release(&table, handles[i]) != 0;
+    }
+    for (unsigned i = 1; i < TEST_CONNECTIONS; i += 2) {
+        Handle old = handles[i];
+        handles[i] = handle_alloc(&table, &items[i]);
+        failures += handles[i] == old || handle_get(&table, old) != NULL;
+    }
+    for (unsigned i = 0; i < TEST_CONNECTIONS; i++) {
+        unsigned *item = handle_get(&table, handles[i]);
+        failures += !item || *item != i;
+    }
+    if (table.count != TEST_CONNECTIONS || table.capacity < TEST_CONNECTIONS || table.capacity > 2 * TEST_CONNECTIONS) {
+        printf("❌ 항목 %u개, 슬롯 %u개\n", table.count, table.capacity);
+        failures++;
+    }
+    handle_table_free(&table);
+    free(handles);
+    free(items);
+
+    printf("연결 %u개: 실패 %u개\n", TEST_CONNECTIONS, failures);
+    return failures;
+}
+
+static unsigned test_limits(void) {
+    HandleTable table;
+    int items[3];
+    unsigned failures = 0;
+
+    handle_table_init(&table, 1, 2);
+    Handle a = handle_alloc(&table, &items[0]);
+    Handle b = handle_alloc(&table, &items[1]);
+    if (a == HANDLE_INVALID || b == HANDLE_INVALID || handle_alloc(&table, &items[2]) != HANDLE_INVALID) {
+        printf("❌ 상한을 넘어 등록됨\n");
+        failures++;
+    }
+    if (handle_alloc(&table, NULL) != HANDLE_INVALID || handle_get(&table, HANDLE_INVALID) != NULL ||
+        handle_get(&table, (a & ~HANDLE_INDEX_MASK) | 5U) != NULL) {
+        printf("❌ 잘못된 핸들을 받아들임\n");
+        failures++;
+    }
+    if (handle_release(&table, a) != 0 || handle_release(&table, a) != -1 || table.count != 1) {
+        printf("❌ 중복 해제\n");
+        failures++;
+    }
+    handle_table_free(&table);
+
+    printf("상한: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 핸들 테이블 테스트 시작 ===\n\n");
+
+    unsigned failures = test_reuse() + test_many() + test_limits();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,221 @@
+/* tests/image_test.c - 바이너리 프로그램 이미지 테스트
+ * ------------------------------------------------------------
+ * 1) 어셈블 → image_write → image_open(mmap)으로 헤더/세그먼트/심볼/진입 PC가 보존되는지 확인합니다.
+ * 2) 손상(체크섬, 잘린 파일, 버전, 범위 밖 세그먼트)된 이미지를 거부하는지 확인합니다.
+ * 3) cpu_load_image로 적재해 실행 결과와 초기 레지스터를 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/assembler.h"
+#include "include/image.h"
+#include "include/cpu.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static const char program_source[] =
+    "        .byte 0xAA, 0xBB       ; 데이터\n"
+    "        .org 0x10\n"
+    "start:  MOV R1, 5\n"
+    "        MOV R2, 3\n"
+    "        ADD R1, R2\n"
+    "        STORE R7, [result]\n"
+    "        .org 0x40\n"
+    "result: .byte 0\n";
+
+/*
+ * @brief 명세를 임시 파일에 쓰고 경로를 돌려줍니다
+ * @returns 성공 시 0
+ */
+static int write_image(const ImageSpec *spec, char *path, size_t path_size) {
+    char error[128];
+    snprintf(path, path_size, "/tmp/image_test_XXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        return -1;
+    }
+    FILE *out = fdopen(fd, "wb");
+    if (!out) {
+        close(fd);
+        return -1;
+    }
+    int status = image_write(out, spec, error, sizeof(error));
+    if (fclose(out) != 0 || status != 0) {
+        printf("❌ 쓰기 실패: %s\n", error);
+        return -1;
+    }
+    return 0;
+}
+
+static unsigned test_round_trip(void) {
+    uint8_t output[MEMORY_SIZE];
+    AsmResult result;
+    ImageSpec spec;
+    ProgramImage image;
+    char path[64];
+    char error[128];
+    unsigned failures = 0;
+    long value;
+
+    if (asm_assemble_image(program_source, sizeof(program_source) - 1, output, sizeof(output), &spec, &result) != 0) {
+        asm_print_errors(&result);
+        return 1;
+    }
+    if (write_image(&spec, path, sizeof(path)) != 0) {
+        asm_image_free(&spec);
+        return 1;
+    }
+    asm_image_free(&spec);
+
+    if (image_open(path, &image, error, sizeof(error)) != 0) {
+        printf("❌ 열기 실패: %s\n", error);
+        unlink(path);
+        return 1;
+    }
+
+    static const struct { uint16_t address; uint16_t size; } expected[] = { { 0x00, 2 }, { 0x10, 8 }, { 0x40, 1 } };
+    const ImageHeader *header = image.header;
+    if (header->segment_count != 3 || header->entry_pc != 0x10 || header->load_address != 0 ||
+        header->symbol_count != 2 || (header->flags & IMAGE_FLAG_REGISTERS)) {
+        printf("❌ 헤더: 세그먼트 %u, 진입 %u, 적재 %u, 심볼 %u\n", header->segment_count, header->entry_pc,
+               header->load_address, header->symbol_count);
+        failures++;
+    }
+    for (unsigned i = 0; i < header->segment_count && i < 3; i++) {
+        if (image.segments[i].address != expected[i].address || image.segments[i].size != expected[i].size ||
+            image.segments[i].offset % IMAGE_ALIGN != 0 ||
+            memcmp(image_segment_data(&image, i), output + expected[i].address, expected[i].size) != 0) {
+            printf("❌ 세그먼트 %u: 주소 %u, 크기 %u\n", i, image.segments[i].address, image.segments[i].size);
+            failures++;
+        }
+    }
+    if (image_find_symbol(&image, "start", &value) != 0 || value != 0x10 ||
+        image_find_symbol(&image, "result", &value) != 0 || value != 0x40 ||
+        image_find_symbol(&image, "missing", &value) == 0) {
+        printf("❌ 심볼 표\n");
+        failures++;
+    }
+
+    // 적재 후 실행: R7 = 5 + 3 → [result]
+    cpu_load_image(&image);
+    for (int i = 0; i < 4; i++) {
+        cpu_step();
+    }
+    if (memory_peek(get_cpu_memory(), 0x40) != 8 || memory_peek(get_cpu_memory(), 0x01) != 0xBB ||
+        get_cpu_registers()->pc != 0x18) {
+        printf("❌ 실행: [result] = %u, PC = %u\n", memory_peek(get_cpu_memory(), 0x40), get_cpu_registers()->pc);
+        failures++;
+    }
+
+    image_close(&image);
+    unlink(path);
+    printf("왕복: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_rejects(void) {
+    static const uint8_t code[] = { 0x01, 0x02, 0x03, 0x04 };
+    ImageSegmentSpec segment = { 0x20, sizeof(code), code };
+    ImageSpec spec = { .entry_pc = 0x20, .segments = &segment, .segment_count = 1 };
+    char path[64];
+    unsigned failures = 0;
+
+    if (write_image(&spec, path, sizeof(path)) != 0) {
+        return 1;
+    }
+    FILE *in = fopen(path, "rb");
+    uint64_t file[32];
+    size_t size = in ? fread(file, 1, sizeof(file), in) : 0;
+    if (in) {
+        fclose(in);
+    }
+    unlink(path);
+
+    ProgramImage image;
+    uint64_t copy[32];
+    ImageHeader *header = (ImageHeader *)copy;
+    if (image_view(file, size, &image, NULL, 0) != 0) {
+        printf("❌ 정상 이미지를 거부\n");
+        failures++;
+    }
+
+    memcpy(copy, file, size);
+    ((uint8_t *)copy)[size - 8] ^= 0x01;            // 세그먼트 데이터 변조
+    if (image_view(copy, size, &image, NULL, 0) == 0) failures++;
+
+    memcpy(copy, file, size);
+    if (image_view(copy, size - 8, &image, NULL, 0) == 0) failures++;   // 잘린 파일
+
+    memcpy(copy, file, size);
+    header->version = IMAGE_VERSION + 1;
+    if (image_view(copy, size, &image, NULL, 0) == 0) failures++;
+
+    memcpy(copy, file, size);
+    ((ImageSegment *)(header + 1))->offset = (uint32_t)size;   // 범위 밖 (체크섬 검사 전에 거부)
+    if (image_view(copy, size, &image, NULL, 0) == 0) failures++;
+
+    memcpy(copy, file, size);
+    if (image_view((uint8_t *)copy + 1, size, &image, NULL, 0) == 0) failures++;   // 정렬 안 됨
+
+    printf("손상 거부: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_registers(void) {
+    static const uint8_t code[] = { 0xF0, 0x00 };  // MARK
+    ImageSegmentSpec segment = { 0x80, sizeof(code), code };
+    ImageSpec spec = { .entry_pc = 0x80, .has_registers = 1, .registers = { 0, 11, 22, 33, 44, 55, 66, 77 },
+                       .segments = &segment, .segment_count = 1 };
+    ProgramImage image;
+    char path[64];
+    unsigned failures = 0;
+
+    if (write_image(&spec, path, sizeof(path)) != 0) {
+        return 1;
+    }
+    if (image_open(path, &image, NULL, 0) != 0 || cpu_load_image(&image) != 0) {
+        printf("❌ 레지스터 이미지 적재 실패\n");
+        unlink(path);
+        return 1;
+    }
+    CPU_Registers *regs = get_cpu_registers();
+    for (uint8_t r = 1; r <= 7; r++) {
+        if (get_register(regs, r) != r * 11) {
+            printf("❌ R%u = %u (기대 %u)\n", r, get_register(regs, r), r * 11);
+            failures++;
+        }
+    }
+    if (regs->pc != 0x80) {
+        failures++;
+    }
+    image_close(&image);
+    unlink(path);
+
+    // 메모리를 벗어나는 세그먼트는 CPU 상태를 바꾸지 않고 거부
+    segment.address = MEMORY_SIZE - 1;
+    if (write_image(&spec, path, sizeof(path)) == 0) {
+        if (image_open(path, &image, NULL, 0) != 0 || cpu_load_image(&image) == 0 || regs->pc != 0x80) {
+            printf("❌ 범위 밖 세그먼트를 적재함\n");
+            failures++;
+        }
+        image_close(&image);
+        unlink(path);
+    }
+
+    printf("초기 레지스터: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 프로그램 이미지 테스트 시작 ===\n\n");
+
+    cpu_init();
+    cpu_log_enabled = 0;
+
+    unsigned failures = test_round_trip() + test_rejects() + test_registers();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
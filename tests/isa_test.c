@@ -0,0 +1,151 @@
+/* tests/isa_test.c - ISA 테이블 테스트
+ * ------------------------------------------------------------
+ * 1) 모든 니모닉이 완전 해시로 자기 줄을 찾고, 없는 니모닉은 찾지 못하는지 확인합니다.
+ * 2) 65,536개 워드 중 디코드되는 워드는 모두 디스어셈블 → 다시 인코딩해 같은 워드로 돌아오는지,
+ *    어셈블리로 표현할 수 없는 워드(R0, [R0], 간접 주소의 남는 비트 등)는 디코드되지 않는지 확인합니다.
+ * 3) 표에서 만든 인코더로 조립한 짧은 프로그램을 실행기로 돌려 결과를 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/isa.h"
+#include "include/cpu.h"
+#include "include/log.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * @brief 니모닉 조회를 확인합니다
+ * @returns 실패 수
+ */
+static unsigned test_lookup(void) {
+    static const char *unknown[] = { "NOP", "ADDS", "PADD8", "VLOAD8", "MO", "add", "JMP" };
+    unsigned failures = 0;
+
+    for (int id = ISA_INVALID + 1; id < ISA_COUNT; id++) {
+        IsaId found = isa_lookup(isa_table[id].mnemonic);
+        if (found == ISA_INVALID || strcmp(isa_table[found].mnemonic, isa_table[id].mnemonic) != 0) {
+            printf("❌ 니모닉 조회 실패: %s\n", isa_table[id].mnemonic);
+            failures++;
+        }
+    }
+    for (size_t i = 0; i < sizeof(unknown) / sizeof(unknown[0]); i++) {
+        if (isa_lookup(unknown[i]) != ISA_INVALID) {
+            printf("❌ 없는 니모닉을 찾음: %s\n", unknown[i]);
+            failures++;
+        }
+    }
+
+    printf("니모닉 조회: 실패 %u개\n", failures);
+    return failures;
+}
+
+/*
+ * @brief 디코드되는 모든 워드의 디스어셈블리를 다시 인코딩해 같은 워드인지 확인합니다
+ * @returns 실패 수
+ */
+static unsigned test_round_trip(void) {
+    unsigned failures = 0;
+    unsigned checked = 0;
+
+    for (uint32_t word = 0; word < 65536; word++) {
+        IsaId id = isa_decode((uint16_t)word);
+        if (id == ISA_INVALID) {
+            continue;
+        }
+
+        char text[64], again[64];
+        char mnemonic[32], operand1[32] = "", operand2[32] = "";
+        uint16_t encoded;
+
+        isa_disassemble((uint16_t)word, text, sizeof(text));
+        sscanf(text, "%31s %31[^,], %31s", mnemonic, operand1, operand2);
+        if (isa_encode(mnemonic, operand1, operand2, &encoded) != 0 || encoded != word ||
+            !isa_disassemble(encoded, again, sizeof(again)) || strcmp(text, again) != 0) {
+            if (failures < 10) {
+                printf("❌ 0x%04X: %s\n", word, text);
+            }
+            failures++;
+        }
+        checked++;
+    }
+
+    // LOAD R0, LOAD R1, [R0], [R8], 간접 주소의 상위 비트, 패킹 연산의 하위 4비트
+    static const uint16_t unencodable[] = { 0x5064, 0x5980, 0x5988, 0x5912, 0x6A13, 0x8C81 };
+    for (size_t i = 0; i < sizeof(unencodable) / sizeof(unencodable[0]); i++) {
+        if (isa_decode(unencodable[i]) != ISA_INVALID) {
+            printf("❌ 0x%04X가 %s로 디코드됨\n", unencodable[i], isa_table[isa_decode(unencodable[i])].mnemonic);
+            failures++;
+        }
+    }
+
+    printf("왕복 인코딩: 워드 %u개, 실패 %u개\n", checked, failures);
+    return failures;
+}
+
+/*
+ * @brief 어셈블리 한 줄을 현재 컨텍스트 메모리에 씁니다
+ */
+static int assemble(const char *line, uint8_t *program, size_t *size) {
+    char mnemonic[32], operand1[32] = "", operand2[32] = "";
+    uint16_t word;
+
+    sscanf(line, "%31s %31[^,], %31s", mnemonic, operand1, operand2);
+    if (isa_encode(mnemonic, operand1, operand2, &word) != 0) {
+        return -1;
+    }
+    program[(*size)++] = (uint8_t)(word >> 8);
+    program[(*size)++] = (uint8_t)(word & 0xFF);
+    return 0;
+}
+
+/*
+ * @brief 표에서 만든 인코더와 실행기가 같은 의미인지 확인합니다
+ * @returns 실패 수
+ */
+static unsigned test_execute(void) {
+    static const char *source[] = {
+        "MOV R1, 5", "MOV R2, 3", "ADD R1, R2", "STORE R7, [100]", "LOAD R3, [100]",
+        "MOV R4, 100", "LOAD R5, [R4]", "MARK", "SUB 9, 4", "MOV 40, 7",
+    };
+    uint8_t program[MEMORY_SIZE];
+    size_t size = 0;
+    unsigned failures = 0;
+
+    for (size_t i = 0; i < sizeof(source) / sizeof(source[0]); i++) {
+        if (assemble(source[i], program, &size) != 0) {
+            printf("❌ 조립 실패: %s\n", source[i]);
+            return 1;
+        }
+    }
+
+    cpu_reset();
+    cpu_load_program(program, size);
+    for (size_t i = 0; i < sizeof(source) / sizeof(source[0]); i++) {
+        cpu_step();
+    }
+
+    CPU_Registers *regs = get_cpu_registers();
+    Memory *memory = get_cpu_memory();
+    if (get_register(regs, 3) != 8) failures++;
+    if (get_register(regs, 5) != 8) failures++;
+    if (get_register(regs, 7) != 5 || get_register(regs, 1) != 9 || get_register(regs, 2) != 4) failures++;
+    if (memory_peek(memory, 71) != 5) failures++;
+    if (memory_peek(memory, 40) != 7) failures++;
+    if (regs->pc != size) failures++;
+
+    printf("실행: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== ISA 테이블 테스트 시작 ===\n\n");
+
+    cpu_init();
+    cpu_log_enabled = 0;
+
+    unsigned failures = test_lookup() + test_round_trip() + test_execute();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
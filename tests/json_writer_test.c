@@ -0,0 +1,129 @@
+/* tests/json_writer_test.c - 할당 없는 JSON 출력 테스트
+ * ------------------------------------------------------------
+ * 1) 중첩된 객체/배열의 쉼표와 괄호가 올바른지 문자열 그대로 비교합니다.
+ * 2) 문자열 이스케이프(따옴표, 역슬래시, 줄바꿈, 제어 문자)와 음수/64비트 정수를 확인합니다.
+ * 3) 버퍼가 모자라거나 중첩이 맞지 않으면 jw_finish()가 0을 돌려주고 버퍼 밖에 쓰지 않는지 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/json_writer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static unsigned expect(const char *name, char *buffer, const JsonWriter *writer, const char *expected) {
+    size_t length = jw_finish(writer);
+
+    if (length != strlen(expected) || memcmp(buffer, expected, length) != 0) {
+        printf("❌ %s: %.*s (기대값 %s)\n", name, (int)length, buffer, expected);
+        return 1;
+    }
+    return 0;
+}
+
+static unsigned test_nesting(void) {
+    static const uint8_t bytes[] = { 0, 7, 42, 255 };
+    char buffer[256];
+    JsonWriter writer;
+    unsigned failures = 0;
+
+    jw_init(&writer, buffer, sizeof(buffer));
+    jw_begin_object(&writer);
+    jw_key(&writer, "type");
+    jw_string(&writer, "state");
+    jw_key(&writer, "payload");
+    jw_begin_object(&writer);
+    jw_key(&writer, "empty");
+    jw_begin_array(&writer);
+    jw_end_array(&writer);
+    jw_key(&writer, "data");
+    jw_byte_array(&writer, bytes, sizeof(bytes));
+    jw_key(&writer, "lines");
+    jw_begin_array(&writer);
+    for (int i = 0; i < 2; i++) {
+        jw_begin_object(&writer);
+        jw_key(&writer, "index");
+        jw_int(&writer, i);
+        jw_key(&writer, "valid");
+        jw_bool(&writer, i);
+        jw_end_object(&writer);
+    }
+    jw_end_array(&writer);
+    jw_end_object(&writer);
+    jw_end_object(&writer);
+    failures += expect("중첩", buffer, &writer,
+                       "{\"type\":\"state\",\"payload\":{\"empty\":[],\"data\":[0,7,42,255],"
+                       "\"lines\":[{\"index\":0,\"valid\":false},{\"index\":1,\"valid\":true}]}}");
+
+    printf("중첩: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_values(void) {
+    char buffer[256];
+    JsonWriter writer;
+    unsigned failures = 0;
+
+    jw_init(&writer, buffer, sizeof(buffer));
+    jw_begin_array(&writer);
+    jw_string(&writer, "a\"b\\c\nd\te");
+    jw_string(&writer, "");
+    jw_string(&writer, "레지스터");
+    jw_end_array(&writer);
+    failures += expect("이스케이프", buffer, &writer, "[\"a\\\"b\\\\c\\nd\\u0009e\",\"\",\"레지스터\"]");
+
+    jw_init(&writer, buffer, sizeof(buffer));
+    jw_begin_array(&writer);
+    jw_int(&writer, -5);
+    jw_int(&writer, 0);
+    jw_int(&writer, -2147483647L - 1);
+    jw_uint64(&writer, UINT64_MAX);
+    jw_end_array(&writer);
+    failures += expect("정수", buffer, &writer, "[-5,0,-2147483648,18446744073709551615]");
+
+    printf("값: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_overflow(void) {
+    char buffer[16];
+    JsonWriter writer;
+    unsigned failures = 0;
+
+    memset(buffer, '#', sizeof(buffer));
+    jw_init(&writer, buffer, 8);
+    jw_begin_object(&writer);
+    jw_key(&writer, "payload");
+    jw_string(&writer, "too long");
+    jw_end_object(&writer);
+    if (jw_finish(&writer) != 0 || buffer[8] != '#') {
+        printf("❌ 공간이 부족한데 성공함\n");
+        failures++;
+    }
+
+    jw_init(&writer, buffer, sizeof(buffer));
+    jw_begin_object(&writer);
+    if (jw_finish(&writer) != 0) {
+        printf("❌ 닫히지 않은 객체가 성공함\n");
+        failures++;
+    }
+
+    jw_init(&writer, buffer, sizeof(buffer));
+    jw_end_array(&writer);
+    if (jw_finish(&writer) != 0) {
+        printf("❌ 열지 않은 배열을 닫음\n");
+        failures++;
+    }
+
+    printf("넘침: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== JSON 출력 테스트 시작 ===\n\n");
+
+    unsigned failures = test_nesting() + test_values() + test_overflow();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
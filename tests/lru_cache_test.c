@@ -0,0 +1,111 @@
+/* tests/lru_cache_test.c - 해시와 LRU 캐시 테스트
+ * ------------------------------------------------------------
+ * 1) hash64가 xxHash64 기준값과 같은지 확인합니다 (짧은 입력과 32바이트 이상 입력).
+ * 2) 조회/교체/히트·미스 통계와, 용량 상한을 넘을 때 가장 오래 쓰지 않은 항목부터 버리는지 확인합니다.
+ * 3) 해시 버킷이 늘어난 뒤에도 모든 키를 찾는지 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/hash.h"
+#include "include/lru_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static unsigned test_hash(void) {
+    uint8_t bytes[100];
+    unsigned failures = 0;
+
+    for (unsigned i = 0; i < sizeof(bytes); i++) {
+        bytes[i] = (uint8_t)i;
+    }
+    static const struct { const void *data; size_t length; uint64_t expected; } cases[] = {
+        { "", 0, 0xEF46DB3751D8E999ULL },
+        { "abc", 3, 0x44BC2CF5AD770999ULL },
+        { NULL, 100, 0x6AC1E58032166597ULL },
+    };
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        uint64_t actual = hash64(cases[i].data ? cases[i].data : bytes, cases[i].length, 0);
+        if (actual != cases[i].expected) {
+            printf("❌ hash64 %u: %016llx (기대 %016llx)\n", i, (unsigned long long)actual,
+                   (unsigned long long)cases[i].expected);
+            failures++;
+        }
+    }
+    printf("해시: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_lru(void) {
+    LruCache cache;
+    size_t length;
+    unsigned failures = 0;
+    char value[32];
+
+    // 항목 하나 = 헤더(포인터 3개 + 해시 + 길이 2개) + 키 2(8로 정렬) + 값 8 → 세 개만 들어가는 상한
+    lru_init(&cache, 3 * (sizeof(void *) * 3 + 8 + 2 * sizeof(size_t) + 16));
+    lru_put(&cache, "k1", 2, "value-01", 8);
+    lru_put(&cache, "k2", 2, "value-02", 8);
+    lru_put(&cache, "k3", 2, "value-03", 8);
+
+    const char *hit = lru_get(&cache, "k1", 2, &length);   // k1이 가장 최근 → k2가 가장 오래됨
+    if (!hit || length != 8 || memcmp(hit, "value-01", 8) != 0) {
+        printf("❌ k1 조회 실패\n");
+        failures++;
+    }
+    lru_put(&cache, "k4", 2, "value-04", 8);               // k2 퇴출
+    if (lru_get(&cache, "k2", 2, NULL) != NULL || !lru_get(&cache, "k1", 2, NULL) ||
+        !lru_get(&cache, "k3", 2, NULL) || !lru_get(&cache, "k4", 2, NULL)) {
+        printf("❌ LRU 순서대로 퇴출되지 않음\n");
+        failures++;
+    }
+
+    lru_put(&cache, "k3", 2, "changed!", 8);               // 교체는 퇴출이 아님
+    hit = lru_get(&cache, "k3", 2, &length);
+    if (!hit || memcmp(hit, "changed!", 8) != 0 || cache.entry_count != 3) {
+        printf("❌ 교체 실패 (항목 %zu개)\n", cache.entry_count);
+        failures++;
+    }
+    if (cache.stats.hits != 5 || cache.stats.misses != 1 || cache.stats.evictions != 1 ||
+        cache.bytes > cache.max_bytes) {
+        printf("❌ 통계: 히트 %llu, 미스 %llu, 퇴출 %llu, %zu/%zu바이트\n", (unsigned long long)cache.stats.hits,
+               (unsigned long long)cache.stats.misses, (unsigned long long)cache.stats.evictions, cache.bytes,
+               cache.max_bytes);
+        failures++;
+    }
+    if (lru_put(&cache, "big", 3, value, cache.max_bytes) == 0) {
+        printf("❌ 상한보다 큰 항목을 저장함\n");
+        failures++;
+    }
+    lru_free(&cache);
+
+    // 버킷 증가 후에도 모두 찾기
+    lru_init(&cache, 1 << 20);
+    for (unsigned i = 0; i < 1000; i++) {
+        int key_length = snprintf(value, sizeof(value), "program-%u", i);
+        lru_put(&cache, value, (size_t)key_length, &i, sizeof(i));
+    }
+    unsigned missing = 0;
+    for (unsigned i = 0; i < 1000; i++) {
+        int key_length = snprintf(value, sizeof(value), "program-%u", i);
+        const unsigned *stored = lru_get(&cache, value, (size_t)key_length, NULL);
+        if (!stored || *stored != i) missing++;
+    }
+    if (missing || cache.bucket_count < 1000) {
+        printf("❌ 버킷 %zu개에서 %u개를 찾지 못함\n", cache.bucket_count, missing);
+        failures++;
+    }
+    lru_free(&cache);
+
+    printf("LRU: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 해시/LRU 캐시 테스트 시작 ===\n\n");
+
+    unsigned failures = test_hash() + test_lru();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,178 @@
+/* tests/ooo_test.c - 비순차(OoO) 코어 검증 테스트
+ * ------------------------------------------------------------
+ * 1) 의존성, 메모리 순서, 자기 수정 코드, 패킹 SIMD를 다루는 프로그램 모음을 여러 코어 구성
+ *    (1-wide ROB 1부터 8-wide ROB 64까지)에서 순차 코어와 비교합니다.
+ * 2) 임의 워드로 만든 프로그램을 순차 코어와 비교합니다.
+ * 3) 검증이 호출자의 CPU 컨텍스트를 바꾸지 않는지 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/ooo.h"
+#include "include/assembler.h"
+#include "include/cpu.h"
+#include "include/log.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define RANDOM_PROGRAMS 2000U
+
+typedef struct {
+    const char *name;
+    const char *source;
+} CorpusProgram;
+
+static const CorpusProgram corpus[] = {
+    { "의존 체인",
+      "MOV R1, 3\n MOV R2, 4\n MUL R1, R2\n MOV R1, 2\n ADD R7, R1\n DIV R7, R2\n SUB R7, R1\n" },
+    { "독립 연산",
+      "MOV R1, 9\n MOV R2, 3\n MOV R3, 7\n MOV R4, 5\n ADD R1, R2\n MOV R5, 1\n MUL R3, R4\n DIV R1, R2\n" },
+    { "0으로 나누기와 플래그",
+      "MOV R1, 200\n MOV R2, 100\n ADD R1, R2\n MOV R3, 0\n DIV R1, R3\n SUB R3, R1\n" },
+    { "기존 6비트 포맷",
+      "ADD 10, 20\n SUB 5, 9\n MUL 7, 8\n DIV 63, 4\n MOV 60, 33\n ADD R1, R2\n" },
+    { "STORE 뒤 LOAD",
+      "MOV R1, 42\n MOV R2, 200\n STORE R1, [R2]\n LOAD R3, [200]\n ADD R3, R1\n STORE R7, [201]\n LOAD R4, [R2]\n" },
+    { "자기 수정 코드",
+      "MOV R1, 0x41\n MOV R2, 0x07\n STORE R1, [12]\n STORE R2, [13]\n MOV R3, 1\n MOV R3, 2\n MOV R4, 3\n" },
+    { "패킹 SIMD",
+      "MOV R1, 250\n STORE R1, [100]\n MOV R1, 7\n STORE R1, [101]\n VLOAD V0, [100]\n VLOAD V1, [100]\n"
+      " PADDS V0, V1\n PMUL4 V1, V0\n VSTORE V0, [120]\n LOAD R2, [120]\n VSTORE4 V1, [124]\n LOAD R3, [125]\n" },
+    { "VSTORE로 코드 덮어쓰기",
+      "MOV R1, 0x42\n STORE R1, [200]\n MOV R1, 0x09\n STORE R1, [201]\n VLOAD V0, [200]\n VSTORE4 V0, [18]\n"
+      " MOV R4, 1\n MOV R5, 1\n MOV R6, 1\n" },
+    { "MARK",
+      "MOV R1, 1\n MARK\n ADD R1, R1\n MARK\n" },
+};
+
+/*
+ * @brief 검증에 쓸 코어 구성 목록을 채웁니다
+ * @returns 구성 수
+ */
+static unsigned make_configs(OOO_Config *configs) {
+    ooo_default_config(&configs[0]);
+
+    configs[1] = configs[0];
+    configs[1].issue_width = 1;
+    configs[1].commit_width = 1;
+    configs[1].rob_size = 1;
+
+    configs[2] = configs[0];
+    configs[2].issue_width = 4;
+    configs[2].commit_width = 4;
+    configs[2].rob_size = 32;
+
+    configs[3] = configs[0];
+    configs[3].issue_width = OOO_MAX_ISSUE_WIDTH;
+    configs[3].commit_width = OOO_MAX_ISSUE_WIDTH;
+    configs[3].rob_size = OOO_MAX_ROB_SIZE;
+    for (int fu = 0; fu < OOO_FU_COUNT; fu++) {
+        configs[3].rs_size[fu] = OOO_MAX_RS_SIZE;
+        configs[3].fu_units[fu] = OOO_MAX_FU_UNITS;
+    }
+    return 4;
+}
+
+/*
+ * @brief 프로그램 모음을 모든 구성에서 검증합니다
+ * @returns 실패 개수
+ */
+static unsigned test_corpus(void) {
+    OOO_Config configs[4];
+    unsigned config_count = make_configs(configs);
+    unsigned failures = 0;
+
+    for (size_t i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++) {
+        uint8_t program[MEMORY_SIZE] = { 0 };
+        AsmResult result;
+
+        if (asm_assemble(corpus[i].source, strlen(corpus[i].source), program, sizeof(program), &result) != 0) {
+            printf("❌ %s: 어셈블 실패\n", corpus[i].name);
+            asm_print_errors(&result);
+            failures++;
+            continue;
+        }
+        for (unsigned c = 0; c < config_count; c++) {
+            if (ooo_verify_against_sequential(program, result.size, &configs[c]) != 0) {
+                printf("❌ %s: 구성 %u에서 불일치\n", corpus[i].name, c);
+                failures++;
+            }
+        }
+    }
+    printf("프로그램 모음 %zu개 × 구성 %u개: 실패 %u개\n", sizeof(corpus) / sizeof(corpus[0]), config_count, failures);
+    return failures;
+}
+
+// 재현 가능한 xorshift32
+static uint32_t random_state = 0x2545F491U;
+
+static uint32_t next_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+/*
+ * @brief 임의 워드로 만든 프로그램을 검증합니다 (0 워드에서 멈추므로 길이는 제각각)
+ * @returns 실패 개수
+ */
+static unsigned test_random_programs(void) {
+    OOO_Config configs[4];
+    unsigned config_count = make_configs(configs);
+    unsigned failures = 0;
+
+    for (unsigned n = 0; n < RANDOM_PROGRAMS; n++) {
+        uint8_t program[MEMORY_SIZE] = { 0 };
+        size_t size = 2U * (1U + next_random() % (MEMORY_SIZE / 2U - 1U));
+
+        for (size_t i = 0; i < size; i++) {
+            program[i] = (uint8_t)next_random();
+        }
+        if (ooo_verify_against_sequential(program, size, &configs[n % config_count]) != 0) {
+            if (failures < 10) {
+                printf("❌ 임의 프로그램 #%u (%zu바이트) 불일치\n", n, size);
+            }
+            failures++;
+        }
+    }
+    printf("임의 프로그램 %u개: 실패 %u개\n", RANDOM_PROGRAMS, failures);
+    return failures;
+}
+
+/*
+ * @brief 검증 전후로 호출자 컨텍스트의 레지스터와 메모리가 그대로인지 확인합니다
+ * @returns 실패 개수
+ */
+static unsigned test_caller_context(void) {
+    static const uint8_t program[] = { 0x41, 0x05, 0x42, 0x07, 0x01, 0x2F };
+    CPU_Context caller;
+    unsigned failures = 0;
+
+    cpu_context_init(&caller);
+    CPU_Context *previous = cpu_set_context(&caller);
+    set_register(&caller.regs, 3, 99);
+    caller.memory.data[10] = 123;
+
+    CPU_Context before = caller;
+    ooo_verify_against_sequential(program, sizeof(program), NULL);
+    if (cpu_get_context() != &caller || memcmp(&before.regs, &caller.regs, sizeof(before.regs)) != 0 ||
+        memcmp(before.memory.data, caller.memory.data, MEMORY_SIZE) != 0) {
+        printf("❌ 검증이 호출자 컨텍스트를 바꿈\n");
+        failures++;
+    }
+    cpu_set_context(previous);
+
+    printf("호출자 컨텍스트 보존: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== OoO 코어 검증 테스트 시작 ===\n\n");
+    cpu_log_enabled = 0;
+
+    unsigned failures = test_corpus() + test_random_programs() + test_caller_context();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,190 @@
+/* tests/profiler_test.c - PC별 실행 프로파일러 테스트
+ * ------------------------------------------------------------
+ * 1) 작은 프로그램을 처음부터 여러 번 반복 실행(루프)한 뒤 PC마다 실행 횟수가 반복 횟수와 같고,
+ *    실행하지 않은 PC는 0이며, PC별 미스 합이 캐시 미스 통계와 같은지 확인합니다.
+ * 2) 핫스팟 정렬, opcode별 합계, folded stack 줄 수를 확인합니다.
+ * 3) 끄면 세지 않고, reset은 0으로 되돌리며, 다른 컨텍스트의 프로파일과 섞이지 않는지 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/profiler.h"
+#include "include/assembler.h"
+#include "include/cpu.h"
+#include "include/log.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define LOOP_ITERATIONS 50U
+#define LOOP_INSTRUCTIONS 6U
+
+// 반복마다 같은 주소를 읽고 쓰는 루프 본문 (미스는 첫 반복에서만 남)
+static const char loop_source[] =
+    "MOV R1, 1\n ADD R2, R1\n STORE R2, [200]\n LOAD R3, [200]\n MUL R3, R1\n LOAD R4, [240]\n";
+
+static uint8_t program[MEMORY_SIZE];
+
+/*
+ * @brief 프로그램을 처음부터 끝까지 iterations번 실행합니다 (PC를 0으로 되돌리는 루프)
+ * @returns 없음 (void)
+ */
+static void run_loop(CPU_Context *ctx, unsigned iterations) {
+    for (unsigned i = 0; i < iterations; i++) {
+        ctx->regs.pc = 0;
+        for (unsigned n = 0; n < LOOP_INSTRUCTIONS; n++) {
+            cpu_step();
+        }
+    }
+}
+
+/*
+ * @brief 반복 실행 후 PC별 실행 횟수와 미스를 확인합니다
+ * @returns 실패 개수
+ */
+static unsigned test_counts(CPU_Context *ctx) {
+    unsigned failures = 0;
+    uint64_t misses_before = ctx->memory.cache.stats.misses;
+
+    if (profiler_enable() != PROFILER_OK || !profiler_is_enabled() || profiler_get() == NULL) {
+        printf("❌ 프로파일러를 켜지 못함\n");
+        return 1;
+    }
+    run_loop(ctx, LOOP_ITERATIONS);
+
+    const Profile *profile = profiler_get();
+    uint64_t misses = 0;
+    for (uint16_t pc = 0; pc < MEMORY_SIZE; pc++) {
+        uint64_t expected = (pc % 2 == 0 && pc < 2 * LOOP_INSTRUCTIONS) ? LOOP_ITERATIONS : 0;
+        if (profile->count[pc] != expected) {
+            printf("❌ PC %u: 실행 %llu회 (예상 %llu회)\n", pc, (unsigned long long)profile->count[pc],
+                   (unsigned long long)expected);
+            failures++;
+        }
+        misses += profile->misses[pc];
+    }
+    if (misses != ctx->memory.cache.stats.misses - misses_before) {
+        printf("❌ PC별 미스 합 %llu, 캐시 미스 %llu\n", (unsigned long long)misses,
+               (unsigned long long)(ctx->memory.cache.stats.misses - misses_before));
+        failures++;
+    }
+    printf("루프 %u회 × 명령어 %u개: 실패 %u개\n", LOOP_ITERATIONS, LOOP_INSTRUCTIONS, failures);
+    return failures;
+}
+
+/*
+ * @brief 핫스팟 정렬, opcode 합계, folded stack을 확인합니다
+ * @returns 실패 개수
+ */
+static unsigned test_reports(CPU_Context *ctx) {
+    ProfileHotspot hot[MEMORY_SIZE];
+    ProfileOpcode ops[PROFILE_OPCODES];
+    const Profile *profile = profiler_get();
+    unsigned failures = 0;
+
+    int n = profiler_hotspots(profile, &ctx->memory, hot, MEMORY_SIZE);
+    if (n != (int)LOOP_INSTRUCTIONS) {
+        printf("❌ 핫스팟 %d개 (예상 %u개)\n", n, LOOP_INSTRUCTIONS);
+        failures++;
+    }
+    for (int i = 0; i < n; i++) {
+        if (hot[i].cycles != hot[i].count * CPU_BASE_CYCLES + hot[i].misses * CACHE_MISS_PENALTY ||
+            (i > 0 && hot[i - 1].cycles < hot[i].cycles)) {
+            printf("❌ 핫스팟 #%d (PC %u) 사이클/정렬 오류\n", i, hot[i].pc);
+            failures++;
+        }
+    }
+    if (profiler_hotspots(profile, &ctx->memory, hot, 2) != 2) {
+        printf("❌ max_count가 적용되지 않음\n");
+        failures++;
+    }
+
+    profiler_opcodes(profile, &ctx->memory, ops);
+    // ADD(0), MUL(2), MOV(4)는 한 번씩, LOAD는 두 번씩
+    if (ops[0].count != LOOP_ITERATIONS || ops[2].count != LOOP_ITERATIONS || ops[4].count != LOOP_ITERATIONS ||
+        ops[OPCODE_LOAD].count != 2 * LOOP_ITERATIONS || ops[OPCODE_STORE].count != LOOP_ITERATIONS) {
+        printf("❌ opcode별 합계 오류 (LOAD %llu회)\n", (unsigned long long)ops[OPCODE_LOAD].count);
+        failures++;
+    }
+
+    FILE *folded = tmpfile();
+    if (!folded || profiler_write_folded(profile, &ctx->memory, folded, NULL) != (int)LOOP_INSTRUCTIONS) {
+        printf("❌ folded stack 줄 수 오류\n");
+        failures++;
+    }
+    if (folded) fclose(folded);
+
+    printf("보고서: 실패 %u개\n", failures);
+    return failures;
+}
+
+/*
+ * @brief 끄기, reset, 컨텍스트별 분리를 확인합니다
+ * @returns 실패 개수
+ */
+static unsigned test_control(CPU_Context *ctx) {
+    static CPU_Context other;
+    unsigned failures = 0;
+
+    profiler_disable();
+    run_loop(ctx, 3);
+    if (profiler_is_enabled() || profiler_get()->count[0] != LOOP_ITERATIONS) {
+        printf("❌ 끈 뒤에도 셈\n");
+        failures++;
+    }
+
+    // 다른 컨텍스트는 자기 프로파일을 가짐
+    cpu_context_init(&other);
+    cpu_set_context(&other);
+    cpu_load_program(program, MEMORY_SIZE);
+    if (profiler_get() != NULL || profiler_is_enabled() || profiler_enable() != PROFILER_OK) {
+        printf("❌ 새 컨텍스트의 프로파일 상태 오류\n");
+        failures++;
+    }
+    run_loop(&other, 2);
+    if (profiler_get()->count[0] != 2) {
+        printf("❌ 새 컨텍스트 실행 %llu회\n", (unsigned long long)profiler_get()->count[0]);
+        failures++;
+    }
+    cpu_set_context(ctx);
+    if (profiler_get()->count[0] != LOOP_ITERATIONS) {
+        printf("❌ 다른 컨텍스트의 실행이 섞임\n");
+        failures++;
+    }
+
+    profiler_reset();
+    for (uint16_t pc = 0; pc < MEMORY_SIZE; pc++) {
+        if (profiler_get()->count[pc] || profiler_get()->misses[pc]) {
+            printf("❌ reset 뒤 PC %u가 0이 아님\n", pc);
+            failures++;
+            break;
+        }
+    }
+
+    printf("켜기/끄기/reset/컨텍스트: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    static CPU_Context ctx;
+    AsmResult assembled;
+
+    printf("=== 프로파일러 테스트 시작 ===\n\n");
+    cpu_init();
+    cpu_log_enabled = 0;
+
+    if (asm_assemble(loop_source, strlen(loop_source), program, sizeof(program), &assembled) != 0 ||
+        assembled.instructions != LOOP_INSTRUCTIONS) {
+        printf("❌ 프로그램 어셈블 실패\n");
+        asm_print_errors(&assembled);
+        return 1;
+    }
+    cpu_context_init(&ctx);
+    cpu_set_context(&ctx);
+    cpu_load_program(program, MEMORY_SIZE);
+
+    unsigned failures = test_counts(&ctx) + test_reports(&ctx) + test_control(&ctx);
+    cpu_set_context(NULL);
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+/* tests/sampling_test.c - 샘플링 시뮬레이션 테스트
+ * ------------------------------------------------------------
+ * 1) 모든 구간을 상세 실행하고 캐시를 전부 데우면, 마지막 구간이 짧아도(구간 길이가 명령어 수를
+ *    나누지 않아도) 외삽한 사이클·CPI·미스율이 상세 모드로 전체를 실행한 값과 정확히 같은지 확인합니다.
+ * 2) 일부 구간만 표본으로 뽑으면 예상 사이클이 전체 실행 값의 10% 안에 드는지 확인합니다.
+ * 3) 호출 스레드의 CPU 컨텍스트가 바뀌지 않는지 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/sampling.h"
+#include "include/assembler.h"
+#include "include/cpu.h"
+#include "include/log.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_INSTRUCTIONS 100U      /* 코드 0~199, 빈 워드 200~203 (멈춤), 데이터 204~255 */
+#define DATA_BASE 204U
+#define DATA_SIZE 52U
+
+static uint8_t program[MEMORY_SIZE];
+static size_t program_size;
+
+/*
+ * @brief 레지스터 연산과 여러 캐시 라인에 걸친 LOAD/STORE가 섞인 직선 프로그램을 만듭니다
+ * @returns 성공 시 0
+ */
+static int build_program(void) {
+    static char source[4096];
+    size_t length = 0;
+    AsmResult result;
+
+    for (unsigned i = 0; i < TEST_INSTRUCTIONS / 4; i++) {
+        unsigned address = DATA_BASE + (i * 13U) % DATA_SIZE;
+        length += (size_t)sprintf(source + length,
+                                  "MOV R1, %u\n ADD R1, R2\n STORE R7, [%u]\n LOAD R2, [%u]\n",
+                                  i * 5U + 1U, address, DATA_BASE + (i * 29U) % DATA_SIZE);
+    }
+    if (asm_assemble(source, length, program, sizeof(program), &result) != 0 ||
+        result.instructions != TEST_INSTRUCTIONS) {
+        asm_print_errors(&result);
+        return -1;
+    }
+    program_size = result.size;
+    return 0;
+}
+
+/*
+ * @brief 전용 컨텍스트에서 상세 모드로 끝까지 실행합니다
+ * @param ctx 실행할 컨텍스트
+ * @returns 없음 (void)
+ */
+static void run_detailed(CPU_Context *ctx) {
+    CPU_Context *previous = cpu_set_context(ctx);
+
+    cpu_context_init(ctx);
+    cpu_load_program(program, program_size);
+    // 멈춤 판정은 memory_peek()로 하여 캐시 통계에 섞이지 않게 함
+    while (ctx->regs.pc < MEMORY_SIZE - 1 &&
+           (memory_peek(&ctx->memory, ctx->regs.pc) | memory_peek(&ctx->memory, ctx->regs.pc + 1)) != 0) {
+        cpu_step();
+    }
+    cpu_set_context(previous);
+}
+
+static unsigned test_exact_when_all_sampled(const CPU_Context *full) {
+    static SampleResult result;
+    SampleConfig config;
+    unsigned failures = 0;
+    uint64_t accesses = full->memory.cache.stats.hits + full->memory.cache.stats.misses;
+    double miss_rate = (double)full->memory.cache.stats.misses / (double)accesses;
+
+    sample_default_config(&config);
+    config.interval_length = 16;        /* 100 = 6 × 16 + 4: 마지막 구간은 4 명령어 */
+    config.max_samples = 0;
+    config.warmup_accesses = MEMORY_ACCESS_LOG_SIZE;
+
+    if (cpu_sample_run(program, program_size, &config, &result) != 0 ||
+        result.total_instructions != TEST_INSTRUCTIONS || result.total_intervals != 7 ||
+        result.sampled_intervals != 7) {
+        printf("❌ 샘플링 실행 실패 (명령어 %llu, 구간 %u/%u)\n", (unsigned long long)result.total_instructions,
+               result.sampled_intervals, result.total_intervals);
+        return 1;
+    }
+    if (fabs(result.estimated_cycles - (double)full->stats.cycles) > 1e-6 || result.estimated_cycles_ci != 0.0 ||
+        fabs(result.cpi_mean - (double)full->stats.cycles / TEST_INSTRUCTIONS) > 1e-9 ||
+        fabs(result.miss_rate_mean - miss_rate) > 1e-9) {
+        printf("❌ 전체 표본: 사이클 %.1f ± %.1f (실제 %llu), 미스율 %.4f (실제 %.4f)\n",
+               result.estimated_cycles, result.estimated_cycles_ci, (unsigned long long)full->stats.cycles,
+               result.miss_rate_mean, miss_rate);
+        failures++;
+    }
+    printf("전체 구간 표본: 예상 %.0f, 실제 %llu 사이클\n", result.estimated_cycles,
+           (unsigned long long)full->stats.cycles);
+    return failures;
+}
+
+static unsigned test_partial_sample(const CPU_Context *full) {
+    static SampleResult result;
+    SampleConfig config;
+    unsigned failures = 0;
+
+    sample_default_config(&config);
+    config.interval_length = 8;         /* 13구간 중 5개 */
+    config.max_samples = 5;
+    config.threads = 3;
+
+    if (cpu_sample_run(program, program_size, &config, &result) != 0 || result.sampled_intervals != 5) {
+        printf("❌ 샘플링 실행 실패\n");
+        return 1;
+    }
+    double error = fabs(result.estimated_cycles - (double)full->stats.cycles) / (double)full->stats.cycles;
+    if (error > 0.10) {
+        printf("❌ 부분 표본: 예상 %.0f ± %.0f, 실제 %llu (오차 %.1f%%)\n", result.estimated_cycles,
+               result.estimated_cycles_ci, (unsigned long long)full->stats.cycles, error * 100.0);
+        failures++;
+    }
+    printf("부분 표본 (5/13): 예상 %.0f ± %.0f, 실제 %llu 사이클\n", result.estimated_cycles,
+           result.estimated_cycles_ci, (unsigned long long)full->stats.cycles);
+    return failures;
+}
+
+static unsigned test_caller_context(void) {
+    static SampleResult result;
+    CPU_Context *before = cpu_get_context();
+    CPU_Registers regs = before->regs;
+    unsigned failures = 0;
+
+    cpu_sample_run(program, program_size, NULL, &result);
+    if (cpu_get_context() != before || memcmp(&regs, &before->regs, sizeof(regs)) != 0 || cpu_log_enabled != 0) {
+        printf("❌ 호출자 컨텍스트가 바뀜\n");
+        failures++;
+    }
+    return failures;
+}
+
+int main(void) {
+    static CPU_Context full;
+
+    printf("=== 샘플링 시뮬레이션 테스트 시작 ===\n\n");
+    cpu_init();
+    cpu_log_enabled = 0;
+
+    if (build_program() != 0) {
+        printf("❌ 프로그램 어셈블 실패\n");
+        return 1;
+    }
+    run_detailed(&full);
+
+    unsigned failures = test_exact_when_all_sampled(&full) + test_partial_sample(&full) + test_caller_context();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,238 @@
+/* tests/send_queue_test.c - 전송 대기열 테스트
+ * ------------------------------------------------------------
+ * 1) 한 프레임을 여러 대기열에 넣어도 복사 없이 공유되고, 마지막 참조를 놓을 때만 해제되는지 확인합니다.
+ * 2) 원형 버퍼가 여러 바퀴 돌아도 넣은 순서대로 나오는지 확인합니다.
+ * 3) 가득 찬 대기열이 프레임을 버리고 개수를 세며, 비우면 참조를 모두 놓는지 확인합니다.
+ * 4) 느린 클라이언트: 상한에 닿으면 상태 프레임만 버리고 이벤트는 순서대로 남기며,
+ *    충분히 비면 send_queue_resume()이 한 번만 재개를 알리는지 확인합니다.
+ * 5) 프레임 풀: 놓은 프레임을 같은 등급 할당에서 다시 쓰고, 여러 대기열이 공유하는 동안에는 돌아오지 않으며,
+ *    풀 상한을 넘거나 등급보다 큰 프레임은 해제하고, trim이 남은 프레임을 모두 해제하는지 확인합니다.
+ *    (누수/중복 해제는 -fsanitize=address로 확인)
+ * Author: Cho Sungju
+*/
+
+#include "include/send_queue.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_HEADROOM 16U
+
+static unsigned test_sharing(void) {
+    SendQueue a, b;
+    unsigned failures = 0;
+
+    send_queue_init(&a);
+    send_queue_init(&b);
+    OutFrame *frame = out_frame_create("state", 5, TEST_HEADROOM, 0);
+    send_queue_push(&a, frame);
+    send_queue_push(&b, frame);
+    if (frame->refs != 3 || memcmp(out_frame_payload(frame), "state", 5) != 0 ||
+        out_frame_payload(frame) != frame->data + TEST_HEADROOM) {
+        printf("❌ 공유 프레임 (참조 %u개)\n", frame->refs);
+        failures++;
+    }
+    out_frame_release(frame);   // 만든 쪽의 참조
+
+    OutFrame *from_a = send_queue_pop(&a);
+    OutFrame *from_b = send_queue_pop(&b);
+    if (from_a != frame || from_b != frame || frame->refs != 2) {
+        printf("❌ 꺼낸 프레임이 같지 않음\n");
+        failures++;
+    }
+    out_frame_release(from_a);
+    out_frame_release(from_b);  // 여기서 해제
+
+    if (send_queue_pop(&a) != NULL || a.sent != 1) {
+        printf("❌ 빈 대기열\n");
+        failures++;
+    }
+
+    printf("공유: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_order(void) {
+    SendQueue queue;
+    unsigned failures = 0;
+    unsigned next = 0;
+
+    send_queue_init(&queue);
+    for (unsigned i = 0; i < (SEND_QUEUE_DEPTH - 2) * 3; i++) {
+        OutFrame *frame = out_frame_create(&i, sizeof(i), 0, 1);
+        send_queue_push(&queue, frame);
+        out_frame_release(frame);
+        if (i % 3 == 2) {       // 세 개 넣을 때마다 두 개 꺼냄
+            for (int k = 0; k < 2; k++) {
+                OutFrame *out = send_queue_pop(&queue);
+                unsigned value;
+                memcpy(&value, out_frame_payload(out), sizeof(value));
+                failures += value != next++;
+                out_frame_release(out);
+            }
+        }
+    }
+    if (queue.count != SEND_QUEUE_DEPTH - 2 || queue.dropped != 0) {
+        printf("❌ 남은 프레임 %u개, 버림 %llu개\n", queue.count, (unsigned long long)queue.dropped);
+        failures++;
+    }
+    send_queue_clear(&queue);
+
+    printf("순서: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_full(void) {
+    SendQueue queue;
+    unsigned failures = 0;
+
+    send_queue_init(&queue);
+    OutFrame *frame = out_frame_create("x", 1, TEST_HEADROOM, 0);
+    for (unsigned i = 0; i < SEND_QUEUE_DEPTH; i++) {
+        failures += send_queue_push(&queue, frame) != SEND_QUEUED;
+    }
+    if (send_queue_push(&queue, frame) != SEND_DROPPED || queue.dropped != 1 || frame->refs != 1 + SEND_QUEUE_DEPTH) {
+        printf("❌ 가득 찬 대기열에 들어감\n");
+        failures++;
+    }
+    send_queue_clear(&queue);
+    if (queue.count != 0 || frame->refs != 1) {
+        printf("❌ 비운 뒤 참조 %u개\n", frame->refs);
+        failures++;
+    }
+    out_frame_release(frame);
+
+    printf("가득 참: 실패 %u개\n", failures);
+    return failures;
+}
+
+static OutFrame* make_frame(unsigned value, int state) {
+    OutFrame *frame = out_frame_create(&value, sizeof(value), TEST_HEADROOM, 0);
+    frame->state = state;
+    return frame;
+}
+
+static unsigned test_coalesce(void) {
+    SendQueue queue;
+    unsigned failures = 0;
+    unsigned events = 0;
+
+    // 상태 프레임 3개마다 이벤트 1개씩 상한까지 쌓음
+    send_queue_init(&queue);
+    for (unsigned i = 0; queue.count < SEND_QUEUE_HIGH_WATER; i++) {
+        OutFrame *frame = make_frame(i, i % 4 != 0);
+        events += !frame->state;
+        failures += send_queue_push(&queue, frame) != SEND_QUEUED;
+        out_frame_release(frame);
+    }
+
+    OutFrame *state = make_frame(1000, 1);
+    OutFrame *event = make_frame(2000, 0);
+    if (send_queue_push(&queue, state) != SEND_COALESCED || !queue.coalescing || queue.count != events ||
+        queue.coalesced != SEND_QUEUE_HIGH_WATER - events + 1 || state->refs != 1) {
+        printf("❌ 합치기 시작 (남은 프레임 %u개, 합친 프레임 %llu개)\n", queue.count,
+               (unsigned long long)queue.coalesced);
+        failures++;
+    }
+    if (send_queue_push(&queue, event) != SEND_QUEUED || send_queue_push(&queue, state) != SEND_COALESCED) {
+        printf("❌ 합치는 중에 이벤트가 빠지거나 상태가 들어감\n");
+        failures++;
+    }
+    out_frame_release(state);
+    out_frame_release(event);
+
+    // 이벤트는 넣은 순서대로 남아 있고, LOW_WATER까지 비어야 재개
+    unsigned previous = 0;
+    int resumed = 0;
+    while (queue.count > 0) {
+        OutFrame *out = send_queue_pop(&queue);
+        unsigned value;
+        memcpy(&value, out_frame_payload(out), sizeof(value));
+        failures += out->state || value < previous;
+        previous = value;
+        out_frame_release(out);
+        if (send_queue_resume(&queue)) {
+            failures += queue.count > SEND_QUEUE_LOW_WATER || resumed;
+            resumed = 1;
+        }
+    }
+    if (!resumed || queue.coalescing || send_queue_resume(&queue)) {
+        printf("❌ 재개되지 않음\n");
+        failures++;
+    }
+
+    state = make_frame(3000, 1);
+    failures += send_queue_push(&queue, state) != SEND_QUEUED;
+    out_frame_release(state);
+    send_queue_clear(&queue);
+
+    printf("합치기: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_pool(void) {
+    SendQueue a, b;
+    OutFrame *frames[OUT_FRAME_POOL_DEPTH + 4];
+    unsigned failures = 0;
+
+    // 놓은 프레임은 같은 등급의 다음 할당에서 그대로 다시 씀
+    OutFrame *first = out_frame_alloc(100, TEST_HEADROOM, 1);
+    if (!first || first->refs != 1 || first->length != 0 || first->capacity < 100 ||
+        out_frame_payload(first) != first->data + TEST_HEADROOM) {
+        printf("❌ 풀 프레임 할당\n");
+        return 1;
+    }
+    out_frame_release(first);
+    OutFrame *again = out_frame_alloc(300, TEST_HEADROOM, 0);
+    if (again != first || again->binary != 0 || again->state != 0 || again->length != 0) {
+        printf("❌ 놓은 프레임을 다시 쓰지 않음\n");
+        failures++;
+    }
+
+    // 브로드캐스트: 프레임 하나를 두 대기열이 공유하는 동안은 풀로 돌아오지 않음
+    send_queue_init(&a);
+    send_queue_init(&b);
+    memcpy(out_frame_payload(again), "delta", 5);
+    again->length = 5;
+    send_queue_push(&a, again);
+    send_queue_push(&b, again);
+    out_frame_release(again);
+    OutFrame *other = out_frame_alloc(100, TEST_HEADROOM, 0);
+    OutFrame *from_a = send_queue_pop(&a);
+    OutFrame *from_b = send_queue_pop(&b);
+    if (other == again || from_a != again || from_b != again || memcmp(out_frame_payload(again), "delta", 5) != 0) {
+        printf("❌ 공유 중인 프레임이 풀로 돌아감\n");
+        failures++;
+    }
+    out_frame_release(other);
+    out_frame_release(from_a);
+    out_frame_release(from_b);
+
+    // 풀 상한을 넘는 프레임과 등급보다 큰 프레임은 해제 (ASan이 누수/중복 해제를 확인)
+    for (unsigned i = 0; i < OUT_FRAME_POOL_DEPTH + 4; i++) {
+        frames[i] = out_frame_alloc(4000, TEST_HEADROOM, 1);
+    }
+    for (unsigned i = 0; i < OUT_FRAME_POOL_DEPTH + 4; i++) {
+        out_frame_release(frames[i]);
+    }
+    OutFrame *large = out_frame_alloc(64 * 1024, TEST_HEADROOM, 1);
+    if (!large || large->pool_class != -1 || large->capacity != 64 * 1024) {
+        printf("❌ 큰 프레임이 풀 밖에서 할당되지 않음\n");
+        failures++;
+    }
+    out_frame_release(large);
+    out_frame_pool_trim();
+
+    printf("프레임 풀: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 전송 대기열 테스트 시작 ===\n\n");
+
+    unsigned failures = test_sharing() + test_order() + test_full() + test_coalesce() + test_pool();
+    out_frame_pool_trim();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,120 @@
+/* tests/simd_test.c - 패킹 SIMD 레인 연산 테스트
+ * ------------------------------------------------------------
+ * 1) 알려진 입력(랩어라운드/포화 경계)에 대해 PADD/PSUB/PMUL 결과를 확인합니다.
+ * 2) 임의 입력 200,000개에 대해 호스트 벡터 백엔드(simd_packed_op)와
+ *    레인 루프 기준 구현(simd_packed_op_scalar)의 8바이트 결과가 같은지 확인합니다.
+ *    4레인 연산은 상위 4레인을 바꾸지 않아야 합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/simd.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define RANDOM_CASES 200000U
+
+static const char *op_names[PACKED_OP_COUNT] = { "PADD", "PSUB", "PMUL" };
+
+// 재현 가능한 xorshift32 (rand()는 플랫폼마다 다름)
+static uint32_t random_state = 0x12345678U;
+
+static uint32_t next_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+typedef struct {
+    uint8_t op;
+    int saturate;
+    unsigned lanes;
+    uint8_t dst[8];
+    uint8_t src[8];
+    uint8_t expected[8];
+} KnownCase;
+
+static const KnownCase known_cases[] = {
+    { PACKED_ADD, 0, 8, { 1, 2, 200, 255, 0, 128, 10, 250 }, { 1, 3, 100, 1, 0, 128, 20, 10 },
+      { 2, 5, 44, 0, 0, 0, 30, 4 } },
+    { PACKED_ADD, 1, 8, { 1, 2, 200, 255, 0, 128, 10, 250 }, { 1, 3, 100, 1, 0, 128, 20, 10 },
+      { 2, 5, 255, 255, 0, 255, 30, 255 } },
+    { PACKED_SUB, 0, 8, { 5, 0, 100, 1, 0, 0, 0, 0 }, { 3, 1, 200, 1, 0, 0, 0, 0 },
+      { 2, 255, 156, 0, 0, 0, 0, 0 } },
+    { PACKED_SUB, 1, 8, { 5, 0, 100, 1, 0, 0, 0, 0 }, { 3, 1, 200, 1, 0, 0, 0, 0 },
+      { 2, 0, 0, 0, 0, 0, 0, 0 } },
+    { PACKED_MUL, 0, 8, { 2, 16, 255, 3, 0, 0, 0, 0 }, { 3, 16, 255, 85, 0, 0, 0, 0 },
+      { 6, 0, 1, 255, 0, 0, 0, 0 } },
+    { PACKED_MUL, 1, 8, { 2, 16, 255, 3, 0, 0, 0, 0 }, { 3, 16, 255, 85, 0, 0, 0, 0 },
+      { 6, 255, 255, 255, 0, 0, 0, 0 } },
+    // 4레인: 상위 레인은 그대로
+    { PACKED_ADD, 0, 4, { 1, 1, 1, 1, 9, 9, 9, 9 }, { 1, 2, 3, 4, 5, 6, 7, 8 },
+      { 2, 3, 4, 5, 9, 9, 9, 9 } },
+};
+
+/*
+ * @brief 알려진 입력의 결과를 두 구현 모두 확인합니다
+ * @returns 실패 개수
+ */
+static unsigned test_known_cases(void) {
+    unsigned failures = 0;
+
+    for (size_t i = 0; i < sizeof(known_cases) / sizeof(known_cases[0]); i++) {
+        const KnownCase *c = &known_cases[i];
+        uint8_t host[8], scalar[8];
+
+        memcpy(host, c->dst, 8);
+        memcpy(scalar, c->dst, 8);
+        simd_packed_op(c->op, c->saturate, c->lanes, host, c->src);
+        simd_packed_op_scalar(c->op, c->saturate, c->lanes, scalar, c->src);
+        if (memcmp(host, c->expected, 8) != 0 || memcmp(scalar, c->expected, 8) != 0) {
+            printf("❌ %s%s%s 알려진 입력 #%zu 불일치\n", op_names[c->op], c->saturate ? "S" : "",
+                   c->lanes == 4 ? "4" : "", i);
+            failures++;
+        }
+    }
+    printf("알려진 입력 %zu개: 실패 %u개\n", sizeof(known_cases) / sizeof(known_cases[0]), failures);
+    return failures;
+}
+
+/*
+ * @brief 임의 입력에서 호스트 백엔드와 기준 구현이 같은지 확인합니다
+ * @returns 불일치 개수
+ */
+static unsigned test_random_equivalence(void) {
+    unsigned mismatches = 0;
+
+    for (unsigned n = 0; n < RANDOM_CASES; n++) {
+        uint8_t op = (uint8_t)(n % PACKED_OP_COUNT);
+        int saturate = (n / PACKED_OP_COUNT) & 1;
+        unsigned lanes = ((n / PACKED_OP_COUNT) & 2) ? 4 : 8;
+        uint8_t src[8], host[8], scalar[8];
+
+        for (unsigned i = 0; i < 8; i++) {
+            uint32_t r = next_random();
+            host[i] = scalar[i] = (uint8_t)r;
+            src[i] = (uint8_t)(r >> 8);
+        }
+        simd_packed_op(op, saturate, lanes, host, src);
+        simd_packed_op_scalar(op, saturate, lanes, scalar, src);
+
+        if (memcmp(host, scalar, 8) != 0) {
+            if (mismatches < 10) {
+                printf("❌ %s%s%s 임의 입력 #%u 불일치\n", op_names[op], saturate ? "S" : "", lanes == 4 ? "4" : "", n);
+            }
+            mismatches++;
+        }
+    }
+    printf("임의 입력 %u개 (%s 백엔드): 불일치 %u개\n", RANDOM_CASES, simd_backend_name(), mismatches);
+    return mismatches;
+}
+
+int main(void) {
+    printf("=== 패킹 SIMD 테스트 시작 ===\n\n");
+
+    unsigned failures = test_known_cases() + test_random_equivalence();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,193 @@
+/* tests/state_delta_test.c - 상태 변화(delta) 테스트
+ * ------------------------------------------------------------
+ * 1) 첫 delta와 resync 뒤의 delta가 모든 항목을 담은 키프레임인지 확인합니다.
+ * 2) 프로그램을 한 단계씩 실행하며 delta만 적용한 클라이언트 쪽 사본이 실제 상태와 같은지 확인합니다.
+ * 3) 바뀐 것이 없으면 빈 delta, keyframe_interval번째마다 키프레임이 오는지 확인합니다.
+ * 4) 중간 delta를 건너뛴 클라이언트가 state_tracker_keyframe 하나로 다시 맞춰지는지 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/state_delta.h"
+#include "include/assembler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_KEYFRAME_INTERVAL 8U
+
+/*
+ * @brief 클라이언트처럼 delta를 사본에 적용합니다
+ */
+static void apply_delta(StateSnapshot *mirror, const StateDelta *delta, const StateSnapshot *now) {
+    mirror->pc = now->pc;
+    mirror->instructions = now->instructions;
+    mirror->cycles = now->cycles;
+    for (unsigned r = 1; r <= 7; r++) {
+        if (delta->register_mask & (1U << r)) mirror->registers[r] = now->registers[r];
+    }
+    for (unsigned v = 0; v < VREG_COUNT; v++) {
+        if (delta->vreg_mask & (1U << v)) memcpy(mirror->vreg[v], now->vreg[v], VREG_LANES);
+    }
+    if (delta->flags_changed) mirror->flags = now->flags;
+    if (delta->mode_changed) mirror->mode = now->mode;
+    if (delta->cache_stats_changed) mirror->cache_stats = now->cache_stats;
+    for (unsigned i = 0; i < delta->run_count; i++) {
+        memcpy(&mirror->memory[delta->runs[i].address], &now->memory[delta->runs[i].address], delta->runs[i].length);
+    }
+    for (unsigned i = 0; i < delta->line_count; i++) {
+        mirror->lines[delta->lines[i]] = now->lines[delta->lines[i]];
+    }
+}
+
+static int same_state(const StateSnapshot *a, const StateSnapshot *b) {
+    if (a->pc != b->pc || a->flags != b->flags || a->mode != b->mode ||
+        memcmp(&a->registers[1], &b->registers[1], 7) != 0 || memcmp(a->vreg, b->vreg, sizeof(a->vreg)) != 0 ||
+        memcmp(a->memory, b->memory, MEMORY_SIZE) != 0 ||
+        memcmp(&a->cache_stats, &b->cache_stats, sizeof(CacheStats)) != 0) {
+        return 0;
+    }
+    for (unsigned i = 0; i < CACHE_NUM_LINES; i++) {
+        if (a->lines[i].tag != b->lines[i].tag || a->lines[i].valid != b->lines[i].valid ||
+            a->lines[i].dirty != b->lines[i].dirty ||
+            memcmp(a->lines[i].block, b->lines[i].block, CACHE_LINE_SIZE) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static unsigned test_keyframes(StateTracker *tracker) {
+    StateDelta delta;
+    unsigned failures = 0;
+
+    unsigned changes = state_tracker_next(tracker, cpu_get_context(), &delta);
+    if (!delta.keyframe || delta.sequence != 0 || delta.register_mask != 0xFE || delta.run_count != 1 ||
+        delta.runs[0].length != MEMORY_SIZE || delta.line_count != CACHE_NUM_LINES) {
+        printf("❌ 첫 delta가 키프레임이 아님 (항목 %u)\n", changes);
+        failures++;
+    }
+
+    changes = state_tracker_next(tracker, cpu_get_context(), &delta);
+    if (delta.keyframe || delta.sequence != 1 || changes != 0 || delta.run_count || delta.line_count) {
+        printf("❌ 바뀐 것이 없는데 항목 %u개\n", changes);
+        failures++;
+    }
+
+    state_tracker_resync(tracker);
+    state_tracker_next(tracker, cpu_get_context(), &delta);
+    if (!delta.keyframe || delta.sequence != 2) {
+        printf("❌ resync 뒤 키프레임이 아님\n");
+        failures++;
+    }
+
+    printf("키프레임: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_mirror(StateTracker *tracker) {
+    static const char source[] =
+        "MOV R1, 5\n"
+        "MOV R2, 3\n"
+        "ADD R1, R2\n"
+        "STORE R7, [0x80]\n"
+        "MOV R4, 0x80\n"
+        "LOAD R5, [R4]\n"
+        "SUB 9, 4\n"
+        "STORE R7, [0x81]\n"
+        "MOV R3, 200\n"
+        "MOV R6, 100\n"
+        "ADD R3, R6\n"
+        "MARK\n";
+    uint8_t program[MEMORY_SIZE];
+    AsmResult result;
+    StateDelta delta;
+    StateSnapshot mirror;
+    StateSnapshot truth;
+    unsigned failures = 0;
+    unsigned keyframes = 0;
+
+    if (asm_assemble(source, sizeof(source) - 1, program, sizeof(program), &result) != 0) {
+        asm_print_errors(&result);
+        return 1;
+    }
+
+    // 키프레임으로 사본을 맞춘 뒤 프로그램 적재와 각 단계를 delta로만 따라감
+    state_tracker_resync(tracker);
+    state_tracker_next(tracker, cpu_get_context(), &delta);
+    mirror = tracker->current;
+
+    cpu_reset();
+    cpu_load_program(program, result.size);
+    for (unsigned step = 0; step <= result.instructions * 2; step++) {
+        state_tracker_next(tracker, cpu_get_context(), &delta);
+        keyframes += (unsigned)delta.keyframe;
+        if (!delta.keyframe && delta.run_count + delta.line_count > MEMORY_SIZE / 4) {
+            printf("❌ 단계 %u: delta가 너무 큼 (구간 %u, 라인 %u)\n", step, delta.run_count, delta.line_count);
+            failures++;
+        }
+        apply_delta(&mirror, &delta, &tracker->current);
+        state_snapshot_capture(&truth, cpu_get_context());
+        if (!same_state(&mirror, &truth)) {
+            printf("❌ 단계 %u: 사본이 실제 상태와 다름\n", step);
+            failures++;
+            break;
+        }
+        cpu_step();
+    }
+
+    if (keyframes != (result.instructions * 2 + 1) / TEST_KEYFRAME_INTERVAL) {
+        printf("❌ 키프레임 %u개\n", keyframes);
+        failures++;
+    }
+    printf("사본 동기화: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_catch_up(StateTracker *tracker) {
+    StateDelta delta;
+    StateSnapshot mirror;
+    StateSnapshot truth;
+    unsigned failures = 0;
+
+    // 다른 클라이언트들이 받는 delta 몇 개를 이 클라이언트는 건너뜀
+    memset(&mirror, 0, sizeof(mirror));
+    for (uint8_t value = 1; value <= 3; value++) {
+        set_register(&cpu_get_context()->regs, value, value);
+        state_tracker_next(tracker, cpu_get_context(), &delta);
+    }
+    uint32_t last_sequence = delta.sequence;
+
+    state_tracker_keyframe(tracker, &delta);
+    if (!delta.keyframe || delta.sequence != last_sequence || delta.line_count != CACHE_NUM_LINES) {
+        printf("❌ 따라잡기 키프레임 (순서 %u)\n", delta.sequence);
+        failures++;
+    }
+    apply_delta(&mirror, &delta, &tracker->current);
+
+    // 이후 delta는 그대로 적용
+    set_register(&cpu_get_context()->regs, 4, 44);
+    state_tracker_next(tracker, cpu_get_context(), &delta);
+    apply_delta(&mirror, &delta, &tracker->current);
+    state_snapshot_capture(&truth, cpu_get_context());
+    if (delta.sequence != last_sequence + 1 || !same_state(&mirror, &truth)) {
+        printf("❌ 따라잡은 뒤 사본이 실제 상태와 다름\n");
+        failures++;
+    }
+
+    printf("따라잡기: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 상태 delta 테스트 시작 ===\n\n");
+
+    cpu_init();
+    cpu_log_enabled = 0;
+
+    StateTracker tracker;
+    state_tracker_init(&tracker, TEST_KEYFRAME_INTERVAL);
+    unsigned failures = test_keyframes(&tracker) + test_mirror(&tracker) + test_catch_up(&tracker);
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,289 @@
+/* tests/trace_test.c - 바이너리 실행 트레이스 테스트
+ * ------------------------------------------------------------
+ * 1) 임의 레코드(seq/pc 건너뛰기, 레지스터 쓰기, 메모리 접근, 플래그, 이벤트)를
+ *    trace_encode_record()로 인코딩해 파일에 쓰고 trace_decode_record()로 되읽어 같은지 확인합니다.
+ *    파일 끝에서는 0, 잘린 레코드에서는 -1을 돌려줘야 합니다.
+ * 2) trace_start()/cpu_step()/trace_stop()으로 만든 파일을 디코딩해, 다른 스레드가 트레이스 없이
+ *    같은 프로그램을 동시에 실행한 결과(PC, 쓴 레지스터, 플래그, 메모리 접근)와 같은지 확인합니다.
+ *    목적지는 명령어가 정합니다: I6 ADD/MUL은 R1, R2도 바꾸지만 R7, 같은 값을 쓰는 MOV R4, 0도 R4.
+ * Author: Cho Sungju
+*/
+
+#include "include/trace.h"
+#include "include/assembler.h"
+#include "include/cpu.h"
+#include "include/flags.h"
+#include "include/log.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#define RANDOM_RECORDS 100000U
+#define TRACE_TEST_PATH "trace_test.bin"
+
+static const char program_source[] =
+    "MOV R1, 200\n MOV R2, 7\n STORE R2, [R1]\n ADD R1, R2\n STORE R7, [210]\n"
+    "MUL 5, 6\n LOAD R3, [200]\n SUB R3, R2\n MOV R4, 0\n DIV R3, R4\n"
+    "VLOAD V0, [200]\n PADDS V0, V0\n VSTORE V0, [216]\n LOAD R5, [217]\n ADD R5, R5\n ADD 3, 4\n";
+
+#define PROGRAM_INSTRUCTIONS 16U
+
+/* 명령어마다 기대하는 목적지 레지스터 */
+static const uint8_t expected_dest[PROGRAM_INSTRUCTIONS] = {
+    1, 2, TRACE_NO_REG, 7, TRACE_NO_REG, 7, 3, 7, 4, 7, TRACE_NO_REG, TRACE_NO_REG, TRACE_NO_REG, 5, 7, 7
+};
+
+// 재현 가능한 xorshift32
+static uint32_t random_state = 0x7F4A7C15U;
+
+static uint32_t next_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+/*
+ * @brief 인코딩에 실리지 않는 필드(접근이 없을 때의 주소 등)를 빼고 두 레코드를 비교합니다
+ * @returns 같으면 1, 다르면 0
+ */
+static int same_record(const TraceRecord *a, const TraceRecord *b) {
+    return a->seq == b->seq && a->pc == b->pc && a->word == b->word && a->op == b->op &&
+           a->dest_reg == b->dest_reg && a->dest_value == b->dest_value && a->mem_count == b->mem_count &&
+           (a->mem_count == 0 || (a->mem_addr == b->mem_addr && a->mem_value == b->mem_value)) &&
+           a->flags == b->flags && a->events == b->events;
+}
+
+/*
+ * @brief 임의 레코드를 만듭니다 (대부분은 직선 실행처럼 seq +1, pc +2)
+ * @param previous 이전 레코드
+ * @param record 결과를 받을 레코드
+ * @returns 없음 (void)
+ */
+static void make_record(const TraceRecord *previous, TraceRecord *record) {
+    uint32_t r = next_random();
+
+    memset(record, 0, sizeof(*record));
+    record->seq = previous->seq + 1 + ((r & 0x7) == 0 ? next_random() : 0);
+    record->pc = (uint16_t)(previous->pc + 2);
+    if ((r & 0x18) == 0) record->pc = (uint16_t)next_random();
+    record->word = (r & 0x20) ? (uint16_t)next_random() : previous->word;
+    record->op = (uint8_t)(record->word >> 12);
+    if (r & 0x40) {
+        record->dest_reg = (uint8_t)(1 + next_random() % 7);
+        record->dest_value = (uint8_t)next_random();
+    }
+    if (r & 0x80) {
+        record->mem_addr = (uint16_t)next_random();
+        record->mem_value = (uint8_t)next_random();
+        record->mem_count = (uint8_t)(1 + next_random() % 8);
+    }
+    record->flags = (r & 0x100) ? (uint8_t)(next_random() & 0xF) : previous->flags;
+    record->events = (r & 0x200) ? (uint8_t)(next_random() & 0xF) : previous->events;
+}
+
+/*
+ * @brief 임의 레코드의 인코딩 → 디코딩 왕복과 파일 끝/잘림 처리를 확인합니다
+ * @returns 실패 개수
+ */
+static unsigned test_round_trip(void) {
+    static TraceRecord records[RANDOM_RECORDS];
+    TraceCodec encoder, decoder;
+    TraceRecord previous, decoded;
+    uint8_t buffer[TRACE_MAX_ENCODED];
+    size_t last_size = 0;
+    unsigned failures = 0;
+    FILE *file = tmpfile();
+
+    if (!file) {
+        printf("❌ 임시 파일 생성 실패\n");
+        return 1;
+    }
+
+    trace_codec_init(&encoder);
+    trace_codec_init(&decoder);
+    previous = encoder.previous;
+    for (unsigned i = 0; i < RANDOM_RECORDS; i++) {
+        make_record(&previous, &records[i]);
+        last_size = trace_encode_record(&encoder, &records[i], buffer);
+        if (last_size > TRACE_MAX_ENCODED) {
+            printf("❌ 레코드 #%u 인코딩 크기 %zu > %u\n", i, last_size, TRACE_MAX_ENCODED);
+            failures++;
+        }
+        fwrite(buffer, 1, last_size, file);
+        previous = records[i];
+    }
+    long file_size = ftell(file);
+
+    rewind(file);
+    for (unsigned i = 0; i < RANDOM_RECORDS; i++) {
+        if (trace_decode_record(&decoder, file, &decoded) != 1 || !same_record(&records[i], &decoded)) {
+            if (failures < 10) {
+                printf("❌ 레코드 #%u 왕복 불일치 (seq %llu/%llu, pc %u/%u)\n", i,
+                       (unsigned long long)records[i].seq, (unsigned long long)decoded.seq, records[i].pc,
+                       decoded.pc);
+            }
+            failures++;
+        }
+    }
+    if (trace_decode_record(&decoder, file, &decoded) != 0) {
+        printf("❌ 파일 끝에서 0을 돌려주지 않음\n");
+        failures++;
+    }
+
+    // 마지막 레코드의 마지막 바이트를 잘라내면 형식 오류
+    if (last_size > 1) {
+        rewind(file);
+        trace_codec_init(&decoder);
+        for (unsigned i = 0; i + 1 < RANDOM_RECORDS; i++) {
+            trace_decode_record(&decoder, file, &decoded);
+        }
+        uint8_t tail[TRACE_MAX_ENCODED];
+        size_t tail_size = fread(tail, 1, sizeof(tail), file);
+        FILE *cut = tmpfile();
+        if (cut && tail_size == last_size) {
+            fwrite(tail, 1, tail_size - 1, cut);
+            rewind(cut);
+            if (trace_decode_record(&decoder, cut, &decoded) != -1) {
+                printf("❌ 잘린 레코드에서 -1을 돌려주지 않음\n");
+                failures++;
+            }
+        }
+        if (cut) fclose(cut);
+    }
+    fclose(file);
+
+    printf("레코드 %u개 왕복 (%.2f바이트/레코드): 실패 %u개\n", RANDOM_RECORDS,
+           (double)file_size / RANDOM_RECORDS, failures);
+    return failures;
+}
+
+/* 트레이스 없이 실행한 기준 결과 (명령어마다) */
+typedef struct {
+    uint8_t program[MEMORY_SIZE];
+    uint16_t pc[PROGRAM_INSTRUCTIONS];
+    uint8_t regs[PROGRAM_INSTRUCTIONS][8];
+    uint8_t flags[PROGRAM_INSTRUCTIONS];
+    unsigned steps;
+} Reference;
+
+/*
+ * @brief 생산자가 아닌 스레드에서 자기 컨텍스트로 프로그램을 실행하며 명령어마다 상태를 모읍니다
+ * @param arg Reference 포인터
+ * @returns NULL
+ */
+static void* reference_main(void *arg) {
+    static CPU_Context ctx;
+    Reference *reference = arg;
+
+    cpu_log_enabled = 0;
+    cpu_context_init(&ctx);
+    cpu_set_context(&ctx);
+    cpu_load_program(reference->program, MEMORY_SIZE);
+    while (reference->steps < PROGRAM_INSTRUCTIONS) {
+        reference->pc[reference->steps] = ctx.regs.pc;
+        cpu_step();
+        for (uint8_t r = 1; r <= 7; r++) {
+            reference->regs[reference->steps][r] = get_register(&ctx.regs, r);
+        }
+        reference->flags[reference->steps] = get_flags(&ctx.regs);
+        reference->steps++;
+    }
+    cpu_set_context(NULL);
+    return NULL;
+}
+
+/*
+ * @brief 트레이스한 실행을 디코딩해 다른 스레드의 기준 실행과 비교합니다
+ * @returns 실패 개수
+ */
+static unsigned test_end_to_end(void) {
+    static Reference reference;
+    static CPU_Context ctx;
+    AsmResult assembled;
+    TraceStats stats;
+    pthread_t thread;
+    unsigned failures = 0;
+
+    if (asm_assemble(program_source, strlen(program_source), reference.program, MEMORY_SIZE, &assembled) != 0 ||
+        assembled.instructions != PROGRAM_INSTRUCTIONS) {
+        printf("❌ 프로그램 어셈블 실패\n");
+        asm_print_errors(&assembled);
+        return 1;
+    }
+
+    cpu_context_init(&ctx);
+    cpu_set_context(&ctx);
+    if (trace_start(TRACE_TEST_PATH, 0) != 0) {
+        cpu_set_context(NULL);
+        return 1;
+    }
+    cpu_load_program(reference.program, MEMORY_SIZE);
+    // 트레이스 중 다른 스레드가 cpu_step()을 돌려도 이 스레드의 레코드에 섞이지 않아야 함
+    pthread_create(&thread, NULL, reference_main, &reference);
+    for (unsigned i = 0; i < PROGRAM_INSTRUCTIONS; i++) {
+        cpu_step();
+    }
+    trace_stop(&stats);
+    pthread_join(thread, NULL);
+    cpu_set_context(NULL);
+
+    FILE *in = fopen(TRACE_TEST_PATH, "rb");
+    char magic[sizeof(TRACE_MAGIC)];
+    if (!in || fread(magic, 1, sizeof(magic), in) != sizeof(magic) || memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0) {
+        printf("❌ 트레이스 파일 머리가 잘못됨\n");
+        if (in) fclose(in);
+        remove(TRACE_TEST_PATH);
+        return 1;
+    }
+
+    TraceCodec codec;
+    TraceRecord record;
+    unsigned count = 0;
+    int status;
+
+    trace_codec_init(&codec);
+    while ((status = trace_decode_record(&codec, in, &record)) > 0) {
+        if (count >= PROGRAM_INSTRUCTIONS) {
+            count++;    // 실행보다 많은 레코드
+            continue;
+        }
+        const uint8_t *after = reference.regs[count];
+        uint8_t dest = expected_dest[count];
+        uint16_t word = (uint16_t)((reference.program[reference.pc[count]] << 8) |
+                                   reference.program[reference.pc[count] + 1]);
+        int accesses = (record.events & (TRACE_EV_MEM_READ | TRACE_EV_MEM_WRITE)) != 0;
+
+        if (record.seq != count || record.pc != reference.pc[count] || record.word != word ||
+            record.dest_reg != dest || (dest != TRACE_NO_REG && record.dest_value != after[dest]) ||
+            record.flags != reference.flags[count] || accesses != (record.mem_count != 0)) {
+            char line[160];
+            trace_format_record(&record, line, sizeof(line));
+            printf("❌ 레코드 #%u 불일치: %s\n", count, line);
+            failures++;
+        }
+        count++;
+    }
+    fclose(in);
+    remove(TRACE_TEST_PATH);
+
+    if (status < 0 || count != PROGRAM_INSTRUCTIONS || stats.records != PROGRAM_INSTRUCTIONS || stats.dropped != 0) {
+        printf("❌ 레코드 %u개 디코딩 (기록 %llu개, 버림 %llu개, 상태 %d)\n", count,
+               (unsigned long long)stats.records, (unsigned long long)stats.dropped, status);
+        failures++;
+    }
+    printf("트레이스 실행 %u개 명령어: 실패 %u개\n", PROGRAM_INSTRUCTIONS, failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 실행 트레이스 테스트 시작 ===\n\n");
+    cpu_init();
+    cpu_log_enabled = 0;
+
+    unsigned failures = test_round_trip() + test_end_to_end();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
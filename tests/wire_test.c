@@ -0,0 +1,151 @@
+/* tests/wire_test.c - 바이너리 WebSocket 프레임 테스트
+ * ------------------------------------------------------------
+ * 1) STATE/MEMORY/CACHE/STEP 프레임의 헤더와 필드 위치가 include/wire.h의 레이아웃과 같은지 확인합니다.
+ * 2) 레지스터 하나만 바뀐 DELTA 프레임이 고정 부분 + 1바이트인지, 키프레임이 최대 크기 안에 드는지 확인합니다.
+ * 3) 클라이언트 명령 해석이 길이 오류와 알 수 없는 명령을 거부하는지, run_all 옵션과 작업 제어 명령을 읽는지 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/wire.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define FRAME_CAPACITY   4096U
+#define DELTA_FIXED_SIZE 28U    /* seq + bits/마스크 + pc + instructions + cycles + 구간 수 + 라인 수 */
+
+static uint16_t le16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static unsigned test_frames(void) {
+    uint8_t frame[FRAME_CAPACITY];
+    StateSnapshot state;
+    unsigned failures = 0;
+
+    cpu_reset();
+    CPU_Context *ctx = cpu_get_context();
+    set_register(&ctx->regs, 1, 0x11);
+    set_register(&ctx->regs, 7, 0x77);
+    ctx->regs.pc = 0x0102;
+    ctx->stats.instructions = 0x0A0B0C0D;
+    state_snapshot_capture(&state, ctx);
+
+    size_t size = wire_encode_state(frame, sizeof(frame), &state);
+    if (size != WIRE_HEADER_SIZE + 59 || frame[0] != WIRE_STATE || le16(frame + 2) != size - WIRE_HEADER_SIZE ||
+        le16(frame + 4) != 0x0102 || frame[6] != 0x11 || frame[12] != 0x77 || frame[47] != 0x0D || frame[50] != 0x0A) {
+        printf("❌ STATE 프레임 (%zu바이트)\n", size);
+        failures++;
+    }
+    if (wire_encode_state(frame, size - 1, &state) != 0) {
+        printf("❌ 공간이 부족한데 STATE를 씀\n");
+        failures++;
+    }
+
+    state.memory[0x10] = 0xAB;
+    size = wire_encode_memory(frame, sizeof(frame), state.memory, 0x10, 3);
+    if (size != WIRE_HEADER_SIZE + 7 || frame[0] != WIRE_MEMORY || le16(frame + 4) != 0x10 || le16(frame + 6) != 3 ||
+        frame[8] != 0xAB) {
+        printf("❌ MEMORY 프레임 (%zu바이트)\n", size);
+        failures++;
+    }
+
+    state.lines[5].tag = 0x0203;
+    state.lines[5].valid = 1;
+    state.lines[5].block[3] = 0xCD;
+    state.cache_stats.hits = 9;
+    size = wire_encode_cache(frame, sizeof(frame), state.lines, &state.cache_stats, 5, 2);
+    if (size != WIRE_HEADER_SIZE + 2 + 24 + 2 * WIRE_LINE_SIZE || frame[4] != 5 || frame[5] != 2 || frame[6] != 9 ||
+        le16(frame + 30) != 0x0203 || frame[32] != 1 || frame[37] != 0xCD) {
+        printf("❌ CACHE 프레임 (%zu바이트)\n", size);
+        failures++;
+    }
+
+    static const uint8_t word[2] = { 0x41, 0x05 };
+    size = wire_encode_step(frame, sizeof(frame), "MOV R1, 5", word, 2);
+    if (size != WIRE_HEADER_SIZE + 3 + 9 || frame[4] != 2 || frame[5] != 0x41 || memcmp(frame + 7, "MOV R1, 5", 9) != 0) {
+        printf("❌ STEP 프레임 (%zu바이트)\n", size);
+        failures++;
+    }
+
+    printf("프레임 레이아웃: 실패 %u개\n", failures);
+    return failures;
+}
+
+static unsigned test_delta(void) {
+    uint8_t frame[FRAME_CAPACITY];
+    StateTracker tracker;
+    StateDelta delta;
+    unsigned failures = 0;
+
+    cpu_reset();
+    state_tracker_init(&tracker, STATE_KEYFRAME_INTERVAL);
+    state_tracker_next(&tracker, cpu_get_context(), &delta);
+    size_t keyframe = wire_encode_delta(frame, sizeof(frame), &delta, &tracker.current);
+    if (keyframe == 0 || !(frame[8] & WIRE_DELTA_KEYFRAME)) {
+        printf("❌ 키프레임 DELTA (%zu바이트)\n", keyframe);
+        failures++;
+    }
+
+    set_register(&cpu_get_context()->regs, 3, 42);
+    state_tracker_next(&tracker, cpu_get_context(), &delta);
+    size_t size = wire_encode_delta(frame, sizeof(frame), &delta, &tracker.current);
+    const uint8_t *payload = frame + WIRE_HEADER_SIZE;
+    if (size != WIRE_HEADER_SIZE + DELTA_FIXED_SIZE + 1 || payload[0] != 1 || payload[5] != (1U << 3) ||
+        payload[25] != 42 || le16(payload + 26) != 0 || payload[28] != 0) {
+        printf("❌ 레지스터 하나 DELTA (%zu바이트)\n", size);
+        failures++;
+    }
+
+    printf("DELTA: 키프레임 %zu바이트, 레지스터 하나 %zu바이트, 실패 %u개\n", keyframe, size, failures);
+    return failures;
+}
+
+static unsigned test_commands(void) {
+    static const uint8_t step[] = { WIRE_CMD_STEP, 0, 0, 0 };
+    static const uint8_t bad_length[] = { WIRE_CMD_STEP, 0, 1, 0 };
+    static const uint8_t extra[] = { WIRE_CMD_RESET, 0, 1, 0, 0xFF };
+    static const uint8_t memory[] = { WIRE_CMD_GET_MEMORY, 0, 4, 0, 0x20, 0x00, 0x10, 0x00 };
+    static const uint8_t load[] = { WIRE_CMD_LOAD_PROGRAM, 0, 4, 0, 'M', 'A', 'R', 'K' };
+    static const uint8_t unknown[] = { WIRE_STATE, 0, 0, 0 };
+    static const uint8_t run_all[] = { WIRE_CMD_RUN_ALL, 0, 0, 0 };
+    static const uint8_t run_rate[] = { WIRE_CMD_RUN_ALL, 0, 8, 0, 0xE8, 0x03, 0, 0, 0x00, 0x00, 0x01, 0x00 };
+    static const uint8_t run_short[] = { WIRE_CMD_RUN_ALL, 0, 4, 0, 0xE8, 0x03, 0, 0 };
+    static const uint8_t pause[] = { WIRE_CMD_PAUSE, 0, 0, 0 };
+    static const uint8_t cancel[] = { WIRE_CMD_CANCEL, 0, 0, 0 };
+    static const uint8_t cancel_extra[] = { WIRE_CMD_CANCEL, 0, 1, 0, 0x01 };
+    WireCommand command;
+    unsigned failures = 0;
+
+    if (wire_decode_command(step, sizeof(step), &command) != 0 || command.type != WIRE_CMD_STEP) failures++;
+    if (wire_decode_command(bad_length, sizeof(bad_length), &command) == 0) failures++;
+    if (wire_decode_command(extra, sizeof(extra), &command) == 0) failures++;
+    if (wire_decode_command(step, 3, &command) == 0) failures++;
+    if (wire_decode_command(memory, sizeof(memory), &command) != 0 || command.address != 0x20 ||
+        command.count != 0x10) failures++;
+    if (wire_decode_command(load, sizeof(load), &command) != 0 || command.length != 4 ||
+        memcmp(command.text, "MARK", 4) != 0) failures++;
+    if (wire_decode_command(unknown, sizeof(unknown), &command) == 0) failures++;
+    if (wire_decode_command(run_all, sizeof(run_all), &command) != 0 || command.has_run_options) failures++;
+    if (wire_decode_command(run_rate, sizeof(run_rate), &command) != 0 || !command.has_run_options ||
+        command.rate != 1000 || command.budget != 0x10000) failures++;
+    if (wire_decode_command(run_short, sizeof(run_short), &command) == 0) failures++;
+    if (wire_decode_command(pause, sizeof(pause), &command) != 0 || command.type != WIRE_CMD_PAUSE) failures++;
+    if (wire_decode_command(cancel, sizeof(cancel), &command) != 0 || command.type != WIRE_CMD_CANCEL) failures++;
+    if (wire_decode_command(cancel_extra, sizeof(cancel_extra), &command) == 0) failures++;
+
+    printf("명령 해석: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 바이너리 프레임 테스트 시작 ===\n\n");
+
+    cpu_init();
+    cpu_log_enabled = 0;
+
+    unsigned failures = test_frames() + test_delta() + test_commands();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
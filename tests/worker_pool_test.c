@@ -0,0 +1,238 @@
+/* tests/worker_pool_test.c - 워커 풀과 MPSC 큐 테스트
+ * ------------------------------------------------------------
+ * 1) 생산자 여럿이 동시에 넣은 항목이 빠짐없이, 생산자별로 넣은 순서대로 꺼내지는지 확인합니다.
+ * 2) 제출한 작업이 모두 WORK_DONE으로 결과 큐에 돌아오고 notify가 작업마다 불리는지 확인합니다.
+ * 3) 실행 중 취소, 대기 중 취소, 마감 시각, 풀 종료가 각각 WORK_CANCELLED/WORK_EXPIRED로 끝나는지,
+ *    대기 중 취소는 워커가 바빠도 바로 끝나는지, work_item_wait()가 작업이 끝난 뒤에 돌아오는지 확인합니다.
+ * Author: Cho Sungju
+*/
+
+#include "include/worker_pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define TEST_PRODUCERS 4U
+#define TEST_PER_PRODUCER 20000U
+#define TEST_JOBS 1000U
+
+typedef struct {
+    WorkItem item;
+    unsigned producer;
+    unsigned sequence;
+    uint64_t value;
+    int started;                /* __atomic */
+} TestItem;
+
+static MpscQueue shared_queue;
+static TestItem *producer_items;
+
+static void* producer_main(void *arg) {
+    unsigned producer = (unsigned)(uintptr_t)arg;
+
+    for (unsigned i = 0; i < TEST_PER_PRODUCER; i++) {
+        TestItem *item = &producer_items[producer * TEST_PER_PRODUCER + i];
+        item->producer = producer;
+        item->sequence = i;
+        mpsc_push(&shared_queue, &item->item);
+    }
+    return NULL;
+}
+
+static unsigned test_mpsc(void) {
+    pthread_t threads[TEST_PRODUCERS];
+    unsigned next[TEST_PRODUCERS] = { 0 };
+    unsigned received = 0;
+    unsigned failures = 0;
+
+    producer_items = calloc(TEST_PRODUCERS * TEST_PER_PRODUCER, sizeof(TestItem));
+    mpsc_init(&shared_queue);
+    for (unsigned p = 0; p < TEST_PRODUCERS; p++) {
+        pthread_create(&threads[p], NULL, producer_main, (void *)(uintptr_t)p);
+    }
+    // 생산자가 넣는 동안 계속 꺼냄
+    while (received < TEST_PRODUCERS * TEST_PER_PRODUCER) {
+        for (WorkItem *item = mpsc_take_all(&shared_queue); item; item = item->next) {
+            TestItem *test = (TestItem *)item;
+            if (test->sequence != next[test->producer]) {
+                failures++;
+            }
+            next[test->producer] = test->sequence + 1;
+            received++;
+        }
+    }
+    for (unsigned p = 0; p < TEST_PRODUCERS; p++) {
+        pthread_join(threads[p], NULL);
+    }
+    if (mpsc_take_all(&shared_queue) != NULL) {
+        failures++;
+    }
+    free(producer_items);
+
+    printf("MPSC 큐: %u개 수신, 순서 오류 %u개\n", received, failures);
+    return failures;
+}
+
+static int notify_count;
+
+static void count_notify(void *arg) {
+    __atomic_add_fetch((int *)arg, 1, __ATOMIC_RELAXED);
+}
+
+static WorkStatus sum_run(WorkItem *item) {
+    TestItem *test = (TestItem *)item;
+    for (unsigned i = 1; i <= test->sequence; i++) {
+        test->value += i;
+    }
+    return WORK_DONE;
+}
+
+// 취소되거나 마감이 지날 때까지 도는 작업
+static WorkStatus spin_run(WorkItem *item) {
+    TestItem *test = (TestItem *)item;
+    __atomic_store_n(&test->started, 1, __ATOMIC_RELEASE);
+    for (;;) {
+        WorkStatus status = work_item_check(item);
+        if (status != WORK_DONE) {
+            return status;
+        }
+        usleep(100);
+    }
+}
+
+// 결과 큐에서 count개를 받을 때까지 기다림
+static unsigned wait_results(MpscQueue *queue, unsigned count, TestItem **out) {
+    unsigned received = 0;
+    uint64_t give_up = work_now_us() + 5000000U;
+
+    while (received < count && work_now_us() < give_up) {
+        for (WorkItem *item = mpsc_take_all(queue); item; item = item->next) {
+            if (out && received < count) {
+                out[received] = (TestItem *)item;
+            }
+            received++;
+        }
+        usleep(100);
+    }
+    return received;
+}
+
+static unsigned test_jobs(void) {
+    WorkerPool pool;
+    MpscQueue results;
+    TestItem *items = calloc(TEST_JOBS, sizeof(TestItem));
+    unsigned failures = 0;
+
+    mpsc_init(&results);
+    notify_count = 0;
+    if (worker_pool_init(&pool, 4, count_notify, &notify_count) != 0) {
+        printf("❌ 워커 풀 시작 실패\n");
+        free(items);
+        return 1;
+    }
+    for (unsigned i = 0; i < TEST_JOBS; i++) {
+        items[i].sequence = i;
+        items[i].item.run = sum_run;
+        items[i].item.reply = &results;
+        failures += worker_pool_submit(&pool, &items[i].item) != 0;
+    }
+    unsigned received = wait_results(&results, TEST_JOBS, NULL);
+    for (unsigned i = 0; i < TEST_JOBS; i++) {
+        if (items[i].item.status != WORK_DONE || items[i].value != (uint64_t)i * (i + 1) / 2) {
+            failures++;
+        }
+    }
+    worker_pool_shutdown(&pool);
+    if (received != TEST_JOBS || __atomic_load_n(&notify_count, __ATOMIC_RELAXED) != (int)TEST_JOBS) {
+        printf("❌ 결과 %u개, notify %d번 (기대 %u)\n", received, notify_count, TEST_JOBS);
+        failures++;
+    }
+    free(items);
+
+    printf("작업 %u개: 실패 %u개\n", TEST_JOBS, failures);
+    return failures;
+}
+
+static unsigned test_cancel(void) {
+    WorkerPool pool;
+    MpscQueue results;
+    TestItem running = { 0 }, queued = { 0 }, waited = { 0 }, expiring = { 0 }, stopped = { 0 };
+    TestItem *done[2];
+    unsigned failures = 0;
+
+    mpsc_init(&results);
+    worker_pool_init(&pool, 1, NULL, NULL);
+
+    // 1) 실행 중 취소, 그 뒤에 기다리던 작업은 실행하지 않고 바로 취소
+    running.item.run = spin_run;
+    running.item.reply = &results;
+    queued.item.run = spin_run;
+    queued.item.reply = &results;
+    worker_pool_submit(&pool, &running.item);
+    worker_pool_submit(&pool, &queued.item);
+    while (!__atomic_load_n(&running.started, __ATOMIC_ACQUIRE)) {
+        usleep(100);
+    }
+    // 대기 중인 작업은 워커가 비기 전에 바로 끝남 (기다려도 막히지 않음)
+    work_item_cancel(&queued.item);
+    if (!queued.item.finished || work_item_wait(&queued.item) != WORK_CANCELLED || running.item.finished) {
+        printf("❌ 대기 중 취소가 바로 끝나지 않음\n");
+        failures++;
+    }
+    work_item_cancel(&running.item);
+    if (wait_results(&results, 2, done) != 2 || done[0] != &queued || done[1] != &running ||
+        running.item.status != WORK_CANCELLED || queued.item.status != WORK_CANCELLED || queued.started) {
+        printf("❌ 취소 (상태 %d, %d, 대기 작업 실행 %d)\n", running.item.status, queued.item.status, queued.started);
+        failures++;
+    }
+
+    // 2) 취소 뒤 기다리면 결과 큐를 꺼내기 전에 결과를 읽을 수 있고, 작업은 여전히 큐로 돌아옴
+    waited.item.run = spin_run;
+    waited.item.reply = &results;
+    worker_pool_submit(&pool, &waited.item);
+    while (!__atomic_load_n(&waited.started, __ATOMIC_ACQUIRE)) {
+        usleep(100);
+    }
+    work_item_cancel(&waited.item);
+    if (work_item_wait(&waited.item) != WORK_CANCELLED || !waited.item.finished ||
+        wait_results(&results, 1, done) != 1 || done[0] != &waited) {
+        printf("❌ 취소 뒤 기다림 (상태 %d)\n", waited.item.status);
+        failures++;
+    }
+
+    // 3) 마감 시각
+    expiring.item.run = spin_run;
+    expiring.item.reply = &results;
+    expiring.item.deadline_us = work_now_us() + 20000U;
+    worker_pool_submit(&pool, &expiring.item);
+    if (wait_results(&results, 1, NULL) != 1 || expiring.item.status != WORK_EXPIRED) {
+        printf("❌ 마감 시각 (상태 %d)\n", expiring.item.status);
+        failures++;
+    }
+
+    // 4) 풀 종료는 실행 중인 작업을 취소하고 결과 큐로 돌려보냄
+    stopped.item.run = spin_run;
+    stopped.item.reply = &results;
+    worker_pool_submit(&pool, &stopped.item);
+    while (!__atomic_load_n(&stopped.started, __ATOMIC_ACQUIRE)) {
+        usleep(100);
+    }
+    worker_pool_shutdown(&pool);
+    if (mpsc_take_all(&results) != &stopped.item || stopped.item.status != WORK_CANCELLED) {
+        printf("❌ 풀 종료 (상태 %d)\n", stopped.item.status);
+        failures++;
+    }
+
+    printf("취소/마감/종료: 실패 %u개\n", failures);
+    return failures;
+}
+
+int main(void) {
+    printf("=== 워커 풀 테스트 시작 ===\n\n");
+
+    unsigned failures = test_mpsc() + test_jobs() + test_cancel();
+
+    printf("\n=== 테스트 %s (실패 %u개) ===\n", failures ? "실패" : "성공", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+/* tools/alu_table_gen.c - ALU 결과/플래그 테이블 생성기
+ * ------------------------------------------------------------
+ * 빌드 시 실행되어 ADD/SUB/MUL/DIV 각각의 256×256 입력에 대한
+ * 결과와 CF/ZF/SF/OF를 16비트로 묶은 alu_tables.c를 생성합니다.
+ * 결과는 alu.h의 alu_result(), 플래그는 flags.c의 get_flags()로 계산하므로 실행 경로와 항상 같습니다.
+ * 사용법: alu_table_gen <출력 파일>
+ * Test Case: tests/alu_table_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/alu.h"
+#include "include/alu_table.h"
+#include "include/register.h"
+#include "include/flags.h"
+
+#include <stdio.h>
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "사용법: %s <출력 파일>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[1], "w");
+    if (!out) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "/* 자동 생성 파일 - tools/alu_table_gen.c가 만듭니다. 직접 수정하지 마세요. */\n\n");
+    fprintf(out, "#include \"include/alu_table.h\"\n\n");
+    fprintf(out, "ALU_TABLE_ALIGN const uint16_t alu_table[ALU_TABLE_OPS][ALU_TABLE_ENTRIES] = {\n");
+
+    CPU_Registers regs;
+    reset_registers(&regs);
+
+    for (unsigned op = 0; op < ALU_TABLE_OPS; op++) {
+        fprintf(out, "  {\n");
+        for (unsigned index = 0; index < ALU_TABLE_ENTRIES; index++) {
+            uint8_t a = (uint8_t)(index >> 8);
+            uint8_t b = (uint8_t)index;
+            uint8_t result = alu_result((uint8_t)op, a, b);
+
+            flags_record(&regs, (uint8_t)(FLAG_OP_ADD + op), a, b, result);
+            uint16_t entry = (uint16_t)(((unsigned)get_flags(&regs) << 8) | result);
+
+            fprintf(out, "%s0x%04X,%s", (index % 16) ? "" : "    ", entry, (index % 16 == 15) ? "\n" : "");
+        }
+        fprintf(out, "  },\n");
+    }
+
+    fprintf(out, "};\n");
+    if (fclose(out) != 0) {
+        perror(argv[1]);
+        return 1;
+    }
+    return 0;
+}
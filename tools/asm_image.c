@@ -0,0 +1,88 @@
+/* tools/asm_image.c - 어셈블리 소스 → 바이너리 프로그램 이미지
+ * ------------------------------------------------------------
+ * 소스를 어셈블해 include/image.h 형식(세그먼트 + 심볼 표 + 진입 PC)으로 씁니다.
+ * 사용법: asm_image <소스 파일> <이미지 파일>
+ * Test Case: tests/image_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/assembler.h"
+#include "include/image.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ASM_IMAGE_CAPACITY 0x10000U     /* 이미지 주소 공간 (16비트) */
+
+/*
+ * @brief 파일 전체를 읽습니다
+ * @returns 할당한 버퍼 (호출자가 free), 실패 시 NULL
+ */
+static char* read_file(const char *path, size_t *length) {
+    FILE *in = fopen(path, "rb");
+    char *buffer = NULL;
+    long size;
+
+    if (!in) {
+        return NULL;
+    }
+    if (fseek(in, 0, SEEK_END) == 0 && (size = ftell(in)) >= 0 && fseek(in, 0, SEEK_SET) == 0) {
+        buffer = malloc((size_t)size + 1);
+        if (buffer && fread(buffer, 1, (size_t)size, in) != (size_t)size) {
+            free(buffer);
+            buffer = NULL;
+        }
+        *length = (size_t)size;
+    }
+    fclose(in);
+    return buffer;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "사용법: %s <소스 파일> <이미지 파일>\n", argv[0]);
+        return 1;
+    }
+
+    size_t length = 0;
+    char *source = read_file(argv[1], &length);
+    if (!source) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    uint8_t *output = malloc(ASM_IMAGE_CAPACITY);
+    AsmResult result;
+    ImageSpec spec;
+    int status = 1;
+
+    if (!output) {
+        fprintf(stderr, "❌ 메모리 부족\n");
+    } else if (asm_assemble_image(source, length, output, ASM_IMAGE_CAPACITY, &spec, &result) != 0) {
+        asm_print_errors(&result);
+    } else {
+        char error[128];
+        FILE *out = fopen(argv[2], "wb");
+        if (!out) {
+            perror(argv[2]);
+        } else {
+            if (image_write(out, &spec, error, sizeof(error)) != 0) {
+                fprintf(stderr, "❌ %s\n", error);
+            } else {
+                status = 0;
+            }
+            if (fclose(out) != 0) {
+                status = 1;
+            }
+        }
+        if (status == 0) {
+            printf("✅ %s: 세그먼트 %u개, 심볼 %u개, 명령어 %u개, 진입 PC 0x%04X\n", argv[2],
+                   spec.segment_count, spec.symbol_count, result.instructions, spec.entry_pc);
+        }
+        asm_image_free(&spec);
+    }
+
+    free(output);
+    free(source);
+    return status;
+}
@@ -0,0 +1,53 @@
+/* tools/trace_decode.c - 바이너리 실행 트레이스 디코더
+ * ------------------------------------------------------------
+ * trace_start()로 만든 파일을 읽어 레코드마다 한 줄씩 텍스트로 출력합니다.
+ * 사용법: trace_decode <트레이스 파일>
+ * Test Case: tests/trace_test.c
+ * Author: Cho Sungju
+*/
+
+#include "include/trace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "사용법: %s <트레이스 파일>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *in = fopen(argv[1], "rb");
+    if (!in) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    char magic[sizeof(TRACE_MAGIC)];
+    if (fread(magic, 1, sizeof(magic), in) != sizeof(magic) || memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0) {
+        fprintf(stderr, "❌ 트레이스 파일이 아닙니다: %s\n", argv[1]);
+        fclose(in);
+        return 1;
+    }
+
+    TraceCodec codec;
+    TraceRecord record;
+    char line[160];
+    unsigned long long count = 0;
+    int status;
+
+    trace_codec_init(&codec);
+    while ((status = trace_decode_record(&codec, in, &record)) > 0) {
+        trace_format_record(&record, line, sizeof(line));
+        puts(line);
+        count++;
+    }
+    fclose(in);
+
+    if (status < 0) {
+        fprintf(stderr, "❌ %llu번째 레코드 뒤에서 파일이 잘렸습니다\n", count);
+        return 1;
+    }
+    fprintf(stderr, "레코드 %llu개\n", count);
+    return 0;
+}